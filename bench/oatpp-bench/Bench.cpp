@@ -0,0 +1,198 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Bench.hpp"
+
+#include "Counters.hpp"
+#include "CountingConnectionProvider.hpp"
+
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace bench {
+
+namespace {
+
+class PlaintextHandler : public web::server::HttpRequestHandler {
+private:
+
+  class HandlerCoroutine : public async::CoroutineWithResult<HandlerCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+  public:
+
+    Action act() override {
+      return _return(ResponseFactory::createResponse(Status::CODE_200, "Hello World!!!"));
+    }
+
+  };
+
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return ResponseFactory::createResponse(Status::CODE_200, "Hello World!!!");
+  }
+
+  async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return HandlerCoroutine::startForResult();
+  }
+
+};
+
+struct CountersSnapshot {
+
+  v_int64 allocations;
+  v_int64 ioCalls;
+  v_int64 contextSwitches;
+
+  static CountersSnapshot take() {
+    return {Counters::ALLOCATIONS.get(), Counters::IO_CALLS.get(), Counters::getContextSwitches()};
+  }
+
+};
+
+v_float64 perRequest(v_int64 value, v_int64 requests) {
+  if(requests == 0) {
+    return 0;
+  }
+  return static_cast<v_float64>(value) / static_cast<v_float64>(requests);
+}
+
+}
+
+oatpp::Object<ScenarioResult> Bench::run(const Scenario& scenario) {
+
+  auto router = web::server::HttpRouter::createShared();
+  router->route("GET", "/plaintext", std::make_shared<PlaintextHandler>());
+
+  auto config = std::make_shared<web::server::HttpProcessor::Config>();
+  config->useRequestArena = scenario.requestArena;
+  auto components = std::make_shared<web::server::HttpProcessor::Components>(router, config);
+
+  std::shared_ptr<async::Executor> executor;
+  std::shared_ptr<network::ConnectionHandler> connectionHandler;
+  if(scenario.handler == Handler::ASYNC) {
+    executor = std::make_shared<async::Executor>();
+    connectionHandler = web::server::AsyncHttpConnectionHandler::createShared(components, executor);
+  } else {
+    connectionHandler = std::make_shared<web::server::HttpConnectionHandler>(components);
+  }
+
+  std::shared_ptr<network::ServerConnectionProvider> serverConnectionProvider;
+  std::shared_ptr<network::ClientConnectionProvider> clientConnectionProvider;
+
+  if(scenario.transport == Transport::VIRTUAL) {
+    auto _interface = network::virtual_::Interface::obtainShared("oatpp-bench");
+    serverConnectionProvider = network::virtual_::server::ConnectionProvider::createShared(_interface);
+    clientConnectionProvider = network::virtual_::client::ConnectionProvider::createShared(_interface);
+  } else {
+    serverConnectionProvider = network::tcp::server::ConnectionProvider::createShared({"localhost", 0, network::Address::IP_4});
+    auto port = oatpp::utils::Conversion::strToInt32(serverConnectionProvider->getProperty("port").toString()->c_str());
+    clientConnectionProvider = network::tcp::client::ConnectionProvider::createShared({"localhost", static_cast<v_uint16>(port), network::Address::IP_4});
+  }
+
+  auto countingConnectionProvider = std::make_shared<CountingConnectionProvider>(serverConnectionProvider);
+
+  network::Server server(countingConnectionProvider, connectionHandler);
+  std::thread serverThread([&server] {
+    server.run();
+  });
+
+  CountersSnapshot start{};
+  CountersSnapshot end{};
+
+  LoadGenerator generator(clientConnectionProvider, scenario.load);
+  auto load = generator.run(
+    [&start] { start = CountersSnapshot::take(); },
+    [&end] { end = CountersSnapshot::take(); }
+  );
+
+  server.stop();
+  connectionHandler->stop();
+  countingConnectionProvider->stop();
+  clientConnectionProvider->stop();
+  serverThread.join();
+
+  if(executor) {
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+  }
+
+  auto result = ScenarioResult::createShared();
+
+  result->handler = getHandlerName(scenario.handler);
+  result->transport = getTransportName(scenario.transport);
+  result->workload = LoadGenerator::getWorkloadName(scenario.load.workload);
+  result->threads = scenario.load.threads;
+  result->pipelineDepth = scenario.load.workload == LoadGenerator::Workload::PIPELINED ? scenario.load.pipelineDepth : 1;
+  result->requestArena = scenario.requestArena;
+
+  result->requests = load.requests;
+  result->errors = load.errors;
+  result->durationSec = static_cast<v_float64>(load.elapsedMicro) / 1000000.0;
+  result->rps = load.elapsedMicro > 0 ? static_cast<v_float64>(load.requests) * 1000000.0 / static_cast<v_float64>(load.elapsedMicro) : 0;
+
+  result->latencyP50 = load.getLatencyMicro(50);
+  result->latencyP99 = load.getLatencyMicro(99);
+  result->latencyP999 = load.getLatencyMicro(99.9);
+
+  result->allocationsPerRequest = perRequest(end.allocations - start.allocations, load.requests);
+  result->ioCallsPerRequest = perRequest(end.ioCalls - start.ioCalls, load.requests);
+  result->contextSwitchesPerRequest = perRequest(end.contextSwitches - start.contextSwitches, load.requests);
+
+  return result;
+
+}
+
+const char* Bench::getHandlerName(Handler handler) {
+  switch (handler) {
+    case Handler::SYNC: return "sync";
+    case Handler::ASYNC: return "async";
+    default: return "unknown";
+  }
+}
+
+const char* Bench::getTransportName(Transport transport) {
+  switch (transport) {
+    case Transport::TCP: return "tcp";
+    case Transport::VIRTUAL: return "virtual";
+    default: return "unknown";
+  }
+}
+
+}}
@@ -0,0 +1,163 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_bench_Bench_hpp
+#define oatpp_bench_Bench_hpp
+
+#include "LoadGenerator.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace bench {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Result of one benchmark scenario.
+ */
+class ScenarioResult : public oatpp::DTO {
+
+  DTO_INIT(ScenarioResult, DTO)
+
+  DTO_FIELD(String, handler);
+  DTO_FIELD(String, transport);
+  DTO_FIELD(String, workload);
+  DTO_FIELD(Int32, threads);
+  DTO_FIELD(Int32, pipelineDepth, "pipeline_depth");
+  DTO_FIELD(Boolean, requestArena, "request_arena");
+
+  DTO_FIELD(Int64, requests);
+  DTO_FIELD(Int64, errors);
+  DTO_FIELD(Float64, durationSec, "duration_sec");
+  DTO_FIELD(Float64, rps);
+
+  DTO_FIELD(Float64, latencyP50, "latency_p50_us");
+  DTO_FIELD(Float64, latencyP99, "latency_p99_us");
+  DTO_FIELD(Float64, latencyP999, "latency_p999_us");
+
+  DTO_FIELD(Float64, allocationsPerRequest, "allocations_per_request");
+  DTO_FIELD(Float64, ioCallsPerRequest, "io_calls_per_request");
+  DTO_FIELD(Float64, contextSwitchesPerRequest, "context_switches_per_request");
+
+};
+
+/**
+ * Benchmark report.
+ */
+class Report : public oatpp::DTO {
+
+  DTO_INIT(Report, DTO)
+
+  DTO_FIELD(String, version) = OATPP_VERSION;
+  DTO_FIELD(List<Object<ScenarioResult>>, results) = {};
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+/**
+ * End-to-end HTTP benchmark. <br>
+ * Starts oatpp server in-process, drives load with &id:oatpp::bench::LoadGenerator; and collects stats.
+ */
+class Bench {
+public:
+
+  /**
+   * Server connection handler.
+   */
+  enum class Handler : v_int32 {
+
+    /**
+     * &id:oatpp::web::server::HttpConnectionHandler;.
+     */
+    SYNC = 0,
+
+    /**
+     * &id:oatpp::web::server::AsyncHttpConnectionHandler;.
+     */
+    ASYNC = 1
+
+  };
+
+  /**
+   * Transport between client and server.
+   */
+  enum class Transport : v_int32 {
+
+    /**
+     * TCP loopback.
+     */
+    TCP = 0,
+
+    /**
+     * &id:oatpp::network::virtual_::Interface;.
+     */
+    VIRTUAL = 1
+
+  };
+
+  /**
+   * Benchmark scenario.
+   */
+  struct Scenario {
+    Handler handler;
+    Transport transport;
+    LoadGenerator::Config load;
+
+    /**
+     * Enable &id:oatpp::web::server::HttpProcessor::Config::useRequestArena;.
+     */
+    bool requestArena = false;
+  };
+
+public:
+
+  /**
+   * Run scenario.
+   * @param scenario - &l:Bench::Scenario;.
+   * @return - &l:ScenarioResult;.
+   */
+  static oatpp::Object<ScenarioResult> run(const Scenario& scenario);
+
+  /**
+   * Get handler name.
+   * @param handler
+   * @return
+   */
+  static const char* getHandlerName(Handler handler);
+
+  /**
+   * Get transport name.
+   * @param transport
+   * @return
+   */
+  static const char* getTransportName(Transport transport);
+
+};
+
+}}
+
+#endif // oatpp_bench_Bench_hpp
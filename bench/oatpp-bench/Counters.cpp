@@ -0,0 +1,132 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Counters.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#if !defined(WIN32) && !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace oatpp { namespace bench {
+
+namespace {
+
+v_int32 getThreadStripe() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  static std::atomic<v_int32> stripeCounter(0);
+  static thread_local v_int32 stripe = stripeCounter ++;
+  return stripe;
+#else
+  return static_cast<v_int32>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % 1024);
+#endif
+}
+
+}
+
+StripedCounter Counters::ALLOCATIONS;
+StripedCounter Counters::IO_CALLS;
+
+void StripedCounter::increment() {
+  m_stripes[getThreadStripe() % STRIPES_COUNT].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+v_int64 StripedCounter::get() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < STRIPES_COUNT; i ++) {
+    result += m_stripes[i].value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+v_int64 Counters::getContextSwitches() {
+#if !defined(WIN32) && !defined(_WIN32)
+  rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) == 0) {
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+  }
+#endif
+  return 0;
+}
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Replace global allocation functions to count allocations per request
+
+void* operator new(std::size_t size) {
+  oatpp::bench::Counters::ALLOCATIONS.increment();
+  if(size == 0) {
+    size = 1;
+  }
+  void* ptr = std::malloc(size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return ::operator new(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_bench_Counters_hpp
+#define oatpp_bench_Counters_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+
+namespace oatpp { namespace bench {
+
+/**
+ * Process-wide counter which can be incremented from many threads without adding contention to the measured code.
+ * Increments go to per-thread stripes. Reading sums all stripes.
+ */
+class StripedCounter {
+private:
+  static constexpr v_int32 STRIPES_COUNT = 64;
+private:
+  struct alignas(64) Stripe {
+    std::atomic<v_int64> value{0};
+  };
+private:
+  Stripe m_stripes[STRIPES_COUNT];
+public:
+
+  /**
+   * Increment counter.
+   */
+  void increment();
+
+  /**
+   * Get current value.
+   * @return
+   */
+  v_int64 get() const;
+
+};
+
+/**
+ * Counters collected by the benchmark.
+ */
+class Counters {
+public:
+
+  /**
+   * Number of `operator new` calls in the whole process.
+   */
+  static StripedCounter ALLOCATIONS;
+
+  /**
+   * Number of read/write calls on server connections.
+   */
+  static StripedCounter IO_CALLS;
+
+  /**
+   * Get number of context switches of the process. Always `0` if not supported by the platform.
+   * @return
+   */
+  static v_int64 getContextSwitches();
+
+};
+
+}}
+
+#endif // oatpp_bench_Counters_hpp
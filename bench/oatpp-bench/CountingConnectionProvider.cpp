@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CountingConnectionProvider.hpp"
+
+#include "Counters.hpp"
+
+namespace oatpp { namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CountingConnectionProvider::CountingStream
+
+CountingConnectionProvider::CountingStream::CountingStream(const provider::ResourceHandle<data::stream::IOStream>& handle)
+  : m_handle(handle)
+{}
+
+v_io_size CountingConnectionProvider::CountingStream::write(const void *buff, v_buff_size count, async::Action& action) {
+  Counters::IO_CALLS.increment();
+  return m_handle.object->write(buff, count, action);
+}
+
+v_io_size CountingConnectionProvider::CountingStream::read(void *buff, v_buff_size count, async::Action& action) {
+  Counters::IO_CALLS.increment();
+  return m_handle.object->read(buff, count, action);
+}
+
+void CountingConnectionProvider::CountingStream::setOutputStreamIOMode(data::stream::IOMode ioMode) {
+  m_handle.object->setOutputStreamIOMode(ioMode);
+}
+
+data::stream::IOMode CountingConnectionProvider::CountingStream::getOutputStreamIOMode() {
+  return m_handle.object->getOutputStreamIOMode();
+}
+
+data::stream::Context& CountingConnectionProvider::CountingStream::getOutputStreamContext() {
+  return m_handle.object->getOutputStreamContext();
+}
+
+void CountingConnectionProvider::CountingStream::setInputStreamIOMode(data::stream::IOMode ioMode) {
+  m_handle.object->setInputStreamIOMode(ioMode);
+}
+
+data::stream::IOMode CountingConnectionProvider::CountingStream::getInputStreamIOMode() {
+  return m_handle.object->getInputStreamIOMode();
+}
+
+data::stream::Context& CountingConnectionProvider::CountingStream::getInputStreamContext() {
+  return m_handle.object->getInputStreamContext();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CountingConnectionProvider::ConnectionInvalidator
+
+void CountingConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<data::stream::IOStream>& connection) {
+  auto stream = std::static_pointer_cast<CountingStream>(connection);
+  stream->m_handle.invalidator->invalidate(stream->m_handle.object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CountingConnectionProvider
+
+CountingConnectionProvider::CountingConnectionProvider(const std::shared_ptr<network::ServerConnectionProvider>& provider)
+  : m_provider(provider)
+  , m_invalidator(std::make_shared<ConnectionInvalidator>())
+{
+  m_properties = provider->getProperties();
+}
+
+provider::ResourceHandle<data::stream::IOStream> CountingConnectionProvider::wrap(const provider::ResourceHandle<data::stream::IOStream>& handle) {
+  if(handle.object == nullptr) {
+    return nullptr;
+  }
+  return provider::ResourceHandle<data::stream::IOStream>(std::make_shared<CountingStream>(handle), m_invalidator);
+}
+
+provider::ResourceHandle<data::stream::IOStream> CountingConnectionProvider::get() {
+  return wrap(m_provider->get());
+}
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> CountingConnectionProvider::getAsync() {
+
+  class GetCoroutine : public async::CoroutineWithResult<GetCoroutine, const provider::ResourceHandle<data::stream::IOStream>&> {
+  private:
+    CountingConnectionProvider* m_provider;
+  public:
+
+    GetCoroutine(CountingConnectionProvider* provider)
+      : m_provider(provider)
+    {}
+
+    Action act() override {
+      return m_provider->m_provider->getAsync().callbackTo(&GetCoroutine::onConnection);
+    }
+
+    Action onConnection(const provider::ResourceHandle<data::stream::IOStream>& connection) {
+      return _return(m_provider->wrap(connection));
+    }
+
+  };
+
+  return GetCoroutine::startForResult(this);
+
+}
+
+void CountingConnectionProvider::stop() {
+  m_provider->stop();
+}
+
+}}
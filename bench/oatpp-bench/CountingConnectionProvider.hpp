@@ -0,0 +1,101 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_bench_CountingConnectionProvider_hpp
+#define oatpp_bench_CountingConnectionProvider_hpp
+
+#include "oatpp/network/ConnectionProvider.hpp"
+
+namespace oatpp { namespace bench {
+
+/**
+ * Server connection provider which wraps connections of the underlying provider
+ * and counts read/write calls on them in &id:oatpp::bench::Counters::IO_CALLS;. <br>
+ * For TCP connections each read/write call is one syscall.
+ */
+class CountingConnectionProvider : public network::ServerConnectionProvider {
+private:
+
+  class CountingStream : public data::stream::IOStream {
+    friend CountingConnectionProvider;
+  private:
+    provider::ResourceHandle<data::stream::IOStream> m_handle;
+  public:
+
+    CountingStream(const provider::ResourceHandle<data::stream::IOStream>& handle);
+
+    v_io_size write(const void *buff, v_buff_size count, async::Action& action) override;
+    v_io_size read(void *buff, v_buff_size count, async::Action& action) override;
+
+    void setOutputStreamIOMode(data::stream::IOMode ioMode) override;
+    data::stream::IOMode getOutputStreamIOMode() override;
+    data::stream::Context& getOutputStreamContext() override;
+
+    void setInputStreamIOMode(data::stream::IOMode ioMode) override;
+    data::stream::IOMode getInputStreamIOMode() override;
+    data::stream::Context& getInputStreamContext() override;
+
+  };
+
+  class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<data::stream::IOStream>& connection) override;
+  };
+
+private:
+  provider::ResourceHandle<data::stream::IOStream> wrap(const provider::ResourceHandle<data::stream::IOStream>& handle);
+private:
+  std::shared_ptr<network::ServerConnectionProvider> m_provider;
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+public:
+
+  /**
+   * Constructor.
+   * @param provider - underlying server connection provider.
+   */
+  CountingConnectionProvider(const std::shared_ptr<network::ServerConnectionProvider>& provider);
+
+  /**
+   * Get incoming connection.
+   * @return
+   */
+  provider::ResourceHandle<data::stream::IOStream> get() override;
+
+  /**
+   * Get incoming connection asynchronously.
+   * @return
+   */
+  async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override;
+
+  /**
+   * Stop underlying provider.
+   */
+  void stop() override;
+
+};
+
+}}
+
+#endif // oatpp_bench_CountingConnectionProvider_hpp
@@ -0,0 +1,304 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "LoadGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace oatpp { namespace bench {
+
+namespace {
+
+v_buff_size parseContentLength(const v_char8* headers, v_buff_size size) {
+
+  static const char* const NAME = "content-length:";
+  static const v_buff_size NAME_SIZE = static_cast<v_buff_size>(std::strlen(NAME));
+
+  for(v_buff_size i = 0; i + NAME_SIZE < size; i ++) {
+
+    v_buff_size j = 0;
+    while(j < NAME_SIZE && (headers[i + j] | 0x20) == NAME[j]) {
+      j ++;
+    }
+
+    if(j == NAME_SIZE) {
+      v_buff_size pos = i + NAME_SIZE;
+      while(pos < size && headers[pos] == ' ') {
+        pos ++;
+      }
+      v_buff_size result = 0;
+      while(pos < size && headers[pos] >= '0' && headers[pos] <= '9') {
+        result = result * 10 + (headers[pos] - '0');
+        pos ++;
+      }
+      return result;
+    }
+
+  }
+
+  return 0;
+
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LoadGenerator::Result
+
+v_float64 LoadGenerator::Result::getLatencyMicro(v_float64 percentile) const {
+  if(latencies.empty()) {
+    return 0;
+  }
+  auto index = static_cast<size_t>(percentile / 100.0 * static_cast<v_float64>(latencies.size()));
+  if(index >= latencies.size()) {
+    index = latencies.size() - 1;
+  }
+  return static_cast<v_float64>(latencies[index]) / 1000.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LoadGenerator::ResponseReader
+
+LoadGenerator::ResponseReader::ResponseReader()
+  : m_buffer(new v_char8[BUFFER_SIZE])
+  , m_start(0)
+  , m_end(0)
+{}
+
+void LoadGenerator::ResponseReader::reset() {
+  m_start = 0;
+  m_end = 0;
+}
+
+bool LoadGenerator::ResponseReader::fill(data::stream::InputStream* stream) {
+
+  if(m_start > 0) {
+    std::memmove(m_buffer.get(), &m_buffer[static_cast<size_t>(m_start)], static_cast<size_t>(m_end - m_start));
+    m_end -= m_start;
+    m_start = 0;
+  }
+
+  if(m_end == BUFFER_SIZE) {
+    return false; // response is too big
+  }
+
+  auto res = stream->readSimple(&m_buffer[static_cast<size_t>(m_end)], BUFFER_SIZE - m_end);
+  if(res <= 0) {
+    return false;
+  }
+
+  m_end += res;
+  return true;
+
+}
+
+bool LoadGenerator::ResponseReader::readResponse(data::stream::InputStream* stream) {
+
+  v_buff_size scanned = 0;
+  v_buff_size headersSize = -1;
+
+  while(true) {
+
+    const v_char8* begin = &m_buffer[static_cast<size_t>(m_start)];
+    v_buff_size size = m_end - m_start;
+
+    if(headersSize < 0) {
+      for(v_buff_size i = scanned; i + 3 < size; i ++) {
+        if(begin[i] == '\r' && begin[i + 1] == '\n' && begin[i + 2] == '\r' && begin[i + 3] == '\n') {
+          headersSize = i + 4;
+          break;
+        }
+      }
+      if(headersSize < 0) {
+        scanned = size > 3 ? size - 3 : 0;
+      }
+    }
+
+    if(headersSize >= 0) {
+      auto total = headersSize + parseContentLength(begin, headersSize);
+      if(size >= total) {
+        m_start += total;
+        if(m_start == m_end) {
+          reset();
+        }
+        return true;
+      }
+    }
+
+    if(!fill(stream)) {
+      return false;
+    }
+
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LoadGenerator
+
+LoadGenerator::LoadGenerator(const std::shared_ptr<network::ClientConnectionProvider>& connectionProvider, const Config& config)
+  : m_connectionProvider(connectionProvider)
+  , m_config(config)
+  , m_phase(PHASE_WARMUP)
+{}
+
+void LoadGenerator::runClient(ClientStats* stats) {
+
+  bool churn = m_config.workload == Workload::CHURN;
+  v_int32 batch = m_config.workload == Workload::PIPELINED ? m_config.pipelineDepth : 1;
+
+  std::string request = std::string("GET ") + m_config.path + " HTTP/1.1\r\n"
+                        "Host: localhost\r\n"
+                        "Connection: " + (churn ? "close" : "keep-alive") + "\r\n"
+                        "\r\n";
+  std::string requests;
+  for(v_int32 i = 0; i < batch; i ++) {
+    requests += request;
+  }
+  auto requestsSize = static_cast<v_buff_size>(requests.size());
+
+  stats->latencies.reserve(1024 * 1024);
+
+  ResponseReader reader;
+  provider::ResourceHandle<data::stream::IOStream> connection;
+
+  while(m_phase != PHASE_STOP) {
+
+    if(connection.object == nullptr) {
+
+      try {
+        connection = m_connectionProvider->get();
+      } catch (...) {
+        connection = nullptr;
+      }
+
+      if(connection.object == nullptr) {
+        if(m_phase == PHASE_MEASURE) {
+          stats->errors ++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        continue;
+      }
+
+      connection.object->setOutputStreamIOMode(data::stream::IOMode::BLOCKING);
+      connection.object->setInputStreamIOMode(data::stream::IOMode::BLOCKING);
+      reader.reset();
+
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = connection.object->writeExactSizeDataSimple(requests.data(), requestsSize) == requestsSize;
+
+    for(v_int32 i = 0; ok && i < batch; i ++) {
+      ok = reader.readResponse(connection.object.get());
+      if(ok && m_phase == PHASE_MEASURE) {
+        stats->requests ++;
+        stats->latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+      }
+    }
+
+    if(!ok && m_phase == PHASE_MEASURE) {
+      stats->errors ++;
+    }
+
+    if(!ok || churn) {
+      connection.invalidator->invalidate(connection.object);
+      connection = nullptr;
+    }
+
+  }
+
+  if(connection.object) {
+    connection.invalidator->invalidate(connection.object);
+  }
+
+}
+
+LoadGenerator::Result LoadGenerator::run(const PhaseCallback& onMeasureStart, const PhaseCallback& onMeasureEnd) {
+
+  m_phase = PHASE_WARMUP;
+
+  std::vector<ClientStats> stats(static_cast<size_t>(m_config.threads));
+  std::vector<std::thread> threads;
+
+  for(auto& clientStats : stats) {
+    threads.emplace_back(&LoadGenerator::runClient, this, &clientStats);
+  }
+
+  std::this_thread::sleep_for(std::chrono::microseconds(m_config.warmupMicro));
+
+  if(onMeasureStart) {
+    onMeasureStart();
+  }
+  auto start = std::chrono::steady_clock::now();
+  m_phase = PHASE_MEASURE;
+
+  std::this_thread::sleep_for(std::chrono::microseconds(m_config.durationMicro));
+
+  m_phase = PHASE_STOP;
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  if(onMeasureEnd) {
+    onMeasureEnd();
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  Result result;
+  result.elapsedMicro = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  size_t samples = 0;
+  for(auto& clientStats : stats) {
+    samples += clientStats.latencies.size();
+  }
+  result.latencies.reserve(samples);
+
+  for(auto& clientStats : stats) {
+    result.requests += clientStats.requests;
+    result.errors += clientStats.errors;
+    result.latencies.insert(result.latencies.end(), clientStats.latencies.begin(), clientStats.latencies.end());
+  }
+
+  std::sort(result.latencies.begin(), result.latencies.end());
+
+  return result;
+
+}
+
+const char* LoadGenerator::getWorkloadName(Workload workload) {
+  switch (workload) {
+    case Workload::KEEP_ALIVE: return "keep-alive";
+    case Workload::PIPELINED: return "pipelined";
+    case Workload::CHURN: return "churn";
+    default: return "unknown";
+  }
+}
+
+}}
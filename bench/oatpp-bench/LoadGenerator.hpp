@@ -0,0 +1,207 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_bench_LoadGenerator_hpp
+#define oatpp_bench_LoadGenerator_hpp
+
+#include "oatpp/network/ConnectionProvider.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace bench {
+
+/**
+ * HTTP load generator. <br>
+ * Writes raw HTTP requests and parses raw responses so that the client side adds as little work as possible to the measurement.
+ * Client is allocation-free in steady state (except for new connections in &l:LoadGenerator::Workload::CHURN;).
+ */
+class LoadGenerator {
+public:
+
+  /**
+   * Workload type.
+   */
+  enum class Workload : v_int32 {
+
+    /**
+     * One persistent connection per client. Next request is sent after the response to the previous one is received.
+     */
+    KEEP_ALIVE = 0,
+
+    /**
+     * One persistent connection per client. Requests are sent in batches of `pipelineDepth` without waiting for responses.
+     */
+    PIPELINED = 1,
+
+    /**
+     * New connection per request - `Connection: close`.
+     */
+    CHURN = 2
+
+  };
+
+  /**
+   * Load generator config.
+   */
+  struct Config {
+
+    /**
+     * Workload.
+     */
+    Workload workload = Workload::KEEP_ALIVE;
+
+    /**
+     * Number of client threads. Each thread uses one connection at a time.
+     */
+    v_int32 threads = 4;
+
+    /**
+     * Number of requests in one batch for &l:LoadGenerator::Workload::PIPELINED;.
+     */
+    v_int32 pipelineDepth = 16;
+
+    /**
+     * Warm-up time. Requests done during warm-up are not counted.
+     */
+    v_int64 warmupMicro = 500 * 1000;
+
+    /**
+     * Measurement time.
+     */
+    v_int64 durationMicro = 3 * 1000 * 1000;
+
+    /**
+     * Request path.
+     */
+    const char* path = "/plaintext";
+
+  };
+
+  /**
+   * Measurement result.
+   */
+  struct Result {
+
+    /**
+     * Number of completed requests.
+     */
+    v_int64 requests = 0;
+
+    /**
+     * Number of failed requests/connections.
+     */
+    v_int64 errors = 0;
+
+    /**
+     * Actual measurement time.
+     */
+    v_int64 elapsedMicro = 0;
+
+    /**
+     * Latency of each request in nanoseconds. Sorted.
+     */
+    std::vector<v_int64> latencies;
+
+    /**
+     * Get latency percentile in microseconds.
+     * @param percentile - percentile in range [0, 100].
+     * @return
+     */
+    v_float64 getLatencyMicro(v_float64 percentile) const;
+
+  };
+
+  /**
+   * Callback called on measurement start/end. Used to snapshot counters.
+   */
+  typedef std::function<void()> PhaseCallback;
+
+private:
+
+  class ResponseReader {
+  private:
+    static constexpr v_buff_size BUFFER_SIZE = 64 * 1024;
+  private:
+    std::unique_ptr<v_char8[]> m_buffer;
+    v_buff_size m_start;
+    v_buff_size m_end;
+  private:
+    bool fill(data::stream::InputStream* stream);
+  public:
+    ResponseReader();
+    void reset();
+    bool readResponse(data::stream::InputStream* stream);
+  };
+
+  struct ClientStats {
+    v_int64 requests = 0;
+    v_int64 errors = 0;
+    std::vector<v_int64> latencies;
+  };
+
+  enum Phase : v_int32 {
+    PHASE_WARMUP = 0,
+    PHASE_MEASURE = 1,
+    PHASE_STOP = 2
+  };
+
+private:
+  void runClient(ClientStats* stats);
+private:
+  std::shared_ptr<network::ClientConnectionProvider> m_connectionProvider;
+  Config m_config;
+  std::atomic<v_int32> m_phase;
+public:
+
+  /**
+   * Constructor.
+   * @param connectionProvider - client connection provider.
+   * @param config - &l:LoadGenerator::Config;.
+   */
+  LoadGenerator(const std::shared_ptr<network::ClientConnectionProvider>& connectionProvider, const Config& config);
+
+  /**
+   * Run load. Blocks for warmup + duration time.
+   * @param onMeasureStart - called when warm-up is finished.
+   * @param onMeasureEnd - called when measurement is finished.
+   * @return - &l:LoadGenerator::Result;.
+   */
+  Result run(const PhaseCallback& onMeasureStart, const PhaseCallback& onMeasureEnd);
+
+  /**
+   * Get workload name.
+   * @param workload
+   * @return
+   */
+  static const char* getWorkloadName(Workload workload);
+
+};
+
+}}
+
+#endif // oatpp_bench_LoadGenerator_hpp
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Bench.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/base/CommandLineArguments.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+const char* const USAGE =
+  "Usage: oatpp-bench [options]\n"
+  "\n"
+  "  --handler <sync|async|all>                    connection handler. Default: all\n"
+  "  --transport <tcp|virtual|all>                 client-server transport. Default: all\n"
+  "  --workload <keep-alive|pipelined|churn|all>   workload. Default: all\n"
+  "  --threads <n>                                 client threads. Default: 4\n"
+  "  --pipeline <n>                                requests per batch for pipelined workload. Default: 16\n"
+  "  --duration <sec>                              measurement time per scenario. Default: 3\n"
+  "  --warmup <sec>                                warm-up time per scenario. Default: 0.5\n"
+  "  --arena                                       allocate per-request structures from the request arena\n"
+  "  --json <file>                                 write results as JSON to file ('-' for stdout)\n";
+
+bool matches(const char* value, const char* name) {
+  return std::strcmp(value, "all") == 0 || std::strcmp(value, name) == 0;
+}
+
+void printResult(const oatpp::Object<oatpp::bench::ScenarioResult>& r) {
+  std::printf("%-6s %-8s %-11s %12.0f %10.1f %10.1f %10.1f %10.2f %10.2f %10.3f %8lld\n",
+              r->handler->c_str(), r->transport->c_str(), r->workload->c_str(),
+              *r->rps, *r->latencyP50, *r->latencyP99, *r->latencyP999,
+              *r->allocationsPerRequest, *r->ioCallsPerRequest, *r->contextSwitchesPerRequest,
+              static_cast<long long>(*r->errors));
+  std::fflush(stdout);
+}
+
+void run(const oatpp::base::CommandLineArguments& args) {
+
+  const char* handler = args.getNamedArgumentValue("--handler", "all");
+  const char* transport = args.getNamedArgumentValue("--transport", "all");
+  const char* workload = args.getNamedArgumentValue("--workload", "all");
+  const char* json = args.getNamedArgumentValue("--json");
+
+  oatpp::bench::LoadGenerator::Config load;
+  load.threads = oatpp::utils::Conversion::strToInt32(args.getNamedArgumentValue("--threads", "4"));
+  load.pipelineDepth = oatpp::utils::Conversion::strToInt32(args.getNamedArgumentValue("--pipeline", "16"));
+  load.durationMicro = static_cast<v_int64>(oatpp::utils::Conversion::strToFloat64(args.getNamedArgumentValue("--duration", "3")) * 1000000);
+  load.warmupMicro = static_cast<v_int64>(oatpp::utils::Conversion::strToFloat64(args.getNamedArgumentValue("--warmup", "0.5")) * 1000000);
+
+  std::vector<oatpp::bench::Bench::Scenario> scenarios;
+
+  for(auto h : {oatpp::bench::Bench::Handler::SYNC, oatpp::bench::Bench::Handler::ASYNC}) {
+    if(!matches(handler, oatpp::bench::Bench::getHandlerName(h))) continue;
+    for(auto t : {oatpp::bench::Bench::Transport::TCP, oatpp::bench::Bench::Transport::VIRTUAL}) {
+      if(!matches(transport, oatpp::bench::Bench::getTransportName(t))) continue;
+      for(auto w : {oatpp::bench::LoadGenerator::Workload::KEEP_ALIVE,
+                    oatpp::bench::LoadGenerator::Workload::PIPELINED,
+                    oatpp::bench::LoadGenerator::Workload::CHURN})
+      {
+        if(!matches(workload, oatpp::bench::LoadGenerator::getWorkloadName(w))) continue;
+        oatpp::bench::Bench::Scenario scenario{h, t, load};
+        scenario.load.workload = w;
+        scenario.requestArena = args.hasArgument("--arena");
+        scenarios.push_back(scenario);
+      }
+    }
+  }
+
+  if(scenarios.empty()) {
+    std::printf("No scenarios selected.\n\n%s", USAGE);
+    return;
+  }
+
+  std::printf("%-6s %-8s %-11s %12s %10s %10s %10s %10s %10s %10s %8s\n",
+              "handler", "transp.", "workload", "rps", "p50(us)", "p99(us)", "p999(us)",
+              "allocs/req", "io/req", "csw/req", "errors");
+
+  auto report = oatpp::bench::Report::createShared();
+
+  for(auto& scenario : scenarios) {
+    auto result = oatpp::bench::Bench::run(scenario);
+    printResult(result);
+    report->results->push_back(result);
+  }
+
+  if(json) {
+
+    oatpp::json::ObjectMapper mapper;
+    mapper.serializerConfig().json.useBeautifier = true;
+    auto text = mapper.writeToString(report);
+
+    if(std::strcmp(json, "-") == 0) {
+      std::printf("%s\n", text->c_str());
+    } else {
+      std::ofstream file(json, std::ios::out | std::ios::trunc);
+      file << *text << "\n";
+    }
+
+  }
+
+}
+
+}
+
+int main(int argc, const char* argv[]) {
+
+  oatpp::base::CommandLineArguments args(argc, argv);
+
+  if(args.hasArgument("--help") || args.hasArgument("-h")) {
+    std::printf("%s", USAGE);
+    return 0;
+  }
+
+  oatpp::Environment::init();
+  run(args);
+  oatpp::Environment::destroy();
+
+  return 0;
+
+}
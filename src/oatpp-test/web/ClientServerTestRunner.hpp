@@ -28,6 +28,10 @@
 #include "oatpp/web/server/api/ApiController.hpp"
 #include "oatpp/web/server/HttpRouter.hpp"
 
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+
 #include "oatpp/network/Server.hpp"
 #include "oatpp/network/ConnectionProvider.hpp"
 
@@ -146,6 +150,43 @@ public:
 
   }
 
+  /**
+   * Run server on the virtual interface `interfaceName`, execute code block passed as lambda, stop server. <br>
+   * Lambda is called with the client connection provider of the same interface.
+   * @tparam Lambda - `void(const std::shared_ptr<oatpp::network::ClientConnectionProvider>&)`.
+   * @param interfaceName - name of the virtual interface. Use different names to isolate test cases.
+   * @param router - router to serve.
+   * @param connectionHandler - connection handler to serve.
+   * @param controller - controller to add to router.
+   * @param lambda - client code.
+   * @param timeout
+   */
+  template<typename Lambda>
+  static void runOnVirtualInterface(
+    const oatpp::String& interfaceName,
+    std::shared_ptr<HttpRouter> router,
+    std::shared_ptr<oatpp::network::ConnectionHandler> connectionHandler,
+    const std::shared_ptr<ApiController>& controller,
+    const Lambda& lambda,
+    const std::chrono::duration<v_int64, std::micro>& timeout = std::chrono::minutes(1)
+  ) {
+
+    auto _interface = oatpp::network::virtual_::Interface::obtainShared(interfaceName);
+
+    std::shared_ptr<oatpp::network::ServerConnectionProvider> serverProvider =
+      oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface);
+    std::shared_ptr<oatpp::network::ClientConnectionProvider> clientProvider =
+      oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface);
+
+    ClientServerTestRunner runner(router, serverProvider, connectionHandler);
+    runner.addController(controller);
+
+    runner.run([&clientProvider, &lambda] {
+      lambda(clientProvider);
+    }, timeout);
+
+  }
+
 };
 
 }}}
@@ -33,6 +33,7 @@
 #include <cstring>
 #include <ctime>
 #include <cstdarg>
+#include <thread>
 
 #if defined(WIN32) || defined(_WIN32)
 	#include <winsock2.h>
@@ -45,14 +46,23 @@
 
 namespace oatpp {
 
-v_atomicCounter Environment::m_objectsCount(0);
-v_atomicCounter Environment::m_objectsCreated(0);
+Environment::ObjectCountersShard Environment::m_objectCounters[OBJECT_COUNTERS_SHARDS_COUNT];
 
 #ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
 thread_local v_counter Environment::m_threadLocalObjectsCount = 0;
 thread_local v_counter Environment::m_threadLocalObjectsCreated = 0;
 #endif
 
+Environment::ObjectCountersShard& Environment::getObjectCountersShard() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  static std::atomic<v_uint32> shardsCounter{0};
+  static thread_local ObjectCountersShard& shard = m_objectCounters[(shardsCounter ++) % OBJECT_COUNTERS_SHARDS_COUNT];
+  return shard;
+#else
+  return m_objectCounters[std::hash<std::thread::id>{}(std::this_thread::get_id()) % OBJECT_COUNTERS_SHARDS_COUNT];
+#endif
+}
+
 std::mutex& Environment::getComponentsMutex() {
   static std::mutex componentsMutex;
   return componentsMutex;
@@ -199,8 +209,10 @@ void Environment::init(const std::shared_ptr<Logger>& logger) {
 
   checkTypes();
 
-  m_objectsCount = 0;
-  m_objectsCreated = 0;
+  for(auto& shard : m_objectCounters) {
+    shard.count = 0;
+    shard.created = 0;
+  }
 
 #ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
   m_threadLocalObjectsCount = 0;
@@ -257,8 +269,9 @@ void Environment::checkTypes(){
 
 void Environment::incObjects(){
 
-  m_objectsCount ++;
-  m_objectsCreated ++;
+  auto& shard = getObjectCountersShard();
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  shard.created.fetch_add(1, std::memory_order_relaxed);
 
 #ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
   m_threadLocalObjectsCount ++;
@@ -269,7 +282,7 @@ void Environment::incObjects(){
 
 void Environment::decObjects(){
 
-  m_objectsCount --;
+  getObjectCountersShard().count.fetch_sub(1, std::memory_order_relaxed);
 
 #ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
   m_threadLocalObjectsCount --;
@@ -278,11 +291,19 @@ void Environment::decObjects(){
 }
 
 v_counter Environment::getObjectsCount(){
-  return m_objectsCount;
+  v_counter result = 0;
+  for(auto& shard : m_objectCounters) {
+    result += shard.count.load(std::memory_order_relaxed);
+  }
+  return result;
 }
 
 v_counter Environment::getObjectsCreated(){
-  return m_objectsCreated;
+  v_counter result = 0;
+  for(auto& shard : m_objectCounters) {
+    result += shard.created.load(std::memory_order_relaxed);
+  }
+  return result;
 }
 
 v_counter Environment::getThreadLocalObjectsCount(){
@@ -396,4 +417,16 @@ v_int64 Environment::getMicroTickCount(){
   return ms.count();
 }
 
+v_int64 Environment::getCoarseMicroTickCount(){
+#if defined(__linux__) && defined(CLOCK_REALTIME_COARSE)
+  timespec ts;
+  if(clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+    v_int64 seconds = ts.tv_sec;
+    v_int64 nanoseconds = ts.tv_nsec;
+    return seconds * 1000000 + nanoseconds / 1000;
+  }
+#endif
+  return getMicroTickCount();
+}
+
 }
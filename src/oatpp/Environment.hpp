@@ -288,8 +288,20 @@ public:
 class Environment{
 private:
 
-  static v_atomicCounter m_objectsCount;
-  static v_atomicCounter m_objectsCreated;
+  /*
+   * Object counters are sharded. Each thread updates counters of its own shard
+   * so that Countable construction/destruction on different cores doesn't contend on one cache line.
+   * Shards are summed when counters are read.
+   * Objects may be destroyed by another thread than the one which created them -
+   * so a single shard count may go negative. Only the sum is meaningful.
+   */
+  struct alignas(64) ObjectCountersShard {
+    v_atomicCounter count{0};
+    v_atomicCounter created{0};
+  };
+
+  static constexpr v_uint32 OBJECT_COUNTERS_SHARDS_COUNT = 64;
+  static ObjectCountersShard m_objectCounters[OBJECT_COUNTERS_SHARDS_COUNT];
 
 #ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
   static thread_local v_counter m_threadLocalObjectsCount;
@@ -297,6 +309,7 @@ private:
 #endif
 private:
 
+  static ObjectCountersShard& getObjectCountersShard();
   static std::mutex& getComponentsMutex();
   static std::unordered_map<std::string, std::unordered_map<std::string, void*>>& getComponents();
 
@@ -388,8 +401,9 @@ public:
   static void decObjects();
 
   /**
-   * Get count of objects currently allocated and stored in the memory.
-   * @return
+   * Get count of objects currently allocated and stored in the memory. <br>
+   * Sums per-thread counter shards. The result is exact only when no objects are being created or destroyed concurrently.
+   * @return - count of objects.
    */
   static v_counter getObjectsCount();
 
@@ -461,6 +475,13 @@ public:
    * @return - ticks count in microseconds.
    */
   static v_int64 getMicroTickCount();
+
+  /**
+   * Get ticks count in microseconds with lower resolution (few milliseconds) but cheaper than &l:Environment::getMicroTickCount ();. <br>
+   * Uses the same epoch as &l:Environment::getMicroTickCount ();.
+   * @return - ticks count in microseconds.
+   */
+  static v_int64 getCoarseMicroTickCount();
   
 };
   
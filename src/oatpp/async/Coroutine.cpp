@@ -255,8 +255,12 @@ Action CoroutineHandle::takeAction(Action&& action) {
     switch (action.m_type) {
 
       case Action::TYPE_COROUTINE: {
-        action.m_data.coroutine->m_parent = _CP;
-        action.m_data.coroutine->m_parentReturnFP = _FP;
+        auto child = action.m_data.coroutine;
+        child->m_parent = _CP;
+        child->m_parentReturnFP = _FP;
+        if(_CP->m_deadline > 0 && (child->m_deadline == 0 || _CP->m_deadline < child->m_deadline)) {
+          child->m_deadline = _CP->m_deadline;
+        }
         _CP = action.m_data.coroutine;
         _FP = &AbstractCoroutine::act;
         action.m_type = Action::TYPE_NONE;
@@ -332,11 +336,49 @@ Action CoroutineHandle::takeAction(Action&& action) {
 }
 
 Action CoroutineHandle::iterate() {
+
+  auto deadline = _CP->m_deadline;
+  if(deadline == 0) {
+    try {
+      return _CP->call(_FP);
+    } catch (...) {
+      return new Error(std::current_exception());
+    }
+  }
+
+  if(oatpp::Environment::getMicroTickCount() >= deadline) {
+    return new TimeoutError();
+  }
+
+  Action action;
   try {
-    return _CP->call(_FP);
+    action = _CP->call(_FP);
   } catch (...) {
     return new Error(std::current_exception());
   }
+
+  /* wake up at the deadline at the latest - the deadline is checked on the next iteration */
+  switch(action.m_type) {
+
+    case Action::TYPE_WAIT_REPEAT:
+      if(action.m_data.timePointMicroseconds > deadline) {
+        action.m_data.timePointMicroseconds = deadline;
+      }
+      break;
+
+    case Action::TYPE_WAIT_LIST:
+      if(action.m_data.waitListData.timePointMicroseconds == 0 || action.m_data.waitListData.timePointMicroseconds > deadline) {
+        action.m_data.waitListData.timePointMicroseconds = deadline;
+      }
+      break;
+
+    default:
+      break;
+
+  }
+
+  return action;
+
 }
 
 Action CoroutineHandle::iterateAndTakeAction() {
@@ -352,6 +394,7 @@ bool CoroutineHandle::finished() const {
 
 AbstractCoroutine::AbstractCoroutine()
   : m_parent(nullptr)
+  , m_deadline(0)
   , m_parentReturnAction(Action(Action::TYPE_NONE))
 {}
 
@@ -363,6 +406,14 @@ AbstractCoroutine* AbstractCoroutine::getParent() const {
   return m_parent;
 }
 
+void AbstractCoroutine::setDeadline(v_int64 deadline) {
+  m_deadline = deadline;
+}
+
+v_int64 AbstractCoroutine::getDeadline() const {
+  return m_deadline;
+}
+
 Action AbstractCoroutine::repeat() {
   return Action::createActionByType(Action::TYPE_REPEAT);
 }
@@ -488,6 +488,7 @@ public:
 
 private:
   AbstractCoroutine* m_parent;
+  v_int64 m_deadline;
 protected:
   Action m_parentReturnAction;
   FunctionPtr m_parentReturnFP;
@@ -534,6 +535,23 @@ public:
    */
   AbstractCoroutine* getParent() const;
 
+  /**
+   * Set deadline of the coroutine. <br>
+   * Once the deadline has passed, the coroutine is not resumed anymore - it gets &id:oatpp::async::TimeoutError; instead.
+   * Timer and wait-list waits are cut short to end at the deadline. I/O waits are cut short at the deadline only by the epoll I/O worker (Linux).
+   * The kqueue and stub I/O workers don't cut I/O waits short - the deadline is checked only when the coroutine is resumed,
+   * so the coroutine may keep waiting for I/O past its deadline. <br>
+   * Coroutines started by this coroutine inherit the deadline (unless they have an earlier one).
+   * @param deadline - time point in microseconds, same clock as &id:oatpp::Environment::getMicroTickCount ();. `0` - no deadline.
+   */
+  void setDeadline(v_int64 deadline);
+
+  /**
+   * Get deadline of the coroutine.
+   * @return - time point in microseconds. `0` - no deadline.
+   */
+  v_int64 getDeadline() const;
+
   /**
    * Convenience method to generate Action of `type == Action::TYPE_REPEAT`.
    * @return - repeat Action.
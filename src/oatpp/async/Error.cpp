@@ -45,4 +45,9 @@ const std::exception_ptr& Error::getExceptionPtr() const {
   return m_exceptionPtr;
 }
 
+TimeoutError::TimeoutError()
+  : Error("Deadline exceeded")
+{
+}
+
 }}
@@ -57,6 +57,20 @@ public:
 
 };
 
+/**
+ * Error returned to the coroutine which is resumed after its deadline has passed.
+ * See &id:oatpp::async::AbstractCoroutine::setDeadline ();.
+ */
+class TimeoutError : public Error {
+public:
+
+  /**
+   * Constructor.
+   */
+  TimeoutError();
+
+};
+
 }}
 
 
@@ -29,6 +29,9 @@
 #include "oatpp/async/worker/TimerWorker.hpp"
 
 #include "oatpp/concurrency/Utils.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <algorithm>
 
 namespace oatpp { namespace async {
 
@@ -84,10 +87,18 @@ void Executor::SubmissionProcessor::detach() {
   }
 }
 
+v_int32 Executor::SubmissionProcessor::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  return oatpp::concurrency::Utils::setThreadAffinityToCpuRange(m_thread.native_handle(), firstCpuIndex, lastCpuIndex);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Executor
 
-Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int32 timerWorkersCount, v_int32 ioWorkerType)
+Executor::Executor(v_int32 processorWorkersCount,
+                   v_int32 ioWorkersCount,
+                   v_int32 timerWorkersCount,
+                   v_int32 ioWorkerType,
+                   const Placement& placement)
   : m_balancer(0)
 {
 
@@ -102,6 +113,16 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
 
   m_allWorkers.insert(m_allWorkers.end(), m_processorWorkers.begin(), m_processorWorkers.end());
 
+  std::vector<v_int32> processorCpus;
+  if(placement.policy != Placement::NONE) {
+    processorCpus = chooseProcessorCpus(placement, oatpp::concurrency::Utils::getNumaNodesCpus(), processorWorkersCount);
+    for(size_t i = 0; i < processorCpus.size(); i ++) {
+      if(m_processorWorkers[i]->setThreadAffinity(processorCpus[i], processorCpus[i]) != 0) {
+        OATPP_LOGw("[oatpp::async::Executor::Executor()]", "Failed to pin processor worker {} to CPU {}", i, processorCpus[i])
+      }
+    }
+  }
+
   std::vector<std::shared_ptr<worker::Worker>> ioWorkers;
   ioWorkers.reserve(static_cast<size_t>(ioWorkersCount));
   switch(ioWorkerType) {
@@ -126,6 +147,7 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
   }
 
   linkWorkers(ioWorkers);
+  pinWorkers(ioWorkers, processorCpus);
 
   std::vector<std::shared_ptr<worker::Worker>> timerWorkers;
   timerWorkers.reserve(static_cast<size_t>(timerWorkersCount));
@@ -134,6 +156,7 @@ Executor::Executor(v_int32 processorWorkersCount, v_int32 ioWorkersCount, v_int3
   }
 
   linkWorkers(timerWorkers);
+  pinWorkers(timerWorkers, processorCpus);
 
 }
 
@@ -224,6 +247,112 @@ void Executor::linkWorkers(const std::vector<std::shared_ptr<worker::Worker>>& w
 
 }
 
+void Executor::pinWorkers(const std::vector<std::shared_ptr<worker::Worker>>& workers, const std::vector<v_int32>& processorCpus) {
+  auto workerCpus = chooseWorkerCpus(workers.size(), processorCpus);
+  for(size_t i = 0; i < workerCpus.size(); i ++) {
+    const auto& cpus = workerCpus[i];
+    if(cpus.empty()) {
+      continue;
+    }
+    /* threads can be pinned to a range of CPUs only */
+    if(static_cast<size_t>(cpus.back() - cpus.front()) + 1 != cpus.size()) {
+      OATPP_LOGd("[oatpp::async::Executor::pinWorkers()]", "Worker {} serves non-contiguous CPUs - left unpinned", i)
+      continue;
+    }
+    if(workers[i]->setThreadAffinity(cpus.front(), cpus.back()) != 0) {
+      OATPP_LOGw("[oatpp::async::Executor::pinWorkers()]", "Failed to pin worker {} to CPUs [{}..{}]", i, cpus.front(), cpus.back())
+    }
+  }
+}
+
+std::vector<std::vector<v_int32>> Executor::chooseWorkerCpus(size_t workersCount, const std::vector<v_int32>& processorCpus) {
+
+  std::vector<std::vector<v_int32>> result;
+  if(processorCpus.empty() || workersCount == 0) {
+    return result;
+  }
+
+  result.resize(workersCount);
+
+  /* mirrors linkWorkers() */
+  if(processorCpus.size() > workersCount && (processorCpus.size() % workersCount) == 0) {
+    for(size_t pi = 0; pi < processorCpus.size(); pi ++) {
+      result[pi % workersCount].push_back(processorCpus[pi]);
+    }
+  } else if((workersCount % processorCpus.size()) == 0) {
+    for(size_t wi = 0; wi < workersCount; wi ++) {
+      result[wi].push_back(processorCpus[wi % processorCpus.size()]);
+    }
+  } else {
+    for(auto& cpus : result) {
+      cpus = processorCpus;
+    }
+  }
+
+  for(auto& cpus : result) {
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  }
+
+  return result;
+
+}
+
+std::vector<v_int32> Executor::chooseProcessorCpus(const Placement& placement,
+                                                   const std::vector<std::vector<v_int32>>& numaNodesCpus,
+                                                   v_int32 processorWorkersCount)
+{
+
+  std::vector<v_int32> cpus;
+
+  switch(placement.policy) {
+
+    case Placement::NONE:
+      return {};
+
+    case Placement::COMPACT:
+      for(const auto& node : numaNodesCpus) {
+        cpus.insert(cpus.end(), node.begin(), node.end());
+      }
+      break;
+
+    case Placement::SCATTER: {
+      size_t maxNodeSize = 0;
+      for(const auto& node : numaNodesCpus) {
+        maxNodeSize = std::max(maxNodeSize, node.size());
+      }
+      for(size_t i = 0; i < maxNodeSize; i ++) {
+        for(const auto& node : numaNodesCpus) {
+          if(i < node.size()) {
+            cpus.push_back(node[i]);
+          }
+        }
+      }
+      break;
+    }
+
+    case Placement::CPU_LIST:
+      cpus = placement.cpus;
+      break;
+
+    default:
+      throw std::runtime_error("[oatpp::async::Executor::chooseProcessorCpus()]: Error. Unknown placement policy.");
+
+  }
+
+  if(cpus.empty()) {
+    throw std::runtime_error("[oatpp::async::Executor::chooseProcessorCpus()]: Error. No CPUs to place workers on.");
+  }
+
+  std::vector<v_int32> result;
+  result.reserve(static_cast<size_t>(processorWorkersCount));
+  for(v_int32 i = 0; i < processorWorkersCount; i ++) {
+    result.push_back(cpus[static_cast<size_t>(i) % cpus.size()]);
+  }
+  return result;
+
+}
+
 void Executor::join() {
   for(auto& worker : m_allWorkers) {
     worker->join();
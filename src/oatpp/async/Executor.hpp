@@ -32,6 +32,7 @@
 #include "oatpp/concurrency/SpinLock.hpp"
 
 #include <tuple>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
 
@@ -78,6 +79,8 @@ private:
     void join() override;
 
     void detach() override;
+
+    v_int32 setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) override;
     
   };
 
@@ -97,6 +100,63 @@ public:
    * IO Worker type event.
    */
   static constexpr const v_int32 IO_WORKER_TYPE_EVENT = 1;
+public:
+
+  /**
+   * Placement of worker-threads on CPUs. <br>
+   * Every processor worker is pinned to one CPU. I/O and timer workers are pinned
+   * to the CPUs of the processors they serve, so that a processor and its I/O worker share a core
+   * and memory they touch stays on one NUMA node. If these CPUs don't form a contiguous range
+   * (ex.: one I/O worker serves processors on different nodes) the worker is left unpinned.
+   */
+  struct Placement {
+
+    /**
+     * Placement policy.
+     */
+    enum Policy : v_int32 {
+
+      /**
+       * Don't pin threads. Default.
+       */
+      NONE = 0,
+
+      /**
+       * Fill CPUs of one NUMA node before moving to the next node.
+       */
+      COMPACT = 1,
+
+      /**
+       * Spread processors across NUMA nodes round-robin.
+       */
+      SCATTER = 2,
+
+      /**
+       * Use CPUs from the &l:Executor::Placement::cpus; list.
+       */
+      CPU_LIST = 3
+
+    };
+
+    /**
+     * Placement policy.
+     */
+    Policy policy;
+
+    /**
+     * CPU indexes for the &l:Executor::Placement::CPU_LIST; policy.
+     * Processor `i` is pinned to `cpus[i % cpus.size()]`.
+     */
+    std::vector<v_int32> cpus;
+
+    /**
+     * Default constructor. Policy - &l:Executor::Placement::NONE;.
+     */
+    Placement()
+      : policy(NONE)
+    {}
+
+  };
 private:
   std::atomic<v_uint32> m_balancer;
 private:
@@ -108,6 +168,27 @@ private:
   static v_int32 chooseTimerWorkersCount(v_int32 timerWorkersCount);
   static v_int32 chooseIOWorkerType(v_int32 ioWorkerType);
   void linkWorkers(const std::vector<std::shared_ptr<worker::Worker>>& workers);
+  void pinWorkers(const std::vector<std::shared_ptr<worker::Worker>>& workers, const std::vector<v_int32>& processorCpus);
+public:
+
+  /**
+   * Choose CPU for each processor worker according to placement policy.
+   * @param placement - &l:Executor::Placement;.
+   * @param numaNodesCpus - CPU indexes grouped by NUMA node. See &id:oatpp::concurrency::Utils::getNumaNodesCpus;.
+   * @param processorWorkersCount - number of processor workers.
+   * @return - CPU index for each processor worker. Empty if threads shouldn't be pinned.
+   */
+  static std::vector<v_int32> chooseProcessorCpus(const Placement& placement,
+                                                  const std::vector<std::vector<v_int32>>& numaNodesCpus,
+                                                  v_int32 processorWorkersCount);
+
+  /**
+   * Get CPUs of the processors served by each I/O or timer worker - as they are linked by the executor.
+   * @param workersCount - number of I/O or timer workers.
+   * @param processorCpus - CPU index for each processor worker. See &l:Executor::chooseProcessorCpus ();.
+   * @return - sorted unique CPU indexes for each worker. Empty if `processorCpus` is empty.
+   */
+  static std::vector<std::vector<v_int32>> chooseWorkerCpus(size_t workersCount, const std::vector<v_int32>& processorCpus);
 public:
 
   /**
@@ -116,11 +197,13 @@ public:
    * @param ioWorkersCount - number of I/O processing workers.
    * @param timerWorkersCount - number of timer processing workers.
    * @param IOWorkerType
+   * @param placement - placement of worker-threads on CPUs. &l:Executor::Placement;.
    */
   Executor(v_int32 processorWorkersCount = VALUE_SUGGESTED,
            v_int32 ioWorkersCount = VALUE_SUGGESTED,
            v_int32 timerWorkersCount = VALUE_SUGGESTED,
-           v_int32 ioWorkerType = VALUE_SUGGESTED);
+           v_int32 ioWorkerType = VALUE_SUGGESTED,
+           const Placement& placement = Placement());
 
   /**
    * Non-virtual Destructor.
@@ -27,6 +27,8 @@
 #include "./CoroutineWaitList.hpp"
 #include "oatpp/async/worker/Worker.hpp"
 
+#include <algorithm>
+
 namespace oatpp { namespace async {
 
 void Processor::addWorker(const std::shared_ptr<worker::Worker>& worker) {
@@ -183,7 +185,12 @@ void Processor::putCoroutineToSleep(CoroutineHandle* ch) {
   } else {
     std::lock_guard<std::mutex> lock(m_sleepMutex);
     m_sleepTimeSet.insert(ch);
-    m_sleepCV.notify_one();
+    auto timePoint = ch->_SCH_A.m_data.waitListData.timePointMicroseconds;
+    /* wake the sleep-checker only if it would sleep past the new timeout */
+    if(m_sleepNextWakeup == 0 || timePoint < m_sleepNextWakeup) {
+      m_sleepNextWakeup = timePoint;
+      m_sleepCV.notify_one();
+    }
   }
 }
 
@@ -200,30 +207,47 @@ void Processor::wakeCoroutine(CoroutineHandle* ch) {
 }
 
 void Processor::checkCoroutinesSleep() {
+
+  /* don't rescan the sleep-set more often than that - the scan is linear */
+  static constexpr v_int64 MIN_SCAN_INTERVAL_MICRO = 1000;
+
+  std::unique_lock<std::mutex> lock{m_sleepMutex};
+
   while (m_running) {
-    {
-      std::unique_lock<std::mutex> lock{m_sleepMutex};
-      while (m_running && m_sleepTimeSet.empty()) {
-        m_sleepCV.wait(lock);
-      }
 
-      auto now = oatpp::Environment::getMicroTickCount();
-      for(auto it = m_sleepTimeSet.begin(); it != m_sleepTimeSet.end();) {
-        auto ch = *it;
-        if(ch->_SCH_A.m_data.waitListData.timePointMicroseconds < now) {
-          it = m_sleepTimeSet.erase(it);
-          ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
-          ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
-          pushOneTask(ch);
-        } else {
-          it ++;
+    if(m_sleepTimeSet.empty()) {
+      m_sleepNextWakeup = 0;
+      m_sleepCV.wait(lock);
+      continue;
+    }
+
+    auto now = oatpp::Environment::getMicroTickCount();
+    v_int64 nextWakeup = 0;
+
+    for(auto it = m_sleepTimeSet.begin(); it != m_sleepTimeSet.end();) {
+      auto ch = *it;
+      auto timePoint = ch->_SCH_A.m_data.waitListData.timePointMicroseconds;
+      if(timePoint < now) {
+        it = m_sleepTimeSet.erase(it);
+        ch->_SCH_A.m_data.waitListData.waitList->forgetCoroutine(ch);
+        ch->_SCH_A = Action::createActionByType(Action::TYPE_NONE);
+        pushOneTask(ch);
+      } else {
+        if(nextWakeup == 0 || timePoint < nextWakeup) {
+          nextWakeup = timePoint;
         }
+        it ++;
       }
+    }
 
+    if(nextWakeup != 0) {
+      nextWakeup = std::max(nextWakeup + 1, now + MIN_SCAN_INTERVAL_MICRO);
+      m_sleepNextWakeup = nextWakeup;
+      m_sleepCV.wait_for(lock, std::chrono::microseconds(nextWakeup - now));
     }
 
-    if(m_running) std::this_thread::sleep_for(std::chrono::milliseconds{100});
   }
+
 }
 
 bool Processor::iterate(v_int32 numIterations) {
@@ -285,6 +309,11 @@ void Processor::stop() {
     m_running = false;
   }
   m_taskCondition.notify_one();
+
+  {
+    /* sleep-checker may be between the m_running check and the wait - don't lose the notification */
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+  }
   m_sleepCV.notify_one();
 
   m_sleepSetTask.join();
@@ -107,6 +107,7 @@ private:
   std::unordered_set<CoroutineHandle*> m_sleepTimeSet;
   std::mutex m_sleepMutex;
   std::condition_variable m_sleepCV;
+  v_int64 m_sleepNextWakeup = 0; // microsecond tick the sleep-checker waits for. 0 - not waiting for any timeout.
 
 private:
 
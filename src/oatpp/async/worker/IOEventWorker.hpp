@@ -30,6 +30,7 @@
 
 #include <thread>
 #include <mutex>
+#include <set>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -86,6 +87,13 @@ private:
   std::unique_ptr<v_char8[]> m_outEvents;
 private:
   std::thread m_thread;
+#ifdef OATPP_IO_EVENT_INTERFACE_EPOLL
+private:
+  /* coroutines with a deadline which are waiting for I/O - ordered by deadline */
+  std::set<std::pair<v_int64, CoroutineHandle*>> m_deadlines;
+private:
+  void expireDeadlines();
+#endif
 private:
   void consumeBacklog();
   void waitEvents();
@@ -138,6 +146,14 @@ public:
    */
   void detach() override;
 
+  /**
+   * Pin worker-thread to CPUs `[firstCpuIndex..lastCpuIndex]`.
+   * @param firstCpuIndex - from CPU-index.
+   * @param lastCpuIndex - to CPU-index included.
+   * @return - zero on success. Negative value on failure.
+   */
+  v_int32 setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) override;
+
 };
 
 /**
@@ -187,6 +203,14 @@ public:
    */
   void detach() override;
 
+  /**
+   * Pin reader and writer worker-threads to CPUs `[firstCpuIndex..lastCpuIndex]`.
+   * @param firstCpuIndex - from CPU-index.
+   * @param lastCpuIndex - to CPU-index included.
+   * @return - zero on success. Negative value on failure.
+   */
+  v_int32 setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) override;
+
 };
 
 }}}
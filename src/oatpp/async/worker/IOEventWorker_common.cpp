@@ -24,6 +24,8 @@
 
 #include "IOEventWorker.hpp"
 
+#include "oatpp/concurrency/Utils.hpp"
+
 #if defined(WIN32) || defined(_WIN32)
 #include <io.h>
 #else
@@ -109,6 +111,10 @@ void IOEventWorker::detach() {
   m_thread.detach();
 }
 
+v_int32 IOEventWorker::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  return oatpp::concurrency::Utils::setThreadAffinityToCpuRange(m_thread.native_handle(), firstCpuIndex, lastCpuIndex);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // IOEventWorkerForeman
 
@@ -194,4 +200,12 @@ void IOEventWorkerForeman::detach() {
   m_writer.detach();
 }
 
+v_int32 IOEventWorkerForeman::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  v_int32 result = m_reader.setThreadAffinity(firstCpuIndex, lastCpuIndex);
+  if(result == 0) {
+    result = m_writer.setThreadAffinity(firstCpuIndex, lastCpuIndex);
+  }
+  return result;
+}
+
 }}}
@@ -36,6 +36,8 @@
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
 
+#include <algorithm>
+
 namespace oatpp { namespace async { namespace worker {
 
 void IOEventWorker::initEventQueue() {
@@ -136,6 +138,36 @@ void IOEventWorker::setCoroutineEvent(CoroutineHandle* coroutine, int operation,
     throw std::runtime_error("[oatpp::async::worker::IOEventWorker::setEpollEvent()]: Error. Call to epoll_ctl failed.");
   }
 
+  auto deadline = getCoroutineDeadline(coroutine);
+  if(deadline > 0) {
+    m_deadlines.insert({deadline, coroutine});
+  }
+
+}
+
+void IOEventWorker::expireDeadlines() {
+
+  auto now = oatpp::Environment::getMicroTickCount();
+
+  while(!m_deadlines.empty() && m_deadlines.begin()->first <= now) {
+
+    auto coroutine = m_deadlines.begin()->second;
+    m_deadlines.erase(m_deadlines.begin());
+
+    auto& action = getCoroutineScheduledAction(coroutine);
+
+    auto res = epoll_ctl(m_eventQueueHandle, EPOLL_CTL_DEL, action.getIOHandle(), nullptr);
+    if(res == -1) {
+      OATPP_LOGe("[oatpp::async::worker::IOEventWorker::expireDeadlines()]", "Error. Call to epoll_ctl failed. operation={}, errno={}", EPOLL_CTL_DEL, errno)
+      throw std::runtime_error("[oatpp::async::worker::IOEventWorker::expireDeadlines()]: Error. Call to epoll_ctl failed.");
+    }
+
+    /* coroutine will fail with the timeout error on its next iteration */
+    setCoroutineScheduledAction(coroutine, Action::createActionByType(Action::TYPE_NONE));
+    getCoroutineProcessor(coroutine)->pushOneTask(coroutine);
+
+  }
+
 }
 
 void IOEventWorker::consumeBacklog() {
@@ -157,7 +189,14 @@ void IOEventWorker::consumeBacklog() {
 void IOEventWorker::waitEvents() {
 
   epoll_event* outEvents = reinterpret_cast<epoll_event*>(m_outEvents.get());
-  auto eventsCount = epoll_wait(m_eventQueueHandle, outEvents, MAX_EVENTS, -1);
+
+  int timeout = -1;
+  if(!m_deadlines.empty()) {
+    auto waitMicroseconds = m_deadlines.begin()->first - oatpp::Environment::getMicroTickCount();
+    timeout = waitMicroseconds > 0 ? static_cast<int>(std::min<v_int64>(waitMicroseconds / 1000 + 1, 60 * 1000)) : 0;
+  }
+
+  auto eventsCount = epoll_wait(m_eventQueueHandle, outEvents, MAX_EVENTS, timeout);
 
   if((eventsCount < 0) && (errno != EINTR)) {
     OATPP_LOGe("[oatpp::async::worker::IOEventWorker::waitEvents()]", "Error:\n"
@@ -189,6 +228,11 @@ void IOEventWorker::waitEvents() {
 
         auto coroutine = reinterpret_cast<CoroutineHandle*>(dataPtr);
 
+        auto deadline = getCoroutineDeadline(coroutine);
+        if(deadline > 0) {
+          m_deadlines.erase({deadline, coroutine});
+        }
+
         Action action = coroutine->iterate();
 
         int res;
@@ -275,6 +319,10 @@ void IOEventWorker::waitEvents() {
     m_foreman->pushTasks(popQueue);
   }
 
+  if(!m_deadlines.empty()) {
+    expireDeadlines();
+  }
+
 }
 
 }}}
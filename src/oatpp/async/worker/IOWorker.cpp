@@ -25,6 +25,7 @@
 #include "IOWorker.hpp"
 
 #include "oatpp/async/Processor.hpp"
+#include "oatpp/concurrency/Utils.hpp"
 
 #include <chrono>
 
@@ -172,4 +173,8 @@ void IOWorker::detach() {
   m_thread.detach();
 }
 
+v_int32 IOWorker::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  return oatpp::concurrency::Utils::setThreadAffinityToCpuRange(m_thread.native_handle(), firstCpuIndex, lastCpuIndex);
+}
+
 }}}
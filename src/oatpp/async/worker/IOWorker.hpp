@@ -88,6 +88,14 @@ public:
   */
   void detach() override;
 
+  /**
+   * Pin worker-thread to CPUs `[firstCpuIndex..lastCpuIndex]`.
+   * @param firstCpuIndex - from CPU-index.
+   * @param lastCpuIndex - to CPU-index included.
+   * @return - zero on success. Negative value on failure.
+   */
+  v_int32 setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) override;
+
 };
 
 }}}
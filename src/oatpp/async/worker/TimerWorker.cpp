@@ -25,6 +25,7 @@
 #include "TimerWorker.hpp"
 
 #include "oatpp/async/Processor.hpp"
+#include "oatpp/concurrency/Utils.hpp"
 
 #include <chrono>
 
@@ -136,4 +137,8 @@ void TimerWorker::detach() {
   m_thread.detach();
 }
 
+v_int32 TimerWorker::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  return oatpp::concurrency::Utils::setThreadAffinityToCpuRange(m_thread.native_handle(), firstCpuIndex, lastCpuIndex);
+}
+
 }}}
@@ -50,6 +50,16 @@ CoroutineHandle* Worker::nextCoroutine(CoroutineHandle* coroutine) {
   return coroutine->_ref;
 }
 
+v_int64 Worker::getCoroutineDeadline(CoroutineHandle* coroutine) {
+  return coroutine->_CP != nullptr ? coroutine->_CP->getDeadline() : 0;
+}
+
+v_int32 Worker::setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex) {
+  (void)firstCpuIndex;
+  (void)lastCpuIndex;
+  return -1;
+}
+
 Worker::Type Worker::getType() {
   return m_type;
 }
@@ -72,6 +72,7 @@ protected:
   static Processor* getCoroutineProcessor(CoroutineHandle* coroutine);
   static void dismissAction(Action& action);
   static CoroutineHandle* nextCoroutine(CoroutineHandle* coroutine);
+  static v_int64 getCoroutineDeadline(CoroutineHandle* coroutine);
 public:
 
   /**
@@ -112,6 +113,16 @@ public:
    */
   virtual void detach() = 0;
 
+  /**
+   * Pin worker-threads to CPUs `[firstCpuIndex..lastCpuIndex]`. <br>
+   * Default implementation does nothing and returns `-1`.
+   * @param firstCpuIndex - from CPU-index.
+   * @param lastCpuIndex - to CPU-index included.
+   * @return - zero on success. Negative value on failure. <br>
+   * -1 if worker or platform doesn't support this call.
+   */
+  virtual v_int32 setThreadAffinity(v_int32 firstCpuIndex, v_int32 lastCpuIndex);
+
   /**
    * Get worker type.
    * @return - one of &l:Worker::Type; values.
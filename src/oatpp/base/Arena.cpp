@@ -0,0 +1,122 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Arena.hpp"
+
+namespace oatpp { namespace base {
+
+Arena::Arena(v_buff_size chunkSize)
+  : m_chunkSize(chunkSize)
+  , m_chunks(nullptr)
+  , m_position(nullptr)
+  , m_end(nullptr)
+  , m_allocationsCount(0)
+  , m_heapAllocationsCount(0)
+{}
+
+Arena::~Arena() {
+  freeChunks(m_chunks);
+}
+
+Arena::Chunk* Arena::allocateChunk(v_buff_size size) {
+
+  auto chunk = static_cast<Chunk*>(::operator new(static_cast<size_t>(HEADER_SIZE + size)));
+  chunk->next = m_chunks;
+  chunk->size = size;
+  m_chunks = chunk;
+
+  m_position = reinterpret_cast<p_char8>(chunk) + HEADER_SIZE;
+  m_end = m_position + size;
+
+  ++ m_heapAllocationsCount;
+
+  return chunk;
+
+}
+
+void Arena::freeChunks(Chunk* chunk) {
+  while(chunk != nullptr) {
+    auto next = chunk->next;
+    ::operator delete(chunk);
+    chunk = next;
+  }
+}
+
+void* Arena::allocateSlow(v_buff_size size, v_buff_size alignment) {
+
+  v_buff_size chunkSize = m_chunkSize;
+  if(size + alignment > chunkSize) {
+    chunkSize = size + alignment;
+  }
+
+  allocateChunk(chunkSize);
+
+  auto position = reinterpret_cast<p_char8>((reinterpret_cast<v_buff_usize>(m_position) + static_cast<v_buff_usize>(alignment) - 1) & ~(static_cast<v_buff_usize>(alignment) - 1));
+  m_position = position + size;
+  ++ m_allocationsCount;
+
+  return position;
+
+}
+
+void Arena::reset() {
+
+  if(m_chunks == nullptr) {
+    return;
+  }
+
+  if(m_chunks->next != nullptr) {
+    /* coalesce chunks - next cycle will likely need the same amount of memory */
+    auto capacity = getCapacity();
+    freeChunks(m_chunks);
+    m_chunks = nullptr;
+    allocateChunk(capacity);
+    return;
+  }
+
+  m_position = reinterpret_cast<p_char8>(m_chunks) + HEADER_SIZE;
+  m_end = m_position + m_chunks->size;
+
+}
+
+v_int64 Arena::getAllocationsCount() const {
+  return m_allocationsCount;
+}
+
+v_int64 Arena::getHeapAllocationsCount() const {
+  return m_heapAllocationsCount;
+}
+
+v_buff_size Arena::getCapacity() const {
+  v_buff_size result = 0;
+  auto chunk = m_chunks;
+  while(chunk != nullptr) {
+    result += chunk->size;
+    chunk = chunk->next;
+  }
+  return result;
+}
+
+}}
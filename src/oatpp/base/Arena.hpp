@@ -0,0 +1,201 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_base_Arena_hpp
+#define oatpp_base_Arena_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace oatpp { namespace base {
+
+/**
+ * Monotonic arena. <br>
+ * Memory is carved out of large chunks and is released all at once by &l:Arena::reset (); or by the destructor.
+ * Individual deallocations are no-ops. <br>
+ * Arena is NOT thread-safe.
+ */
+class Arena {
+public:
+
+  /**
+   * Default size of the arena chunk.
+   */
+  static constexpr v_buff_size DEFAULT_CHUNK_SIZE = 4096;
+
+private:
+
+  struct Chunk {
+    Chunk* next;
+    v_buff_size size;
+  };
+
+  static constexpr v_buff_size HEADER_SIZE = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+private:
+  Chunk* allocateChunk(v_buff_size size);
+  void freeChunks(Chunk* chunk);
+  void* allocateSlow(v_buff_size size, v_buff_size alignment);
+private:
+  v_buff_size m_chunkSize;
+  Chunk* m_chunks;
+  p_char8 m_position;
+  p_char8 m_end;
+  v_int64 m_allocationsCount;
+  v_int64 m_heapAllocationsCount;
+public:
+
+  /**
+   * Constructor. No memory is allocated until the first allocation.
+   * @param chunkSize - size of the arena chunk.
+   */
+  explicit Arena(v_buff_size chunkSize = DEFAULT_CHUNK_SIZE);
+
+  Arena(const Arena&) = delete;
+  Arena& operator = (const Arena&) = delete;
+
+  /**
+   * Destructor. Frees all chunks.
+   */
+  ~Arena();
+
+  /**
+   * Allocate memory block.
+   * @param size - size of the block.
+   * @param alignment - alignment of the block. Must be a power of two.
+   * @return - pointer to allocated memory.
+   */
+  void* allocate(v_buff_size size, v_buff_size alignment = alignof(std::max_align_t)) {
+    auto position = reinterpret_cast<p_char8>((reinterpret_cast<v_buff_usize>(m_position) + static_cast<v_buff_usize>(alignment) - 1) & ~(static_cast<v_buff_usize>(alignment) - 1));
+    if(m_position != nullptr && position + size <= m_end) {
+      m_position = position + size;
+      ++ m_allocationsCount;
+      return position;
+    }
+    return allocateSlow(size, alignment);
+  }
+
+  /**
+   * Release all memory allocated from the arena at once. <br>
+   * If more than one chunk was in use, chunks are coalesced into a single one of the same total size,
+   * so that the steady state of reset/allocate cycle makes no heap allocations.
+   */
+  void reset();
+
+  /**
+   * Get number of allocations served by the arena.
+   * @return
+   */
+  v_int64 getAllocationsCount() const;
+
+  /**
+   * Get number of heap allocations made by the arena (chunks allocated).
+   * @return
+   */
+  v_int64 getHeapAllocationsCount() const;
+
+  /**
+   * Get number of bytes reserved by the arena.
+   * @return
+   */
+  v_buff_size getCapacity() const;
+
+};
+
+/**
+ * Allocator for standard containers. Allocates memory from &l:Arena;. <br>
+ * Default-constructed allocator (or allocator with `nullptr` arena) falls back to the global `operator new`. <br>
+ * Copies of a container are always allocated on the heap so that they can safely outlive the arena.
+ * @tparam T - value type.
+ */
+template<typename T>
+class ArenaAllocator {
+  template<typename U>
+  friend class ArenaAllocator;
+private:
+  Arena* m_arena;
+public:
+
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::false_type propagate_on_container_move_assignment;
+  typedef std::false_type propagate_on_container_swap;
+  typedef std::false_type is_always_equal;
+
+public:
+
+  ArenaAllocator() noexcept
+    : m_arena(nullptr)
+  {}
+
+  explicit ArenaAllocator(Arena* arena) noexcept
+    : m_arena(arena)
+  {}
+
+  template<typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : m_arena(other.m_arena)
+  {}
+
+  T* allocate(std::size_t n) {
+    if(m_arena) {
+      return static_cast<T*>(m_arena->allocate(static_cast<v_buff_size>(n * sizeof(T)), alignof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    (void) n;
+    if(!m_arena) {
+      ::operator delete(ptr);
+    }
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator();
+  }
+
+  Arena* getArena() const noexcept {
+    return m_arena;
+  }
+
+  template<typename U>
+  bool operator == (const ArenaAllocator<U>& other) const noexcept {
+    return m_arena == other.m_arena;
+  }
+
+  template<typename U>
+  bool operator != (const ArenaAllocator<U>& other) const noexcept {
+    return m_arena != other.m_arena;
+  }
+
+};
+
+}}
+
+#endif /* oatpp_base_Arena_hpp */
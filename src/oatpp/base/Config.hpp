@@ -62,6 +62,10 @@
  */
 //#define OATPP_COMPAT_BUILD_NO_THREAD_LOCAL 1
 
+/**
+ * `printf` format used to convert floating point numbers to strings. <br>
+ * Define as `nullptr` to use the shortest representation which converts back to the same value.
+ */
 #ifndef OATPP_FLOAT_STRING_FORMAT
   #define OATPP_FLOAT_STRING_FORMAT "%.16g"
 #endif
@@ -25,6 +25,15 @@
 #include "Utils.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__linux__)
+  #include <dirent.h>
+#endif
+
 namespace oatpp { namespace concurrency {
 
 v_int32 Utils::setThreadAffinityToOneCpu(std::thread::native_handle_type nativeHandle, v_int32 cpuIndex) {
@@ -89,4 +98,88 @@ v_int32 Utils::getHardwareConcurrency() {
   return concurrency;
 }
 
+std::vector<v_int32> Utils::parseCpuList(const std::string& cpuList) {
+
+  // format: "0-3,8,10-11"
+  std::vector<v_int32> result;
+  size_t pos = 0;
+
+  while(pos < cpuList.size()) {
+
+    auto end = cpuList.find(',', pos);
+    if(end == std::string::npos) {
+      end = cpuList.size();
+    }
+
+    auto range = cpuList.substr(pos, end - pos);
+    auto dash = range.find('-');
+    try {
+      if(dash == std::string::npos) {
+        result.push_back(std::stoi(range));
+      } else {
+        v_int32 first = std::stoi(range.substr(0, dash));
+        v_int32 last = std::stoi(range.substr(dash + 1));
+        for(v_int32 i = first; i <= last; i ++) {
+          result.push_back(i);
+        }
+      }
+    } catch (const std::invalid_argument&) {
+      // skip blank or malformed entries
+    } catch (const std::out_of_range&) {
+      // skip entries that don't fit v_int32
+    }
+
+    pos = end + 1;
+
+  }
+
+  return result;
+
+}
+
+std::vector<std::vector<v_int32>> Utils::getNumaNodesCpus() {
+
+  std::vector<std::vector<v_int32>> result;
+
+#if defined(__linux__)
+
+  std::vector<v_int32> nodeIds;
+  DIR* dir = opendir("/sys/devices/system/node");
+  if(dir != nullptr) {
+    while(auto entry = readdir(dir)) {
+      std::string name = entry->d_name;
+      if(name.size() > 4 && name.compare(0, 4, "node") == 0 && std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+        nodeIds.push_back(std::stoi(name.substr(4)));
+      }
+    }
+    closedir(dir);
+  }
+
+  std::sort(nodeIds.begin(), nodeIds.end());
+
+  for(auto nodeId : nodeIds) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(nodeId) + "/cpulist");
+    std::string cpuList;
+    if(file && std::getline(file, cpuList)) {
+      auto cpus = parseCpuList(cpuList);
+      if(!cpus.empty()) {
+        result.push_back(std::move(cpus));
+      }
+    }
+  }
+
+#endif
+
+  if(result.empty()) {
+    std::vector<v_int32> cpus;
+    for(v_int32 i = 0; i < getHardwareConcurrency(); i ++) {
+      cpus.push_back(i);
+    }
+    result.push_back(std::move(cpus));
+  }
+
+  return result;
+
+}
+
 }}
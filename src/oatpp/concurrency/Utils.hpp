@@ -27,12 +27,14 @@
 
 #include "oatpp/Environment.hpp"
 #include <thread>
+#include <vector>
 
 namespace oatpp { namespace concurrency {
 
 class Utils {
 private:
   static v_int32 calcHardwareConcurrency();
+  static std::vector<v_int32> parseCpuList(const std::string& cpuList);
 public:
 
   /**
@@ -62,6 +64,14 @@ public:
    */
   static v_int32 getHardwareConcurrency();
 
+  /**
+   * Get CPU indexes grouped by NUMA node. <br>
+   * On Linux reads topology from `/sys/devices/system/node`.
+   * On other platforms, or if topology is not available, returns one node with CPUs `[0..getHardwareConcurrency())`.
+   * @return - list of NUMA nodes. Each node is a list of CPU indexes.
+   */
+  static std::vector<std::vector<v_int32>> getNumaNodesCpus();
+
 };
 
 }}
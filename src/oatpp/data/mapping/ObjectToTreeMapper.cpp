@@ -173,6 +173,7 @@ void ObjectToTreeMapper::mapCollection(const ObjectToTreeMapper* mapper, State&
       State nestedState;
       nestedState.tree = childrenOperator.putItem({});
       nestedState.config = state.config;
+      nestedState.internKeys = state.internKeys;
 
       mapper->map(nestedState, value);
 
@@ -230,6 +231,7 @@ void ObjectToTreeMapper::mapMap(const ObjectToTreeMapper* mapper, State& state,
       State nestedState;
       nestedState.tree = childrenOperator.putPair(key, {});
       nestedState.config = state.config;
+      nestedState.internKeys = state.internKeys;
 
       mapper->map(nestedState, value);
 
@@ -284,11 +286,16 @@ void ObjectToTreeMapper::mapObject(const ObjectToTreeMapper* mapper, State& stat
     if (value || state.config->includeNullFields || (field->info.required && state.config->alwaysIncludeRequired)) {
 
       oatpp::String key;
-      state.config->useUnqualifiedFieldNames ? key = field->unqualifiedName : key = field->name;
+      if(state.internKeys) {
+        key = state.config->useUnqualifiedFieldNames ? field->internedUnqualifiedName : field->internedName;
+      } else {
+        state.config->useUnqualifiedFieldNames ? key = field->unqualifiedName : key = field->name;
+      }
 
       State nestedState;
       nestedState.tree = childrenOperator.putPair(key, {});
       nestedState.config = state.config;
+      nestedState.internKeys = state.internKeys;
 
       mapper->map(nestedState, value);
 
@@ -55,6 +55,12 @@ public:
     Tree* tree;
     ErrorStack errorStack;
 
+    /**
+     * Use interned property names (&id:oatpp::data::type::BaseObject::Property::internedName;) as keys of the tree. <br>
+     * Set only when the resulting tree is not handed out to the user (ex.: it is serialized right away).
+     */
+    bool internKeys = false;
+
   };
 
 public:
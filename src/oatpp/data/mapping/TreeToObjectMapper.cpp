@@ -24,10 +24,96 @@
 
 #include "TreeToObjectMapper.hpp"
 
+#include "oatpp/data/share/StringInternTable.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
 
 namespace oatpp { namespace data { namespace mapping {
 
+namespace {
+
+/* keys of the tree may be interned instances shared with the global table (see json::Deserializer) -
+ * copy them before they become user-visible */
+oatpp::String unshareKey(const oatpp::String& key) {
+  if(share::StringInternTable::getGlobal().isInterned(key)) {
+    return oatpp::String(key->data(), static_cast<v_buff_size>(key->size()));
+  }
+  return key;
+}
+
+void copyTree(const Tree& from, Tree& to) {
+
+  switch (from.getType()) {
+
+    case Tree::Type::UNDEFINED:
+
+    case Tree::Type::NULL_VALUE:
+
+    case Tree::Type::INTEGER:
+    case Tree::Type::FLOAT:
+
+    case Tree::Type::BOOL:
+
+    case Tree::Type::INT_8:
+    case Tree::Type::UINT_8:
+    case Tree::Type::INT_16:
+    case Tree::Type::UINT_16:
+    case Tree::Type::INT_32:
+    case Tree::Type::UINT_32:
+    case Tree::Type::INT_64:
+    case Tree::Type::UINT_64:
+
+    case Tree::Type::FLOAT_32:
+    case Tree::Type::FLOAT_64:
+
+    case Tree::Type::STRING:
+      to = from;
+      return;
+
+    case Tree::Type::VECTOR: {
+      const auto& vector = from.getVector();
+      to.setVector(vector.size());
+      auto& toVector = to.getVector();
+      for(size_t i = 0; i < vector.size(); i ++) {
+        copyTree(vector[i], toVector[i]);
+      }
+      break;
+    }
+
+    case Tree::Type::MAP: {
+      const auto& map = from.getMap();
+      to.setMap({});
+      auto& toMap = to.getMap();
+      for(v_uint64 i = 0; i < map.size(); i ++) {
+        auto pair = map[i];
+        copyTree(pair.second.get(), toMap[unshareKey(pair.first)]);
+      }
+      break;
+    }
+
+    case Tree::Type::PAIRS: {
+      const auto& pairs = from.getPairs();
+      to.setPairs({});
+      auto& toPairs = to.getPairs();
+      toPairs.reserve(pairs.size());
+      for(const auto& pair : pairs) {
+        toPairs.emplace_back(unshareKey(pair.first), Tree());
+        copyTree(pair.second, toPairs.back().second);
+      }
+      break;
+    }
+
+    default:
+      to = from;
+      return;
+
+  }
+
+  to.attributes() = from.attributes();
+
+}
+
+}
+
 TreeToObjectMapper::TreeToObjectMapper() {
 
   m_methods.resize(static_cast<size_t>(data::type::ClassId::getClassCount()), nullptr);
@@ -274,7 +360,9 @@ oatpp::Void TreeToObjectMapper::mapString(const TreeToObjectMapper* mapper, Stat
 oatpp::Void TreeToObjectMapper::mapTree(const TreeToObjectMapper* mapper, State& state, const Type* type) {
   (void) type;
   (void) mapper;
-  return oatpp::Tree(std::make_shared<mapping::Tree>(*state.tree), oatpp::Tree::Class::getType());
+  auto tree = std::make_shared<mapping::Tree>();
+  copyTree(*state.tree, *tree);
+  return oatpp::Tree(tree, oatpp::Tree::Class::getType());
 }
 
 oatpp::Void TreeToObjectMapper::mapAny(const TreeToObjectMapper* mapper, State& state, const Type* type) {
@@ -398,7 +486,7 @@ oatpp::Void TreeToObjectMapper::mapMap(const TreeToObjectMapper* mapper, State&
       return nullptr;
     }
 
-    dispatcher->addItem(map, pair.first, item);
+    dispatcher->addItem(map, unshareKey(pair.first), item);
 
   }
 
@@ -27,6 +27,7 @@
 
 #include "./MemoryLabel.hpp"
 #include "oatpp/concurrency/SpinLock.hpp"
+#include "oatpp/base/Arena.hpp"
 
 #include <unordered_map>
 
@@ -42,6 +43,7 @@ template<typename Key, typename MapType>
 class LazyStringMapTemplate {
 public:
   typedef oatpp::data::type::String String;
+  typedef typename MapType::allocator_type allocator_type;
 private:
   mutable concurrency::SpinLock m_lock;
   mutable bool m_fullyInitialized;
@@ -55,6 +57,32 @@ public:
     : m_fullyInitialized(true)
   {}
 
+  /**
+   * Constructor.
+   * @param arena - &id:oatpp::base::Arena; to allocate map entries from. `nullptr` - allocate on heap.
+   */
+  explicit LazyStringMapTemplate(base::Arena* arena)
+    : m_fullyInitialized(true)
+    , m_map(allocator_type(arena))
+  {}
+
+  /**
+   * Copy-constructor. Copy entries to the arena.
+   * @param other
+   * @param arena - &id:oatpp::base::Arena; to allocate map entries from. `nullptr` - allocate on heap.
+   */
+  LazyStringMapTemplate(const LazyStringMapTemplate& other, base::Arena* arena)
+    : m_map(allocator_type(arena))
+  {
+
+    std::lock_guard<concurrency::SpinLock> otherLock(other.m_lock);
+
+    m_fullyInitialized = other.m_fullyInitialized;
+    m_map.reserve(other.m_map.size());
+    m_map.insert(other.m_map.begin(), other.m_map.end());
+
+  }
+
   /**
    * Copy-constructor.
    * @param other
@@ -72,7 +100,9 @@ public:
    * Move constructor.
    * @param other
    */
-  LazyStringMapTemplate(LazyStringMapTemplate&& other) {
+  LazyStringMapTemplate(LazyStringMapTemplate&& other)
+    : m_map(other.m_map.get_allocator())
+  {
 
     std::lock_guard<concurrency::SpinLock> otherLock(other.m_lock);
 
@@ -328,15 +358,19 @@ public:
 
 /**
  * Convenience template for &l:LazyStringMapTemplate;. Based on `std::unordered_map`.
+ * Entries may be allocated from &id:oatpp::base::Arena;.
  */
 template<typename Key, typename Value = StringKeyLabel>
-using LazyStringMap = LazyStringMapTemplate<Key, std::unordered_map<Key, Value>>;
+using LazyStringMap = LazyStringMapTemplate<Key, std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                                                    base::ArenaAllocator<std::pair<const Key, Value>>>>;
 
 /**
- * Convenience template for &l:LazyStringMapTemplate;. Based on `std::unordered_map`.
+ * Convenience template for &l:LazyStringMapTemplate;. Based on `std::unordered_multimap`.
+ * Entries may be allocated from &id:oatpp::base::Arena;.
  */
 template<typename Key, typename Value = StringKeyLabel>
-using LazyStringMultimap = LazyStringMapTemplate<Key, std::unordered_multimap<Key, Value>>;
+using LazyStringMultimap = LazyStringMapTemplate<Key, std::unordered_multimap<Key, Value, std::hash<Key>, std::equal_to<Key>,
+                                                                              base::ArenaAllocator<std::pair<const Key, Value>>>>;
 
 }}}
 
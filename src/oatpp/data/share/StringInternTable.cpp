@@ -0,0 +1,99 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "StringInternTable.hpp"
+
+#include <mutex>
+
+namespace oatpp { namespace data { namespace share {
+
+StringInternTable::Shard& StringInternTable::getShard(std::string_view view) {
+  return m_shards[std::hash<std::string_view>{}(view) % SHARDS_COUNT];
+}
+
+const StringInternTable::Shard& StringInternTable::getShard(std::string_view view) const {
+  return m_shards[std::hash<std::string_view>{}(view) % SHARDS_COUNT];
+}
+
+StringInternTable& StringInternTable::getGlobal() {
+  static StringInternTable* table = new StringInternTable();
+  return *table;
+}
+
+type::String StringInternTable::intern(const char* data, v_buff_size size) {
+
+  std::string_view view(data, static_cast<size_t>(size));
+  auto& shard = getShard(view);
+
+  {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.strings.find(view);
+    if(it != shard.strings.end()) {
+      return it->second;
+    }
+  }
+
+  auto str = std::make_shared<std::string>(data, static_cast<size_t>(size));
+
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  /* key view points to the data of the stored string - it doesn't move while the string is in the table */
+  auto result = shard.strings.emplace(std::string_view(str->data(), str->size()), str);
+  return result.first->second;
+
+}
+
+type::String StringInternTable::intern(const std::string& str) {
+  return intern(str.data(), static_cast<v_buff_size>(str.size()));
+}
+
+type::String StringInternTable::find(const char* data, v_buff_size size) const {
+  std::string_view view(data, static_cast<size_t>(size));
+  auto& shard = getShard(view);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.strings.find(view);
+  if(it != shard.strings.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+bool StringInternTable::isInterned(const type::String& str) const {
+  if(!str) {
+    return false;
+  }
+  auto interned = find(str->data(), static_cast<v_buff_size>(str->size()));
+  return interned.get() == str.get();
+}
+
+v_int64 StringInternTable::getSize() const {
+  v_int64 result = 0;
+  for(auto& shard : m_shards) {
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    result += static_cast<v_int64>(shard.strings.size());
+  }
+  return result;
+}
+
+}}}
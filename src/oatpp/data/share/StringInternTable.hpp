@@ -0,0 +1,125 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_data_share_StringInternTable_hpp
+#define oatpp_data_share_StringInternTable_hpp
+
+#include "oatpp/data/type/Primitive.hpp"
+
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace oatpp { namespace data { namespace share {
+
+/**
+ * Table of interned strings. <br>
+ * Interning returns the same &id:oatpp::String; instance for the same content so that recurring strings
+ * (DTO property names, JSON object keys, etc.) are shared by reference instead of being allocated again. <br>
+ * Interned strings live as long as the table and *must not* be modified - never hand them out to the user
+ * (ex.: as keys of a returned &id:oatpp::data::mapping::Tree; or map). <br>
+ * Thread-safe. Lookups in different shards don't contend.
+ */
+class StringInternTable {
+public:
+  /**
+   * Number of independently locked shards.
+   */
+  static constexpr v_uint32 SHARDS_COUNT = 16;
+private:
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string_view, std::shared_ptr<std::string>> strings;
+  };
+
+private:
+  Shard m_shards[SHARDS_COUNT];
+private:
+  Shard& getShard(std::string_view view);
+  const Shard& getShard(std::string_view view) const;
+public:
+
+  /**
+   * Default constructor.
+   */
+  StringInternTable() = default;
+
+  /**
+   * Non-copyable.
+   */
+  StringInternTable(const StringInternTable&) = delete;
+  StringInternTable& operator = (const StringInternTable&) = delete;
+
+  /**
+   * Get global (process-wide) intern table. <br>
+   * The global table is never destroyed, so interned strings may be safely used from static objects.
+   * @return - &l:StringInternTable;.
+   */
+  static StringInternTable& getGlobal();
+
+  /**
+   * Intern string. Adds string to the table if it's not there yet.
+   * @param data - pointer to string data.
+   * @param size - size of the string.
+   * @return - interned &id:oatpp::String;.
+   */
+  type::String intern(const char* data, v_buff_size size);
+
+  /**
+   * Intern string. Adds string to the table if it's not there yet.
+   * @param str - `std::string`.
+   * @return - interned &id:oatpp::String;.
+   */
+  type::String intern(const std::string& str);
+
+  /**
+   * Find interned string without adding it to the table. <br>
+   * Use this for untrusted input (ex.: keys of the received JSON) - so that the table doesn't grow unbounded.
+   * @param data - pointer to string data.
+   * @param size - size of the string.
+   * @return - interned &id:oatpp::String; or `nullptr` if the string is not interned.
+   */
+  type::String find(const char* data, v_buff_size size) const;
+
+  /**
+   * Check if this exact &id:oatpp::String; instance (not just its content) is owned by the table. <br>
+   * Use it to detect shared interned instances before handing a string out to the user.
+   * @param str - &id:oatpp::String;.
+   * @return - `true` if `str` is the interned instance.
+   */
+  bool isInterned(const type::String& str) const;
+
+  /**
+   * Get number of interned strings.
+   * @return - number of interned strings.
+   */
+  v_int64 getSize() const;
+
+};
+
+}}}
+
+#endif // oatpp_data_share_StringInternTable_hpp
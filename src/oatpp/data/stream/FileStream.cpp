@@ -25,6 +25,12 @@
 #include "FileStream.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include <new>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
 namespace oatpp { namespace data{ namespace stream {
 
 
@@ -117,15 +123,18 @@ FileOutputStream::FileOutputStream(FileOutputStream&& other)
   : m_file(other.m_file)
   , m_ownsFile(other.m_ownsFile)
   , m_ioMode(other.m_ioMode)
+  , m_writeBuffer(other.m_writeBuffer)
 {
   other.m_file = nullptr;
   other.m_ownsFile = false;
+  other.m_writeBuffer = nullptr;
 }
 
 FileOutputStream::FileOutputStream(std::FILE* file, bool ownsFile, const std::shared_ptr<void>& captureData)
   : m_file(file)
   , m_ownsFile(ownsFile)
   , m_ioMode(IOMode::ASYNCHRONOUS)
+  , m_writeBuffer(nullptr)
   , m_capturedData(captureData)
 {}
 
@@ -146,6 +155,41 @@ std::FILE* FileOutputStream::getFile() {
   return m_file;
 }
 
+void FileOutputStream::freeWriteBuffer() {
+  if(m_writeBuffer) {
+    ::operator delete(m_writeBuffer, std::align_val_t(WRITE_BUFFER_ALIGNMENT));
+    m_writeBuffer = nullptr;
+  }
+}
+
+bool FileOutputStream::setWriteBuffer(v_buff_size size) {
+
+  if(m_file == nullptr || !m_ownsFile || m_writeBuffer != nullptr || size <= 0) {
+    return false;
+  }
+
+  auto buffer = static_cast<v_char8*>(::operator new(static_cast<size_t>(size), std::align_val_t(WRITE_BUFFER_ALIGNMENT)));
+  if(std::setvbuf(m_file, reinterpret_cast<char*>(buffer), _IOFBF, static_cast<size_t>(size)) != 0) {
+    ::operator delete(buffer, std::align_val_t(WRITE_BUFFER_ALIGNMENT));
+    return false;
+  }
+
+  m_writeBuffer = buffer;
+  return true;
+
+}
+
+bool FileOutputStream::preallocate(v_int64 size) {
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+  if(m_file != nullptr && size > 0) {
+    return fallocate(fileno(m_file), FALLOC_FL_KEEP_SIZE, 0, size) == 0;
+  }
+#else
+  (void) size;
+#endif
+  return false;
+}
+
 v_io_size FileOutputStream::write(const void *data, v_buff_size count, async::Action& action) {
   (void) action;
   return static_cast<v_io_size>(std::fwrite(data, 1, static_cast<size_t>(count), m_file));
@@ -167,6 +211,7 @@ void FileOutputStream::close() {
   if(m_ownsFile && m_file) {
     std::fclose(m_file);
   }
+  freeWriteBuffer();
 }
 
 FileOutputStream& FileOutputStream::operator=(FileOutputStream&& other) {
@@ -178,9 +223,11 @@ FileOutputStream& FileOutputStream::operator=(FileOutputStream&& other) {
   m_file = other.m_file;
   m_ownsFile = other.m_ownsFile;
   m_ioMode = other.m_ioMode;
+  m_writeBuffer = other.m_writeBuffer;
 
   other.m_file = nullptr;
   other.m_ownsFile = false;
+  other.m_writeBuffer = nullptr;
 
   return *this;
 }
@@ -124,12 +124,20 @@ public:
 class FileOutputStream : public OutputStream {
 public:
   static oatpp::data::stream::DefaultInitializedContext DEFAULT_CONTEXT;
+public:
+  /**
+   * Alignment of the write buffer set via &l:FileOutputStream::setWriteBuffer ();.
+   */
+  static constexpr v_buff_size WRITE_BUFFER_ALIGNMENT = 4096;
 private:
   std::FILE* m_file;
   bool m_ownsFile;
   IOMode m_ioMode;
+  v_char8* m_writeBuffer;
 private:
   std::shared_ptr<void> m_capturedData;
+private:
+  void freeWriteBuffer();
 public:
 
   FileOutputStream(const FileOutputStream&) = delete;
@@ -168,6 +176,23 @@ public:
    */
   std::FILE* getFile();
 
+  /**
+   * Replace default `std::FILE` buffer with an aligned buffer of the given size. <br>
+   * Small writes are accumulated in the buffer and flushed to disk in large batches. <br>
+   * *Note: must be called before the first write to the stream. Applicable only if stream owns the file.*
+   * @param size - size of the buffer in bytes.
+   * @return - `true` if buffer was set.
+   */
+  bool setWriteBuffer(v_buff_size size);
+
+  /**
+   * Reserve disk space for the file without changing its visible size. <br>
+   * Supported on Linux only (`fallocate` with `FALLOC_FL_KEEP_SIZE`). On other platforms it's a no-op.
+   * @param size - expected size of the file in bytes.
+   * @return - `true` if space was reserved.
+   */
+  bool preallocate(v_int64 size);
+
   /**
    * Write data to stream up to count bytes, and return number of bytes actually written. <br>
    * It is a legal case if return result < count. Caller should handle this!
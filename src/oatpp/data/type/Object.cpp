@@ -24,6 +24,8 @@
 
 #include "./Object.hpp"
 
+#include "oatpp/data/share/StringInternTable.hpp"
+
 namespace oatpp { namespace data { namespace type {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +90,9 @@ BaseObject::Property::Property(v_int64 pOffset, std::string pName, std::string p
   : offset(pOffset)
   , name(std::move(pName))
   , unqualifiedName(std::move(pUName))
+  /* interned names let json::Deserializer share keys while mapping to DTOs - see json::Utils::parseInternedString() */
+  , internedName(share::StringInternTable::getGlobal().intern(name))
+  , internedUnqualifiedName(share::StringInternTable::getGlobal().intern(unqualifiedName))
   , type(pType)
 {}
 
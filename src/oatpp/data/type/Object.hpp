@@ -140,6 +140,17 @@ public:
      */
     const std::string unqualifiedName;
 
+    /**
+     * Property name interned in the global &id:oatpp::data::share::StringInternTable;. <br>
+     * The instance is shared with the table - never hand it out to the user where it can be modified.
+     */
+    const String internedName;
+
+    /**
+     * Unqualified property name interned in the global &id:oatpp::data::share::StringInternTable;.
+     */
+    const String internedUnqualifiedName;
+
     /**
      * Property type.
      */
@@ -24,6 +24,14 @@
 
 #include "Base64.hpp"
 
+#include "oatpp/utils/Cpu.hpp"
+
+#include <cstring>
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  #include <immintrin.h>
+#endif
+
 namespace oatpp { namespace encoding {
   
 const char* const Base64::ALPHABET_BASE64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/=";
@@ -33,6 +41,182 @@ const char* const Base64::ALPHABET_BASE64_URL_SAFE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ
 const char* const Base64::ALPHABET_BASE64_AUXILIARY_CHARS = "+/=";
 const char* const Base64::ALPHABET_BASE64_URL_AUXILIARY_CHARS = "-_=";
 const char* const Base64::ALPHABET_BASE64_URL_SAFE_AUXILIARY_CHARS = "._-";
+
+namespace {
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+
+bool isAlphaNumeric(v_char8 a) {
+  return (a >= 'A' && a <='Z') || (a >= 'a' && a <='z') || (a >= '0' && a <='9');
+}
+
+/*
+ * SIMD paths work for alphabets which share first 62 chars with the standard alphabet
+ * and have non-alphanumeric auxiliary chars - that is all predefined alphabets.
+ * Each function processes whole blocks only and returns number of consumed input bytes.
+ * The remainder is processed by the scalar code.
+ */
+
+/*
+ * Map 6-bit indexes to alphabet chars: A-Z, a-z, 0-9, aux0, aux1.
+ */
+GPP_ATTRIBUTE(target("ssse3"))
+__m128i encodeTranslate128(__m128i idx, v_char8 aux0, v_char8 aux1) {
+  __m128i offset = _mm_set1_epi8(65);
+  offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(25)), _mm_set1_epi8(6)));
+  offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(idx, _mm_set1_epi8(51)), _mm_set1_epi8(-75)));
+  offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(idx, _mm_set1_epi8(62)), _mm_set1_epi8(static_cast<char>(aux0 - 58))));
+  offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(idx, _mm_set1_epi8(63)), _mm_set1_epi8(static_cast<char>(aux1 - 59))));
+  return _mm_add_epi8(idx, offset);
+}
+
+GPP_ATTRIBUTE(target("avx2"))
+__m256i encodeTranslate256(__m256i idx, v_char8 aux0, v_char8 aux1) {
+  __m256i offset = _mm256_set1_epi8(65);
+  offset = _mm256_add_epi8(offset, _mm256_and_si256(_mm256_cmpgt_epi8(idx, _mm256_set1_epi8(25)), _mm256_set1_epi8(6)));
+  offset = _mm256_add_epi8(offset, _mm256_and_si256(_mm256_cmpgt_epi8(idx, _mm256_set1_epi8(51)), _mm256_set1_epi8(-75)));
+  offset = _mm256_add_epi8(offset, _mm256_and_si256(_mm256_cmpeq_epi8(idx, _mm256_set1_epi8(62)), _mm256_set1_epi8(static_cast<char>(aux0 - 58))));
+  offset = _mm256_add_epi8(offset, _mm256_and_si256(_mm256_cmpeq_epi8(idx, _mm256_set1_epi8(63)), _mm256_set1_epi8(static_cast<char>(aux1 - 59))));
+  return _mm256_add_epi8(idx, offset);
+}
+
+GPP_ATTRIBUTE(target("ssse3"))
+v_buff_size encodeSSSE3(const v_char8* src, v_buff_size size, p_char8 dst, v_char8 aux0, v_char8 aux1) {
+
+  const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+
+  v_buff_size pos = 0;
+  while(pos + 16 <= size) {
+    __m128i in = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos)), shuffle);
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), encodeTranslate128(_mm_or_si128(t0, t1), aux0, aux1));
+    pos += 12;
+    dst += 16;
+  }
+  return pos;
+
+}
+
+GPP_ATTRIBUTE(target("avx2"))
+v_buff_size encodeAVX2(const v_char8* src, v_buff_size size, p_char8 dst, v_char8 aux0, v_char8 aux1) {
+
+  const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+  v_buff_size pos = 0;
+  while(pos + 28 <= size) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos + 12));
+    __m256i in = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+    __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), encodeTranslate256(_mm256_or_si256(t0, t1), aux0, aux1));
+    pos += 24;
+    dst += 32;
+  }
+  return pos;
+
+}
+
+/*
+ * Decode blocks of 16 chars into 12 bytes.
+ * Stops at the first block containing a char which is not in the alphabet (including padding).
+ */
+GPP_ATTRIBUTE(target("ssse3"))
+v_buff_size decodeSSSE3(const char* src, v_buff_size size, p_char8 dst, v_buff_size dstCapacity,
+                        v_char8 aux0, v_char8 aux1, v_buff_size& written)
+{
+
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  v_buff_size pos = 0;
+  written = 0;
+  while(pos + 16 <= size && written + 16 <= dstCapacity) {
+
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+    __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    __m128i a0 = _mm_cmpeq_epi8(c, _mm_set1_epi8(static_cast<char>(aux0)));
+    __m128i a1 = _mm_cmpeq_epi8(c, _mm_set1_epi8(static_cast<char>(aux1)));
+
+    __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, a0)), a1);
+    if(_mm_movemask_epi8(valid) != 0xFFFF) {
+      break;
+    }
+
+    __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-65));
+    shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(-71)));
+    shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+    shift = _mm_or_si128(shift, _mm_and_si128(a0, _mm_set1_epi8(static_cast<char>(62 - aux0))));
+    shift = _mm_or_si128(shift, _mm_and_si128(a1, _mm_set1_epi8(static_cast<char>(63 - aux1))));
+
+    __m128i values = _mm_add_epi8(c, shift);
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + written), _mm_shuffle_epi8(packed, shuffle));
+
+    pos += 16;
+    written += 12;
+
+  }
+  return pos;
+
+}
+
+/*
+ * Decode blocks of 32 chars into 24 bytes.
+ * Stops at the first block containing a char which is not in the alphabet (including padding).
+ */
+GPP_ATTRIBUTE(target("avx2"))
+v_buff_size decodeAVX2(const char* src, v_buff_size size, p_char8 dst, v_buff_size dstCapacity,
+                       v_char8 aux0, v_char8 aux1, v_buff_size& written)
+{
+
+  const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  const __m256i permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+  v_buff_size pos = 0;
+  written = 0;
+  while(pos + 32 <= size && written + 32 <= dstCapacity) {
+
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pos));
+
+    __m256i upper = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('Z')), _mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)));
+    __m256i lower = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('z')), _mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)));
+    __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('9')), _mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)));
+    __m256i a0 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(static_cast<char>(aux0)));
+    __m256i a1 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(static_cast<char>(aux1)));
+
+    __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, a0)), a1);
+    if(_mm256_movemask_epi8(valid) != -1) {
+      break;
+    }
+
+    __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-65));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(a0, _mm256_set1_epi8(static_cast<char>(62 - aux0))));
+    shift = _mm256_or_si256(shift, _mm256_and_si256(a1, _mm256_set1_epi8(static_cast<char>(63 - aux1))));
+
+    __m256i values = _mm256_add_epi8(c, shift);
+    __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    __m256i result = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(packed, shuffle), permute);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + written), result);
+
+    pos += 32;
+    written += 24;
+
+  }
+  return pos;
+
+}
+
+#endif
+
+}
   
 v_char8 Base64::getAlphabetCharIndex(v_char8 a, const char* auxiliaryChars) {
   if(a >= 'A' && a <='Z') {
@@ -113,6 +297,23 @@ oatpp::String Base64::encode(const void* data, v_buff_size size, const char* alp
   auto resultData = reinterpret_cast<p_char8>(result->data());
   
   v_buff_size pos = 0;
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  v_char8 aux0 = static_cast<v_char8>(alphabet[62]);
+  v_char8 aux1 = static_cast<v_char8>(alphabet[63]);
+  if(size >= 16 && !isAlphaNumeric(aux0) && !isAlphaNumeric(aux1) && std::memcmp(alphabet, ALPHABET_BASE64, 62) == 0) {
+    if(utils::Cpu::hasAVX2()) {
+      pos = encodeAVX2(bdata, size, resultData, aux0, aux1);
+      resultData += (pos / 3) * 4;
+    }
+    if(utils::Cpu::hasSSSE3()) {
+      auto consumed = encodeSSSE3(bdata + pos, size - pos, resultData, aux0, aux1);
+      resultData += (consumed / 3) * 4;
+      pos += consumed;
+    }
+  }
+#endif
+
   while (pos + 2 < size) {
     
     v_char8 b0 = bdata[pos];
@@ -151,16 +352,36 @@ oatpp::String Base64::encode(const oatpp::String& data, const char* alphabet) {
 }
   
 oatpp::String Base64::decode(const char* data, v_buff_size size, const char* auxiliaryChars) {
-  
+
+  auto result = oatpp::String((size >> 2) * 3 + 3);
+  auto resultData = reinterpret_cast<p_char8>(result->data());
+  v_buff_size pos = 0;
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  v_char8 aux0 = static_cast<v_char8>(auxiliaryChars[0]);
+  v_char8 aux1 = static_cast<v_char8>(auxiliaryChars[1]);
+  if(size >= 16 && !isAlphaNumeric(aux0) && !isAlphaNumeric(aux1)) {
+    auto capacity = static_cast<v_buff_size>(result->size());
+    v_buff_size written = 0;
+    if(utils::Cpu::hasAVX2()) {
+      pos = decodeAVX2(data, size, resultData, capacity, aux0, aux1, written);
+      resultData += written;
+      capacity -= written;
+    }
+    if(utils::Cpu::hasSSSE3()) {
+      pos += decodeSSSE3(data + pos, size - pos, resultData, capacity, aux0, aux1, written);
+      resultData += written;
+    }
+  }
+#endif
+
   v_buff_size base64StrLength;
-  auto resultSize = calcDecodedStringSize(data, size, base64StrLength, auxiliaryChars);
-  if(resultSize < 0) {
+  auto tailSize = calcDecodedStringSize(data + pos, size - pos, base64StrLength, auxiliaryChars);
+  if(tailSize < 0) {
     throw DecodingError("Data is no base64 string. Make sure that auxiliaryChars match with encoder alphabet");
   }
-  
-  auto result = oatpp::String(resultSize);
-  auto resultData = reinterpret_cast<p_char8>(result->data());
-  v_buff_size pos = 0;
+  base64StrLength += pos;
+
   while (pos + 3 < base64StrLength) {
     v_char8 b0 = getAlphabetCharIndex(static_cast<v_char8>(data[pos]), auxiliaryChars);
     v_char8 b1 = getAlphabetCharIndex(static_cast<v_char8>(data[pos + 1]), auxiliaryChars);
@@ -182,12 +403,15 @@ oatpp::String Base64::decode(const char* data, v_buff_size size, const char* aux
     v_char8 b2 = getAlphabetCharIndex(static_cast<v_char8>(data[pos + 2]), auxiliaryChars);
     resultData[0] = static_cast<v_char8>((b0 << 2) | ((b1 >> 4) & 3));
     resultData[1] = static_cast<v_char8>(((b1 & 15) << 4) | ((b2 >> 2) & 15));
+    resultData += 2;
   } else if(posDiff == 2) {
     v_char8 b0 = getAlphabetCharIndex(static_cast<v_char8>(data[pos]), auxiliaryChars);
     v_char8 b1 = getAlphabetCharIndex(static_cast<v_char8>(data[pos + 1]), auxiliaryChars);
     resultData[0] = static_cast<v_char8>((b0 << 2) | ((b1 >> 4) & 3));
+    resultData += 1;
   }
-  
+
+  result->resize(static_cast<size_t>(resultData - reinterpret_cast<p_char8>(result->data())));
   return result;
   
 }
@@ -31,11 +31,95 @@
 #endif
 
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Cpu.hpp"
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  #include <immintrin.h>
+#endif
 
 namespace oatpp { namespace encoding {
   
 const char* Hex::ALPHABET_UPPER = "0123456789ABCDEF";
 const char* Hex::ALPHABET_LOWER = "0123456789abcdef";
+
+namespace {
+
+/*
+ * Size of the intermediate buffer used to batch writes to the output stream.
+ */
+constexpr v_buff_size CHUNK_SIZE = 256;
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+
+/*
+ * Encode blocks of 16 bytes into 32 chars.
+ * Returns number of consumed input bytes.
+ */
+GPP_ATTRIBUTE(target("ssse3"))
+v_buff_size encodeSSSE3(const v_char8* src, v_buff_size size, p_char8 dst, const char* alphabet) {
+
+  const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphabet));
+  const __m128i mask = _mm_set1_epi8(0x0F);
+
+  v_buff_size pos = 0;
+  while(pos + 16 <= size) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+    __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+    __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(in, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi8(hi, lo));
+    pos += 16;
+    dst += 32;
+  }
+  return pos;
+
+}
+
+/*
+ * Decode blocks of 32 hex chars into 16 bytes.
+ * Stops at the first block containing a non-hex char.
+ * Returns number of consumed input chars.
+ */
+GPP_ATTRIBUTE(target("ssse3"))
+v_buff_size decodeSSSE3(const char* src, v_buff_size size, p_char8 dst) {
+
+  v_buff_size pos = 0;
+  while(pos + 32 <= size) {
+
+    __m128i words[2];
+
+    for(v_int32 i = 0; i < 2; i ++) {
+
+      __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos + i * 16));
+
+      __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+      __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('F' + 1)));
+      __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('f' + 1)));
+
+      if(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(digit, upper), lower)) != 0xFFFF) {
+        return pos;
+      }
+
+      __m128i shift = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+      shift = _mm_or_si128(shift, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+      shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+
+      words[i] = _mm_maddubs_epi16(_mm_add_epi8(c, shift), _mm_set1_epi16(0x0110));
+
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(words[0], words[1]));
+    pos += 32;
+    dst += 16;
+
+  }
+  return pos;
+
+}
+
+#endif
+
+}
     
 void Hex::writeUInt16(v_uint16 value, p_char8 buffer){
   *(reinterpret_cast<p_uint32>(buffer)) = htonl((static_cast<v_uint32>(ALPHABET_UPPER[ value & 0x000F       ])      ) |
@@ -88,20 +172,41 @@ void Hex::encode(data::stream::ConsistentOutputStream* stream,
                  const void* data, v_buff_size size,
                  const char* alphabet)
 {
-  auto buffer = reinterpret_cast<const char*>(data);
-  char oneByteBuffer[2];
-  for(v_buff_size i = 0; i < size; i ++) {
-    v_char8 c = static_cast<v_char8>(buffer[i]);
-    v_char8 b1 = 0x0F & (c >> 4);
-    v_char8 b2 = 0x0F & (c);
-    oneByteBuffer[0] = alphabet[b1];
-    oneByteBuffer[1] = alphabet[b2];
-    stream->writeSimple(oneByteBuffer, 2);
+
+  auto buffer = reinterpret_cast<const v_char8*>(data);
+  v_char8 chunk[CHUNK_SIZE * 2];
+
+  v_buff_size pos = 0;
+  while(pos < size) {
+
+    v_buff_size chunkSize = size - pos;
+    if(chunkSize > CHUNK_SIZE) {
+      chunkSize = CHUNK_SIZE;
+    }
+
+    v_buff_size i = 0;
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+    if(chunkSize >= 16 && utils::Cpu::hasSSSE3()) {
+      i = encodeSSSE3(buffer + pos, chunkSize, chunk, alphabet);
+    }
+#endif
+
+    for(; i < chunkSize; i ++) {
+      v_char8 c = buffer[pos + i];
+      chunk[i * 2] = static_cast<v_char8>(alphabet[0x0F & (c >> 4)]);
+      chunk[i * 2 + 1] = static_cast<v_char8>(alphabet[0x0F & c]);
+    }
+
+    stream->writeSimple(chunk, chunkSize * 2);
+    pos += chunkSize;
+
   }
+
 }
 
 oatpp::String Hex::encode(const oatpp::String& data, const char* alphabet) {
-  oatpp::data::stream::BufferOutputStream ss(256);
+  oatpp::data::stream::BufferOutputStream ss(static_cast<v_buff_size>(data->size()) * 2 + 1);
   encode(&ss, data->data(), static_cast<v_buff_size>(data->size()), alphabet);
   return ss.toString();
 }
@@ -110,9 +215,29 @@ void Hex::decode(data::stream::ConsistentOutputStream* stream,
                  const void* data, v_buff_size size, bool allowSeparators)
 {
   auto buffer = reinterpret_cast<const char*>(data);
+  v_char8 chunk[CHUNK_SIZE];
+  v_buff_size chunkSize = 0;
+
+  v_buff_size i = 0;
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  if(size >= 32 && utils::Cpu::hasSSSE3()) {
+    while(i + 32 <= size) {
+      auto consumed = decodeSSSE3(buffer + i, std::min<v_buff_size>(size - i, CHUNK_SIZE * 2), chunk);
+      if(consumed > 0) {
+        stream->writeSimple(chunk, consumed / 2);
+        i += consumed;
+      }
+      if(consumed < CHUNK_SIZE * 2) {
+        break;
+      }
+    }
+  }
+#endif
+
   v_char8 byte = 0;
   v_int32 shift = 4;
-  for(v_buff_size i = 0; i < size; i ++) {
+  for(; i < size; i ++) {
 
     auto a = buffer[i];
 
@@ -126,17 +251,26 @@ void Hex::decode(data::stream::ConsistentOutputStream* stream,
       byte |= static_cast<v_char8>((a - 'a' + 10) << shift);
       shift -= 4;
     } else if(!allowSeparators) {
+      stream->writeSimple(chunk, chunkSize);
       throw DecodingError("Invalid Character");
     }
 
     if(shift < 0) {
-      stream->writeCharSimple(byte);
+      chunk[chunkSize ++] = byte;
+      if(chunkSize == CHUNK_SIZE) {
+        stream->writeSimple(chunk, chunkSize);
+        chunkSize = 0;
+      }
       byte = 0;
       shift = 4;
     }
 
   }
 
+  if(chunkSize > 0) {
+    stream->writeSimple(chunk, chunkSize);
+  }
+
   if(shift != 4) {
     throw DecodingError("Invalid input data size");
   }
@@ -144,7 +278,7 @@ void Hex::decode(data::stream::ConsistentOutputStream* stream,
 }
 
 oatpp::String Hex::decode(const oatpp::String& data, bool allowSeparators) {
-  oatpp::data::stream::BufferOutputStream ss(256);
+  oatpp::data::stream::BufferOutputStream ss(static_cast<v_buff_size>(data->size()) / 2 + 1);
   decode(&ss, data->data(), static_cast<v_buff_size>(data->size()), allowSeparators);
   return ss.toString();
 }
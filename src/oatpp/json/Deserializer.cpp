@@ -38,11 +38,31 @@ void Deserializer::deserializeNull(State& state) {
 }
 
 void Deserializer::deserializeNumber(State& state) {
-  if (!Utils::findDecimalSeparatorInCurrentNumber(*state.caret)) {
-    state.tree->setInteger(state.caret->parseInt());
+
+  auto& caret = *state.caret;
+  auto data = caret.getCurrData();
+  auto size = caret.getDataSize() - caret.getPosition();
+
+  if (!Utils::findDecimalSeparatorInCurrentNumber(caret)) {
+    v_int64 value;
+    auto parsed = utils::Conversion::charSequenceToInt64(data, size, value);
+    if(parsed > 0) {
+      caret.inc(parsed);
+      state.tree->setInteger(value);
+    } else {
+      state.tree->setInteger(caret.parseInt());
+    }
   } else {
-    state.tree->setFloat(state.caret->parseFloat64());
+    v_float64 value;
+    auto parsed = utils::Conversion::charSequenceToFloat64(data, size, value);
+    if(parsed > 0) {
+      caret.inc(parsed);
+      state.tree->setFloat(value);
+    } else {
+      state.tree->setFloat(caret.parseFloat64());
+    }
   }
+
 }
 
 void Deserializer::deserializeBoolean(State& state) {
@@ -79,6 +99,7 @@ void Deserializer::deserializeArray(State& state) {
       State nestedState;
       nestedState.caret = state.caret;
       nestedState.config = state.config;
+      nestedState.internKeys = state.internKeys;
       nestedState.tree = &vector[vector.size() - 1];
 
       deserialize(nestedState);
@@ -121,7 +142,7 @@ void Deserializer::deserializeMap(State& state) {
 
       state.caret->skipBlankChars();
 
-      auto key = Utils::parseString(*state.caret);
+      auto key = state.internKeys ? Utils::parseInternedString(*state.caret) : Utils::parseString(*state.caret);
       if(state.caret->hasError()){
         state.errorStack.push("[oatpp::json::Deserializer::deserializeMap()]: Item key name expected");
         return;
@@ -138,6 +159,7 @@ void Deserializer::deserializeMap(State& state) {
       State nestedState;
       nestedState.caret = state.caret;
       nestedState.config = state.config;
+      nestedState.internKeys = state.internKeys;
       nestedState.tree = &map[key];
 
       deserialize(nestedState);
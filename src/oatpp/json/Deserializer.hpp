@@ -59,6 +59,13 @@ public:
     data::mapping::Tree* tree;
     utils::parser::Caret* caret;
     data::mapping::ErrorStack errorStack;
+
+    /**
+     * Use interned instances for object keys (see &id:oatpp::json::Utils::parseInternedString;). <br>
+     * Set only when the resulting tree is not handed out to the user as is -
+     * &id:oatpp::data::mapping::TreeToObjectMapper; copies interned keys which end up in maps and trees.
+     */
+    bool internKeys = false;
   };
 
 private:
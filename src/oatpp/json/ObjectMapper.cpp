@@ -57,6 +57,8 @@ void ObjectMapper::write(data::stream::ConsistentOutputStream* stream, const oat
 
   state.config = &m_serializerConfig.mapper;
   state.tree = &tree;
+  /* the tree is only serialized - it may share interned keys */
+  state.internKeys = true;
 
   m_objectToTreeMapper.map(state, variant);
   if(!state.errorStack.empty()) {
@@ -77,6 +79,8 @@ oatpp::Void ObjectMapper::read(utils::parser::Caret& caret, const data::type::Ty
     state.caret = &caret;
     state.tree = &tree;
     state.config = &m_deserializerConfig.json;
+    /* keys of the tree returned as is must be user's own strings */
+    state.internKeys = type != data::type::Tree::Class::getType();
     Deserializer::deserialize(state);
     if(!state.errorStack.empty()) {
       errorStack = std::move(state.errorStack);
@@ -37,6 +37,22 @@ void Serializer::serializeString(data::stream::ConsistentOutputStream* stream, c
   stream->writeCharSimple('\"');
 }
 
+void Serializer::serializeFloat32(State& state, v_float32 value) {
+  v_char8 buffer[100];
+  auto size = utils::Conversion::float32ToCharSequence(value, buffer, 100, state.config->floatStringFormat);
+  if(size > 0) {
+    state.stream->writeSimple(buffer, size);
+  }
+}
+
+void Serializer::serializeFloat64(State& state, v_float64 value) {
+  v_char8 buffer[100];
+  auto size = utils::Conversion::float64ToCharSequence(value, buffer, 100, state.config->floatStringFormat);
+  if(size > 0) {
+    state.stream->writeSimple(buffer, size);
+  }
+}
+
 void Serializer::serializeNull(State& state) {
   state.stream->writeSimple("null");
 }
@@ -173,7 +189,7 @@ void Serializer::serialize(State& state) {
     case data::mapping::Tree::Type::NULL_VALUE: serializeNull(state); return;
 
     case data::mapping::Tree::Type::INTEGER: state.stream->writeAsString(state.tree->getInteger()); return;
-    case data::mapping::Tree::Type::FLOAT: state.stream->writeAsString(state.tree->getFloat()); return;
+    case data::mapping::Tree::Type::FLOAT: serializeFloat64(state, state.tree->getFloat()); return;
 
     case data::mapping::Tree::Type::BOOL:  state.stream->writeAsString(state.tree->getPrimitive<bool>()); return;
 
@@ -186,8 +202,8 @@ void Serializer::serialize(State& state) {
     case data::mapping::Tree::Type::INT_64: state.stream->writeAsString(state.tree->getPrimitive<v_int64>()); return;
     case data::mapping::Tree::Type::UINT_64: state.stream->writeAsString(state.tree->getPrimitive<v_uint64>()); return;
 
-    case data::mapping::Tree::Type::FLOAT_32: state.stream->writeAsString(state.tree->getPrimitive<v_float32>()); return;
-    case data::mapping::Tree::Type::FLOAT_64: state.stream->writeAsString(state.tree->getPrimitive<v_float64>()); return;
+    case data::mapping::Tree::Type::FLOAT_32: serializeFloat32(state, state.tree->getPrimitive<v_float32>()); return;
+    case data::mapping::Tree::Type::FLOAT_64: serializeFloat64(state, state.tree->getPrimitive<v_float64>()); return;
 
     case data::mapping::Tree::Type::STRING: serializeString(state); return;
     case data::mapping::Tree::Type::VECTOR: serializeArray(state); return;
@@ -73,6 +73,12 @@ public:
      */
     v_uint32 escapeFlags = json::Utils::FLAG_ESCAPE_ALL;
 
+    /**
+     * `printf` format of floating point numbers. <br>
+     * `nullptr` - shortest representation which converts back to the same value.
+     */
+    const char* floatStringFormat = OATPP_FLOAT_STRING_FORMAT;
+
   };
 
 public:
@@ -96,6 +102,8 @@ private:
                               v_uint32 escapeFlags);
 
   static void serializeNull(State& state);
+  static void serializeFloat32(State& state, v_float32 value);
+  static void serializeFloat64(State& state, v_float64 value);
   static void serializeString(State& state);
   static void serializeArray(State& state);
   static void serializeMap(State& state);
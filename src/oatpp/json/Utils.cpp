@@ -26,14 +26,197 @@
 
 #include "oatpp/encoding/Unicode.hpp"
 #include "oatpp/encoding/Hex.hpp"
+#include "oatpp/utils/Cpu.hpp"
+#include "oatpp/data/share/StringInternTable.hpp"
+
+#include <cstring>
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  #include <immintrin.h>
+#endif
 
 namespace oatpp { namespace json{
 
+namespace {
+
+/*
+ * Chars which can't be copied to the escaped string as-is: control chars, non-ASCII, '"', '\\' and optionally '/'.
+ */
+inline bool isEscapeCandidate(v_char8 a, bool solidus) {
+  return a < 32 || a >= 128 || a == '"' || a == '\\' || (solidus && a == '/');
+}
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+
+/*
+ * SIMD helpers below process full blocks only.
+ * They return position of the first matching char, or position where less than a block is left.
+ */
+
+GPP_ATTRIBUTE(target("avx2"))
+v_buff_size skipPlainCharsAVX2(const char* data, v_buff_size pos, v_buff_size size, bool solidus) {
+
+  const __m256i space = _mm256_set1_epi8(32);
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i slash = solidus ? _mm256_set1_epi8('/') : quote;
+
+  while(pos + 32 <= size) {
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    // signed compare - catches both control chars and bytes >= 128
+    __m256i special = _mm256_cmpgt_epi8(space, c);
+    special = _mm256_or_si256(special, _mm256_cmpeq_epi8(c, quote));
+    special = _mm256_or_si256(special, _mm256_cmpeq_epi8(c, backslash));
+    special = _mm256_or_si256(special, _mm256_cmpeq_epi8(c, slash));
+    auto mask = static_cast<v_uint32>(_mm256_movemask_epi8(special));
+    if(mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+    pos += 32;
+  }
+  return pos;
+
+}
+
+GPP_ATTRIBUTE(target("avx2"))
+v_buff_size findQuoteOrBackslashAVX2(const char* data, v_buff_size pos, v_buff_size size) {
+
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+
+  while(pos + 32 <= size) {
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+    __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(c, quote), _mm256_cmpeq_epi8(c, backslash));
+    auto mask = static_cast<v_uint32>(_mm256_movemask_epi8(special));
+    if(mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+    pos += 32;
+  }
+  return pos;
+
+}
+
+#if defined(__SSE2__)
+
+v_buff_size skipPlainCharsSSE2(const char* data, v_buff_size pos, v_buff_size size, bool solidus) {
+
+  const __m128i space = _mm_set1_epi8(32);
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i slash = solidus ? _mm_set1_epi8('/') : quote;
+
+  while(pos + 16 <= size) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    // signed compare - catches both control chars and bytes >= 128
+    __m128i special = _mm_cmplt_epi8(c, space);
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(c, quote));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(c, backslash));
+    special = _mm_or_si128(special, _mm_cmpeq_epi8(c, slash));
+    auto mask = static_cast<v_uint32>(_mm_movemask_epi8(special));
+    if(mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+    pos += 16;
+  }
+  return pos;
+
+}
+
+v_buff_size findQuoteOrBackslashSSE2(const char* data, v_buff_size pos, v_buff_size size) {
+
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+
+  while(pos + 16 <= size) {
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    __m128i special = _mm_or_si128(_mm_cmpeq_epi8(c, quote), _mm_cmpeq_epi8(c, backslash));
+    auto mask = static_cast<v_uint32>(_mm_movemask_epi8(special));
+    if(mask != 0) {
+      return pos + __builtin_ctz(mask);
+    }
+    pos += 16;
+  }
+  return pos;
+
+}
+
+#endif
+
+#endif
+
+/*
+ * Find position of the first char starting from pos which needs escaping.
+ * Returns size if there is no such char.
+ */
+v_buff_size skipPlainChars(const char* data, v_buff_size pos, v_buff_size size, bool solidus) {
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  if(size - pos >= 32 && utils::Cpu::hasAVX2()) {
+    pos = skipPlainCharsAVX2(data, pos, size, solidus);
+    if(pos + 32 <= size) return pos;
+  }
+#if defined(__SSE2__)
+  pos = skipPlainCharsSSE2(data, pos, size, solidus);
+#endif
+#endif
+
+  while(pos < size && !isEscapeCandidate(static_cast<v_char8>(data[pos]), solidus)) {
+    pos ++;
+  }
+  return pos;
+
+}
+
+/*
+ * Find position of the first '"' or '\\' starting from pos.
+ * Returns size if there is no such char.
+ */
+v_buff_size findQuoteOrBackslash(const char* data, v_buff_size pos, v_buff_size size) {
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  if(size - pos >= 32 && utils::Cpu::hasAVX2()) {
+    pos = findQuoteOrBackslashAVX2(data, pos, size);
+    if(pos + 32 <= size) return pos;
+  }
+#if defined(__SSE2__)
+  pos = findQuoteOrBackslashSSE2(data, pos, size);
+#endif
+#endif
+
+  while(pos < size && data[pos] != '"' && data[pos] != '\\') {
+    pos ++;
+  }
+  return pos;
+
+}
+
+/*
+ * Find position of the first '\\' starting from pos.
+ * Returns size if there is no such char.
+ */
+v_buff_size findBackslash(const char* data, v_buff_size pos, v_buff_size size) {
+  auto found = std::memchr(data + pos, '\\', static_cast<size_t>(size - pos));
+  if(found == nullptr) {
+    return size;
+  }
+  return static_cast<const char*>(found) - data;
+}
+
+}
+
 v_buff_size Utils::calcEscapedStringSize(const char* data, v_buff_size size, v_buff_size& safeSize, v_uint32 flags) {
   v_buff_size result = 0;
   v_buff_size i = 0;
   safeSize = size;
+  bool solidus = (flags & FLAG_ESCAPE_SOLIDUS) > 0;
   while (i < size) {
+    v_buff_size plainEnd = skipPlainChars(data, i, size, solidus);
+    result += plainEnd - i;
+    i = plainEnd;
+    if(i == size) {
+      break;
+    }
     v_char8 a = static_cast<v_char8>(data[i]);
     if(a < 32) {
       i ++;
@@ -100,6 +283,12 @@ v_buff_size Utils::calcUnescapedStringSize(const char* data, v_buff_size size, v
   v_buff_size i = 0;
   
   while (i < size) {
+    v_buff_size plainEnd = findBackslash(data, i, size);
+    result += plainEnd - i;
+    i = plainEnd;
+    if(i == size) {
+      break;
+    }
     v_char8 a = static_cast<v_char8>(data[i]);
     if(a == '\\'){
       
@@ -241,7 +430,17 @@ oatpp::String Utils::escapeString(const char* data, v_buff_size size, v_uint32 f
 
   {
     v_buff_size i = 0;
+    bool solidus = (flags & FLAG_ESCAPE_SOLIDUS) > 0;
     while (i < safeSize) {
+      v_buff_size plainEnd = skipPlainChars(data, i, safeSize, solidus);
+      if(plainEnd > i) {
+        std::memcpy(&resultData[pos], &data[i], static_cast<size_t>(plainEnd - i));
+        pos += plainEnd - i;
+        i = plainEnd;
+        if(i == safeSize) {
+          break;
+        }
+      }
       v_char8 a = static_cast<v_char8>(data[i]);
       if (a < 32) {
 
@@ -328,6 +527,15 @@ void Utils::unescapeStringToBuffer(const char* data, v_buff_size size, p_char8 r
   v_buff_size pos = 0;
   
   while (i < size) {
+    v_buff_size plainEnd = findBackslash(data, i, size);
+    if(plainEnd > i) {
+      std::memcpy(&resultData[pos], &data[i], static_cast<size_t>(plainEnd - i));
+      pos += plainEnd - i;
+      i = plainEnd;
+      if(i == size) {
+        break;
+      }
+    }
     v_char8 a = static_cast<v_char8>(data[i]);
     
     if(a == '\\'){
@@ -422,6 +630,10 @@ const char* Utils::preparseString(ParsingCaret& caret, v_buff_size& size){
     v_buff_size length = caret.getDataSize();
     
     while (pos < length) {
+      pos = findQuoteOrBackslash(data, pos, length);
+      if(pos == length) {
+        break;
+      }
       v_char8 a = static_cast<v_char8>(data[pos]);
       if(a == '"'){
         size = pos - pos0;
@@ -469,6 +681,44 @@ oatpp::String Utils::parseString(ParsingCaret& caret) {
   
 }
   
+oatpp::String Utils::parseInternedString(ParsingCaret& caret) {
+
+  v_buff_size size;
+  const char* data = preparseString(caret, size);
+
+  if(data != nullptr) {
+
+    v_buff_size pos = caret.getPosition();
+
+    v_int64 errorCode;
+    v_buff_size errorPosition;
+    v_buff_size unescapedSize = calcUnescapedStringSize(data, size, errorCode, errorPosition);
+    if(errorCode != 0) {
+      caret.setError("[oatpp::json::Utils::parseInternedString()]: Error. Call to calcUnescapedStringSize() failed", errorCode);
+      caret.setPosition(pos + errorPosition);
+      return nullptr;
+    }
+
+    caret.setPosition(pos + size + 1);
+
+    if(unescapedSize == size) {
+      auto interned = data::share::StringInternTable::getGlobal().find(data, size);
+      if(interned) {
+        return interned;
+      }
+      return String(data, size);
+    }
+
+    String result(unescapedSize);
+    unescapeStringToBuffer(data, size, reinterpret_cast<p_char8>(result->data()));
+    return result;
+
+  }
+
+  return nullptr;
+
+}
+
 std::string Utils::parseStringToStdString(ParsingCaret& caret){
   
   v_buff_size size;
@@ -128,6 +128,17 @@ public:
    */
   static String parseString(ParsingCaret& caret);
 
+  /**
+   * Parse string enclosed in `"<string>"`. <br>
+   * If the string is found in the global &id:oatpp::data::share::StringInternTable; the interned instance
+   * is returned and no allocation is made. Strings are never added to the table. <br>
+   * Used for object keys which are usually names of DTO fields. <br>
+   * *Note:* the returned instance may be shared and must not be modified or exposed to the user.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @return - &id:oatpp::String;.
+   */
+  static String parseInternedString(ParsingCaret& caret);
+
   /**
    * Parse string enclosed in `"<string>"`.
    * @param caret - &id:oatpp::utils::parser::Caret;.
@@ -61,4 +61,26 @@ oatpp::data::stream::Context& ConnectionAcquisitionProxy::getInputStreamContext(
   return _handle.object->getInputStreamContext();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionValidator
+
+bool ConnectionValidator::validate(const std::shared_ptr<data::stream::IOStream>& connection) {
+
+  auto ioMode = connection->getInputStreamIOMode();
+  if(ioMode != data::stream::IOMode::ASYNCHRONOUS) {
+    connection->setInputStreamIOMode(data::stream::IOMode::ASYNCHRONOUS);
+  }
+
+  v_char8 byte;
+  async::Action action;
+  auto res = connection->read(&byte, 1, action);
+
+  if(ioMode != data::stream::IOMode::ASYNCHRONOUS) {
+    connection->setInputStreamIOMode(ioMode);
+  }
+
+  return res == IOError::RETRY_READ || res == IOError::RETRY_WRITE;
+
+}
+
 }}
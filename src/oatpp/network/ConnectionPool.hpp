@@ -55,6 +55,19 @@ struct ConnectionAcquisitionProxy : public provider::AcquisitionProxy<data::stre
 
 };
 
+/**
+ * Validator of idle pooled connections. <br>
+ * Does a non-blocking read of one byte from the connection. Idle connection is considered valid only if there is nothing to read -
+ * connection closed by the peer, broken, or having unexpected data is invalid.
+ * Use with &l:Pool::setValidator ();.
+ */
+class ConnectionValidator : public provider::Validator<data::stream::IOStream> {
+public:
+
+  bool validate(const std::shared_ptr<data::stream::IOStream>& connection) override;
+
+};
+
 typedef oatpp::provider::Pool<
   oatpp::network::ClientConnectionProvider,
   oatpp::data::stream::IOStream,
@@ -26,6 +26,7 @@
 
 #include "oatpp/base/Log.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -39,6 +40,32 @@ void ConnectionMonitor::ConnectionInvalidator::invalidate(const std::shared_ptr<
   proxy->invalidate();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionMonitor::DirectionStats
+
+void ConnectionMonitor::DirectionStats::update(v_io_size size, v_int64 timestamp) {
+  auto seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  total.store(total.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+  lastSize.store(size, std::memory_order_relaxed);
+  timestampLast.store(timestamp, std::memory_order_relaxed);
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+void ConnectionMonitor::DirectionStats::read(v_io_size& outTotal, v_io_size& outLastSize, v_int64& outTimestampLast) const {
+  v_uint64 seq0;
+  v_uint64 seq1;
+  do {
+    seq0 = sequence.load(std::memory_order_acquire);
+    outTotal = total.load(std::memory_order_relaxed);
+    outLastSize = lastSize.load(std::memory_order_relaxed);
+    outTimestampLast = timestampLast.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    seq1 = sequence.load(std::memory_order_relaxed);
+  } while((seq0 & 1) != 0 || seq0 != seq1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ConnectionMonitor::ConnectionProxy
 
@@ -46,41 +73,82 @@ ConnectionMonitor::ConnectionProxy::ConnectionProxy(const std::shared_ptr<Monito
                                                     const provider::ResourceHandle<data::stream::IOStream>& connectionHandle)
   : m_monitor(monitor)
   , m_connectionHandle(connectionHandle)
+  , m_timestampCreated(oatpp::Environment::getCoarseMicroTickCount())
+  , m_statCollectors(monitor->getStatCollectors())
 {
-  m_stats.timestampCreated = oatpp::Environment::getMicroTickCount();
+  m_metricsData.resize(m_statCollectors->size(), nullptr);
+  for(size_t i = 0; i < m_statCollectors->size(); i ++) {
+    auto& collector = (*m_statCollectors)[i];
+    if(collector) {
+      m_metricsData[i] = collector->createMetricData();
+    }
+  }
 }
 
 ConnectionMonitor::ConnectionProxy::~ConnectionProxy() {
 
   m_monitor->removeConnection(reinterpret_cast<v_uint64>(this));
 
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-
-  m_monitor->freeConnectionStats(m_stats);
-
-  if(m_stats.metricsData.size() > 0) {
-
-    for(auto& pair : m_stats.metricsData) {
-      OATPP_LOGe("[oatpp::network::ConnectionMonitor::ConnectionProxy::~ConnectionProxy()]",
-                 "Error. Memory leak. Metric data was not deleted: Metric name - '{}'", pair.first->c_str())
+  for(size_t i = 0; i < m_statCollectors->size(); i ++) {
+    auto& collector = (*m_statCollectors)[i];
+    if(collector) {
+      collector->deleteMetricData(m_metricsData[i]);
     }
-
   }
 
 }
 
+void ConnectionMonitor::ConnectionProxy::readStats(ConnectionStats& stats) const {
+  stats.timestampCreated = m_timestampCreated;
+  m_readStats.read(stats.totalRead, stats.lastReadSize, stats.timestampLastRead);
+  m_writeStats.read(stats.totalWrite, stats.lastWriteSize, stats.timestampLastWrite);
+  stats.metricsData.assign(m_metricsData.begin(), m_metricsData.end());
+}
+
 v_io_size ConnectionMonitor::ConnectionProxy::read(void *buffer, v_buff_size count, async::Action& action) {
+
   auto res = m_connectionHandle.object->read(buffer, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionRead(m_stats, res);
+  v_int64 currTimestamp = oatpp::Environment::getCoarseMicroTickCount();
+
+  if(res > 0) {
+    m_readStats.update(res, currTimestamp);
+  }
+
+  if(!m_metricsData.empty()) {
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    for(size_t i = 0; i < m_statCollectors->size(); i ++) {
+      auto& collector = (*m_statCollectors)[i];
+      if(collector) {
+        collector->onRead(m_metricsData[i], res, currTimestamp);
+      }
+    }
+  }
+
   return res;
+
 }
 
 v_io_size ConnectionMonitor::ConnectionProxy::write(const void *data, v_buff_size count, async::Action& action) {
+
   auto res = m_connectionHandle.object->write(data, count, action);
-  std::lock_guard<std::mutex> lock(m_statsMutex);
-  m_monitor->onConnectionWrite(m_stats, res);
+  v_int64 currTimestamp = oatpp::Environment::getCoarseMicroTickCount();
+
+  if(res > 0) {
+    m_writeStats.update(res, currTimestamp);
+  }
+
+  if(!m_metricsData.empty()) {
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    for(size_t i = 0; i < m_statCollectors->size(); i ++) {
+      auto& collector = (*m_statCollectors)[i];
+      if(collector) {
+        collector->onWrite(m_metricsData[i], res, currTimestamp);
+      }
+    }
+  }
+
   return res;
+
 }
 
 void ConnectionMonitor::ConnectionProxy::setInputStreamIOMode(data::stream::IOMode ioMode) {
@@ -114,83 +182,168 @@ void ConnectionMonitor::ConnectionProxy::invalidate()  {
 
 void ConnectionMonitor::Monitor::monitorTask(std::shared_ptr<Monitor> monitor) {
 
+  ConnectionStats stats;
+  std::vector<std::shared_ptr<MetricsChecker>> checkers;
+
   while(monitor->m_running) {
 
     {
+      std::lock_guard<std::mutex> lock(monitor->m_checkMutex);
+      checkers = monitor->m_metricsCheckers;
+    }
+
+    std::unique_lock<std::mutex> lock(monitor->m_connectionsMutex);
+
+    if(monitor->m_rescheduleAll.exchange(false)) {
+      monitor->m_schedule.clear();
+      for(auto& pair : monitor->m_connections) {
+        monitor->m_schedule.push_back({0, pair.first, pair.second});
+      }
+      std::make_heap(monitor->m_schedule.begin(), monitor->m_schedule.end(), ScheduledCheckLater());
+    }
+
+    auto currMicroTime = oatpp::Environment::getCoarseMicroTickCount();
 
-      std::lock_guard<std::mutex> lock(monitor->m_connectionsMutex);
+    while(!monitor->m_schedule.empty() && monitor->m_schedule.front().deadline <= currMicroTime) {
 
-      auto currMicroTime = oatpp::Environment::getMicroTickCount();
+      std::pop_heap(monitor->m_schedule.begin(), monitor->m_schedule.end(), ScheduledCheckLater());
+      auto entry = monitor->m_schedule.back();
+      monitor->m_schedule.pop_back();
 
-      for(auto& caddr : monitor->m_connections) {
+      auto it = monitor->m_connections.find(entry.connectionId);
+      if(it == monitor->m_connections.end() || it->second != entry.generation) {
+        continue; // stale entry
+      }
 
-        auto connection = reinterpret_cast<ConnectionProxy*>(caddr);
-        std::lock_guard<std::mutex> dataLock(connection->m_statsMutex);
-        std::lock_guard<std::mutex> analysersLock(monitor->m_checkMutex);
+      auto connection = reinterpret_cast<ConnectionProxy*>(entry.connectionId);
+      connection->readStats(stats);
 
-        for(auto& a : monitor->m_metricsCheckers) {
-          bool res = a->check(connection->m_stats, currMicroTime);
-          if(!res) {
-            connection->invalidate();
+      bool valid = true;
+      {
+        std::unique_lock<std::mutex> metricsLock(connection->m_metricsMutex, std::defer_lock);
+        if(!stats.metricsData.empty()) {
+          metricsLock.lock();
+        }
+        for(auto& a : checkers) {
+          if(!a->check(stats, currMicroTime)) {
+            valid = false;
             break;
           }
         }
+      }
 
+      if(valid) {
+        if(!checkers.empty()) {
+          monitor->scheduleUnsafe(getNextCheckTime(checkers, stats, currMicroTime), entry.connectionId, entry.generation);
+        }
+      } else {
+        connection->invalidate();
+        // Keep it in schedule in case the connection is not released right away.
+        monitor->scheduleUnsafe(currMicroTime + CHECK_INTERVAL_DEFAULT, entry.connectionId, entry.generation);
       }
 
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    v_int64 nextWakeup = currMicroTime + CHECK_INTERVAL_MAX;
+    if(!monitor->m_schedule.empty() && monitor->m_schedule.front().deadline < nextWakeup) {
+      nextWakeup = monitor->m_schedule.front().deadline;
+    }
+    monitor->m_nextWakeup = nextWakeup;
 
-  }
+    if(monitor->m_running && !monitor->m_rescheduleAll) {
+      monitor->m_wakeupCondition.wait_for(lock, std::chrono::microseconds(nextWakeup - currMicroTime));
+    }
 
-  {
-    std::lock_guard<std::mutex> lock(monitor->m_runMutex);
-    monitor->m_stopped = true;
   }
 
-  monitor->m_runCondition.notify_all();
+  checkers.clear();
+
+  // Release the thread's reference before reporting stop so that the Monitor doesn't outlive stop() call.
+  // The caller of stop() keeps the Monitor alive until m_stopped is observed.
+  auto m = monitor.get();
+  monitor.reset();
+
+  std::lock_guard<std::mutex> lock(m->m_runMutex);
+  m->m_stopped = true;
+  m->m_runCondition.notify_all();
 
 }
 
-void* ConnectionMonitor::Monitor::createOrGetMetricData(ConnectionStats& stats, const std::shared_ptr<StatCollector>& collector) {
-  void* data;
-  auto it = stats.metricsData.find(collector->metricName());
-  if(it == stats.metricsData.end()) {
-    data = collector->createMetricData();
-    stats.metricsData.insert({collector->metricName(), data});
-  } else {
-    data = it->second;
+v_int64 ConnectionMonitor::Monitor::getNextCheckTime(const std::vector<std::shared_ptr<MetricsChecker>>& checkers,
+                                                     const ConnectionStats& stats,
+                                                     v_int64 currMicroTime)
+{
+  v_int64 result = currMicroTime + CHECK_INTERVAL_MAX;
+  for(auto& checker : checkers) {
+    auto time = checker->getNextCheckTime(stats, currMicroTime);
+    if(time < result) {
+      result = time;
+    }
   }
-  return data;
+  return result;
+}
+
+void ConnectionMonitor::Monitor::scheduleUnsafe(v_int64 deadline, v_uint64 connectionId, v_uint64 generation) {
+  m_schedule.push_back({deadline, connectionId, generation});
+  std::push_heap(m_schedule.begin(), m_schedule.end(), ScheduledCheckLater());
+}
+
+void ConnectionMonitor::Monitor::compactScheduleUnsafe() {
+  auto end = std::remove_if(m_schedule.begin(), m_schedule.end(), [this](const ScheduledCheck& entry) {
+    auto it = m_connections.find(entry.connectionId);
+    return it == m_connections.end() || it->second != entry.generation;
+  });
+  m_schedule.erase(end, m_schedule.end());
+  std::make_heap(m_schedule.begin(), m_schedule.end(), ScheduledCheckLater());
 }
 
 std::shared_ptr<ConnectionMonitor::Monitor> ConnectionMonitor::Monitor::createShared() {
   auto monitor = std::make_shared<Monitor>();
-  std::thread t([monitor](){
-    ConnectionMonitor::Monitor::monitorTask(monitor);
-  });
+  std::thread t(&ConnectionMonitor::Monitor::monitorTask, monitor);
   t.detach();
   return monitor;
 }
 
-void ConnectionMonitor::Monitor::addConnection(ConnectionProxy* connection) {
-  std::lock_guard<std::mutex> lock(m_connectionsMutex);
-  m_connections.insert(reinterpret_cast<v_uint64>(connection));
+ConnectionMonitor::Monitor::Monitor()
+  : m_statCollectors(std::make_shared<StatCollectors>())
+{}
+
+std::shared_ptr<const ConnectionMonitor::StatCollectors> ConnectionMonitor::Monitor::getStatCollectors() {
+  std::lock_guard<std::mutex> lock(m_checkMutex);
+  return m_statCollectors;
 }
 
-void ConnectionMonitor::Monitor::freeConnectionStats(ConnectionStats& stats) {
+void ConnectionMonitor::Monitor::addConnection(ConnectionProxy* connection) {
 
-  std::lock_guard<std::mutex> lock(m_checkMutex);
+  ConnectionStats stats;
+  connection->readStats(stats);
+  auto currMicroTime = oatpp::Environment::getCoarseMicroTickCount();
 
-  for(auto& metric : stats.metricsData) {
-    auto it = m_statCollectors.find(metric.first);
-    if(it != m_statCollectors.end()) {
-      it->second->deleteMetricData(metric.second);
-    } else {
-      OATPP_LOGe("[oatpp::network::ConnectionMonitor::Monitor::freeConnectionStats]",
-                 "Error. Can't free Metric data. Unknown Metric: name - '{}'", metric.first->c_str())
+  v_int64 deadline;
+  bool hasCheckers;
+  {
+    std::lock_guard<std::mutex> lock(m_checkMutex);
+    hasCheckers = !m_metricsCheckers.empty();
+    deadline = getNextCheckTime(m_metricsCheckers, stats, currMicroTime);
+  }
+
+  bool wakeup;
+  {
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    auto id = reinterpret_cast<v_uint64>(connection);
+    auto generation = ++ m_generation;
+    m_connections[id] = generation;
+    if(m_schedule.size() > 2 * m_connections.size() + 1024) {
+      compactScheduleUnsafe();
     }
+    if(hasCheckers) {
+      scheduleUnsafe(deadline, id, generation);
+    }
+    wakeup = hasCheckers && deadline < m_nextWakeup;
+  }
+
+  if(wakeup) {
+    m_wakeupCondition.notify_one();
   }
 
 }
@@ -202,74 +355,85 @@ void ConnectionMonitor::Monitor::removeConnection(v_uint64 id) {
 
 void ConnectionMonitor::Monitor::invalidateAll() {
   std::lock_guard<std::mutex> lock(m_connectionsMutex);
-  for(v_uint64 caddr : m_connections) {
-    auto connection = reinterpret_cast<ConnectionProxy*>(caddr);
+  for(auto& pair : m_connections) {
+    auto connection = reinterpret_cast<ConnectionProxy*>(pair.first);
     connection->invalidate();
   }
 }
 
+void ConnectionMonitor::Monitor::addStatCollectorUnsafe(const std::shared_ptr<StatCollector>& collector) {
+  auto metricName = collector->metricName();
+  if(m_metricIndexes.find(metricName) != m_metricIndexes.end()) {
+    return;
+  }
+  auto collectors = std::make_shared<StatCollectors>(*m_statCollectors);
+  collector->m_metricIndex = static_cast<v_int64>(collectors->size());
+  collectors->push_back(collector);
+  m_statCollectors = collectors;
+  m_metricIndexes[metricName] = collector->m_metricIndex;
+}
+
 void ConnectionMonitor::Monitor::addStatCollector(const std::shared_ptr<StatCollector>& collector) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
-  m_statCollectors.insert({collector->metricName(), collector});
+  addStatCollectorUnsafe(collector);
 }
 
 void ConnectionMonitor::Monitor::removeStatCollector(const oatpp::String& metricName) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
-  m_statCollectors.erase(metricName);
+  auto collectors = std::make_shared<StatCollectors>(*m_statCollectors);
+  for(auto& c : *collectors) {
+    if(c && c->metricName() == metricName) {
+      c = nullptr;
+    }
+  }
+  m_statCollectors = collectors;
+  m_metricIndexes.erase(metricName);
 }
 
-void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker) {
+v_int64 ConnectionMonitor::Monitor::getMetricIndex(const oatpp::String& metricName) {
   std::lock_guard<std::mutex> lock(m_checkMutex);
-  m_metricsCheckers.push_back(checker);
-  auto metrics = checker->getMetricsList();
-  for(auto& m : metrics) {
-    auto it = m_statCollectors.find(m);
-    if(it == m_statCollectors.end()) {
-      m_statCollectors.insert({m, checker->createStatCollector(m)});
-    }
+  auto it = m_metricIndexes.find(metricName);
+  if(it != m_metricIndexes.end()) {
+    return it->second;
   }
+  return -1;
 }
 
-void ConnectionMonitor::Monitor::onConnectionRead(ConnectionStats& stats, v_io_size readResult) {
-
-  v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
-
-  if(readResult > 0) {
-    stats.totalRead += readResult;
-    stats.lastReadSize = readResult;
-    stats.timestampLastRead = currTimestamp;
-  }
+void ConnectionMonitor::Monitor::addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker, ConnectionMonitor& owner) {
 
   {
     std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onRead(createOrGetMetricData(stats, pair.second), readResult, currTimestamp);
+    auto metrics = checker->getMetricsList();
+    for(auto& m : metrics) {
+      if(m_metricIndexes.find(m) == m_metricIndexes.end()) {
+        addStatCollectorUnsafe(checker->createStatCollector(m));
+      }
     }
   }
 
-}
-
-void ConnectionMonitor::Monitor::onConnectionWrite(ConnectionStats& stats, v_io_size writeResult) {
-
-  v_int64 currTimestamp = oatpp::Environment::getMicroTickCount();
+  // checker resolves its metric indexes before its first check
+  checker->onMetricsRegistered(owner);
 
-  if(writeResult > 0) {
-    stats.totalWrite += writeResult;
-    stats.lastWriteSize = writeResult;
-    stats.timestampLastWrite = currTimestamp;
+  {
+    std::lock_guard<std::mutex> lock(m_checkMutex);
+    m_metricsCheckers.push_back(checker);
   }
 
+  // deadlines of existing connections were calculated without this checker
   {
-    std::lock_guard<std::mutex> lock(m_checkMutex);
-    for(auto& pair : m_statCollectors) {
-      pair.second->onWrite(createOrGetMetricData(stats, pair.second), writeResult, currTimestamp);
-    }
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    m_rescheduleAll = true;
   }
+  m_wakeupCondition.notify_one();
 
 }
 
 void ConnectionMonitor::Monitor::stop() {
-  m_running = false;
+  {
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    m_running = false;
+  }
+  m_wakeupCondition.notify_all();
   std::unique_lock<std::mutex> runLock(m_runMutex);
   while(!m_stopped) {
     m_runCondition.wait(runLock);
@@ -339,7 +503,11 @@ void ConnectionMonitor::addStatCollector(const std::shared_ptr<StatCollector>& c
 }
 
 void ConnectionMonitor::addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker) {
-  m_monitor->addMetricsChecker(checker);
+  m_monitor->addMetricsChecker(checker, *this);
+}
+
+v_int64 ConnectionMonitor::getMetricIndex(const oatpp::String& metricName) {
+  return m_monitor->getMetricIndex(metricName);
 }
 
 void ConnectionMonitor::invalidateAll() {
@@ -30,8 +30,9 @@
 #include "oatpp/network/ConnectionProvider.hpp"
 #include "oatpp/data/stream/Stream.hpp"
 
-#include <unordered_set>
+#include <unordered_map>
 #include <condition_variable>
+#include <atomic>
 
 namespace oatpp { namespace network { namespace monitor {
 
@@ -49,6 +50,27 @@ private:
 
   };
 
+private:
+
+  typedef std::vector<std::shared_ptr<StatCollector>> StatCollectors;
+
+  /*
+   * Stats of one direction (read or write) of the connection.
+   * Single writer (the thread doing I/O in this direction) - updated without locks.
+   * Readers get a consistent snapshot via the sequence counter (seqlock).
+   */
+  struct DirectionStats {
+
+    std::atomic<v_uint64> sequence {0};
+    std::atomic<v_io_size> total {0};
+    std::atomic<v_io_size> lastSize {0};
+    std::atomic<v_int64> timestampLast {0};
+
+    void update(v_io_size size, v_int64 timestamp);
+    void read(v_io_size& outTotal, v_io_size& outLastSize, v_int64& outTimestampLast) const;
+
+  };
+
 private:
 
   class Monitor; // FWD
@@ -58,8 +80,18 @@ private:
   private:
     std::shared_ptr<Monitor> m_monitor;
     provider::ResourceHandle<data::stream::IOStream> m_connectionHandle;
-    std::mutex m_statsMutex;
-    ConnectionStats m_stats;
+    v_int64 m_timestampCreated;
+    DirectionStats m_readStats;
+    DirectionStats m_writeStats;
+    /*
+     * Collectors registered at the moment of connection creation and their data (same indexes).
+     * Both are immutable during the connection lifetime. m_metricsMutex serializes collectors' callbacks and checks.
+     */
+    std::shared_ptr<const StatCollectors> m_statCollectors;
+    std::vector<void*> m_metricsData;
+    std::mutex m_metricsMutex;
+  private:
+    void readStats(ConnectionStats& stats) const;
   public:
 
     ConnectionProxy(const std::shared_ptr<Monitor>& monitor,
@@ -85,6 +117,34 @@ private:
 private:
 
   class Monitor : public oatpp::base::Countable {
+  private:
+
+    /*
+     * Recheck interval for connections which failed the check, but were not released yet.
+     */
+    static constexpr v_int64 CHECK_INTERVAL_DEFAULT = 1000 * 1000;
+
+    /*
+     * Max time between checks of the same connection and max monitor sleep time.
+     */
+    static constexpr v_int64 CHECK_INTERVAL_MAX = 60 * 1000 * 1000;
+
+    /*
+     * Connection has to be checked at `deadline`.
+     * Entry is stale if connection was removed (or its address was reused - generation doesn't match).
+     */
+    struct ScheduledCheck {
+      v_int64 deadline;
+      v_uint64 connectionId;
+      v_uint64 generation;
+    };
+
+    struct ScheduledCheckLater {
+      bool operator()(const ScheduledCheck& a, const ScheduledCheck& b) const {
+        return a.deadline > b.deadline;
+      }
+    };
+
   private:
 
     std::mutex m_runMutex;
@@ -93,22 +153,39 @@ private:
     bool m_stopped {false};
 
     std::mutex m_connectionsMutex;
-    std::unordered_set<v_uint64> m_connections;
+    std::condition_variable m_wakeupCondition;
+    std::unordered_map<v_uint64, v_uint64> m_connections; // connection id --> generation
+    std::vector<ScheduledCheck> m_schedule; // min-heap by deadline
+    v_uint64 m_generation {0};
+    v_int64 m_nextWakeup {0};
+    std::atomic<bool> m_rescheduleAll {false};
 
     std::mutex m_checkMutex;
     std::vector<std::shared_ptr<MetricsChecker>> m_metricsCheckers;
-    std::unordered_map<oatpp::String, std::shared_ptr<StatCollector>> m_statCollectors;
+    /*
+     * Copy-on-write list of collectors. Index in the list is the collector's metric index.
+     * Removed collectors leave `nullptr` in their slot so indexes stay stable.
+     */
+    std::shared_ptr<const StatCollectors> m_statCollectors;
+    std::unordered_map<oatpp::String, v_int64> m_metricIndexes; // metric name --> index in m_statCollectors
 
   private:
     static void monitorTask(std::shared_ptr<Monitor> monitor);
-  private:
-    static void* createOrGetMetricData(ConnectionStats& stats, const std::shared_ptr<StatCollector>& collector);
+    static v_int64 getNextCheckTime(const std::vector<std::shared_ptr<MetricsChecker>>& checkers,
+                                    const ConnectionStats& stats,
+                                    v_int64 currMicroTime);
+    void scheduleUnsafe(v_int64 deadline, v_uint64 connectionId, v_uint64 generation);
+    void compactScheduleUnsafe();
+    void addStatCollectorUnsafe(const std::shared_ptr<StatCollector>& collector);
   public:
 
     static std::shared_ptr<Monitor> createShared();
 
+    Monitor();
+
+    std::shared_ptr<const StatCollectors> getStatCollectors();
+
     void addConnection(ConnectionProxy* connection);
-    void freeConnectionStats(ConnectionStats& stats);
     void removeConnection(v_uint64 id);
 
     void invalidateAll();
@@ -116,10 +193,9 @@ private:
     void addStatCollector(const std::shared_ptr<StatCollector>& collector);
     void removeStatCollector(const oatpp::String& metricName);
 
-    void addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker);
+    v_int64 getMetricIndex(const oatpp::String& metricName);
 
-    void onConnectionRead(ConnectionStats& stats, v_io_size readResult);
-    void onConnectionWrite(ConnectionStats& stats, v_io_size writeResult);
+    void addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker, ConnectionMonitor& owner);
 
     void stop();
 
@@ -141,6 +217,11 @@ public:
 
   async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override;
 
+  /**
+   * Add stat collector. <br>
+   * Collector is applied to connections created after this call.
+   * @param collector - &id:oatpp::network::monitor::StatCollector;.
+   */
   void addStatCollector(const std::shared_ptr<StatCollector>& collector);
 
   /**
@@ -149,6 +230,14 @@ public:
    */
   void addMetricsChecker(const std::shared_ptr<MetricsChecker>& checker);
 
+  /**
+   * Get index of the metric data in &id:oatpp::network::monitor::ConnectionStats::metricsData;. <br>
+   * Index is the same for all connections and doesn't change while the collector is registered.
+   * @param metricName - name of the metric - &id:oatpp::network::monitor::StatCollector::metricName ();.
+   * @return - metric index. `-1` if no collector is registered for this metric.
+   */
+  v_int64 getMetricIndex(const oatpp::String& metricName);
+
   /**
    * Invalidate all currently active connections.
    */
@@ -55,6 +55,17 @@ public:
    */
   virtual std::shared_ptr<StatCollector> createStatCollector(const oatpp::String& metricName) = 0;
 
+  /**
+   * Called by &id:oatpp::network::monitor::ConnectionMonitor; when the checker is added, before its first check. <br>
+   * At this point collectors of all metrics from &l:MetricsChecker::getMetricsList (); are registered - either created
+   * by this checker or registered earlier by someone else. Resolve indexes of the metrics in
+   * &id:oatpp::network::monitor::ConnectionStats::metricsData; here with &id:oatpp::network::monitor::ConnectionMonitor::getMetricIndex ();.
+   * @param monitor - &id:oatpp::network::monitor::ConnectionMonitor;.
+   */
+  virtual void onMetricsRegistered(ConnectionMonitor& monitor) {
+    (void) monitor;
+  }
+
   /**
    * Called by &id:oatpp::network::monitor::ConnectionMonitor; on each
    * time interval to check if connection satisfies the rule.
@@ -64,6 +75,19 @@ public:
    */
   virtual bool check(const ConnectionStats& stats, v_int64 currMicroTime) = 0;
 
+  /**
+   * Get time when the connection has to be checked next. <br>
+   * &id:oatpp::network::monitor::ConnectionMonitor; won't call &l:MetricsChecker::check (); for
+   * the connection before this time. Default implementation returns `currMicroTime` + 1 second.
+   * @param stats - &id:oatpp::network::monitor::ConnectionStats;.
+   * @param currMicroTime - current time microseconds.
+   * @return - time microseconds.
+   */
+  virtual v_int64 getNextCheckTime(const ConnectionStats& stats, v_int64 currMicroTime) {
+    (void) stats;
+    return currMicroTime + 1000 * 1000;
+  }
+
 };
 
 }}}
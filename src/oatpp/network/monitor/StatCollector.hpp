@@ -74,16 +74,23 @@ struct ConnectionStats {
   v_io_size lastWriteSize = 0;
 
   /**
-   * Data collected by stat-collectors - &l:StatCollector;
+   * Data collected by stat-collectors - &l:StatCollector;. <br>
+   * Indexed by &id:oatpp::network::monitor::ConnectionMonitor::getMetricIndex ();. Entry may be `nullptr` or missing (index out of bounds)
+   * if the collector was added after the connection was created.
    */
-  std::unordered_map<oatpp::String, void*> metricsData;
+  std::vector<void*> metricsData;
 
 };
 
+class ConnectionMonitor; // FWD
+
 /**
  * StatCollector collects metrics data of the connection.
  */
 class StatCollector : public oatpp::base::Countable {
+  friend ConnectionMonitor;
+private:
+  v_int64 m_metricIndex = -1;
 public:
 
   /**
@@ -124,6 +131,18 @@ public:
    * @param timestamp - timestamp microseconds when the connection `write` method was called.
    */
   virtual void onWrite(void* metricData, v_io_size writeResult, v_int64 timestamp) = 0;
+
+  /**
+   * Index of this collector's data in &l:ConnectionStats::metricsData;. <br>
+   * Assigned by &id:oatpp::network::monitor::ConnectionMonitor; when the collector is registered. <br>
+   * If another collector with the same metric name was registered first, this one is not registered -
+   * use &id:oatpp::network::monitor::ConnectionMonitor::getMetricIndex (); to look the index up by metric name.
+   * @return - metric index. `-1` if collector is not registered.
+   */
+  v_int64 getMetricIndex() const {
+    return m_metricIndex;
+  }
+
 };
 
 }}}
@@ -0,0 +1,224 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CachingResolver.hpp"
+
+#include "oatpp/Environment.hpp"
+
+namespace oatpp { namespace network { namespace resolver {
+
+CachingResolver::CachingResolver(const std::shared_ptr<Resolver>& resolver,
+                                 const std::chrono::duration<v_int64, std::micro>& ttl,
+                                 const std::chrono::duration<v_int64, std::micro>& negativeTtl,
+                                 v_int64 maxEntries)
+  : m_resolver(resolver)
+  , m_ttl(ttl.count())
+  , m_negativeTtl(negativeTtl.count())
+  , m_maxEntries(maxEntries > 0 ? maxEntries : 1)
+  , m_hits(0)
+  , m_misses(0)
+{
+  if(!m_resolver) {
+    throw std::runtime_error("[oatpp::network::resolver::CachingResolver::CachingResolver()]: Error. Resolver is null.");
+  }
+}
+
+std::shared_ptr<CachingResolver> CachingResolver::createShared(const std::shared_ptr<Resolver>& resolver,
+                                                               const std::chrono::duration<v_int64, std::micro>& ttl,
+                                                               const std::chrono::duration<v_int64, std::micro>& negativeTtl,
+                                                               v_int64 maxEntries)
+{
+  return std::make_shared<CachingResolver>(resolver, ttl, negativeTtl, maxEntries);
+}
+
+std::string CachingResolver::getKey(const Address& address) {
+  std::string key = address.host ? *address.host : std::string();
+  key.push_back(':');
+  key.append(std::to_string(static_cast<v_int32>(address.port)));
+  key.push_back(':');
+  key.append(std::to_string(static_cast<v_int32>(address.family)));
+  return key;
+}
+
+bool CachingResolver::lookupCache(const std::string& key, Endpoints& endpoints, oatpp::String& error) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_entries.find(key);
+  if(it == m_entries.end()) {
+    return false;
+  }
+
+  if(it->second.expiresAt <= oatpp::Environment::getMicroTickCount()) {
+    m_entries.erase(it);
+    return false;
+  }
+
+  endpoints = it->second.endpoints;
+  error = it->second.error;
+  return true;
+
+}
+
+void CachingResolver::putToCache(const std::string& key, const Endpoints& endpoints, const oatpp::String& error) {
+
+  v_int64 ttl = error ? m_negativeTtl : m_ttl;
+  if(ttl <= 0) {
+    return;
+  }
+
+  auto now = oatpp::Environment::getMicroTickCount();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(static_cast<v_int64>(m_entries.size()) >= m_maxEntries && m_entries.find(key) == m_entries.end()) {
+
+    for(auto it = m_entries.begin(); it != m_entries.end();) {
+      if(it->second.expiresAt <= now) {
+        it = m_entries.erase(it);
+      } else {
+        ++ it;
+      }
+    }
+
+    if(static_cast<v_int64>(m_entries.size()) >= m_maxEntries) {
+      m_entries.erase(m_entries.begin());
+    }
+
+  }
+
+  m_entries[key] = {endpoints, error, now + ttl};
+
+}
+
+Resolver::Endpoints CachingResolver::resolve(const Address& address) {
+
+  Endpoints endpoints;
+  if(resolveNumeric(address, endpoints)) {
+    return endpoints;
+  }
+
+  auto key = getKey(address);
+  oatpp::String error;
+
+  if(lookupCache(key, endpoints, error)) {
+    ++ m_hits;
+    if(error) {
+      throw std::runtime_error("[oatpp::network::resolver::CachingResolver::resolve()]: " + *error);
+    }
+    return endpoints;
+  }
+
+  ++ m_misses;
+
+  try {
+    endpoints = m_resolver->resolve(address);
+  } catch (const std::runtime_error& e) {
+    putToCache(key, {}, e.what());
+    throw;
+  }
+
+  putToCache(key, endpoints, nullptr);
+  return endpoints;
+
+}
+
+oatpp::async::CoroutineStarterForResult<const Resolver::Endpoints&> CachingResolver::resolveAsync(const Address& address) {
+
+  class ResolveCoroutine : public oatpp::async::CoroutineWithResult<ResolveCoroutine, const Endpoints&> {
+  private:
+    CachingResolver* m_this;
+    Address m_address;
+    std::string m_key;
+    Endpoints m_endpoints;
+    bool m_lookingUp;
+  public:
+
+    ResolveCoroutine(CachingResolver* _this, const Address& address)
+      : m_this(_this)
+      , m_address(address)
+      , m_lookingUp(false)
+    {}
+
+    Action act() override {
+
+      if(resolveNumeric(m_address, m_endpoints)) {
+        return _return(m_endpoints);
+      }
+
+      m_key = getKey(m_address);
+      oatpp::String cachedError;
+
+      if(m_this->lookupCache(m_key, m_endpoints, cachedError)) {
+        ++ m_this->m_hits;
+        if(cachedError) {
+          return error<oatpp::async::Error>("[oatpp::network::resolver::CachingResolver::resolveAsync()]: " + *cachedError);
+        }
+        return _return(m_endpoints);
+      }
+
+      ++ m_this->m_misses;
+      m_lookingUp = true;
+      return m_this->m_resolver->resolveAsync(m_address).callbackTo(&ResolveCoroutine::onResolved);
+
+    }
+
+    Action onResolved(const Endpoints& endpoints) {
+      m_endpoints = endpoints;
+      m_this->putToCache(m_key, m_endpoints, nullptr);
+      return _return(m_endpoints);
+    }
+
+    Action handleError(oatpp::async::Error* error) override {
+      if(m_lookingUp) {
+        m_this->putToCache(m_key, {}, error->what());
+      }
+      return error;
+    }
+
+  };
+
+  return ResolveCoroutine::startForResult(this, address);
+
+}
+
+void CachingResolver::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+}
+
+std::shared_ptr<Resolver> CachingResolver::getResolver() const {
+  return m_resolver;
+}
+
+v_int64 CachingResolver::getHitsCount() const {
+  return m_hits.load();
+}
+
+v_int64 CachingResolver::getMissesCount() const {
+  return m_misses.load();
+}
+
+}}}
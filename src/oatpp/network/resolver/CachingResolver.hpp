@@ -0,0 +1,134 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_resolver_CachingResolver_hpp
+#define oatpp_network_resolver_CachingResolver_hpp
+
+#include "./Resolver.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace network { namespace resolver {
+
+/**
+ * Resolver which caches results of another resolver per host:port:family. <br>
+ * Successful results are kept for `ttl`, failures are kept for `negativeTtl`.
+ * Numeric IP literals are resolved in place and never cached.
+ */
+class CachingResolver : public Resolver {
+private:
+
+  struct Entry {
+    Endpoints endpoints;
+    oatpp::String error;
+    v_int64 expiresAt;
+  };
+
+private:
+  static std::string getKey(const Address& address);
+private:
+  std::shared_ptr<Resolver> m_resolver;
+  v_int64 m_ttl;
+  v_int64 m_negativeTtl;
+  v_int64 m_maxEntries;
+  std::unordered_map<std::string, Entry> m_entries;
+  std::mutex m_mutex;
+  std::atomic<v_int64> m_hits;
+  std::atomic<v_int64> m_misses;
+private:
+  bool lookupCache(const std::string& key, Endpoints& endpoints, oatpp::String& error);
+  void putToCache(const std::string& key, const Endpoints& endpoints, const oatpp::String& error);
+public:
+
+  /**
+   * Constructor.
+   * @param resolver - underlying &id:oatpp::network::resolver::Resolver;.
+   * @param ttl - how long successful results are cached.
+   * @param negativeTtl - how long failed lookups are cached.
+   * @param maxEntries - max number of cached entries.
+   */
+  CachingResolver(const std::shared_ptr<Resolver>& resolver,
+                  const std::chrono::duration<v_int64, std::micro>& ttl = std::chrono::seconds(60),
+                  const std::chrono::duration<v_int64, std::micro>& negativeTtl = std::chrono::seconds(5),
+                  v_int64 maxEntries = 1024);
+
+  /**
+   * Create shared CachingResolver.
+   * @param resolver - underlying &id:oatpp::network::resolver::Resolver;.
+   * @param ttl - how long successful results are cached.
+   * @param negativeTtl - how long failed lookups are cached.
+   * @param maxEntries - max number of cached entries.
+   * @return - `std::shared_ptr` to CachingResolver.
+   */
+  static std::shared_ptr<CachingResolver> createShared(const std::shared_ptr<Resolver>& resolver,
+                                                       const std::chrono::duration<v_int64, std::micro>& ttl = std::chrono::seconds(60),
+                                                       const std::chrono::duration<v_int64, std::micro>& negativeTtl = std::chrono::seconds(5),
+                                                       v_int64 maxEntries = 1024);
+
+  /**
+   * Resolve address using cache. On cache miss the underlying resolver is called.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::network::resolver::Resolver::Endpoints;.
+   * @throws - `std::runtime_error` if address can't be resolved or the failure is cached.
+   */
+  Endpoints resolve(const Address& address) override;
+
+  /**
+   * Same as &l:CachingResolver::resolve (); but Async.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const Endpoints&> resolveAsync(const Address& address) override;
+
+  /**
+   * Drop all cached entries.
+   */
+  void clear();
+
+  /**
+   * Get underlying resolver.
+   * @return - &id:oatpp::network::resolver::Resolver;.
+   */
+  std::shared_ptr<Resolver> getResolver() const;
+
+  /**
+   * Number of lookups served from cache.
+   * @return
+   */
+  v_int64 getHitsCount() const;
+
+  /**
+   * Number of lookups passed to the underlying resolver.
+   * @return
+   */
+  v_int64 getMissesCount() const;
+
+};
+
+}}}
+
+#endif // oatpp_network_resolver_CachingResolver_hpp
@@ -0,0 +1,158 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Resolver.hpp"
+
+#include "./CachingResolver.hpp"
+#include "./SystemResolver.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+
+#include <mutex>
+#include <string.h>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <winsock2.h>
+  #include <ws2tcpip.h>
+#else
+  #include <netdb.h>
+  #include <sys/socket.h>
+#endif
+
+namespace oatpp { namespace network { namespace resolver {
+
+oatpp::String Resolver::lookup(const Address& address, bool numericHostOnly, Endpoints& endpoints) {
+
+  if(!address.host) {
+    return "Error. Host is null.";
+  }
+
+  auto portStr = oatpp::utils::Conversion::int32ToStr(address.port);
+
+  addrinfo hints;
+
+  memset(&hints, 0, sizeof(addrinfo));
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_NUMERICSERV;
+  hints.ai_protocol = 0;
+
+  if(numericHostOnly) {
+    hints.ai_flags |= AI_NUMERICHOST;
+  }
+
+  switch(address.family) {
+    case Address::IP_4: hints.ai_family = AF_INET; break;
+    case Address::IP_6: hints.ai_family = AF_INET6; break;
+    case Address::UNSPEC:
+    default:
+      hints.ai_family = AF_UNSPEC;
+  }
+
+  addrinfo* result = nullptr;
+  auto res = getaddrinfo(address.host->c_str(), portStr->c_str(), &hints, &result);
+
+  if (res != 0) {
+#if defined(WIN32) || defined(_WIN32)
+    return "Error. Call to getaddrinfo() failed with code " + std::to_string(res);
+#else
+    return std::string("Error. Call to getaddrinfo() failed: ") + gai_strerror(res);
+#endif
+  }
+
+  endpoints.clear();
+
+  for(addrinfo* curr = result; curr != nullptr; curr = curr->ai_next) {
+    if(curr->ai_family == AF_INET || curr->ai_family == AF_INET6) {
+      const v_char8* data = reinterpret_cast<const v_char8*>(curr->ai_addr);
+      endpoints.push_back({curr->ai_family, std::vector<v_char8>(data, data + curr->ai_addrlen)});
+    }
+  }
+
+  if(result != nullptr) {
+    freeaddrinfo(result);
+  }
+
+  if(endpoints.empty()) {
+    return "Error. Call to getaddrinfo() returned no results.";
+  }
+
+  return nullptr;
+
+}
+
+bool Resolver::resolveNumeric(const Address& address, Endpoints& endpoints) {
+  return lookup(address, true, endpoints) == nullptr;
+}
+
+Resolver::Endpoints Resolver::interleave(const Endpoints& endpoints) {
+
+  Endpoints result;
+
+  if(endpoints.empty()) {
+    return result;
+  }
+
+  Endpoints primary;
+  Endpoints secondary;
+
+  v_int32 firstFamily = endpoints[0].family;
+  for(auto& endpoint : endpoints) {
+    if(endpoint.family == firstFamily) {
+      primary.push_back(endpoint);
+    } else {
+      secondary.push_back(endpoint);
+    }
+  }
+
+  result.reserve(endpoints.size());
+
+  size_t i = 0;
+  while(i < primary.size() || i < secondary.size()) {
+    if(i < primary.size()) result.push_back(std::move(primary[i]));
+    if(i < secondary.size()) result.push_back(std::move(secondary[i]));
+    i ++;
+  }
+
+  return result;
+
+}
+
+std::shared_ptr<Resolver> Resolver::getDefault() {
+
+  /* not owned here - otherwise the default resolver would live (and hold its threads) till the program exit */
+  static std::mutex mutex;
+  static std::weak_ptr<Resolver> instance;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto result = instance.lock();
+  if(!result) {
+    result = CachingResolver::createShared(SystemResolver::createShared());
+    instance = result;
+  }
+  return result;
+
+}
+
+}}}
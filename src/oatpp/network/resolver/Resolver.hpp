@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_resolver_Resolver_hpp
+#define oatpp_network_resolver_Resolver_hpp
+
+#include "oatpp/network/Address.hpp"
+#include "oatpp/async/Coroutine.hpp"
+#include "oatpp/base/Countable.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace oatpp { namespace network { namespace resolver {
+
+/**
+ * Abstract host name resolver. <br>
+ * Resolves &id:oatpp::network::Address; to the list of socket addresses to connect to.
+ */
+class Resolver : public oatpp::base::Countable {
+public:
+
+  /**
+   * Resolved socket address.
+   */
+  struct Endpoint {
+
+    /**
+     * Native address family - `AF_INET` or `AF_INET6`.
+     */
+    v_int32 family;
+
+    /**
+     * Raw `sockaddr` bytes.
+     */
+    std::vector<v_char8> data;
+
+  };
+
+  /**
+   * List of resolved endpoints.
+   */
+  typedef std::vector<Endpoint> Endpoints;
+
+public:
+
+  /**
+   * Default virtual destructor.
+   */
+  virtual ~Resolver() override = default;
+
+  /**
+   * Resolve address. Blocks until address is resolved.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &l:Resolver::Endpoints;.
+   * @throws - `std::runtime_error` if address can't be resolved.
+   */
+  virtual Endpoints resolve(const Address& address) = 0;
+
+  /**
+   * Same as &l:Resolver::resolve (); but Async.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  virtual oatpp::async::CoroutineStarterForResult<const Endpoints&> resolveAsync(const Address& address) = 0;
+
+protected:
+
+  /**
+   * Call `getaddrinfo()` for the address.
+   * @param address - &id:oatpp::network::Address;.
+   * @param numericHostOnly - if `true` don't make any lookups - succeed only if the host is a numeric IP literal.
+   * @param endpoints - out parameter. Resolved endpoints.
+   * @return - `nullptr` on success. Error message otherwise.
+   */
+  static oatpp::String lookup(const Address& address, bool numericHostOnly, Endpoints& endpoints);
+
+public:
+
+  /**
+   * Resolve address if its host is a numeric IP literal. Doesn't make any lookups.
+   * @param address - &id:oatpp::network::Address;.
+   * @param endpoints - out parameter. Resolved endpoint.
+   * @return - `true` if the host is a numeric IP literal.
+   */
+  static bool resolveNumeric(const Address& address, Endpoints& endpoints);
+
+  /**
+   * Reorder endpoints so that address families alternate, starting with the family of the first endpoint
+   * (as recommended by RFC 8305 "Happy Eyeballs").
+   * @param endpoints - &l:Resolver::Endpoints;.
+   * @return - reordered &l:Resolver::Endpoints;.
+   */
+  static Endpoints interleave(const Endpoints& endpoints);
+
+  /**
+   * Get default resolver - &id:oatpp::network::resolver::CachingResolver; over &id:oatpp::network::resolver::SystemResolver;. <br>
+   * The same instance (same cache and resolver threads) is returned while anyone holds it,
+   * and it is destroyed once the last user releases it.
+   * @return - `std::shared_ptr` to Resolver.
+   */
+  static std::shared_ptr<Resolver> getDefault();
+
+};
+
+}}}
+
+#endif // oatpp_network_resolver_Resolver_hpp
@@ -0,0 +1,203 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SystemResolver.hpp"
+
+#include "oatpp/async/ConditionVariable.hpp"
+
+namespace oatpp { namespace network { namespace resolver {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SystemResolver::Task
+
+struct SystemResolver::Task {
+
+  Task(const Address& pAddress)
+    : address(pAddress)
+    , done(false)
+  {}
+
+  Address address;
+
+  oatpp::async::Lock lock;
+  oatpp::async::ConditionVariable condition;
+
+  bool done;
+  Endpoints endpoints;
+  oatpp::String error;
+
+  void complete(Endpoints&& pEndpoints, const oatpp::String& pError) {
+    {
+      std::lock_guard<oatpp::async::Lock> guard(lock);
+      endpoints = std::move(pEndpoints);
+      error = pError;
+      done = true;
+    }
+    condition.notifyAll();
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// SystemResolver
+
+SystemResolver::SystemResolver(v_int32 threadsCount)
+  : m_threadsCount(threadsCount > 0 ? threadsCount : 1)
+  , m_idleThreads(0)
+  , m_running(true)
+{}
+
+SystemResolver::~SystemResolver() {
+
+  std::list<std::shared_ptr<Task>> tasks;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    tasks = std::move(m_tasks);
+  }
+  m_condition.notify_all();
+
+  for(auto& thread : m_threads) {
+    thread.join();
+  }
+
+  for(auto& task : tasks) {
+    task->complete({}, "Error. Resolver stopped.");
+  }
+
+}
+
+std::shared_ptr<SystemResolver> SystemResolver::createShared(v_int32 threadsCount) {
+  return std::make_shared<SystemResolver>(threadsCount);
+}
+
+void SystemResolver::submit(const std::shared_ptr<Task>& task) {
+
+  bool accepted;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    accepted = m_running;
+    if(accepted) {
+      m_tasks.push_back(task);
+      /* start new thread only if the task can't be taken by an idle one */
+      if(m_threads.size() < static_cast<size_t>(m_threadsCount) && static_cast<size_t>(m_idleThreads) < m_tasks.size()) {
+        m_threads.emplace_back(&SystemResolver::run, this);
+      }
+    }
+  }
+
+  if(accepted) {
+    m_condition.notify_one();
+  } else {
+    task->complete({}, "Error. Resolver stopped.");
+  }
+
+}
+
+void SystemResolver::run() {
+
+  while(true) {
+
+    std::shared_ptr<Task> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_idleThreads ++;
+      while(m_running && m_tasks.empty()) {
+        m_condition.wait(lock);
+      }
+      m_idleThreads --;
+      if(!m_running) {
+        return;
+      }
+      task = m_tasks.front();
+      m_tasks.pop_front();
+    }
+
+    Endpoints endpoints;
+    auto error = lookup(task->address, false, endpoints);
+    task->complete(std::move(endpoints), error);
+
+  }
+
+}
+
+Resolver::Endpoints SystemResolver::resolve(const Address& address) {
+  Endpoints endpoints;
+  auto error = lookup(address, false, endpoints);
+  if(error) {
+    throw std::runtime_error("[oatpp::network::resolver::SystemResolver::resolve()]: " + *error);
+  }
+  return endpoints;
+}
+
+oatpp::async::CoroutineStarterForResult<const Resolver::Endpoints&> SystemResolver::resolveAsync(const Address& address) {
+
+  class ResolveCoroutine : public oatpp::async::CoroutineWithResult<ResolveCoroutine, const Endpoints&> {
+  private:
+    SystemResolver* m_this;
+    std::shared_ptr<Task> m_task;
+    oatpp::async::LockGuard m_lockGuard;
+  public:
+
+    ResolveCoroutine(SystemResolver* _this, const Address& address)
+      : m_this(_this)
+      , m_task(std::make_shared<Task>(address))
+      , m_lockGuard(&m_task->lock)
+    {}
+
+    Action act() override {
+
+      Endpoints endpoints;
+      if(resolveNumeric(m_task->address, endpoints)) {
+        m_task->endpoints = std::move(endpoints);
+        return _return(m_task->endpoints);
+      }
+
+      m_this->submit(m_task);
+
+      auto task = m_task.get();
+      return m_task->condition.wait(m_lockGuard, [task]() noexcept { return task->done; })
+        .next(yieldTo(&ResolveCoroutine::onResolved));
+
+    }
+
+    Action onResolved() {
+      m_lockGuard.unlock();
+      if(m_task->error) {
+        return error<oatpp::async::Error>("[oatpp::network::resolver::SystemResolver::resolveAsync()]: " + *m_task->error);
+      }
+      return _return(m_task->endpoints);
+    }
+
+  };
+
+  return ResolveCoroutine::startForResult(this, address);
+
+}
+
+}}}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_resolver_SystemResolver_hpp
+#define oatpp_network_resolver_SystemResolver_hpp
+
+#include "./Resolver.hpp"
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace oatpp { namespace network { namespace resolver {
+
+/**
+ * Resolver using system `getaddrinfo()`. <br>
+ * &l:SystemResolver::resolveAsync (); doesn't block the calling processor -
+ * lookups are made by a small pool of resolver threads, and the coroutine is resumed once the lookup is done. <br>
+ * Numeric IP literals are resolved in place without any lookups.
+ */
+class SystemResolver : public Resolver {
+private:
+  struct Task;
+private:
+  v_int32 m_threadsCount;
+  v_int32 m_idleThreads;
+  std::vector<std::thread> m_threads;
+  std::list<std::shared_ptr<Task>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_running;
+private:
+  void submit(const std::shared_ptr<Task>& task);
+  void run();
+public:
+
+  /**
+   * Constructor.
+   * @param threadsCount - number of resolver threads used for async lookups. Threads are started on the first async lookup.
+   */
+  SystemResolver(v_int32 threadsCount = 2);
+
+  /**
+   * Destructor. Stops resolver threads. Pending async lookups fail.
+   */
+  ~SystemResolver() override;
+
+  /**
+   * Create shared SystemResolver.
+   * @param threadsCount - number of resolver threads used for async lookups.
+   * @return - `std::shared_ptr` to SystemResolver.
+   */
+  static std::shared_ptr<SystemResolver> createShared(v_int32 threadsCount = 2);
+
+  /**
+   * Resolve address in the calling thread.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::network::resolver::Resolver::Endpoints;.
+   * @throws - `std::runtime_error` if address can't be resolved.
+   */
+  Endpoints resolve(const Address& address) override;
+
+  /**
+   * Resolve address in one of resolver threads.
+   * @param address - &id:oatpp::network::Address;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const Endpoints&> resolveAsync(const Address& address) override;
+
+};
+
+}}}
+
+#endif // oatpp_network_resolver_SystemResolver_hpp
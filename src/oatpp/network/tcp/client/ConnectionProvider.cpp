@@ -25,6 +25,7 @@
 #include "./ConnectionProvider.hpp"
 
 #include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/async/worker/IOEventWorker.hpp"
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/base/Log.hpp"
 
@@ -40,9 +41,18 @@
   #include <netdb.h>
   #include <arpa/inet.h>
   #include <sys/socket.h>
+  #include <poll.h>
   #include <unistd.h>
 #endif
 
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+  #include <sys/epoll.h>
+  #include <sys/timerfd.h>
+#elif defined(OATPP_IO_EVENT_INTERFACE_KQUEUE)
+  #include <sys/event.h>
+  #include <sys/time.h>
+#endif
+
 namespace oatpp { namespace network { namespace tcp { namespace client {
 
 void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<data::stream::IOStream>& connection) {
@@ -70,264 +80,431 @@ void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr
 
 }
 
-ConnectionProvider::ConnectionProvider(const network::Address& address)
-  : m_invalidator(std::make_shared<ConnectionInvalidator>())
-  , m_address(address)
-{
-  setProperty(PROPERTY_HOST, address.host);
-  setProperty(PROPERTY_PORT, oatpp::utils::Conversion::int32ToStr(address.port));
-}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionProvider::ConnectionRace
+
+/*
+ * Races non-blocking connect() attempts to resolved endpoints.
+ * A new attempt starts when the previous one fails, or when it hasn't connected within the attempt delay.
+ * The first connected socket wins, all other attempts are closed.
+ */
+class ConnectionProvider::ConnectionRace {
+private:
+  resolver::Resolver::Endpoints m_endpoints;
+  v_int64 m_attemptDelay;
+  size_t m_nextEndpoint;
+  v_int64 m_nextAttemptTime;
+  std::vector<v_io_handle> m_pending;
+  int m_lastError;
+  v_io_handle m_waitHandle;
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+  v_io_handle m_timerHandle;
+#endif
+private:
 
-provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::get() {
+  static void closeHandle(v_io_handle handle) {
+#if defined(WIN32) || defined(_WIN32)
+    ::closesocket(handle);
+#else
+    ::close(handle);
+#endif
+  }
 
-  auto portStr = oatpp::utils::Conversion::int32ToStr(m_address.port);
+  static int getLastError() {
+#if defined(WIN32) || defined(_WIN32)
+    return WSAGetLastError();
+#else
+    return errno;
+#endif
+  }
 
-  addrinfo hints;
+  void startAttempt(v_int64 now) {
 
-  memset(&hints, 0, sizeof(addrinfo));
-  hints.ai_socktype = SOCK_STREAM;
-  hints.ai_flags = 0;
-  hints.ai_protocol = 0;
+    const auto& endpoint = m_endpoints[m_nextEndpoint ++];
+    m_nextAttemptTime = now + m_attemptDelay;
 
-  switch(m_address.family) {
-    case Address::IP_4: hints.ai_family = AF_INET; break;
-    case Address::IP_6: hints.ai_family = AF_INET6; break;
-    case Address::UNSPEC:
-    default:
-      hints.ai_family = AF_UNSPEC;
-  }
+    v_io_handle handle = socket(endpoint.family, SOCK_STREAM, 0);
 
-  addrinfo* result;
-  auto res = getaddrinfo(m_address.host->c_str(), portStr->c_str(), &hints, &result);
+#if defined(WIN32) || defined(_WIN32)
+    if (handle == INVALID_SOCKET) {
+      m_lastError = getLastError();
+      return;
+    }
+    u_long flags = 1;
+    ioctlsocket(handle, FIONBIO, &flags);
+#else
+    if (handle < 0) {
+      m_lastError = getLastError();
+      return;
+    }
+    fcntl(handle, F_SETFL, O_NONBLOCK);
+#endif
+
+#ifdef SO_NOSIGPIPE
+    int yes = 1;
+    v_int32 ret = setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
+    if(ret < 0) {
+      OATPP_LOGd("[oatpp::network::tcp::client::ConnectionProvider::ConnectionRace::startAttempt()]", "Warning. Failed to set {} for socket", "SO_NOSIGPIPE")
+    }
+#endif
+
+    auto res = connect(handle, reinterpret_cast<const sockaddr*>(endpoint.data.data()), static_cast<socklen_t>(endpoint.data.size()));
 
-  if (res != 0) {
+    if(res != 0) {
+      auto error = getLastError();
 #if defined(WIN32) || defined(_WIN32)
-    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. "
-                             "Error. Call to getaddrinfo() failed with code " + std::to_string(res));
+      bool inProgress = (error == WSAEWOULDBLOCK || error == WSAEINPROGRESS);
 #else
-    std::string errorString = "[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. Error. Call to getaddrinfo() failed: ";
-	  throw std::runtime_error(errorString.append(gai_strerror(res)));
+      bool inProgress = (error == EINPROGRESS || error == EINTR);
 #endif
+      if(!inProgress) {
+        m_lastError = error;
+        closeHandle(handle);
+        return;
+      }
+    }
+
+    m_pending.push_back(handle);
+
   }
 
-  if (result == nullptr) {
-    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]. Error. Call to getaddrinfo() returned no results.");
+public:
+
+  ConnectionRace(resolver::Resolver::Endpoints&& endpoints, v_int64 attemptDelay)
+    : m_endpoints(std::move(endpoints))
+    , m_attemptDelay(attemptDelay)
+    , m_nextEndpoint(0)
+    , m_nextAttemptTime(0)
+    , m_lastError(0)
+    , m_waitHandle(INVALID_IO_HANDLE)
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+    , m_timerHandle(INVALID_IO_HANDLE)
+#endif
+  {}
+
+  ~ConnectionRace() {
+    for(auto handle : m_pending) {
+      closeHandle(handle);
+    }
+    if(m_waitHandle != INVALID_IO_HANDLE) {
+      closeHandle(m_waitHandle);
+    }
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
+    if(m_timerHandle != INVALID_IO_HANDLE) {
+      closeHandle(m_timerHandle);
+    }
+#endif
   }
 
-  addrinfo* currResult = result;
-  oatpp::v_io_handle clientHandle = INVALID_IO_HANDLE;
-  int err = 0;
+  /*
+   * Returns connected handle or INVALID_IO_HANDLE.
+   * If block == false - returns immediately if there is no connected socket yet.
+   */
+  v_io_handle poll(bool block) {
+
+    while(true) {
+
+      auto now = oatpp::Environment::getMicroTickCount();
+
+      if(m_nextEndpoint < m_endpoints.size() && (m_pending.empty() || now >= m_nextAttemptTime)) {
+        startAttempt(now);
+        continue;
+      }
 
-  while(currResult != nullptr) {
+      if(m_pending.empty()) {
+        return INVALID_IO_HANDLE;
+      }
 
-    clientHandle = socket(currResult->ai_family, currResult->ai_socktype, currResult->ai_protocol);
+      int timeout = 0;
+      if(block) {
+        if(m_nextEndpoint < m_endpoints.size()) {
+          timeout = static_cast<int>((m_nextAttemptTime - now + 999) / 1000);
+        } else {
+          timeout = -1;
+        }
+      }
 
-    if(clientHandle >= 0) {
+      std::vector<pollfd> fds(m_pending.size());
+      for(size_t i = 0; i < m_pending.size(); i ++) {
+        fds[i].fd = m_pending[i];
+        fds[i].events = POLLOUT;
+        fds[i].revents = 0;
+      }
 
-      if(connect(clientHandle, currResult->ai_addr, currResult->ai_addrlen) == 0) {
-        break;
-      } else {
-          err = errno;
 #if defined(WIN32) || defined(_WIN32)
-		    ::closesocket(clientHandle);
+      auto res = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout);
 #else
-        ::close(clientHandle);
+      auto res = ::poll(fds.data(), fds.size(), timeout);
 #endif
+
+      if(res < 0) {
+        auto error = getLastError();
+#if !defined(WIN32) && !defined(_WIN32)
+        if(error == EINTR) {
+          continue;
+        }
+#endif
+        m_lastError = error;
+        for(auto handle : m_pending) {
+          closeHandle(handle);
+        }
+        m_pending.clear();
+        m_nextEndpoint = m_endpoints.size();
+        return INVALID_IO_HANDLE;
       }
 
-    }
+      for(size_t i = fds.size(); i > 0; i --) {
 
-    currResult = currResult->ai_next;
+        auto& fd = fds[i - 1];
+        if(fd.revents == 0) {
+          continue;
+        }
+
+        auto handle = m_pending[i - 1];
+
+        int error = 0;
+        socklen_t errorSize = sizeof(error);
+        if(getsockopt(handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &errorSize) != 0) {
+          error = getLastError();
+        }
+
+        if(error == 0 && (fd.revents & POLLOUT) != 0) {
+          m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(i - 1));
+          return handle;
+        }
+
+        if(error != 0 || (fd.revents & (POLLERR | POLLHUP)) != 0) {
+          m_lastError = error;
+          closeHandle(handle);
+          m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(i - 1));
+        }
+
+      }
+
+      if(!block && !(m_pending.empty() && m_nextEndpoint < m_endpoints.size())) {
+        return INVALID_IO_HANDLE;
+      }
+
+    }
 
   }
 
-  freeaddrinfo(result);
+  bool isFailed() const {
+    return m_pending.empty() && m_nextEndpoint >= m_endpoints.size();
+  }
 
-  if(currResult == nullptr) {
-    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]: Error. Can't connect: " +
-                                 std::string(strerror(err)));
+  bool hasMoreEndpoints() const {
+    return m_nextEndpoint < m_endpoints.size();
   }
 
-#ifdef SO_NOSIGPIPE
-  int yes = 1;
-  v_int32 ret = setsockopt(clientHandle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
-  if(ret < 0) {
-    OATPP_LOGd("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]", "Warning. Failed to set {} for socket", "SO_NOSIGPIPE")
+  const std::vector<v_io_handle>& getPending() const {
+    return m_pending;
   }
-#endif
 
-  return provider::ResourceHandle<data::stream::IOStream>(
-      std::make_shared<oatpp::network::tcp::Connection>(clientHandle),
-      m_invalidator
-  );
+  /*
+   * Get handle which becomes readable once any of the pending attempts is writable (connected or failed),
+   * or once it's time to start the next attempt. Call it before each wait.
+   * Returns INVALID_IO_HANDLE if there is no event queue to aggregate the attempts on this platform.
+   */
+  v_io_handle getWaitHandle() {
 
-}
+#if defined(OATPP_IO_EVENT_INTERFACE_EPOLL)
 
-oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> ConnectionProvider::getAsync() {
+    if(m_waitHandle == INVALID_IO_HANDLE) {
 
-  class ConnectCoroutine : public oatpp::async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
-  private:
-    std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
-    network::Address m_address;
-    oatpp::v_io_handle m_clientHandle;
-  private:
-    addrinfo* m_result;
-    addrinfo* m_currentResult;
-    bool m_isHandleOpened;
-  public:
+      m_waitHandle = epoll_create1(EPOLL_CLOEXEC);
+      if(m_waitHandle < 0) {
+        m_waitHandle = INVALID_IO_HANDLE;
+        return INVALID_IO_HANDLE;
+      }
 
-    ConnectCoroutine(const std::shared_ptr<ConnectionInvalidator>& connectionInvalidator,
-                     const network::Address& address)
-      : m_connectionInvalidator(connectionInvalidator)
-      , m_address(address)
-      , m_result(nullptr)
-      , m_currentResult(nullptr)
-      , m_isHandleOpened(false)
-    {}
+      m_timerHandle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      if(m_timerHandle < 0) {
+        m_timerHandle = INVALID_IO_HANDLE;
+        return INVALID_IO_HANDLE;
+      }
 
-    ~ConnectCoroutine() override {
-      if(m_result != nullptr) {
-        freeaddrinfo(m_result);
+      epoll_event event;
+      memset(&event, 0, sizeof(epoll_event));
+      event.events = EPOLLIN;
+      event.data.fd = m_timerHandle;
+      if(epoll_ctl(m_waitHandle, EPOLL_CTL_ADD, m_timerHandle, &event) != 0) {
+        return INVALID_IO_HANDLE;
       }
+
     }
 
-    Action act() override {
+    /* attempts which are already watched fail with EEXIST. Closed attempts are removed by the kernel */
+    for(auto handle : m_pending) {
+      epoll_event event;
+      memset(&event, 0, sizeof(epoll_event));
+      event.events = EPOLLOUT;
+      event.data.fd = handle;
+      epoll_ctl(m_waitHandle, EPOLL_CTL_ADD, handle, &event);
+    }
 
-      auto portStr = oatpp::utils::Conversion::int32ToStr(m_address.port);
+    uint64_t expirations;
+    while(::read(m_timerHandle, &expirations, sizeof(expirations)) > 0) {}
 
-      addrinfo hints;
+    itimerspec spec;
+    memset(&spec, 0, sizeof(itimerspec));
+    if(hasMoreEndpoints()) {
+      auto delay = std::max<v_int64>(m_nextAttemptTime - oatpp::Environment::getMicroTickCount(), 1);
+      spec.it_value.tv_sec = delay / 1000000;
+      spec.it_value.tv_nsec = (delay % 1000000) * 1000;
+    }
+    if(timerfd_settime(m_timerHandle, 0, &spec, nullptr) != 0) {
+      return INVALID_IO_HANDLE;
+    }
 
-      memset(&hints, 0, sizeof(addrinfo));
-      hints.ai_socktype = SOCK_STREAM;
-      hints.ai_flags = 0;
-      hints.ai_protocol = 0;
+    return m_waitHandle;
 
-      switch(m_address.family) {
-        case Address::IP_4: hints.ai_family = AF_INET; break;
-        case Address::IP_6: hints.ai_family = AF_INET6; break;
-        case Address::UNSPEC:
-        default:
-          hints.ai_family = AF_UNSPEC;
-      }
+#elif defined(OATPP_IO_EVENT_INTERFACE_KQUEUE)
 
-      // TODO make call to get addrinfo non-blocking !!!
-      auto res = getaddrinfo(m_address.host->c_str(), portStr->c_str(), &hints, &m_result);
-      if (res != 0) {
-        return error<async::Error>(
-          "[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]. Error. Call to getaddrinfo() failed.");
+    if(m_waitHandle == INVALID_IO_HANDLE) {
+      m_waitHandle = kqueue();
+      if(m_waitHandle < 0) {
+        m_waitHandle = INVALID_IO_HANDLE;
+        return INVALID_IO_HANDLE;
       }
+    }
 
-      m_currentResult = m_result;
+    /* drop already fired events. Level-triggered filters which are still true are queued again */
+    struct kevent events[16];
+    timespec zeroTimeout = {0, 0};
+    while(kevent(m_waitHandle, nullptr, 0, events, 16, &zeroTimeout) == 16) {}
 
-      if (m_result == nullptr) {
-        return error<async::Error>(
-          "[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]. Error. Call to getaddrinfo() returned no results.");
-      }
+    std::vector<struct kevent> changes(m_pending.size() + 1);
+    for(size_t i = 0; i < m_pending.size(); i ++) {
+      EV_SET(&changes[i], m_pending[i], EVFILT_WRITE, EV_ADD, 0, 0, nullptr);
+    }
 
-      return yieldTo(&ConnectCoroutine::iterateAddrInfoResults);
+    if(hasMoreEndpoints()) {
+      auto delay = std::max<v_int64>((m_nextAttemptTime - oatpp::Environment::getMicroTickCount() + 999) / 1000, 1);
+      EV_SET(&changes[m_pending.size()], 0, EVFILT_TIMER, EV_ADD | EV_ONESHOT, 0, delay, nullptr);
+    } else {
+      changes.pop_back();
+    }
 
+    if(kevent(m_waitHandle, changes.data(), static_cast<int>(changes.size()), nullptr, 0, nullptr) != 0) {
+      return INVALID_IO_HANDLE;
     }
 
-    Action iterateAddrInfoResults() {
+    return m_waitHandle;
 
-      /*
-       * Close previously opened socket here.
-       * Don't ever close socket in the method which returns action ioWait or ioRepeat
-       */
-      if(m_isHandleOpened) {
-        m_isHandleOpened = false;
-#if defined(WIN32) || defined(_WIN32)
-        ::closesocket(m_clientHandle);
 #else
-        ::close(m_clientHandle);
+
+    return INVALID_IO_HANDLE;
+
 #endif
 
-      }
+  }
 
-      if(m_currentResult != nullptr) {
+  std::string getErrorMessage() const {
+    return std::string(strerror(m_lastError));
+  }
 
-        m_clientHandle = socket(m_currentResult->ai_family, m_currentResult->ai_socktype, m_currentResult->ai_protocol);
+};
 
-#if defined(WIN32) || defined(_WIN32)
-        if (m_clientHandle == INVALID_SOCKET) {
-          m_currentResult = m_currentResult->ai_next;
-          return repeat();
-        }
-        u_long flags = 1;
-        ioctlsocket(m_clientHandle, FIONBIO, &flags);
-#else
-        if (m_clientHandle < 0) {
-          m_currentResult = m_currentResult->ai_next;
-          return repeat();
-        }
-        fcntl(m_clientHandle, F_SETFL, O_NONBLOCK);
-#endif
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionProvider
 
-#ifdef SO_NOSIGPIPE
-        int yes = 1;
-        v_int32 ret = setsockopt(m_clientHandle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
-        if(ret < 0) {
-          OATPP_LOGd("[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]", "Warning. Failed to set {} for socket", "SO_NOSIGPIPE")
-        }
-#endif
+ConnectionProvider::ConnectionProvider(const network::Address& address, const std::shared_ptr<resolver::Resolver>& resolver)
+  : m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_resolver(resolver)
+  , m_connectionAttemptDelay(250 * 1000)
+  , m_address(address)
+{
+  if(!m_resolver) {
+    m_resolver = resolver::Resolver::getDefault();
+  }
+  setProperty(PROPERTY_HOST, address.host);
+  setProperty(PROPERTY_PORT, oatpp::utils::Conversion::int32ToStr(address.port));
+}
 
-        m_isHandleOpened = true;
-        return yieldTo(&ConnectCoroutine::doConnect);
+provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::get() {
 
-      }
+  ConnectionRace race(resolver::Resolver::interleave(m_resolver->resolve(m_address)), m_connectionAttemptDelay);
 
-      return error<Error>("[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]: Error. Can't connect.");
+  auto clientHandle = race.poll(true);
 
-    }
+  if(clientHandle == INVALID_IO_HANDLE) {
+    throw std::runtime_error("[oatpp::network::tcp::client::ConnectionProvider::getConnection()]: Error. Can't connect: " +
+                             race.getErrorMessage());
+  }
 
-    Action doConnect() {
-      errno = 0;
+  auto connection = std::make_shared<oatpp::network::tcp::Connection>(clientHandle);
+  connection->setInputStreamIOMode(data::stream::IOMode::BLOCKING);
 
-      auto res = connect(m_clientHandle, m_currentResult->ai_addr, m_currentResult->ai_addrlen);
+  return provider::ResourceHandle<data::stream::IOStream>(connection, m_invalidator);
 
-#if defined(WIN32) || defined(_WIN32)
+}
 
-      auto error = WSAGetLastError();
+oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> ConnectionProvider::getAsync() {
 
-      if(res == 0 || error == WSAEISCONN) {
-        return _return(provider::ResourceHandle<data::stream::IOStream>(
-                std::make_shared<oatpp::network::tcp::Connection>(m_clientHandle),
-                m_connectionInvalidator
-            ));
-      }
-      if(error == WSAEWOULDBLOCK || error == WSAEINPROGRESS) {
-        return ioWait(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
-      } else if(error == WSAEINTR || error == WSAEALREADY) {
-        return ioRepeat(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
-      } else if(error == WSAEINVAL) {
-         return AbstractCoroutine::error(new async::Error(
-                  "[oatpp::network::tcp::client::ConnectionProvider::doConnect()]: Error. The parameter m_clientHandle is a listening socket."));
-      }
+  class ConnectCoroutine : public oatpp::async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
+  private:
+    std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
+    std::shared_ptr<resolver::Resolver> m_resolver;
+    network::Address m_address;
+    v_int64 m_connectionAttemptDelay;
+    std::unique_ptr<ConnectionRace> m_race;
+  public:
 
-#else
+    ConnectCoroutine(const std::shared_ptr<ConnectionInvalidator>& connectionInvalidator,
+                     const std::shared_ptr<resolver::Resolver>& resolver,
+                     const network::Address& address,
+                     v_int64 connectionAttemptDelay)
+      : m_connectionInvalidator(connectionInvalidator)
+      , m_resolver(resolver)
+      , m_address(address)
+      , m_connectionAttemptDelay(connectionAttemptDelay)
+    {}
+
+    Action act() override {
+      return m_resolver->resolveAsync(m_address).callbackTo(&ConnectCoroutine::onResolved);
+    }
+
+    Action onResolved(const resolver::Resolver::Endpoints& endpoints) {
+      m_race.reset(new ConnectionRace(resolver::Resolver::interleave(endpoints), m_connectionAttemptDelay));
+      return yieldTo(&ConnectCoroutine::doConnect);
+    }
+
+    Action doConnect() {
 
-      if(res == 0 || errno == EISCONN) {
+      auto handle = m_race->poll(false);
+
+      if(handle != INVALID_IO_HANDLE) {
         return _return(provider::ResourceHandle<data::stream::IOStream>(
-                std::make_shared<oatpp::network::tcp::Connection>(m_clientHandle),
-                m_connectionInvalidator
-            ));
+          std::make_shared<oatpp::network::tcp::Connection>(handle),
+          m_connectionInvalidator
+        ));
       }
-      if(errno == EALREADY || errno == EINPROGRESS) {
-        return ioWait(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
-      } else if(errno == EINTR) {
-        return ioRepeat(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+
+      if(m_race->isFailed()) {
+        return error<Error>("[oatpp::network::tcp::client::ConnectionProvider::getConnectionAsync()]: Error. Can't connect: " +
+                            m_race->getErrorMessage());
       }
 
-#endif
+      /* single attempt in flight and nothing to race against - just wait for the socket */
+      if(!m_race->hasMoreEndpoints() && m_race->getPending().size() == 1) {
+        return ioWait(m_race->getPending()[0], oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+
+      /* wait for any of the pending attempts, or for the time to start the next one */
+      auto waitHandle = m_race->getWaitHandle();
+      if(waitHandle != INVALID_IO_HANDLE) {
+        return ioWait(waitHandle, oatpp::async::Action::IOEventType::IO_EVENT_READ);
+      }
 
-      m_currentResult = m_currentResult->ai_next;
-      return yieldTo(&ConnectCoroutine::iterateAddrInfoResults);
+      /* no event queue to wait on multiple attempts */
+      return waitRepeat(std::chrono::milliseconds(5));
 
     }
 
   };
 
-  return ConnectCoroutine::startForResult(m_invalidator, m_address);
+  return ConnectCoroutine::startForResult(m_invalidator, m_resolver, m_address, m_connectionAttemptDelay);
 
 }
 
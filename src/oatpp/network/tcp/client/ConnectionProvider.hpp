@@ -25,6 +25,7 @@
 #ifndef oatpp_netword_tcp_client_ConnectionProvider_hpp
 #define oatpp_netword_tcp_client_ConnectionProvider_hpp
 
+#include "oatpp/network/resolver/Resolver.hpp"
 #include "oatpp/network/Address.hpp"
 
 #include "oatpp/network/ConnectionProvider.hpp"
@@ -34,11 +35,16 @@
 namespace oatpp { namespace network { namespace tcp { namespace client {
 
 /**
- * Simple provider of clinet TCP connections.
+ * Simple provider of clinet TCP connections. <br>
+ * Host names are resolved by &id:oatpp::network::resolver::Resolver; (by default - system resolver with TTL cache).
+ * When host resolves to multiple addresses, connection attempts race (RFC 8305 "Happy Eyeballs") -
+ * address families alternate and a new attempt is started every `connectionAttemptDelay` until one of them connects.
  */
 class ConnectionProvider : public ClientConnectionProvider {
 private:
 
+  class ConnectionRace;
+
   class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
   public:
 
@@ -48,23 +54,29 @@ private:
 
 private:
   std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  std::shared_ptr<resolver::Resolver> m_resolver;
+  v_int64 m_connectionAttemptDelay;
 protected:
   network::Address m_address;
 public:
   /**
    * Constructor.
    * @param address - &id:oatpp::network::Address;.
+   * @param resolver - &id:oatpp::network::resolver::Resolver;. If `nullptr` -
+   * &id:oatpp::network::resolver::Resolver::getDefault (); is used.
    */
-  ConnectionProvider(const network::Address& address);
+  ConnectionProvider(const network::Address& address, const std::shared_ptr<resolver::Resolver>& resolver = nullptr);
 public:
 
   /**
    * Create shared client ConnectionProvider.
    * @param address - &id:oatpp::network::Address;.
+   * @param resolver - &id:oatpp::network::resolver::Resolver;. If `nullptr` - &id:oatpp::network::resolver::Resolver::getDefault (); is used.
    * @return - `std::shared_ptr` to ConnectionProvider.
    */
-  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address){
-    return std::make_shared<ConnectionProvider>(address);
+  static std::shared_ptr<ConnectionProvider> createShared(const network::Address& address,
+                                                          const std::shared_ptr<resolver::Resolver>& resolver = nullptr){
+    return std::make_shared<ConnectionProvider>(address, resolver);
   }
 
   /**
@@ -93,6 +105,31 @@ public:
   const network::Address& getAddress() const {
     return m_address;
   }
+
+  /**
+   * Get resolver.
+   * @return - &id:oatpp::network::resolver::Resolver;.
+   */
+  std::shared_ptr<resolver::Resolver> getResolver() const {
+    return m_resolver;
+  }
+
+  /**
+   * Set delay after which the next connection attempt is started while previous attempts are still pending.
+   * Default - 250 milliseconds.
+   * @param delay
+   */
+  void setConnectionAttemptDelay(const std::chrono::duration<v_int64, std::micro>& delay) {
+    m_connectionAttemptDelay = delay.count();
+  }
+
+  /**
+   * Get connection attempt delay in microseconds.
+   * @return
+   */
+  v_int64 getConnectionAttemptDelay() const {
+    return m_connectionAttemptDelay;
+  }
   
 };
   
@@ -0,0 +1,256 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "./ConnectionProvider.hpp"
+
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <io.h>
+  #include <winsock2.h>
+  #include <afunix.h>
+#else
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace oatpp { namespace network { namespace unix_ { namespace client {
+
+namespace {
+
+v_sock_size makeAddress(const oatpp::String& path, sockaddr_un& address) {
+
+  memset(&address, 0, sizeof(sockaddr_un));
+  address.sun_family = AF_UNIX;
+
+  if(!path || path->empty() || path->size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("[oatpp::network::unix_::client::ConnectionProvider::makeAddress()]: Error. Invalid socket path.");
+  }
+
+  memcpy(address.sun_path, path->data(), path->size());
+
+  if(address.sun_path[0] == '@') {
+    address.sun_path[0] = '\0';
+    return static_cast<v_sock_size>(offsetof(sockaddr_un, sun_path) + path->size());
+  }
+
+  return static_cast<v_sock_size>(sizeof(sockaddr_un));
+
+}
+
+void closeHandle(v_io_handle handle) {
+#if defined(WIN32) || defined(_WIN32)
+  ::closesocket(handle);
+#else
+  ::close(handle);
+#endif
+}
+
+void setNoSigPipe(v_io_handle handle) {
+#ifdef SO_NOSIGPIPE
+  int yes = 1;
+  v_int32 ret = setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
+  if(ret < 0) {
+    OATPP_LOGd("[oatpp::network::unix_::client::ConnectionProvider]", "Warning. Failed to set {} for socket", "SO_NOSIGPIPE")
+  }
+#else
+  (void) handle;
+#endif
+}
+
+}
+
+void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<data::stream::IOStream>& connection) {
+
+  /*
+   * Use shutdown instead of close - see tcp::client::ConnectionProvider::ConnectionInvalidator::invalidate()
+   */
+
+  auto c = std::static_pointer_cast<network::tcp::Connection>(connection);
+  v_io_handle handle = c->getHandle();
+
+#if defined(WIN32) || defined(_WIN32)
+  shutdown(handle, SD_BOTH);
+#else
+  shutdown(handle, SHUT_RDWR);
+#endif
+
+}
+
+ConnectionProvider::ConnectionProvider(const oatpp::String& path, const oatpp::String& host)
+  : m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_path(path)
+{
+  setProperty(PROPERTY_HOST, host);
+}
+
+provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::get() {
+
+  sockaddr_un address;
+  auto addressSize = makeAddress(m_path, address);
+
+  oatpp::v_io_handle handle = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if(!oatpp::isValidIOHandle(handle)) {
+    throw std::runtime_error("[oatpp::network::unix_::client::ConnectionProvider::get()]: Error. Can't create socket.");
+  }
+
+  if(connect(handle, reinterpret_cast<sockaddr*>(&address), addressSize) != 0) {
+    std::string err = strerror(errno);
+    closeHandle(handle);
+    throw std::runtime_error("[oatpp::network::unix_::client::ConnectionProvider::get()]: Error. Can't connect: " + err);
+  }
+
+  setNoSigPipe(handle);
+
+  return provider::ResourceHandle<data::stream::IOStream>(
+    std::make_shared<network::tcp::Connection>(handle),
+    m_invalidator
+  );
+
+}
+
+oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> ConnectionProvider::getAsync() {
+
+  class ConnectCoroutine : public oatpp::async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<oatpp::data::stream::IOStream>&> {
+  private:
+    std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
+    oatpp::String m_path;
+    sockaddr_un m_address;
+    v_sock_size m_addressSize;
+    oatpp::v_io_handle m_clientHandle;
+    bool m_isHandleOpened;
+  public:
+
+    ConnectCoroutine(const std::shared_ptr<ConnectionInvalidator>& connectionInvalidator,
+                     const oatpp::String& path)
+      : m_connectionInvalidator(connectionInvalidator)
+      , m_path(path)
+      , m_addressSize(0)
+      , m_clientHandle(INVALID_IO_HANDLE)
+      , m_isHandleOpened(false)
+    {}
+
+    ~ConnectCoroutine() override {
+      if(m_isHandleOpened) {
+        closeHandle(m_clientHandle);
+      }
+    }
+
+    Action act() override {
+      try {
+        m_addressSize = makeAddress(m_path, m_address);
+      } catch (...) {
+        return error<async::Error>(std::current_exception());
+      }
+      return yieldTo(&ConnectCoroutine::openSocket);
+    }
+
+    Action openSocket() {
+
+      /*
+       * Close previously opened socket here.
+       * Don't ever close socket in the method which returns action ioWait or ioRepeat
+       */
+      if(m_isHandleOpened) {
+        m_isHandleOpened = false;
+        closeHandle(m_clientHandle);
+      }
+
+      m_clientHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+      if(!oatpp::isValidIOHandle(m_clientHandle)) {
+        return error<async::Error>("[oatpp::network::unix_::client::ConnectionProvider::getAsync()]: Error. Can't create socket.");
+      }
+      m_isHandleOpened = true;
+
+#if defined(WIN32) || defined(_WIN32)
+      u_long flags = 1;
+      ioctlsocket(m_clientHandle, FIONBIO, &flags);
+#else
+      fcntl(m_clientHandle, F_SETFL, O_NONBLOCK);
+#endif
+
+      setNoSigPipe(m_clientHandle);
+
+      return yieldTo(&ConnectCoroutine::doConnect);
+
+    }
+
+    Action doConnect() {
+
+      errno = 0;
+      auto res = connect(m_clientHandle, reinterpret_cast<sockaddr*>(&m_address), m_addressSize);
+
+#if defined(WIN32) || defined(_WIN32)
+      auto err = WSAGetLastError();
+      if(res == 0 || err == WSAEISCONN) {
+        return onConnected();
+      }
+      if(err == WSAEWOULDBLOCK || err == WSAEINPROGRESS || err == WSAEALREADY) {
+        return ioWait(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+#else
+      auto err = errno;
+      if(res == 0 || err == EISCONN) {
+        return onConnected();
+      }
+      if(err == EINPROGRESS || err == EALREADY) {
+        return ioWait(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      if(err == EINTR) {
+        return ioRepeat(m_clientHandle, oatpp::async::Action::IOEventType::IO_EVENT_WRITE);
+      }
+      if(err == EAGAIN) {
+        /* listen backlog is full - retry with the new socket */
+        return waitFor(std::chrono::milliseconds(10)).next(yieldTo(&ConnectCoroutine::openSocket));
+      }
+#endif
+
+      return error<async::Error>("[oatpp::network::unix_::client::ConnectionProvider::getAsync()]: Error. Can't connect: " +
+                                 std::string(strerror(err)));
+
+    }
+
+    Action onConnected() {
+      m_isHandleOpened = false;
+      return _return(provider::ResourceHandle<data::stream::IOStream>(
+        std::make_shared<oatpp::network::tcp::Connection>(m_clientHandle),
+        m_connectionInvalidator
+      ));
+    }
+
+  };
+
+  return ConnectCoroutine::startForResult(m_invalidator, m_path);
+
+}
+
+}}}}
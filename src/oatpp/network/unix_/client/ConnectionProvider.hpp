@@ -0,0 +1,105 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_unix__client_ConnectionProvider_hpp
+#define oatpp_network_unix__client_ConnectionProvider_hpp
+
+#include "oatpp/network/ConnectionProvider.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace network { namespace unix_ { namespace client {
+
+/**
+ * Provider of Unix domain socket (`AF_UNIX`, `SOCK_STREAM`) client connections. <br>
+ * Connections are &id:oatpp::network::tcp::Connection; objects, so the provider can be used wherever
+ * &id:oatpp::network::tcp::client::ConnectionProvider; is used - ex.: with &id:oatpp::network::ClientConnectionPool;. <br>
+ * Path starting with `'@'` is the Linux abstract namespace socket.
+ */
+class ConnectionProvider : public ClientConnectionProvider {
+private:
+
+  class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
+  public:
+
+    void invalidate(const std::shared_ptr<data::stream::IOStream>& connection) override;
+
+  };
+
+private:
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  oatpp::String m_path;
+public:
+
+  /**
+   * Constructor.
+   * @param path - socket path. Prefix with `'@'` for abstract namespace socket.
+   * @param host - value of the `host` property (used by HTTP client for the `Host` header).
+   */
+  ConnectionProvider(const oatpp::String& path, const oatpp::String& host = "localhost");
+
+public:
+
+  /**
+   * Create shared client ConnectionProvider.
+   * @param path - socket path. Prefix with `'@'` for abstract namespace socket.
+   * @param host - value of the `host` property (used by HTTP client for the `Host` header).
+   * @return - `std::shared_ptr` to ConnectionProvider.
+   */
+  static std::shared_ptr<ConnectionProvider> createShared(const oatpp::String& path, const oatpp::String& host = "localhost"){
+    return std::make_shared<ConnectionProvider>(path, host);
+  }
+
+  /**
+   * Implements &id:oatpp::provider::Provider::stop;. Here does nothing.
+   */
+  void stop() override {
+    // DO NOTHING
+  }
+
+  /**
+   * Get connection.
+   * @return - `std::shared_ptr` to &id:oatpp::data::stream::IOStream;.
+   */
+  provider::ResourceHandle<data::stream::IOStream> get() override;
+
+  /**
+   * Get connection in asynchronous manner.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override;
+
+  /**
+   * Get socket path.
+   * @return
+   */
+  oatpp::String getPath() const {
+    return m_path;
+  }
+
+};
+
+}}}}
+
+#endif /* oatpp_network_unix__client_ConnectionProvider_hpp */
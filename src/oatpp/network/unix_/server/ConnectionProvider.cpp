@@ -0,0 +1,274 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "./ConnectionProvider.hpp"
+
+#include "oatpp/base/Log.hpp"
+
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <io.h>
+  #include <winsock2.h>
+  #include <afunix.h>
+#else
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace oatpp { namespace network { namespace unix_ { namespace server {
+
+namespace {
+
+v_sock_size makeAddress(const oatpp::String& path, sockaddr_un& address) {
+
+  memset(&address, 0, sizeof(sockaddr_un));
+  address.sun_family = AF_UNIX;
+
+  if(!path || path->empty() || path->size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("[oatpp::network::unix_::server::ConnectionProvider::makeAddress()]: Error. Invalid socket path.");
+  }
+
+  memcpy(address.sun_path, path->data(), path->size());
+
+  if(address.sun_path[0] == '@') {
+    address.sun_path[0] = '\0';
+    return static_cast<v_sock_size>(offsetof(sockaddr_un, sun_path) + path->size());
+  }
+
+  return static_cast<v_sock_size>(sizeof(sockaddr_un));
+
+}
+
+bool isAbstract(const oatpp::String& path) {
+  return path && !path->empty() && (*path)[0] == '@';
+}
+
+/*
+ * Check what is at the path. Doesn't follow symlinks.
+ * Returns `false` if there is nothing. `isSocket` is set to `true` if it's a socket file.
+ * (On Windows AF_UNIX socket is a reparse point and has no inode - `device` and `inode` are always zero).
+ */
+bool statPath(const oatpp::String& path, bool& isSocket, v_uint64& device, v_uint64& inode) {
+
+  isSocket = false;
+  device = 0;
+  inode = 0;
+
+#if defined(WIN32) || defined(_WIN32)
+  auto attributes = GetFileAttributesA(path->c_str());
+  if(attributes == INVALID_FILE_ATTRIBUTES) {
+    return false;
+  }
+  isSocket = (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0 && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+#else
+  struct stat info;
+  if(::lstat(path->c_str(), &info) != 0) {
+    return false;
+  }
+  isSocket = S_ISSOCK(info.st_mode);
+  device = info.st_dev;
+  inode = info.st_ino;
+#endif
+
+  return true;
+
+}
+
+void unlinkPath(const oatpp::String& path) {
+#if defined(WIN32) || defined(_WIN32)
+  ::_unlink(path->c_str());
+#else
+  ::unlink(path->c_str());
+#endif
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionProvider::ConnectionInvalidator
+
+void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<data::stream::IOStream>& connection) {
+
+  /*
+   * Use shutdown instead of close - see tcp::server::ConnectionProvider::ConnectionInvalidator::invalidate()
+   */
+
+  auto c = std::static_pointer_cast<network::tcp::Connection>(connection);
+  v_io_handle handle = c->getHandle();
+
+#if defined(WIN32) || defined(_WIN32)
+  shutdown(handle, SD_BOTH);
+#else
+  shutdown(handle, SHUT_RDWR);
+#endif
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConnectionProvider
+
+ConnectionProvider::ConnectionProvider(const oatpp::String& path, bool removeExisting)
+  : m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_path(path)
+  , m_closed(false)
+  , m_ownsFile(false)
+  , m_fileDevice(0)
+  , m_fileInode(0)
+{
+  setProperty(PROPERTY_HOST, m_path);
+  setProperty(PROPERTY_PORT, "0");
+  m_serverHandle = instantiateServer(removeExisting);
+}
+
+ConnectionProvider::~ConnectionProvider() {
+  stop();
+}
+
+void ConnectionProvider::stop() {
+  if(!m_closed.exchange(true)) {
+#if defined(WIN32) || defined(_WIN32)
+    ::closesocket(m_serverHandle);
+#else
+    ::close(m_serverHandle);
+#endif
+    /* the file might have been replaced by another server since - don't remove someone else's socket */
+    if(m_ownsFile) {
+      bool isSocket;
+      v_uint64 device, inode;
+      if(statPath(m_path, isSocket, device, inode) && isSocket && device == m_fileDevice && inode == m_fileInode) {
+        unlinkPath(m_path);
+      }
+    }
+  }
+}
+
+oatpp::v_io_handle ConnectionProvider::instantiateServer(bool removeExisting) {
+
+  sockaddr_un address;
+  auto addressSize = makeAddress(m_path, address);
+
+  if(removeExisting && !isAbstract(m_path)) {
+    bool isSocket;
+    v_uint64 device, inode;
+    if(statPath(m_path, isSocket, device, inode)) {
+      if(!isSocket) {
+        OATPP_LOGe("[oatpp::network::unix_::server::ConnectionProvider::instantiateServer()]", "Error. '{}' exists and is not a socket.", m_path->c_str())
+        throw std::runtime_error("[oatpp::network::unix_::server::ConnectionProvider::instantiateServer()]: Error. Path exists and is not a socket.");
+      }
+      unlinkPath(m_path);
+    }
+  }
+
+  oatpp::v_io_handle serverHandle = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if(!oatpp::isValidIOHandle(serverHandle)) {
+    throw std::runtime_error("[oatpp::network::unix_::server::ConnectionProvider::instantiateServer()]: Error. Can't create socket.");
+  }
+
+  if(bind(serverHandle, reinterpret_cast<sockaddr*>(&address), addressSize) != 0 ||
+     listen(serverHandle, 10000) != 0)
+  {
+    std::string err = strerror(errno);
+#if defined(WIN32) || defined(_WIN32)
+    ::closesocket(serverHandle);
+#else
+    ::close(serverHandle);
+#endif
+    OATPP_LOGe("[oatpp::network::unix_::server::ConnectionProvider::instantiateServer()]", "Error. Couldn't bind '{}'. {}", m_path->c_str(), err)
+    throw std::runtime_error("[oatpp::network::unix_::server::ConnectionProvider::instantiateServer()]: Error. Couldn't bind " + err);
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+  u_long flags = 1;
+  ioctlsocket(serverHandle, FIONBIO, &flags);
+#else
+  fcntl(serverHandle, F_SETFL, O_NONBLOCK);
+#endif
+
+  if(!isAbstract(m_path)) {
+    bool isSocket;
+    m_ownsFile = statPath(m_path, isSocket, m_fileDevice, m_fileInode) && isSocket;
+  }
+
+  return serverHandle;
+
+}
+
+provider::ResourceHandle<data::stream::IOStream> ConnectionProvider::get() {
+
+  while(!m_closed) {
+
+    fd_set set;
+    timeval timeout;
+    FD_ZERO(&set);
+    FD_SET(m_serverHandle, &set);
+
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+
+    auto res = select(
+#if defined(WIN32) || defined(_WIN32)
+      static_cast<int>(m_serverHandle + 1),
+#else
+      m_serverHandle + 1,
+#endif
+      &set,
+      nullptr,
+      nullptr,
+      &timeout);
+
+    if (res >= 0) {
+      break;
+    }
+
+  }
+
+  oatpp::v_io_handle handle = accept(m_serverHandle, nullptr, nullptr);
+
+  if(!oatpp::isValidIOHandle(handle)) {
+    return nullptr;
+  }
+
+#ifdef SO_NOSIGPIPE
+  int yes = 1;
+  v_int32 ret = setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(int));
+  if(ret < 0) {
+    OATPP_LOGd("[oatpp::network::unix_::server::ConnectionProvider::get()]", "Warning. Failed to set {} for socket", "SO_NOSIGPIPE")
+  }
+#endif
+
+  return provider::ResourceHandle<data::stream::IOStream>(
+    std::make_shared<network::tcp::Connection>(handle),
+    m_invalidator
+  );
+
+}
+
+}}}}
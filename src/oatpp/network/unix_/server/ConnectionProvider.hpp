@@ -0,0 +1,121 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_network_unix__server_ConnectionProvider_hpp
+#define oatpp_network_unix__server_ConnectionProvider_hpp
+
+#include "oatpp/network/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace network { namespace unix_ { namespace server {
+
+/**
+ * Provider of Unix domain socket (`AF_UNIX`, `SOCK_STREAM`) server connections. <br>
+ * Connections are &id:oatpp::network::tcp::Connection; objects - they work with any stream socket handle,
+ * so the provider plugs into &id:oatpp::network::Server;, HTTP connection handlers and connection monitors unchanged. <br>
+ * Path starting with `'@'` is the Linux abstract namespace socket - `'@'` is replaced with `'\0'` and no file is created.
+ */
+class ConnectionProvider : public ServerConnectionProvider {
+private:
+
+  class ConnectionInvalidator : public provider::Invalidator<data::stream::IOStream> {
+  public:
+
+    void invalidate(const std::shared_ptr<data::stream::IOStream>& connection) override;
+
+  };
+
+private:
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  oatpp::String m_path;
+  std::atomic<bool> m_closed;
+  oatpp::v_io_handle m_serverHandle;
+  bool m_ownsFile;
+  v_uint64 m_fileDevice;
+  v_uint64 m_fileInode;
+private:
+  oatpp::v_io_handle instantiateServer(bool removeExisting);
+public:
+
+  /**
+   * Constructor.
+   * @param path - socket path. Prefix with `'@'` for abstract namespace socket.
+   * @param removeExisting - remove stale socket file at `path` before binding.
+   * Only sockets are removed - if `path` is any other file, constructor throws.
+   */
+  ConnectionProvider(const oatpp::String& path, bool removeExisting = true);
+
+public:
+
+  /**
+   * Create shared ConnectionProvider.
+   * @param path - socket path. Prefix with `'@'` for abstract namespace socket.
+   * @param removeExisting - remove stale socket file at `path` before binding.
+   * @return - `std::shared_ptr` to ConnectionProvider.
+   */
+  static std::shared_ptr<ConnectionProvider> createShared(const oatpp::String& path, bool removeExisting = true){
+    return std::make_shared<ConnectionProvider>(path, removeExisting);
+  }
+
+  /**
+   * Virtual destructor.
+   */
+  ~ConnectionProvider() override;
+
+  /**
+   * Close accept-socket and remove socket file. <br>
+   * The file is removed only if it's still the socket created by this provider.
+   */
+  void stop() override;
+
+  /**
+   * Get incoming connection.
+   * @return &id:oatpp::data::stream::IOStream;.
+   */
+  provider::ResourceHandle<data::stream::IOStream> get() override;
+
+  /**
+   * Not implemented. Accept connections with the blocking &l:ConnectionProvider::get (); in a separate thread
+   * and process them in Asynchronous manner (same as &id:oatpp::network::tcp::server::ConnectionProvider;).
+   */
+  oatpp::async::CoroutineStarterForResult<const provider::ResourceHandle<data::stream::IOStream>&> getAsync() override {
+    throw std::runtime_error("[oatpp::network::unix_::server::ConnectionProvider::getAsync()]: Error. Not implemented.");
+  }
+
+  /**
+   * Get socket path.
+   * @return
+   */
+  oatpp::String getPath() const {
+    return m_path;
+  }
+
+};
+
+}}}}
+
+#endif /* oatpp_network_unix__server_ConnectionProvider_hpp */
@@ -24,6 +24,9 @@
 
 #include "Pipe.hpp"
 
+#include <cstring>
+#include <thread>
+
 namespace oatpp { namespace network { namespace virtual_ {
 
 data::stream::DefaultInitializedContext Pipe::Reader::DEFAULT_CONTEXT(data::stream::StreamType::STREAM_INFINITE);
@@ -47,39 +50,68 @@ v_io_size Pipe::Reader::read(void *data, v_buff_size count, async::Action& actio
   }
   
   Pipe& pipe = *m_pipe;
-  oatpp::v_io_size result;
-  
-  if(m_ioMode == oatpp::data::stream::IOMode::ASYNCHRONOUS) {
 
-    std::lock_guard<std::mutex> lock(pipe.m_mutex);
+  if(count <= 0) {
+    if(!pipe.m_open) {
+      return IOError::BROKEN_PIPE;
+    }
+    return 0;
+  }
+
+  auto readPosition = pipe.m_readPosition.load(std::memory_order_relaxed);
+  auto available = pipe.m_writePosition.load(std::memory_order_acquire) - readPosition;
+
+  if(available == 0) {
+
+    if(m_ioMode == oatpp::data::stream::IOMode::ASYNCHRONOUS) {
+
+      /* raise the flag before re-check so that the writer will notify the wait list */
+      pipe.m_readerWaiting = true;
+      available = pipe.availableToRead();
+
+      if(available == 0) {
+        if(!pipe.m_open) {
+          return IOError::BROKEN_PIPE;
+        }
+        action = async::Action::createWaitListAction(&m_waitList);
+        return IOError::RETRY_READ;
+      }
+
+      pipe.m_readerWaiting = false;
 
-    if (pipe.m_fifo.availableToRead() > 0) {
-      result = pipe.m_fifo.read(data, count);
-    } else if (pipe.m_open) {
-      action = async::Action::createWaitListAction(&m_waitList);
-      result = IOError::RETRY_READ;
     } else {
-      result = IOError::BROKEN_PIPE;
+
+      pipe.waitReadable();
+      available = pipe.availableToRead();
+      if(available == 0) {
+        return IOError::BROKEN_PIPE;
+      }
+
     }
 
+  }
+
+  v_buff_usize size = static_cast<v_buff_usize>(count);
+  if(size > available) {
+    size = available;
+  }
+
+  auto offset = readPosition % pipe.m_capacity;
+  auto firstPart = pipe.m_capacity - offset;
+  if(firstPart >= size) {
+    std::memcpy(data, &pipe.m_data[offset], size);
   } else {
-    std::unique_lock<std::mutex> lock(pipe.m_mutex);
-    while (pipe.m_fifo.availableToRead() == 0 && pipe.m_open) {
-      pipe.m_conditionRead.wait(lock);
-    }
-    if (pipe.m_fifo.availableToRead() > 0) {
-      result = pipe.m_fifo.read(data, count);
-    } else {
-      result = IOError::BROKEN_PIPE;
-    }
+    std::memcpy(data, &pipe.m_data[offset], firstPart);
+    std::memcpy(static_cast<p_char8>(data) + firstPart, pipe.m_data, size - firstPart);
   }
 
-  if(result > 0) {
-    pipe.m_conditionWrite.notify_one();
-    pipe.m_writer.notifyWaitList();
+  pipe.m_readPosition.store(readPosition + size);
+
+  if(pipe.m_writerWaiting) {
+    pipe.wakeWriter();
   }
-  
-  return result;
+
+  return static_cast<v_io_size>(size);
   
 }
 
@@ -118,41 +150,67 @@ v_io_size Pipe::Writer::write(const void *data, v_buff_size count, async::Action
   }
 
   Pipe& pipe = *m_pipe;
-  oatpp::v_io_size result;
-  
-  if(m_ioMode == oatpp::data::stream::IOMode::ASYNCHRONOUS) {
 
-    std::lock_guard<std::mutex> lock(pipe.m_mutex);
+  if(!pipe.m_open) {
+    return IOError::BROKEN_PIPE;
+  }
+
+  if(count <= 0) {
+    return 0;
+  }
+
+  auto writePosition = pipe.m_writePosition.load(std::memory_order_relaxed);
+  auto available = pipe.m_capacity - (writePosition - pipe.m_readPosition.load(std::memory_order_acquire));
+
+  if(available == 0) {
+
+    if(m_ioMode == oatpp::data::stream::IOMode::ASYNCHRONOUS) {
+
+      /* raise the flag before re-check so that the reader will notify the wait list */
+      pipe.m_writerWaiting = true;
+      available = pipe.availableToWrite();
 
-    if(pipe.m_open) {
-      if (pipe.m_fifo.availableToWrite() > 0) {
-        result = pipe.m_fifo.write(data, count);
-      } else {
+      if(available == 0) {
         action = async::Action::createWaitListAction(&m_waitList);
-        result = IOError::RETRY_WRITE;
+        return IOError::RETRY_WRITE;
       }
+
+      pipe.m_writerWaiting = false;
+
     } else {
-      result = IOError::BROKEN_PIPE;
-    }
 
-  } else {
-    std::unique_lock<std::mutex> lock(pipe.m_mutex);
-    while (pipe.m_fifo.availableToWrite() == 0 && pipe.m_open) {
-      pipe.m_conditionWrite.wait(lock);
+      pipe.waitWritable();
+      available = pipe.availableToWrite();
+
     }
-    if (pipe.m_open && pipe.m_fifo.availableToWrite() > 0) {
-      result = pipe.m_fifo.write(data, count);
-    } else {
-      result = IOError::BROKEN_PIPE;
+
+    if(!pipe.m_open || available == 0) {
+      return IOError::BROKEN_PIPE;
     }
+
   }
 
-  if(result > 0) {
-    pipe.m_conditionRead.notify_one();
-    pipe.m_reader.notifyWaitList();
+  v_buff_usize size = static_cast<v_buff_usize>(count);
+  if(size > available) {
+    size = available;
   }
-  
-  return result;
+
+  auto offset = writePosition % pipe.m_capacity;
+  auto firstPart = pipe.m_capacity - offset;
+  if(firstPart >= size) {
+    std::memcpy(&pipe.m_data[offset], data, size);
+  } else {
+    std::memcpy(&pipe.m_data[offset], data, firstPart);
+    std::memcpy(pipe.m_data, static_cast<const v_char8*>(data) + firstPart, size - firstPart);
+  }
+
+  pipe.m_writePosition.store(writePosition + size);
+
+  if(pipe.m_readerWaiting) {
+    pipe.wakeReader();
+  }
+
+  return static_cast<v_io_size>(size);
   
 }
 
@@ -167,7 +225,12 @@ Pipe::Pipe()
   , m_writer(this)
   , m_reader(this)
   , m_buffer()
-  , m_fifo(m_buffer.getData(), m_buffer.getSize())
+  , m_data(static_cast<p_char8>(m_buffer.getData()))
+  , m_capacity(static_cast<v_buff_usize>(m_buffer.getSize()))
+  , m_writePosition(0)
+  , m_readPosition(0)
+  , m_readerWaiting(false)
+  , m_writerWaiting(false)
 {}
 
 std::shared_ptr<Pipe> Pipe::createShared(){
@@ -178,6 +241,74 @@ Pipe::~Pipe() {
   close();
 }
 
+v_buff_usize Pipe::availableToRead() const {
+  return m_writePosition.load() - m_readPosition.load();
+}
+
+v_buff_usize Pipe::availableToWrite() const {
+  return m_capacity - (m_writePosition.load() - m_readPosition.load());
+}
+
+void Pipe::waitReadable() {
+  /* the other side is usually in the middle of the operation - give it a chance before going to sleep */
+  for(v_int32 i = 0; i < SPIN_ITERATIONS; i ++) {
+    if(availableToRead() > 0 || !m_open) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true) {
+    m_readerWaiting = true;
+    if(availableToRead() > 0 || !m_open) {
+      break;
+    }
+    m_conditionRead.wait(lock);
+  }
+  m_readerWaiting = false;
+}
+
+void Pipe::waitWritable() {
+  /* the other side is usually in the middle of the operation - give it a chance before going to sleep */
+  for(v_int32 i = 0; i < SPIN_ITERATIONS; i ++) {
+    if(availableToWrite() > 0 || !m_open) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true) {
+    m_writerWaiting = true;
+    if(availableToWrite() > 0 || !m_open) {
+      break;
+    }
+    m_conditionWrite.wait(lock);
+  }
+  m_writerWaiting = false;
+}
+
+void Pipe::wakeReader() {
+  if(m_readerWaiting.exchange(false)) {
+    {
+      /* reader is either about to re-check the ring or is already waiting */
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_conditionRead.notify_one();
+    m_reader.notifyWaitList();
+  }
+}
+
+void Pipe::wakeWriter() {
+  if(m_writerWaiting.exchange(false)) {
+    {
+      /* writer is either about to re-check the ring or is already waiting */
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_conditionWrite.notify_one();
+    m_writer.notifyWaitList();
+  }
+}
+
 Pipe::Writer* Pipe::getWriter() {
   return &m_writer;
 }
@@ -29,11 +29,9 @@
 
 #include "oatpp/data/stream/Stream.hpp"
 
-#include "oatpp/data/buffer/FIFOBuffer.hpp"
 #include "oatpp/data/buffer/IOBuffer.hpp"
 
-#include "oatpp/concurrency/SpinLock.hpp"
-
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 
@@ -41,7 +39,9 @@ namespace oatpp { namespace network { namespace virtual_ {
 
 /**
  * Virtual pipe implementation. Can be used for unidirectional data transfer between different threads of the same process. <br>
- * Under the hood it uses &id:oatpp::data::buffer::SynchronizedFIFOBuffer; over the &id:oatpp::data::buffer::IOBuffer;.
+ * Under the hood it uses a lock-free single-producer/single-consumer ring over the &id:oatpp::data::buffer::IOBuffer;.
+ * There must be only one thread reading and one thread writing at a time.
+ * Reader and writer block (or put coroutine to the wait list) only when the ring is empty/full.
  */
 class Pipe : public oatpp::base::Countable {
 public:
@@ -66,8 +66,7 @@ public:
       {}
 
       void onNewItem(oatpp::async::CoroutineWaitList& list) override {
-        std::lock_guard<std::mutex> lock(m_pipe->m_mutex);
-        if (m_pipe->m_fifo.availableToRead() > 0 || !m_pipe->m_open) {
+        if (m_pipe->availableToRead() > 0 || !m_pipe->m_open) {
           list.notifyAll();
         }
       }
@@ -160,8 +159,7 @@ public:
       {}
 
       void onNewItem(oatpp::async::CoroutineWaitList& list) override {
-        std::lock_guard<std::mutex> lock(m_pipe->m_mutex);
-        if (m_pipe->m_fifo.availableToWrite() > 0 || !m_pipe->m_open) {
+        if (m_pipe->availableToWrite() > 0 || !m_pipe->m_open) {
           list.notifyAll();
         }
       }
@@ -235,13 +233,39 @@ public:
   };
   
 private:
-  bool m_open;
+  static constexpr v_int32 SPIN_ITERATIONS = 64;
+private:
+
+  v_buff_usize availableToRead() const;
+  v_buff_usize availableToWrite() const;
+
+  /*
+   * Block until there is data to read/space to write or the pipe is closed.
+   * Called only when the ring is empty/full.
+   */
+  void waitReadable();
+  void waitWritable();
+
+  void wakeReader();
+  void wakeWriter();
+
+private:
+  std::atomic<bool> m_open;
   Writer m_writer;
   Reader m_reader;
 
   oatpp::data::buffer::IOBuffer m_buffer;
-  oatpp::data::buffer::SynchronizedFIFOBuffer m_fifo;
+  p_char8 m_data;
+  v_buff_usize m_capacity;
+
+  /* total bytes written. Modified by writer only */
+  alignas(64) std::atomic<v_buff_usize> m_writePosition;
+  /* total bytes read. Modified by reader only */
+  alignas(64) std::atomic<v_buff_usize> m_readPosition;
 
+  /* slow path - used only when the ring is empty/full */
+  alignas(64) std::atomic<bool> m_readerWaiting;
+  std::atomic<bool> m_writerWaiting;
   std::mutex m_mutex;
   std::condition_variable m_conditionRead;
   std::condition_variable m_conditionWrite;
@@ -27,10 +27,16 @@
 #define oatpp_provider_Pool_hpp
 
 #include "Provider.hpp"
+#include "Validator.hpp"
 #include "oatpp/async/CoroutineWaitList.hpp"
+#include "oatpp/concurrency/Utils.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <thread>
 #include <condition_variable>
+#include <vector>
 
 namespace oatpp { namespace provider {
 
@@ -97,6 +103,17 @@ private:
     v_int64 timestamp;
   };
 
+  /*
+   * Part of the bench. Threads release resources to their own shard and steal from other shards when theirs is empty.
+   * Records are pushed to the back with increasing timestamps -
+   * the most recently used resource is reused first and expired resources are always at the front.
+   */
+  struct alignas(64) Shard {
+    std::mutex lock;
+    std::vector<PoolRecord> records;
+    std::atomic<v_int64> size{0};
+  };
+
 private:
 
   class ResourceInvalidator : public provider::Invalidator<TResource> {
@@ -116,44 +133,222 @@ private:
 
 private:
 
-  void onNewItem(async::CoroutineWaitList& list) override {
+  static std::size_t getThreadSlot() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+    static std::atomic<std::size_t> slotCounter{0};
+    static thread_local std::size_t slot = slotCounter ++;
+    return slot;
+#else
+    return std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+  }
 
-    std::unique_lock<std::mutex> guard(m_lock);
+  static bool popFromShard(Shard& shard, PoolRecord& record) {
+    if(shard.size == 0) {
+      return false;
+    }
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if(shard.records.empty()) {
+      return false;
+    }
+    record = std::move(shard.records.back());
+    shard.records.pop_back();
+    -- shard.size;
+    return true;
+  }
+
+  /*
+   * Take resource from the bench - local shard first, then the other shards - or reserve a slot for a new resource.
+   * @param record - out parameter. Contains resource if it was taken from the bench. Empty if slot was reserved.
+   * @return - `false` if the pool is exhausted.
+   */
+  bool tryAcquire(PoolRecord& record) {
 
+    auto first = getThreadSlot();
+    for(std::size_t i = 0; i < m_shardsCount; i ++) {
+      if(popFromShard(m_shards[(first + i) % m_shardsCount], record)) {
+        return true;
+      }
+    }
+
+    return reserveSlot();
+
+  }
+
+  bool reserveSlot() {
+    auto counter = m_counter.load();
+    while(counter < m_maxResources) {
+      if(m_counter.compare_exchange_weak(counter, counter + 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool bench(Shard& shard, provider::ResourceHandle<TResource>&& resource) {
+    std::lock_guard<std::mutex> guard(shard.lock);
     if(!m_running) {
-      guard.unlock();
-      list.notifyAll();
-      return;
+      return false;
     }
+    shard.records.push_back({std::move(resource), oatpp::Environment::getMicroTickCount()});
+    ++ shard.size;
+    return true;
+  }
+
+  /*
+   * Create new resources and put them on the bench until there are `target` idle resources
+   * or the pool is at its maxResources.
+   * @return - number of resources created.
+   */
+  v_int64 fillIdle(v_int64 target) {
+
+    v_int64 created = 0;
+
+    while(m_running && getIdleCount() < target && reserveSlot()) {
+
+      provider::ResourceHandle<TResource> resource;
+      try {
+        resource = m_provider->get();
+      } catch (...) {
+        resource = nullptr;
+      }
+
+      if(resource.object == nullptr) {
+        releaseSlot();
+        break;
+      }
+
+      if(!bench(m_shards[static_cast<std::size_t>(created) % m_shardsCount], std::move(resource))) {
+        resource.invalidator->invalidate(resource.object);
+        releaseSlot();
+        break;
+      }
+
+      created ++;
 
-    if(m_counter < m_maxResources || m_bench.size() > 0) {
-      guard.unlock();
-      list.notifyFirst();
     }
 
+    return created;
+
   }
 
-  void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) {
+  /*
+   * Check idle resources with the validator.
+   * Records are taken off the shard while being checked, and valid ones are returned to the front of the shard
+   * to keep the bench ordered by timestamp.
+   */
+  void validateIdle(const std::shared_ptr<Validator<TResource>>& validator) {
 
-    {
+    std::vector<PoolRecord> records;
+    std::vector<PoolRecord> valid;
+    v_int64 invalidated = 0;
 
-      std::lock_guard<std::mutex> guard(m_lock);
+    for(std::size_t i = 0; i < m_shardsCount; i ++) {
 
-      if(!m_running) {
-        -- m_counter;
-        return;
+      auto& shard = m_shards[i];
+      if(shard.size == 0) {
+        continue;
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        records.swap(shard.records);
+        shard.size = 0;
+      }
+
+      for(auto& record : records) {
+        if(validator->validate(record.resource.object)) {
+          valid.push_back(std::move(record));
+        } else {
+          record.resource.invalidator->invalidate(record.resource.object);
+          invalidated ++;
+        }
       }
 
-      if(canReuse) {
-        m_bench.push_back({resource, oatpp::Environment::getMicroTickCount()});
-      } else {
-        -- m_counter;
+      if(!valid.empty()) {
+        {
+          std::lock_guard<std::mutex> guard(shard.lock);
+          shard.records.insert(shard.records.begin(), std::make_move_iterator(valid.begin()), std::make_move_iterator(valid.end()));
+          shard.size = static_cast<v_int64>(shard.records.size());
+        }
+        /* waiters could come while the shard was empty - several resources are back, wake all of them */
+        notifyAllWaiters();
+      }
+
+      records.clear();
+      valid.clear();
+
+    }
+
+    if(invalidated > 0) {
+      m_counter -= invalidated;
+      notifyAllWaiters();
+    }
+
+  }
+
+  bool hasAvailable() {
+    if(m_counter < m_maxResources) {
+      return true;
+    }
+    for(std::size_t i = 0; i < m_shardsCount; i ++) {
+      if(m_shards[i].size > 0) {
+        return true;
       }
+    }
+    return false;
+  }
+
+  void notifyWaiters() {
+    if(m_waiters > 0) {
+      {
+        /* waiter is either about to re-check the bench or is already waiting */
+        std::lock_guard<std::mutex> guard(m_lock);
+      }
+      m_condition.notify_one();
+      m_waitList.notifyFirst();
+    }
+  }
+
+  void notifyAllWaiters() {
+    if(m_waiters > 0) {
+      {
+        std::lock_guard<std::mutex> guard(m_lock);
+      }
+      m_condition.notify_all();
+      m_waitList.notifyAll();
+    }
+  }
 
+  void releaseSlot() {
+    -- m_counter;
+    notifyWaiters();
+  }
+
+private:
+
+  void onNewItem(async::CoroutineWaitList& list) override {
+
+    if(!m_running) {
+      list.notifyAll();
+      return;
     }
 
-    m_condition.notify_one();
-    m_waitList.notifyFirst();
+    if(hasAvailable()) {
+      list.notifyFirst();
+    }
+
+  }
+
+  void release(provider::ResourceHandle<TResource>&& resource, bool canReuse) {
+
+    bool benched = canReuse && bench(m_shards[getThreadSlot() % m_shardsCount], std::move(resource));
+
+    if(!benched) {
+      -- m_counter;
+    }
+
+    notifyWaiters();
 
   }
 
@@ -161,44 +356,78 @@ private:
 
   static void cleanupTask(std::shared_ptr<PoolTemplate> pool) {
 
-    while(pool->m_running) { // timer-based cleanup loop
+    std::vector<PoolRecord> expired;
+    v_int64 lastValidation = oatpp::Environment::getMicroTickCount();
 
-      {
-        std::lock_guard<std::mutex> guard(pool->m_lock);
-        auto ticks = oatpp::Environment::getMicroTickCount();
-
-        auto i = pool->m_bench.begin();
-        while (i != pool->m_bench.end()) {
-
-          auto elapsed = ticks - i->timestamp;
-          if(elapsed > pool->m_maxResourceTTL) {
-            i->resource.invalidator->invalidate(i->resource.object);
-            i = pool->m_bench.erase(i);
-            pool->m_counter --;
-          } else {
-            i ++;
-          }
+    while(pool->m_running) { // timer-based cleanup and maintenance loop
+
+      auto ticks = oatpp::Environment::getMicroTickCount();
+
+      for(std::size_t i = 0; i < pool->m_shardsCount; i ++) {
+
+        auto& shard = pool->m_shards[i];
+        if(shard.size == 0) {
+          continue;
+        }
 
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto begin = shard.records.begin();
+        auto end = begin;
+        while(end != shard.records.end() && ticks - end->timestamp > pool->m_maxResourceTTL) {
+          end ++;
+        }
+        if(end != begin) {
+          std::move(begin, end, std::back_inserter(expired));
+          shard.size -= std::distance(begin, end);
+          shard.records.erase(begin, end);
         }
 
       }
 
+      for(auto& record : expired) {
+        record.resource.invalidator->invalidate(record.resource.object);
+        pool->m_counter --;
+      }
+      expired.clear();
+
+      std::shared_ptr<Validator<TResource>> validator;
+      v_int64 validationInterval;
+      {
+        std::lock_guard<std::mutex> guard(pool->m_lock);
+        validator = pool->m_validator;
+        validationInterval = pool->m_validationInterval;
+      }
+
+      if(validator && ticks - lastValidation >= validationInterval) {
+        pool->validateIdle(validator);
+        lastValidation = ticks;
+      }
+
+      /* replace expired and invalid resources so that the first requests don't pay for resource creation */
+      pool->fillIdle(pool->m_minIdle);
+
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     }
 
-    { /* invalidate all pooled resources */
+    /* invalidate all pooled resources */
 
-      std::lock_guard<std::mutex> guard(pool->m_lock);
-      auto i = pool->m_bench.begin();
-      while (i != pool->m_bench.end()) {
-        i->resource.invalidator->invalidate(i->resource.object);
-        i = pool->m_bench.erase(i);
-        pool->m_counter --;
-      }
+    for(std::size_t i = 0; i < pool->m_shardsCount; i ++) {
+      auto& shard = pool->m_shards[i];
+      std::lock_guard<std::mutex> guard(shard.lock);
+      std::move(shard.records.begin(), shard.records.end(), std::back_inserter(expired));
+      shard.records.clear();
+      shard.size = 0;
+    }
 
-      pool->m_finished = true;
+    for(auto& record : expired) {
+      record.resource.invalidator->invalidate(record.resource.object);
+      pool->m_counter --;
+    }
 
+    {
+      std::lock_guard<std::mutex> guard(pool->m_lock);
+      pool->m_finished = true;
     }
 
     pool->m_condition.notify_all();
@@ -208,13 +437,18 @@ private:
 private:
   std::shared_ptr<ResourceInvalidator> m_invalidator;
   std::shared_ptr<Provider<TResource>> m_provider;
-  v_int64 m_counter{0};
+  std::atomic<v_int64> m_counter{0};
   v_int64 m_maxResources;
   v_int64 m_maxResourceTTL;
   std::atomic<bool> m_running{true};
   bool m_finished{false};
 private:
-  std::list<PoolRecord> m_bench;
+  std::size_t m_shardsCount;
+  std::unique_ptr<Shard[]> m_shards;
+  std::atomic<v_int64> m_waiters{0};
+  std::atomic<v_int64> m_minIdle{0};
+  std::shared_ptr<Validator<TResource>> m_validator;
+  v_int64 m_validationInterval{0};
   async::CoroutineWaitList m_waitList;
   std::condition_variable m_condition;
   std::mutex m_lock;
@@ -226,8 +460,12 @@ protected:
     , m_provider(provider)
     , m_maxResources(maxResources)
     , m_maxResourceTTL(maxResourceTTL)
+    , m_shardsCount(static_cast<std::size_t>(std::max<v_int64>(1, std::min<v_int64>(maxResources, oatpp::concurrency::Utils::getHardwareConcurrency()))))
+    , m_shards(new Shard[m_shardsCount])
     , m_timeout(timeout)
-  {}
+  {
+    m_waitList.setListener(this);
+  }
 
   static void startCleanupTask(const std::shared_ptr<PoolTemplate>& _this) {
     std::thread poolCleanupTask(cleanupTask, _this);
@@ -235,43 +473,58 @@ protected:
   }
 
   static provider::ResourceHandle<TResource> get(const std::shared_ptr<PoolTemplate>& _this) {
-    auto readyPredicate = [&_this]() { return !_this->m_running || !_this->m_bench.empty() || _this->m_counter < _this->m_maxResources; };
-
-    std::unique_lock<std::mutex> guard{_this->m_lock};
-    if (_this->m_timeout == std::chrono::microseconds::zero())
-    {
-      while (!readyPredicate()) {
-        _this->m_condition.wait(guard);
-      }
-    } else if (!_this->m_condition.wait_for(guard, _this->m_timeout, std::move(readyPredicate))) {
-      return nullptr;
-    }    
 
     if(!_this->m_running) {
       return nullptr;
     }
 
-    if (_this->m_bench.size() > 0) {
-      auto record = _this->m_bench.front();
-      _this->m_bench.pop_front();
+    PoolRecord record;
+
+    if(!_this->tryAcquire(record)) {
+
+      /* pool is exhausted - wait for the resource to be released */
+
+      bool acquired = false;
+      auto deadline = std::chrono::steady_clock::now() + _this->m_timeout;
+
+      std::unique_lock<std::mutex> guard{_this->m_lock};
+      ++ _this->m_waiters;
+
+      while(_this->m_running) {
+        if(_this->tryAcquire(record)) {
+          acquired = true;
+          break;
+        }
+        if (_this->m_timeout == std::chrono::microseconds::zero()) {
+          _this->m_condition.wait(guard);
+        } else if(_this->m_condition.wait_until(guard, deadline) == std::cv_status::timeout) {
+          acquired = _this->m_running && _this->tryAcquire(record);
+          break;
+        }
+      }
+
+      -- _this->m_waiters;
+
+      if(!acquired) {
+        return nullptr;
+      }
+
+    }
+
+    if(record.resource.object != nullptr) {
       return provider::ResourceHandle<TResource>(
         std::make_shared<AcquisitionProxyImpl>(record.resource, _this),
         _this->m_invalidator
       );
-    } else {
-      ++ _this->m_counter;
     }
 
-    guard.unlock();
-
     try {
       return provider::ResourceHandle<TResource>(
         std::make_shared<AcquisitionProxyImpl>(_this->m_provider->get(), _this),
         _this->m_invalidator
       );
     } catch (...) {
-      guard.lock();
-      --_this->m_counter;
+      _this->releaseSlot();
       return nullptr;
     }
   }
@@ -282,48 +535,63 @@ protected:
     private:
       std::shared_ptr<PoolTemplate> m_pool;
       std::chrono::system_clock::time_point m_startTime{std::chrono::system_clock::now()};
+      bool m_waiting{false};
+    private:
+
+      void stopWaiting() {
+        if(m_waiting) {
+          m_waiting = false;
+          -- m_pool->m_waiters;
+        }
+      }
+
     public:
 
       GetCoroutine(const std::shared_ptr<PoolTemplate>& pool)
         : m_pool(pool)
       {}
 
+      ~GetCoroutine() override {
+        stopWaiting();
+      }
+
       bool timedout() const noexcept {
         return m_pool->m_timeout != std::chrono::microseconds::zero() && m_pool->m_timeout < (std::chrono::system_clock::now() - m_startTime);
       }
 
       async::Action act() override {
-        
+
+        stopWaiting();
+
         if (timedout()) return this->_return(nullptr);
 
-        {
-          /* Careful!!! Using non-async lock */
-          std::unique_lock<std::mutex> guard(m_pool->m_lock);
+        if(!m_pool->m_running) {
+          return this->_return(nullptr);
+        }
+
+        PoolRecord record;
+
+        if(!m_pool->tryAcquire(record)) {
+
+          /* Register as a waiter and re-check, so that a concurrent release() won't be missed */
+          m_waiting = true;
+          ++ m_pool->m_waiters;
 
-          if (m_pool->m_running && m_pool->m_bench.size() == 0 && m_pool->m_counter >= m_pool->m_maxResources) {
-            guard.unlock();
+          if(!m_pool->tryAcquire(record)) {
             return m_pool->m_timeout == std::chrono::microseconds::zero()
               ? async::Action::createWaitListAction(&m_pool->m_waitList)
               : async::Action::createWaitListAction(&m_pool->m_waitList, m_startTime + m_pool->m_timeout);
           }
 
-          if(!m_pool->m_running) {
-            guard.unlock();
-            return this->_return(nullptr);
-          }
+          stopWaiting();
 
-          if (m_pool->m_bench.size() > 0) {
-            auto record = m_pool->m_bench.front();
-            m_pool->m_bench.pop_front();
-            guard.unlock();
-            return this->_return(provider::ResourceHandle<TResource>(
-              std::make_shared<AcquisitionProxyImpl>(record.resource, m_pool),
-              m_pool->m_invalidator
-            ));
-          } else {
-            ++ m_pool->m_counter;
-          }
+        }
 
+        if(record.resource.object != nullptr) {
+          return this->_return(provider::ResourceHandle<TResource>(
+            std::make_shared<AcquisitionProxyImpl>(record.resource, m_pool),
+            m_pool->m_invalidator
+          ));
         }
 
         return m_pool->m_provider->getAsync().callbackTo(&GetCoroutine::onGet);
@@ -338,11 +606,7 @@ protected:
       }
 
       async::Action handleError(oatpp::async::Error* error) override {
-        {
-          /* Careful!!! Using non-async lock */
-          std::lock_guard<std::mutex> guard(m_pool->m_lock);
-          -- m_pool->m_counter;
-        }
+        m_pool->releaseSlot();
         return error;
       }
 
@@ -379,8 +643,14 @@ public:
       }
 
       m_running = false;
-      m_counter -= static_cast<v_int64>(m_bench.size());
-      m_bench.clear();
+    }
+
+    for(std::size_t i = 0; i < m_shardsCount; i ++) {
+      auto& shard = m_shards[i];
+      std::lock_guard<std::mutex> guard(shard.lock);
+      m_counter -= shard.size;
+      shard.records.clear();
+      shard.size = 0;
     }
 
     m_condition.notify_all();
@@ -399,10 +669,35 @@ public:
   }
 
   v_int64 getCounter() {
-    std::lock_guard<std::mutex> guard(m_lock);
     return m_counter;
   }
 
+  v_int64 getIdleCount() {
+    v_int64 result = 0;
+    for(std::size_t i = 0; i < m_shardsCount; i ++) {
+      result += m_shards[i].size;
+    }
+    return result;
+  }
+
+  void setMinIdle(v_int64 minIdle) {
+    m_minIdle = minIdle;
+  }
+
+  v_int64 getMinIdle() {
+    return m_minIdle;
+  }
+
+  v_int64 prewarm(v_int64 count) {
+    return fillIdle(count);
+  }
+
+  void setValidator(const std::shared_ptr<Validator<TResource>>& validator, const std::chrono::duration<v_int64, std::micro>& interval) {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_validator = validator;
+    m_validationInterval = interval.count();
+  }
+
 };
 
 /**
@@ -490,6 +785,56 @@ public:
     return TPool::getCounter();
   }
 
+  /**
+   * Get count of idle resources - resources available in the pool and not acquired by anyone.
+   * @return
+   */
+  v_int64 getIdleCount() {
+    return TPool::getIdleCount();
+  }
+
+  /**
+   * Set min count of idle resources the pool should keep. <br>
+   * The pool maintenance task creates new resources in background when idle resources are acquired, expire by `maxResourceTTL`,
+   * or fail validation. The total count of resources is still limited by `maxResources`.
+   * @param minIdle - min count of idle resources. Default - `0`.
+   */
+  void setMinIdle(v_int64 minIdle) {
+    TPool::setMinIdle(minIdle);
+  }
+
+  /**
+   * Get min count of idle resources the pool should keep.
+   * @return
+   */
+  v_int64 getMinIdle() {
+    return TPool::getMinIdle();
+  }
+
+  /**
+   * Create resources on the calling thread until there are `count` idle resources in the pool
+   * or the pool is at its `maxResources`. <br>
+   * Use-case: warm up connections after the application start so that the first requests don't pay for connection setup.
+   * @param count - desired count of idle resources.
+   * @return - number of resources created.
+   */
+  v_int64 prewarm(v_int64 count) {
+    return TPool::prewarm(count);
+  }
+
+  /**
+   * Set validator for idle resources. <br>
+   * The pool maintenance task checks idle resources with the validator every `interval`
+   * and invalidates those which are not usable anymore, so they are not handed out on &l:Pool::get ();.
+   * @param validator - &id:oatpp::provider::Validator;. `nullptr` - disable validation.
+   * @param interval - interval between validation of idle resources.
+   */
+  void setValidator(const std::shared_ptr<Validator<TResource>>& validator,
+                    const std::chrono::duration<v_int64, std::micro>& interval = std::chrono::seconds(5))
+  {
+    TPool::setValidator(validator, interval);
+  }
+
 };
 
 }}
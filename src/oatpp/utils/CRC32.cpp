@@ -24,9 +24,186 @@
 
 #include "CRC32.hpp"
 
+#include "oatpp/utils/Cpu.hpp"
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  #include <immintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+  #include <arm_acle.h>
+  #include <cstring>
+#endif
+
 namespace oatpp { namespace utils {
   
 const p_uint32 CRC32::TABLE_04C11DB7 = generateTable(0x04C11DB7);
+
+namespace {
+
+/*
+ * Tables for slicing-by-8. table[0] is the regular byte-at-a-time table.
+ */
+struct SlicingTables {
+
+  v_uint32 table[8][256];
+
+  SlicingTables() {
+    p_uint32 base = CRC32::generateTable(0x04C11DB7);
+    for(v_uint32 i = 0; i < 256; i ++) {
+      table[0][i] = base[i];
+    }
+    delete [] base;
+    for(v_uint32 i = 0; i < 256; i ++) {
+      for(v_uint32 k = 1; k < 8; k ++) {
+        table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+      }
+    }
+  }
+
+};
+
+const SlicingTables& getSlicingTables() {
+  static const SlicingTables tables;
+  return tables;
+}
+
+v_uint32 updateSlicingBy8(v_uint32 crc, const v_char8* data, v_buff_size size) {
+
+  const auto& t = getSlicingTables().table;
+
+  while(size >= 8) {
+    v_uint32 one = (static_cast<v_uint32>(data[0]) | (static_cast<v_uint32>(data[1]) << 8) |
+                   (static_cast<v_uint32>(data[2]) << 16) | (static_cast<v_uint32>(data[3]) << 24)) ^ crc;
+    v_uint32 two = static_cast<v_uint32>(data[4]) | (static_cast<v_uint32>(data[5]) << 8) |
+                   (static_cast<v_uint32>(data[6]) << 16) | (static_cast<v_uint32>(data[7]) << 24);
+    crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+          t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+    data += 8;
+    size -= 8;
+  }
+
+  while(size > 0) {
+    crc = t[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    data ++;
+    size --;
+  }
+
+  return crc;
+
+}
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+
+/*
+ * CRC32 folding with carry-less multiplication.
+ * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction", Intel, 2009.
+ * Constants are for the bit-reflected 0x04C11DB7 polynomial.
+ * Requires size >= 64 and size % 16 == 0.
+ */
+GPP_ATTRIBUTE(target("pclmul,sse4.1"))
+v_uint32 updatePCLMUL(v_uint32 crc, const v_char8* data, v_buff_size size) {
+
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+  __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+  x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+  x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+  x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+  data += 64;
+  size -= 64;
+
+  // Fold 4 x 128 bits in parallel
+  while(size >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+
+    data += 64;
+    size -= 64;
+  }
+
+  // Fold 4 x 128 bits into 128 bits
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // Fold remaining 128-bit blocks
+  while(size >= 16) {
+    x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    data += 16;
+    size -= 16;
+  }
+
+  // Fold 128 bits into 64 bits
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction to 32 bits
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<v_uint32>(_mm_extract_epi32(x1, 1));
+
+}
+
+#elif defined(__ARM_FEATURE_CRC32)
+
+v_uint32 updateARMv8(v_uint32 crc, const v_char8* data, v_buff_size size) {
+  while(size >= 8) {
+    v_uint64 value;
+    std::memcpy(&value, data, 8);
+    crc = __crc32d(crc, value);
+    data += 8;
+    size -= 8;
+  }
+  while(size > 0) {
+    crc = __crc32b(crc, *data);
+    data ++;
+    size --;
+  }
+  return crc;
+}
+
+#endif
+
+}
   
 v_uint32 CRC32::bitReverse(v_uint32 poly) {
   v_uint32 result = 0;
@@ -62,16 +239,86 @@ p_uint32 CRC32::generateTable(v_uint32 poly) {
   
 }
   
+v_uint32 CRC32::update(v_uint32 crc, const void *buffer, v_buff_size size) {
+
+  auto data = reinterpret_cast<const v_char8*>(buffer);
+
+#if defined(OATPP_CPU_X86_DISPATCH)
+  if(size >= 64 && Cpu::hasPCLMUL() && Cpu::hasSSE41()) {
+    v_buff_size blocksSize = size & ~static_cast<v_buff_size>(15);
+    crc = updatePCLMUL(crc, data, blocksSize);
+    data += blocksSize;
+    size -= blocksSize;
+  }
+#elif defined(__ARM_FEATURE_CRC32)
+  return updateARMv8(crc, data, size);
+#endif
+
+  return updateSlicingBy8(crc, data, size);
+
+}
+
 v_uint32 CRC32::calc(const void *buffer, v_buff_size size, v_uint32 crc, v_uint32 initValue, v_uint32 xorOut, p_uint32 table) {
   
-  auto data = reinterpret_cast<const unsigned char*>(buffer);
   crc = crc ^ initValue;
-  
+
+  if(table == TABLE_04C11DB7) {
+    return update(crc, buffer, size) ^ xorOut;
+  }
+
+  auto data = reinterpret_cast<const unsigned char*>(buffer);
   for(v_buff_size i = 0; i < size; i++) {
     crc = table[(crc & 0xFF) ^ data[i]] ^ (crc >> 8);
   }
   
   return crc ^ xorOut;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CRC32::Processor
+
+CRC32::Processor::Processor(v_uint32 initValue, v_uint32 xorOut)
+  : m_crc(initValue)
+  , m_xorOut(xorOut)
+  , m_lastFlush(0)
+{}
+
+v_io_size CRC32::Processor::suggestInputStreamReadSize() {
+  return 32767;
+}
+
+v_int32 CRC32::Processor::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(dataIn.currBufferPtr != nullptr) {
+
+    if(m_lastFlush > 0) {
+      dataIn.inc(m_lastFlush);
+      m_lastFlush = 0;
+    }
+
+    if(dataIn.bytesLeft == 0) {
+      return Error::PROVIDE_DATA_IN;
+    }
+
+    m_crc = update(m_crc, dataIn.currBufferPtr, dataIn.bytesLeft);
+
+    dataOut = dataIn;
+    m_lastFlush = dataOut.bytesLeft;
+    return Error::FLUSH_DATA_OUT;
+
+  }
+
+  dataOut.set(nullptr, 0);
+  return Error::FINISHED;
+
+}
+
+v_uint32 CRC32::Processor::getValue() const {
+  return m_crc ^ m_xorOut;
+}
   
 }}
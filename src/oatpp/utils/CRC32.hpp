@@ -25,6 +25,7 @@
 #ifndef oatpp_utils_CRC32_hpp
 #define oatpp_utils_CRC32_hpp
 
+#include "oatpp/data/buffer/Processor.hpp"
 #include "oatpp/Environment.hpp"
 
 #include "oatpp/encoding/Hex.hpp"
@@ -32,9 +33,57 @@
 namespace oatpp { namespace utils {
 
 /**
- * Implementation of CRC-32. Cyclic redundancy check algorithm.
+ * Implementation of CRC-32. Cyclic redundancy check algorithm. <br>
+ * For the default table (&l:CRC32::TABLE_04C11DB7;) uses PCLMULQDQ folding or ARMv8 CRC instructions when available,
+ * and slicing-by-8 otherwise.
  */
 class CRC32 {
+public:
+
+  /**
+   * Buffer processor which calculates CRC32 of the data passing through it. <br>
+   * Data is passed to the output unchanged, so the processor can be a part of &id:oatpp::data::buffer::ProcessingPipeline;
+   * or used in &id:oatpp::data::stream::transfer; to checksum data without a second pass.
+   */
+  class Processor : public oatpp::data::buffer::Processor {
+  private:
+    v_uint32 m_crc;
+    v_uint32 m_xorOut;
+    v_buff_size m_lastFlush;
+  public:
+
+    /**
+     * Constructor.
+     * @param initValue
+     * @param xorOut
+     */
+    Processor(v_uint32 initValue = 0xFFFFFFFF, v_uint32 xorOut = 0xFFFFFFFF);
+
+    /**
+     * If the client is using the input stream to read data and add it to the processor,
+     * the client MAY ask the processor for a suggested read size.
+     * @return - suggested read size.
+     */
+    v_io_size suggestInputStreamReadSize() override;
+
+    /**
+     * Process data.
+     * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+     * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+     * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+     * @return - &id:oatpp::data::buffer::Processor::Error;.
+     */
+    v_int32 iterate(data::buffer::InlineReadData& dataIn,
+                    data::buffer::InlineReadData& dataOut) override;
+
+    /**
+     * Get CRC32 value of the data processed so far.
+     * @return - CRC32 value (v_uint32)
+     */
+    v_uint32 getValue() const;
+
+  };
+
 public:
 
   /**
@@ -61,7 +110,17 @@ public:
    * @return - CRC32 value (v_uint32)
    */
   static v_uint32 calc(const void *buffer, v_buff_size size, v_uint32 crc = 0, v_uint32 initValue = 0xFFFFFFFF, v_uint32 xorOut = 0xFFFFFFFF, p_uint32 table = TABLE_04C11DB7);
-  
+
+  /**
+   * Incremental update of the raw (not finalized) CRC32 register with the default &l:CRC32::TABLE_04C11DB7;. <br>
+   * Start with `initValue` and apply `xorOut` to the result of the last update to get the CRC32 value.
+   * @param crc - current register value.
+   * @param buffer
+   * @param size
+   * @return - updated register value.
+   */
+  static v_uint32 update(v_uint32 crc, const void *buffer, v_buff_size size);
+
 };
     
 }}
@@ -25,9 +25,165 @@
 #include "Conversion.hpp"
 
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__has_include)
+  #if __has_include(<charconv>)
+    #include <charconv>
+  #endif
+#endif
 
 namespace oatpp { namespace utils {
-  
+
+namespace {
+
+const char DIGIT_PAIRS[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/*
+ * Write decimal digits of value to the end of the buffer (two digits per step).
+ * Returns pointer to the first digit.
+ */
+char* writeDigitsBackward(v_uint64 value, char* end) {
+  char* p = end;
+  while(value >= 100) {
+    v_uint64 index = (value % 100) * 2;
+    value /= 100;
+    p -= 2;
+    p[0] = DIGIT_PAIRS[index];
+    p[1] = DIGIT_PAIRS[index + 1];
+  }
+  if(value >= 10) {
+    v_uint64 index = value * 2;
+    p -= 2;
+    p[0] = DIGIT_PAIRS[index];
+    p[1] = DIGIT_PAIRS[index + 1];
+  } else {
+    *--p = static_cast<char>('0' + value);
+  }
+  return p;
+}
+
+/*
+ * Copy the formatted number to the user buffer the same way snprintf does -
+ * result is always null-terminated (if n > 0) and the full length is returned.
+ */
+v_buff_size copyTerminated(const char* str, v_buff_size size, p_char8 data, v_buff_size n) {
+  if(n > 0) {
+    v_buff_size count = size < n ? size : n - 1;
+    std::memcpy(data, str, static_cast<size_t>(count));
+    data[count] = 0;
+  }
+  return size;
+}
+
+v_buff_size unsignedToCharSequence(v_uint64 value, p_char8 data, v_buff_size n) {
+  char buff[24];
+  char* end = buff + 24;
+  char* start = writeDigitsBackward(value, end);
+  return copyTerminated(start, end - start, data, n);
+}
+
+v_buff_size signedToCharSequence(v_int64 value, p_char8 data, v_buff_size n) {
+  char buff[24];
+  char* end = buff + 24;
+  char* start;
+  if(value < 0) {
+    start = writeDigitsBackward(0 - static_cast<v_uint64>(value), end);
+    *--start = '-';
+  } else {
+    start = writeDigitsBackward(static_cast<v_uint64>(value), end);
+  }
+  return copyTerminated(start, end - start, data, n);
+}
+
+template<typename T>
+v_buff_size floatToCharSequence(T value, p_char8 data, v_buff_size n) {
+#if defined(__cpp_lib_to_chars)
+  char buff[128];
+  auto res = std::to_chars(buff, buff + 128, value);
+  if(res.ec == std::errc()) {
+    return copyTerminated(buff, res.ptr - buff, data, n);
+  }
+#endif
+  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n),
+                  std::numeric_limits<T>::digits10 > 6 ? "%.17g" : "%.9g", static_cast<double>(value));
+}
+
+}
+
+v_buff_size Conversion::charSequenceToInt64(const char* data, v_buff_size size, v_int64& value) {
+
+  v_buff_size pos = 0;
+  bool negative = false;
+
+  if(pos < size && (data[pos] == '-' || data[pos] == '+')) {
+    negative = data[pos] == '-';
+    pos ++;
+  }
+
+  v_buff_size digitsStart = pos;
+  v_uint64 limit = negative ? static_cast<v_uint64>(std::numeric_limits<v_int64>::max()) + 1 : static_cast<v_uint64>(std::numeric_limits<v_int64>::max());
+  v_uint64 result = 0;
+  bool overflow = false;
+
+  while(pos < size) {
+    v_uint64 digit = static_cast<v_uint64>(static_cast<v_char8>(data[pos]) - '0');
+    if(digit > 9) {
+      break;
+    }
+    if(!overflow) {
+      if(result > (limit - digit) / 10) {
+        overflow = true;
+        result = limit;
+      } else {
+        result = result * 10 + digit;
+      }
+    }
+    pos ++;
+  }
+
+  if(pos == digitsStart) {
+    value = 0;
+    return 0;
+  }
+
+  value = negative ? static_cast<v_int64>(0 - result) : static_cast<v_int64>(result);
+  return pos;
+
+}
+
+v_buff_size Conversion::charSequenceToFloat64(const char* data, v_buff_size size, v_float64& value) {
+#if defined(__cpp_lib_to_chars)
+  const char* begin = data;
+  const char* end = data + size;
+  if(begin < end && *begin == '+') {
+    // from_chars doesn't accept leading '+'. Leave it to strtod.
+    return 0;
+  }
+  auto res = std::from_chars(begin, end, value);
+  if(res.ec == std::errc()) {
+    return res.ptr - begin;
+  }
+#else
+  (void) data;
+  (void) size;
+  (void) value;
+#endif
+  return 0;
+}
+
+
 v_int32 Conversion::strToInt32(const char* str){
   char* end;
   return static_cast<v_int32>(std::strtol(str, &end, 10));
@@ -70,6 +226,12 @@ v_int64 Conversion::strToInt64(const oatpp::String& str, bool& success){
     success = false;
     return 0;
   }
+  v_int64 fastResult;
+  auto size = static_cast<v_buff_size>(str->size());
+  if(charSequenceToInt64(str->data(), size, fastResult) == size) {
+    success = true;
+    return fastResult;
+  }
   char* end;
   v_int64 result = std::strtoll(str->data(), &end, 10);
   success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
@@ -93,19 +255,19 @@ v_uint64 Conversion::strToUInt64(const oatpp::String& str, bool& success){
 }
 
 v_buff_size Conversion::int32ToCharSequence(v_int32 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%ld", static_cast<long>(value));
+  return signedToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::uint32ToCharSequence(v_uint32 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%lu", static_cast<unsigned long>(value));
+  return unsignedToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::int64ToCharSequence(v_int64 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%lld", static_cast<long long int>(value));
+  return signedToCharSequence(value, data, n);
 }
 
 v_buff_size Conversion::uint64ToCharSequence(v_uint64 value, p_char8 data, v_buff_size n) {
-  return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), "%llu", static_cast<long long unsigned int>(value));
+  return unsignedToCharSequence(value, data, n);
 }
 
 oatpp::String Conversion::int32ToStr(v_int32 value){
@@ -206,6 +368,12 @@ v_float64 Conversion::strToFloat64(const oatpp::String& str, bool& success) {
     success = false;
     return 0;
   }
+  v_float64 fastResult;
+  auto size = static_cast<v_buff_size>(str->size());
+  if(charSequenceToFloat64(str->data(), size, fastResult) == size) {
+    success = true;
+    return fastResult;
+  }
   char* end;
   v_float64 result = std::strtod(str->data(), &end);
   success = ((reinterpret_cast<v_buff_size>(end) - reinterpret_cast<v_buff_size>(str->data())) == static_cast<v_buff_size>(str->size()));
@@ -213,10 +381,16 @@ v_float64 Conversion::strToFloat64(const oatpp::String& str, bool& success) {
 }
 
 v_buff_size Conversion::float32ToCharSequence(v_float32 value, p_char8 data, v_buff_size n, const char* format) {
+  if(format == nullptr) {
+    return floatToCharSequence(value, data, n);
+  }
   return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), format, static_cast<double>(value));
 }
 
 v_buff_size Conversion::float64ToCharSequence(v_float64 value, p_char8 data, v_buff_size n, const char* format) {
+  if(format == nullptr) {
+    return floatToCharSequence(value, data, n);
+  }
   return snprintf(reinterpret_cast<char*>(data), static_cast<size_t>(n), format, value);
 }
 
@@ -102,6 +102,27 @@ public:
    */
   static v_uint64 strToUInt64(const oatpp::String &str, bool &success);
 
+  /**
+   * Parse decimal 64-bit integer from the char sequence. <br>
+   * Accepts optional sign followed by decimal digits. The sequence doesn't have to be null-terminated.
+   * @param data - pointer to the char sequence.
+   * @param size - size of the char sequence.
+   * @param value - out parameter. Parsed value. On overflow the value is clamped (same as `std::strtoll`).
+   * @return - number of chars consumed. `0` if the sequence doesn't start with a number.
+   */
+  static v_buff_size charSequenceToInt64(const char* data, v_buff_size size, v_int64& value);
+
+  /**
+   * Parse decimal 64-bit float from the char sequence without going through `std::strtod` where possible. <br>
+   * The sequence doesn't have to be null-terminated.
+   * @param data - pointer to the char sequence.
+   * @param size - size of the char sequence.
+   * @param value - out parameter. Parsed value.
+   * @return - number of chars consumed. `0` if the sequence can't be parsed by the fast parser
+   * (in this case use &l:Conversion::strToFloat64 ();).
+   */
+  static v_buff_size charSequenceToFloat64(const char* data, v_buff_size size, v_float64& value);
+
   /**
    * Convert 32-bit integer to it's string representation.
    * @param value - 32-bit integer value.
@@ -260,6 +281,7 @@ public:
    * @param value - 32-bit float value.
    * @param data - buffer to write data to.
    * @param n - buffer size.
+   * @param format - `printf` format. `nullptr` - shortest representation which converts back to the same value.
    * @return - length of the resultant string.
    */
   static v_buff_size float32ToCharSequence(v_float32 value, p_char8 data, v_buff_size n, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -269,6 +291,7 @@ public:
    * @param value - 64-bit float value.
    * @param data - buffer to write data to.
    * @param n - buffer size.
+   * @param format - `printf` format. `nullptr` - shortest representation which converts back to the same value.
    * @return - length of the resultant string.
    */
   static v_buff_size float64ToCharSequence(v_float64 value, p_char8 data, v_buff_size n, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -276,6 +299,7 @@ public:
   /**
    * Convert 32-bit float to it's string representation.
    * @param value - 32-bit float value.
+   * @param format - `printf` format. `nullptr` - shortest representation which converts back to the same value.
    * @return - value as `oatpp::String`
    */
   static oatpp::String float32ToStr(v_float32 value, const char *format = OATPP_FLOAT_STRING_FORMAT);
@@ -283,6 +307,7 @@ public:
   /**
    * Convert 64-bit float to it's string representation.
    * @param value - 64-bit float value.
+   * @param format - `printf` format. `nullptr` - shortest representation which converts back to the same value.
    * @return - value as `oatpp::String`
    */
   static oatpp::String float64ToStr(v_float64 value, const char *format = OATPP_FLOAT_STRING_FORMAT);
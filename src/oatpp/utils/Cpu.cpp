@@ -0,0 +1,47 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Cpu.hpp"
+
+namespace oatpp { namespace utils {
+
+const Cpu::Features& Cpu::getFeatures() {
+
+  static const Features features = [] {
+    Features result;
+#if defined(OATPP_CPU_X86_DISPATCH)
+    __builtin_cpu_init();
+    result.ssse3 = __builtin_cpu_supports("ssse3");
+    result.sse41 = __builtin_cpu_supports("sse4.1");
+    result.avx2 = __builtin_cpu_supports("avx2");
+    result.pclmul = __builtin_cpu_supports("pclmul");
+#endif
+    return result;
+  }();
+
+  return features;
+
+}
+
+}}
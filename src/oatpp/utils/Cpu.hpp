@@ -0,0 +1,93 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_utils_Cpu_hpp
+#define oatpp_utils_Cpu_hpp
+
+#include "oatpp/base/Compiler.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  /**
+   * Defined when x86 SIMD code paths are compiled in and selected at runtime.
+   */
+  #define OATPP_CPU_X86_DISPATCH
+#endif
+
+namespace oatpp { namespace utils {
+
+/**
+ * Runtime CPU features detection. <br>
+ * Used to select SIMD-accelerated code paths. Results are detected once and cached.
+ */
+class Cpu {
+private:
+
+  struct Features {
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool avx2 = false;
+    bool pclmul = false;
+  };
+
+  static const Features& getFeatures();
+
+public:
+
+  /**
+   * Check if CPU supports SSSE3 instructions.
+   * @return
+   */
+  static bool hasSSSE3() {
+    return getFeatures().ssse3;
+  }
+
+  /**
+   * Check if CPU supports SSE4.1 instructions.
+   * @return
+   */
+  static bool hasSSE41() {
+    return getFeatures().sse41;
+  }
+
+  /**
+   * Check if CPU supports carry-less multiplication (PCLMULQDQ) instruction.
+   * @return
+   */
+  static bool hasPCLMUL() {
+    return getFeatures().pclmul;
+  }
+
+  /**
+   * Check if CPU (and OS) supports AVX2 instructions.
+   * @return
+   */
+  static bool hasAVX2() {
+    return getFeatures().avx2;
+  }
+
+};
+
+}}
+
+#endif // oatpp_utils_Cpu_hpp
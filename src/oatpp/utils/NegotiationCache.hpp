@@ -0,0 +1,166 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_utils_NegotiationCache_hpp
+#define oatpp_utils_NegotiationCache_hpp
+
+#include "oatpp/Environment.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace oatpp { namespace utils {
+
+/**
+ * Memoized result of content negotiation by the raw header value (`Accept`, `Accept-Encoding`). <br>
+ * Clients send only a handful of distinct header values, so negotiation becomes one hash probe. <br>
+ * Results are kept in a small direct-mapped per-thread table - lookups take no locks and
+ * don't touch shared memory other than the generation counter. <br>
+ * Slots hold results by `std::weak_ptr` - the table never extends lifetime of negotiated objects
+ * (mappers, encoder providers) beyond the lifetime of their owners.
+ * Call &l:NegotiationCache::invalidate (); whenever the set of negotiated candidates changes.
+ * @tparam T - type of the negotiation result.
+ */
+template<class T>
+class NegotiationCache {
+public:
+
+  /**
+   * Number of slots in the per-thread table.
+   */
+  static constexpr v_buff_size SLOTS_COUNT = 64;
+
+  /**
+   * Header values longer than this are negotiated without the cache.
+   */
+  static constexpr v_buff_size MAX_KEY_SIZE = 512;
+
+private:
+
+  struct Slot {
+    v_uint64 cacheId = 0;
+    v_uint64 generation = 0;
+    std::size_t hash = 0;
+    std::string key;
+    bool hasValue = false;
+    std::weak_ptr<T> value;
+  };
+
+private:
+
+  static v_uint64 nextCacheId() {
+    static std::atomic<v_uint64> counter(0);
+    return ++ counter;
+  }
+
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  static Slot* getThreadSlots() {
+    static thread_local Slot slots[SLOTS_COUNT];
+    return slots;
+  }
+#endif
+
+private:
+  const v_uint64 m_id;
+  std::atomic<v_uint64> m_generation;
+public:
+
+  /**
+   * Constructor.
+   */
+  NegotiationCache()
+    : m_id(nextCacheId())
+    , m_generation(1)
+  {}
+
+  NegotiationCache(const NegotiationCache&) = delete;
+  NegotiationCache& operator=(const NegotiationCache&) = delete;
+
+  /**
+   * Invalidate all memoized results. <br>
+   * Must be called after the change of the negotiated candidates is visible to `negotiate` function.
+   */
+  void invalidate() {
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  /**
+   * Get memoized negotiation result or negotiate and memoize.
+   * @tparam F - negotiate function type.
+   * @param data - pointer to header value.
+   * @param size - size of header value.
+   * @param negotiate - function returning `std::shared_ptr<T>` result of negotiation.
+   * @return - result of negotiation.
+   */
+  template<typename F>
+  std::shared_ptr<T> get(const char* data, v_buff_size size, const F& negotiate) const {
+
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+
+    if(size <= MAX_KEY_SIZE) {
+
+      auto generation = m_generation.load(std::memory_order_acquire);
+      std::string_view key(data, static_cast<size_t>(size));
+      auto hash = std::hash<std::string_view>{}(key);
+
+      auto& slot = getThreadSlots()[(hash ^ static_cast<std::size_t>(m_id * 0x9E3779B97F4A7C15ULL)) % static_cast<std::size_t>(SLOTS_COUNT)];
+
+      if(slot.cacheId == m_id && slot.generation == generation && slot.hash == hash && slot.key == key) {
+        if(!slot.hasValue) {
+          return nullptr;
+        }
+        auto value = slot.value.lock();
+        if(value) {
+          return value;
+        }
+        /* negotiated object is gone - negotiate again */
+      }
+
+      auto value = negotiate();
+
+      slot.cacheId = m_id;
+      slot.generation = generation;
+      slot.hash = hash;
+      slot.key.assign(data, static_cast<size_t>(size));
+      slot.hasValue = (value != nullptr);
+      slot.value = value;
+
+      return value;
+
+    }
+
+#endif
+
+    return negotiate();
+
+  }
+
+};
+
+}}
+
+#endif // oatpp_utils_NegotiationCache_hpp
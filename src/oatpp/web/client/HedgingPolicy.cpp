@@ -0,0 +1,129 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HedgingPolicy.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace oatpp { namespace web { namespace client {
+
+HedgingPolicy::HedgingPolicy(const std::chrono::duration<v_int64, std::micro>& delay)
+  : m_adaptive(false)
+  , m_percentile(0)
+  , m_minDelay(delay.count())
+  , m_maxDelay(delay.count())
+  , m_samples{}
+  , m_samplesCount(0)
+  , m_delay(delay.count())
+  , m_hedges(0)
+  , m_hedgeWins(0)
+{}
+
+HedgingPolicy::HedgingPolicy(v_float64 percentile,
+                             const std::chrono::duration<v_int64, std::micro>& minDelay,
+                             const std::chrono::duration<v_int64, std::micro>& maxDelay)
+  : m_adaptive(true)
+  , m_percentile(percentile)
+  , m_minDelay(minDelay.count())
+  , m_maxDelay(maxDelay.count())
+  , m_samples{}
+  , m_samplesCount(0)
+  , m_delay(maxDelay.count())
+  , m_hedges(0)
+  , m_hedgeWins(0)
+{
+  if(percentile <= 0 || percentile > 1) {
+    throw std::runtime_error("[oatpp::web::client::HedgingPolicy::HedgingPolicy()]: Error. Percentile should be in range (0, 1].");
+  }
+  if(m_minDelay > m_maxDelay) {
+    throw std::runtime_error("[oatpp::web::client::HedgingPolicy::HedgingPolicy()]: Error. minDelay > maxDelay.");
+  }
+}
+
+std::shared_ptr<HedgingPolicy> HedgingPolicy::createShared(const std::chrono::duration<v_int64, std::micro>& delay) {
+  return std::make_shared<HedgingPolicy>(delay);
+}
+
+std::shared_ptr<HedgingPolicy> HedgingPolicy::createShared(v_float64 percentile,
+                                                           const std::chrono::duration<v_int64, std::micro>& minDelay,
+                                                           const std::chrono::duration<v_int64, std::micro>& maxDelay)
+{
+  return std::make_shared<HedgingPolicy>(percentile, minDelay, maxDelay);
+}
+
+bool HedgingPolicy::canHedge(const oatpp::String& method) {
+  return method == "GET" || method == "HEAD" || method == "OPTIONS" ||
+         method == "PUT" || method == "DELETE" || method == "TRACE";
+}
+
+v_int64 HedgingPolicy::getDelayMicroseconds() const {
+  return m_delay.load(std::memory_order_relaxed);
+}
+
+void HedgingPolicy::recordLatency(v_int64 latencyMicroseconds) {
+
+  if(!m_adaptive) {
+    return;
+  }
+
+  v_int64 window[LATENCY_WINDOW];
+  v_int64 count;
+
+  {
+    std::lock_guard<concurrency::SpinLock> lock(m_lock);
+    m_samples[m_samplesCount % LATENCY_WINDOW] = latencyMicroseconds;
+    m_samplesCount ++;
+    if(m_samplesCount % RECOMPUTE_INTERVAL != 0) {
+      return;
+    }
+    count = std::min<v_int64>(m_samplesCount, LATENCY_WINDOW);
+    std::copy(m_samples, m_samples + count, window);
+  }
+
+  auto index = static_cast<v_int64>(m_percentile * static_cast<v_float64>(count - 1));
+  std::nth_element(window, window + index, window + count);
+
+  m_delay.store(std::max(m_minDelay, std::min(m_maxDelay, window[index])), std::memory_order_relaxed);
+
+}
+
+void HedgingPolicy::onHedge() {
+  m_hedges.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HedgingPolicy::onHedgeWin() {
+  m_hedgeWins.fetch_add(1, std::memory_order_relaxed);
+}
+
+v_int64 HedgingPolicy::getHedgesCount() const {
+  return m_hedges.load(std::memory_order_relaxed);
+}
+
+v_int64 HedgingPolicy::getHedgeWinsCount() const {
+  return m_hedgeWins.load(std::memory_order_relaxed);
+}
+
+}}}
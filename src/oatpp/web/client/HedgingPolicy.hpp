@@ -0,0 +1,158 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_client_HedgingPolicy_hpp
+#define oatpp_web_client_HedgingPolicy_hpp
+
+#include "oatpp/concurrency/SpinLock.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace oatpp { namespace web { namespace client {
+
+/**
+ * Hedging policy for &id:oatpp::web::client::RequestExecutor;. <br>
+ * If the response for an idempotent request didn't arrive within the hedging delay,
+ * the executor sends a second (hedged) attempt over another connection, takes whichever response
+ * comes first and invalidates the connection of the loser. <br>
+ * The delay is either fixed, or adaptive - the given percentile of the recently observed latencies.
+ */
+class HedgingPolicy {
+public:
+
+  /**
+   * Number of latency samples kept by adaptive policy.
+   */
+  static constexpr v_int32 LATENCY_WINDOW = 128;
+
+  /**
+   * Adaptive delay is recomputed once per this number of samples.
+   */
+  static constexpr v_int32 RECOMPUTE_INTERVAL = 16;
+
+private:
+  bool m_adaptive;
+  v_float64 m_percentile;
+  v_int64 m_minDelay;
+  v_int64 m_maxDelay;
+private:
+  concurrency::SpinLock m_lock;
+  v_int64 m_samples[LATENCY_WINDOW];
+  v_int64 m_samplesCount;
+  std::atomic<v_int64> m_delay;
+private:
+  std::atomic<v_int64> m_hedges;
+  std::atomic<v_int64> m_hedgeWins;
+public:
+
+  /**
+   * Constructor. Fixed delay policy.
+   * @param delay - hedging delay.
+   */
+  HedgingPolicy(const std::chrono::duration<v_int64, std::micro>& delay);
+
+  /**
+   * Constructor. Adaptive delay policy. <br>
+   * Until there are enough samples collected the `maxDelay` is used.
+   * @param percentile - latency percentile to hedge at. Ex.: `0.95`.
+   * @param minDelay - lower bound for the delay.
+   * @param maxDelay - upper bound for the delay.
+   */
+  HedgingPolicy(v_float64 percentile,
+                const std::chrono::duration<v_int64, std::micro>& minDelay,
+                const std::chrono::duration<v_int64, std::micro>& maxDelay);
+
+  /**
+   * Create shared fixed delay HedgingPolicy.
+   * @param delay - hedging delay.
+   * @return - `std::shared_ptr` to HedgingPolicy.
+   */
+  static std::shared_ptr<HedgingPolicy> createShared(const std::chrono::duration<v_int64, std::micro>& delay);
+
+  /**
+   * Create shared adaptive HedgingPolicy.
+   * @param percentile - latency percentile to hedge at. Ex.: `0.95`.
+   * @param minDelay - lower bound for the delay.
+   * @param maxDelay - upper bound for the delay.
+   * @return - `std::shared_ptr` to HedgingPolicy.
+   */
+  static std::shared_ptr<HedgingPolicy> createShared(v_float64 percentile,
+                                                     const std::chrono::duration<v_int64, std::micro>& minDelay,
+                                                     const std::chrono::duration<v_int64, std::micro>& maxDelay);
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~HedgingPolicy() = default;
+
+  /**
+   * Check if request can be hedged. <br>
+   * Default implementation allows hedging of idempotent methods only - GET, HEAD, OPTIONS, PUT, DELETE, TRACE.
+   * @param method - request method.
+   * @return - `true` if request can be hedged.
+   */
+  virtual bool canHedge(const oatpp::String& method);
+
+  /**
+   * Get current hedging delay.
+   * @return - delay in microseconds.
+   */
+  v_int64 getDelayMicroseconds() const;
+
+  /**
+   * Record latency of the completed request. Used by adaptive policy.
+   * @param latencyMicroseconds - latency in microseconds.
+   */
+  void recordLatency(v_int64 latencyMicroseconds);
+
+  /**
+   * Called by executor when hedged attempt is sent.
+   */
+  void onHedge();
+
+  /**
+   * Called by executor when hedged attempt wins.
+   */
+  void onHedgeWin();
+
+  /**
+   * Get number of hedged attempts sent.
+   * @return - number of hedged attempts.
+   */
+  v_int64 getHedgesCount() const;
+
+  /**
+   * Get number of hedged attempts which won over the original attempt.
+   * @return - number of hedge wins.
+   */
+  v_int64 getHedgeWinsCount() const;
+
+};
+
+}}}
+
+#endif // oatpp_web_client_HedgingPolicy_hpp
@@ -0,0 +1,564 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpPipeline.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+namespace oatpp { namespace web { namespace client {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpPipeline::BodyReader
+
+/*
+ * Reads exactly one response body off the connection according to its framing
+ * (Content-Length, chunked, or until connection is closed) and removes transfer-encoding.
+ * Content-Encoding is left untouched - it's up to the BodyDecoder.
+ */
+class HttpPipeline::BodyReader {
+private:
+  typedef oatpp::web::protocol::http::Header Header;
+private:
+  static constexpr v_buff_size READ_CHUNK_SIZE = 4096;
+  static constexpr v_buff_size MAX_LINE_SIZE = 4096;
+public:
+
+  enum class State : v_int32 {
+    CHUNK_SIZE = 0,
+    CHUNK_DATA = 1,
+    CHUNK_END = 2,
+    TRAILERS = 3,
+    FIXED = 4,
+    UNTIL_EOF = 5,
+    DONE = 6
+  };
+
+private:
+  v_int64 m_maxBodySize;
+  State m_state;
+  bool m_hasBody;
+  v_int64 m_remaining;
+  std::string m_line;
+  oatpp::data::stream::BufferOutputStream m_body;
+private:
+
+  /*
+   * Read line ending with '\n'. `complete` is set to `true` once the whole line is read to m_line (without CRLF).
+   */
+  v_io_size readLine(data::stream::InputStreamBufferedProxy* stream, async::Action& action, bool& complete) {
+
+    v_char8 buffer[128];
+    auto res = stream->peek(buffer, 128, action);
+    complete = false;
+
+    if(res > 0) {
+
+      v_buff_size i = 0;
+      for(; i < res; i ++) {
+        if(buffer[i] == '\n') {
+          complete = true;
+          break;
+        }
+      }
+
+      m_line.append(reinterpret_cast<const char*>(buffer), static_cast<size_t>(i));
+      stream->commitReadOffset(complete ? i + 1 : i);
+
+      if(complete && !m_line.empty() && m_line.back() == '\r') {
+        m_line.pop_back();
+      }
+
+      if(static_cast<v_buff_size>(m_line.size()) > MAX_LINE_SIZE) {
+        throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::readLine()]: Error. Line is too long.");
+      }
+
+    }
+
+    return res;
+
+  }
+
+  v_io_size readData(data::stream::InputStreamBufferedProxy* stream, async::Action& action, v_buff_size desired) {
+    m_body.reserveBytesUpfront(desired);
+    auto res = stream->read(m_body.getData() + m_body.getCurrentPosition(), desired, action);
+    if(res > 0) {
+      m_body.setCurrentPosition(m_body.getCurrentPosition() + res);
+      checkBodySize(0);
+    }
+    return res;
+  }
+
+  void checkBodySize(v_int64 expected) {
+    if(m_maxBodySize > 0 && m_body.getCurrentPosition() + expected > m_maxBodySize) {
+      throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::checkBodySize()]: Error. Body is too large.");
+    }
+  }
+
+  static v_int64 parseChunkSize(const std::string& line) {
+    v_int64 result = 0;
+    size_t i = 0;
+    for(; i < line.size(); i ++) {
+      char a = line[i];
+      v_int64 digit;
+      if(a >= '0' && a <= '9') digit = a - '0';
+      else if(a >= 'a' && a <= 'f') digit = a - 'a' + 10;
+      else if(a >= 'A' && a <= 'F') digit = a - 'A' + 10;
+      else break;
+      if(result > (std::numeric_limits<v_int64>::max() >> 4)) {
+        throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::parseChunkSize()]: Error. Chunk size is too big.");
+      }
+      result = (result << 4) | digit;
+    }
+    if(i == 0 || (i < line.size() && line[i] != ';' && line[i] != ' ' && line[i] != '\t')) {
+      throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::parseChunkSize()]: Error. Invalid chunk size.");
+    }
+    return result;
+  }
+
+public:
+
+  BodyReader(v_int64 maxBodySize)
+    : m_maxBodySize(maxBodySize)
+    , m_state(State::DONE)
+    , m_hasBody(false)
+    , m_remaining(0)
+  {}
+
+  void init(const protocol::http::Headers& headers, v_int32 statusCode, bool headRequest) {
+
+    if(headRequest || statusCode / 100 == 1 || statusCode == 204 || statusCode == 304) {
+      m_state = State::DONE;
+      m_hasBody = false;
+      return;
+    }
+
+    m_hasBody = true;
+
+    auto transferEncoding = headers.getAsMemoryLabel<data::share::StringKeyLabelCI>(Header::TRANSFER_ENCODING);
+    if(transferEncoding) {
+      if(transferEncoding != Header::Value::TRANSFER_ENCODING_CHUNKED) {
+        throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::init()]: Error. Unsupported Transfer-Encoding.");
+      }
+      m_state = State::CHUNK_SIZE;
+      return;
+    }
+
+    auto contentLength = headers.get(Header::CONTENT_LENGTH);
+    if(contentLength) {
+      bool success;
+      m_remaining = utils::Conversion::strToInt64(contentLength, success);
+      if(!success || m_remaining < 0) {
+        throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::init()]: Error. Invalid Content-Length.");
+      }
+      checkBodySize(m_remaining);
+      m_state = m_remaining > 0 ? State::FIXED : State::DONE;
+      return;
+    }
+
+    m_state = State::UNTIL_EOF;
+
+  }
+
+  v_io_size iterate(data::stream::InputStreamBufferedProxy* stream, async::Action& action) {
+
+    bool complete;
+
+    switch(m_state) {
+
+      case State::CHUNK_SIZE: {
+        auto res = readLine(stream, action, complete);
+        if(complete) {
+          m_remaining = parseChunkSize(m_line);
+          m_line.clear();
+          checkBodySize(m_remaining);
+          m_state = m_remaining > 0 ? State::CHUNK_DATA : State::TRAILERS;
+        }
+        return res;
+      }
+
+      case State::CHUNK_DATA: {
+        auto res = readData(stream, action, std::min<v_int64>(m_remaining, READ_CHUNK_SIZE));
+        if(res > 0) {
+          m_remaining -= res;
+          if(m_remaining == 0) {
+            m_state = State::CHUNK_END;
+          }
+        }
+        return res;
+      }
+
+      case State::CHUNK_END: {
+        auto res = readLine(stream, action, complete);
+        if(complete) {
+          if(!m_line.empty()) {
+            throw std::runtime_error("[oatpp::web::client::HttpPipeline::BodyReader::iterate()]: Error. Invalid chunk end.");
+          }
+          m_state = State::CHUNK_SIZE;
+        }
+        return res;
+      }
+
+      case State::TRAILERS: {
+        auto res = readLine(stream, action, complete);
+        if(complete) {
+          if(m_line.empty()) {
+            m_state = State::DONE;
+          }
+          m_line.clear();
+        }
+        return res;
+      }
+
+      case State::FIXED: {
+        auto res = readData(stream, action, std::min<v_int64>(m_remaining, READ_CHUNK_SIZE));
+        if(res > 0) {
+          m_remaining -= res;
+          if(m_remaining == 0) {
+            m_state = State::DONE;
+          }
+        }
+        return res;
+      }
+
+      case State::UNTIL_EOF: {
+        auto res = readData(stream, action, READ_CHUNK_SIZE);
+        if(res == IOError::ZERO_VALUE || res == IOError::BROKEN_PIPE) {
+          m_state = State::DONE;
+          return 1;
+        }
+        return res;
+      }
+
+      case State::DONE:
+      default:
+        return 0;
+
+    }
+
+  }
+
+  bool isDone() const {
+    return m_state == State::DONE;
+  }
+
+  bool hasBody() const {
+    return m_hasBody;
+  }
+
+  oatpp::String getBody() {
+    return m_body.toString();
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpPipeline
+
+HttpPipeline::HttpPipeline(const std::shared_ptr<data::stream::IOStream>& connection,
+                           const Invalidator& invalidator,
+                           v_int64 maxInFlight,
+                           v_int64 maxBodySize)
+  : m_connection(connection)
+  , m_invalidator(invalidator)
+  , m_maxInFlight(maxInFlight > 0 ? maxInFlight : 1)
+  , m_maxBodySize(maxBodySize)
+  , m_writeBuffer(std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0))
+  , m_inStream(data::stream::InputStreamBufferedProxy::createShared(connection, std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0)))
+  , m_headersReader(std::make_shared<std::string>(data::buffer::IOBuffer::BUFFER_SIZE, 0), 4096)
+  , m_nextTicket(0)
+  , m_writeTurn(0)
+  , m_readTurn(0)
+  , m_failed(false)
+  , m_ioModeSet(false)
+  , m_ioMode(data::stream::IOMode::BLOCKING)
+{}
+
+void HttpPipeline::notifyAll() {
+  m_condition.notify_all();
+  m_asyncCondition.notifyAll();
+}
+
+bool HttpPipeline::canWrite(v_int64 ticket) const {
+  return m_failed || (m_writeTurn == ticket && ticket < m_readTurn + m_maxInFlight);
+}
+
+bool HttpPipeline::canRead(v_int64 ticket) const {
+  return m_failed || m_readTurn == ticket;
+}
+
+std::shared_ptr<data::stream::IOStream> HttpPipeline::getConnection() const {
+  return m_connection;
+}
+
+oatpp::data::share::MemoryLabel HttpPipeline::getWriteBuffer() const {
+  return m_writeBuffer;
+}
+
+bool HttpPipeline::setIOMode(data::stream::IOMode ioMode) {
+  std::lock_guard<oatpp::async::Lock> lock(m_lock);
+  if(m_ioModeSet) {
+    return m_ioMode == ioMode;
+  }
+  m_connection->setInputStreamIOMode(ioMode);
+  m_connection->setOutputStreamIOMode(ioMode);
+  m_ioMode = ioMode;
+  m_ioModeSet = true;
+  return true;
+}
+
+v_int64 HttpPipeline::enqueue() {
+  std::lock_guard<oatpp::async::Lock> lock(m_lock);
+  return m_nextTicket ++;
+}
+
+bool HttpPipeline::waitWriteTurn(v_int64 ticket) {
+  std::unique_lock<oatpp::async::Lock> lock(m_lock);
+  m_condition.wait(lock, [this, ticket]{ return canWrite(ticket); });
+  return !m_failed;
+}
+
+void HttpPipeline::onWritten() {
+  {
+    std::lock_guard<oatpp::async::Lock> lock(m_lock);
+    m_writeTurn ++;
+  }
+  notifyAll();
+}
+
+bool HttpPipeline::waitReadTurn(v_int64 ticket) {
+  std::unique_lock<oatpp::async::Lock> lock(m_lock);
+  m_condition.wait(lock, [this, ticket]{ return canRead(ticket); });
+  return !m_failed;
+}
+
+oatpp::async::CoroutineStarter HttpPipeline::waitAsync(std::function<bool()> condition) {
+
+  class WaitCoroutine : public oatpp::async::Coroutine<WaitCoroutine> {
+  private:
+    HttpPipeline* m_this;
+    std::function<bool()> m_condition;
+    oatpp::async::LockGuard m_lockGuard;
+  public:
+
+    WaitCoroutine(HttpPipeline* _this, const std::function<bool()>& condition)
+      : m_this(_this)
+      , m_condition(condition)
+      , m_lockGuard(&_this->m_lock)
+    {}
+
+    Action act() override {
+      return m_this->m_asyncCondition.wait(m_lockGuard, m_condition).next(yieldTo(&WaitCoroutine::onReady));
+    }
+
+    Action onReady() {
+      bool failed = m_this->m_failed;
+      m_lockGuard.unlock();
+      if(failed) {
+        return error<oatpp::async::Error>("[oatpp::web::client::HttpPipeline::waitAsync()]: Error. Pipeline has failed.");
+      }
+      return finish();
+    }
+
+  };
+
+  return WaitCoroutine::start(this, condition);
+
+}
+
+oatpp::async::CoroutineStarter HttpPipeline::waitWriteTurnAsync(v_int64 ticket) {
+  return waitAsync([this, ticket]() noexcept { return canWrite(ticket); });
+}
+
+oatpp::async::CoroutineStarter HttpPipeline::waitReadTurnAsync(v_int64 ticket) {
+  return waitAsync([this, ticket]() noexcept { return canRead(ticket); });
+}
+
+std::shared_ptr<HttpPipeline::Response>
+HttpPipeline::createResponse(const protocol::http::incoming::ResponseHeadersReader::Result& headers,
+                             BodyReader& bodyReader,
+                             const std::shared_ptr<const BodyDecoder>& bodyDecoder)
+{
+
+  typedef oatpp::web::protocol::http::Header Header;
+
+  if(!bodyReader.hasBody()) {
+    return Response::createShared(headers.startingLine.statusCode,
+                                  headers.startingLine.description.toString(),
+                                  headers.headers,
+                                  std::make_shared<data::stream::BufferInputStream>(oatpp::String("")),
+                                  bodyDecoder);
+  }
+
+  auto body = bodyReader.getBody();
+
+  /* body is already de-chunked and is in memory - describe it with Content-Length */
+  protocol::http::Headers responseHeaders;
+  for(const auto& pair : headers.headers.getAll()) {
+    if(pair.first != Header::TRANSFER_ENCODING && pair.first != Header::CONTENT_LENGTH) {
+      responseHeaders.put_LockFree(pair.first, pair.second);
+    }
+  }
+  responseHeaders.put_LockFree(Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(static_cast<v_int64>(body->size())));
+
+  return Response::createShared(headers.startingLine.statusCode,
+                                headers.startingLine.description.toString(),
+                                responseHeaders,
+                                std::make_shared<data::stream::BufferInputStream>(body),
+                                bodyDecoder);
+
+}
+
+std::shared_ptr<HttpPipeline::Response> HttpPipeline::readResponse(bool headRequest, const std::shared_ptr<const BodyDecoder>& bodyDecoder) {
+
+  protocol::http::HttpError::Info error;
+  auto headers = m_headersReader.readHeaders(m_inStream.get(), error);
+
+  if(error.ioStatus <= 0) {
+    throw std::runtime_error("[oatpp::web::client::HttpPipeline::readResponse()]: Error. Failed to read response.");
+  }
+
+  if(error.status.code != 0) {
+    throw std::runtime_error("[oatpp::web::client::HttpPipeline::readResponse()]: Error. Failed to parse response headers.");
+  }
+
+  BodyReader bodyReader(m_maxBodySize);
+  bodyReader.init(headers.headers, headers.startingLine.statusCode, headRequest);
+
+  while(!bodyReader.isDone()) {
+
+    async::Action action;
+    auto res = bodyReader.iterate(m_inStream.get(), action);
+
+    if(!action.isNone()) {
+      throw std::runtime_error("[oatpp::web::client::HttpPipeline::readResponse()]: Error. Async action is unexpected.");
+    }
+
+    if(res > 0 || res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+      continue;
+    }
+
+    throw std::runtime_error("[oatpp::web::client::HttpPipeline::readResponse()]: Error. Failed to read response body.");
+
+  }
+
+  return createResponse(headers, bodyReader, bodyDecoder);
+
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<HttpPipeline::Response>&>
+HttpPipeline::readResponseAsync(bool headRequest, const std::shared_ptr<const BodyDecoder>& bodyDecoder) {
+
+  typedef protocol::http::incoming::ResponseHeadersReader ResponseHeadersReader;
+
+  class ReadCoroutine : public oatpp::async::CoroutineWithResult<ReadCoroutine, const std::shared_ptr<Response>&> {
+  private:
+    HttpPipeline* m_this;
+    bool m_headRequest;
+    std::shared_ptr<const BodyDecoder> m_bodyDecoder;
+    ResponseHeadersReader::Result m_headers;
+    BodyReader m_bodyReader;
+  public:
+
+    ReadCoroutine(HttpPipeline* _this, bool headRequest, const std::shared_ptr<const BodyDecoder>& bodyDecoder)
+      : m_this(_this)
+      , m_headRequest(headRequest)
+      , m_bodyDecoder(bodyDecoder)
+      , m_bodyReader(_this->m_maxBodySize)
+    {}
+
+    Action act() override {
+      return m_this->m_headersReader.readHeadersAsync(m_this->m_inStream).callbackTo(&ReadCoroutine::onHeaders);
+    }
+
+    Action onHeaders(const ResponseHeadersReader::Result& headers) {
+      m_headers = headers;
+      m_bodyReader.init(m_headers.headers, m_headers.startingLine.statusCode, m_headRequest);
+      return yieldTo(&ReadCoroutine::readBody);
+    }
+
+    Action readBody() {
+
+      if(m_bodyReader.isDone()) {
+        return _return(m_this->createResponse(m_headers, m_bodyReader, m_bodyDecoder));
+      }
+
+      async::Action action;
+      auto res = m_bodyReader.iterate(m_this->m_inStream.get(), action);
+
+      if(!action.isNone()) {
+        return action;
+      }
+
+      if(res > 0 || res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+        return repeat();
+      }
+
+      return error<oatpp::AsyncIOError>("[oatpp::web::client::HttpPipeline::readResponseAsync()]: Error. Failed to read response body.", res);
+
+    }
+
+  };
+
+  return ReadCoroutine::startForResult(this, headRequest, bodyDecoder);
+
+}
+
+void HttpPipeline::onRead(bool closeConnection) {
+  {
+    std::lock_guard<oatpp::async::Lock> lock(m_lock);
+    m_readTurn ++;
+  }
+  if(closeConnection) {
+    fail();
+  } else {
+    notifyAll();
+  }
+}
+
+void HttpPipeline::fail() {
+  bool wasFailed;
+  {
+    std::lock_guard<oatpp::async::Lock> lock(m_lock);
+    wasFailed = m_failed;
+    m_failed = true;
+  }
+  if(!wasFailed && m_invalidator) {
+    m_invalidator();
+  }
+  notifyAll();
+}
+
+bool HttpPipeline::isFailed() {
+  std::lock_guard<oatpp::async::Lock> lock(m_lock);
+  return m_failed;
+}
+
+v_int64 HttpPipeline::getInFlightCount() {
+  std::lock_guard<oatpp::async::Lock> lock(m_lock);
+  return m_nextTicket - m_readTurn;
+}
+
+}}}
@@ -0,0 +1,219 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_client_HttpPipeline_hpp
+#define oatpp_web_client_HttpPipeline_hpp
+
+#include "oatpp/web/protocol/http/incoming/ResponseHeadersReader.hpp"
+#include "oatpp/web/protocol/http/incoming/Response.hpp"
+#include "oatpp/data/stream/StreamBufferedProxy.hpp"
+#include "oatpp/async/ConditionVariable.hpp"
+
+#include <condition_variable>
+
+namespace oatpp { namespace web { namespace client {
+
+/**
+ * HTTP/1.1 pipeline over a single connection. <br>
+ * Requests are assigned tickets in the order they are enqueued, written back-to-back in ticket order,
+ * and responses are matched to requests in the same (FIFO) order. <br>
+ * Response bodies are read into memory as soon as response is read, so that the next response can be read
+ * from the connection without waiting for the user to consume the previous body. <br>
+ * Response body larger than `maxBodySize` fails the pipeline, as the rest of the body can't be skipped safely. <br>
+ * Any error fails the pipeline - all requests still in flight fail, and the connection is invalidated. <br>
+ * A pipeline is used either in synchronous or in asynchronous mode, not both - see &l:HttpPipeline::setIOMode ();.
+ */
+class HttpPipeline : public oatpp::base::Countable {
+public:
+
+  /**
+   * Convenience typedef for &id:oatpp::web::protocol::http::incoming::Response;.
+   */
+  typedef oatpp::web::protocol::http::incoming::Response Response;
+
+  /**
+   * Convenience typedef for &id:oatpp::web::protocol::http::incoming::BodyDecoder;.
+   */
+  typedef oatpp::web::protocol::http::incoming::BodyDecoder BodyDecoder;
+
+  /**
+   * Function called to invalidate the connection when pipeline fails.
+   */
+  typedef std::function<void()> Invalidator;
+
+  /**
+   * Default max size of a response body read to memory - 4MB.
+   */
+  static constexpr v_int64 DEFAULT_MAX_BODY_SIZE = 4 * 1024 * 1024;
+
+private:
+
+  class BodyReader;
+
+private:
+  std::shared_ptr<data::stream::IOStream> m_connection;
+  Invalidator m_invalidator;
+  v_int64 m_maxInFlight;
+  v_int64 m_maxBodySize;
+private:
+  oatpp::data::share::MemoryLabel m_writeBuffer;
+  std::shared_ptr<data::stream::InputStreamBufferedProxy> m_inStream;
+  oatpp::web::protocol::http::incoming::ResponseHeadersReader m_headersReader;
+private:
+  oatpp::async::Lock m_lock;
+  std::condition_variable_any m_condition;
+  oatpp::async::ConditionVariable m_asyncCondition;
+  v_int64 m_nextTicket;
+  v_int64 m_writeTurn;
+  v_int64 m_readTurn;
+  bool m_failed;
+  bool m_ioModeSet;
+  data::stream::IOMode m_ioMode;
+private:
+  void notifyAll();
+  bool canWrite(v_int64 ticket) const;
+  bool canRead(v_int64 ticket) const;
+  oatpp::async::CoroutineStarter waitAsync(std::function<bool()> condition);
+  std::shared_ptr<Response> createResponse(const protocol::http::incoming::ResponseHeadersReader::Result& headers,
+                                           BodyReader& bodyReader,
+                                           const std::shared_ptr<const BodyDecoder>& bodyDecoder);
+public:
+
+  /**
+   * Constructor.
+   * @param connection - connection to pipeline requests over.
+   * @param invalidator - called once when the pipeline fails.
+   * @param maxInFlight - max number of requests written but not yet answered.
+   * @param maxBodySize - max size of a response body. Larger response fails the pipeline. `<= 0` - no limit.
+   */
+  HttpPipeline(const std::shared_ptr<data::stream::IOStream>& connection,
+               const Invalidator& invalidator,
+               v_int64 maxInFlight,
+               v_int64 maxBodySize = DEFAULT_MAX_BODY_SIZE);
+
+  /**
+   * Get connection.
+   * @return - connection.
+   */
+  std::shared_ptr<data::stream::IOStream> getConnection() const;
+
+  /**
+   * Buffer to use for writing a request. May be used only by the ticket holding the write turn.
+   * @return - &id:oatpp::data::share::MemoryLabel;.
+   */
+  oatpp::data::share::MemoryLabel getWriteBuffer() const;
+
+  /**
+   * Set I/O mode of the connection. The first call fixes the mode for the lifetime of the pipeline. <br>
+   * Call it before &l:HttpPipeline::enqueue ();.
+   * @param ioMode - &id:oatpp::data::stream::IOMode;.
+   * @return - `false` if the pipeline is already used in the other I/O mode.
+   */
+  bool setIOMode(data::stream::IOMode ioMode);
+
+  /**
+   * Enqueue new request.
+   * @return - ticket.
+   */
+  v_int64 enqueue();
+
+  /**
+   * Wait until it's the ticket's turn to write request. Blocks while there are `maxInFlight` requests in flight.
+   * @param ticket - ticket returned by &l:HttpPipeline::enqueue ();.
+   * @return - `false` if pipeline has failed.
+   */
+  bool waitWriteTurn(v_int64 ticket);
+
+  /**
+   * Same as &l:HttpPipeline::waitWriteTurn (); but Async. Reports error if pipeline has failed.
+   * @param ticket - ticket returned by &l:HttpPipeline::enqueue ();.
+   * @return - &id:oatpp::async::CoroutineStarter;.
+   */
+  oatpp::async::CoroutineStarter waitWriteTurnAsync(v_int64 ticket);
+
+  /**
+   * Request of the current write turn is written.
+   */
+  void onWritten();
+
+  /**
+   * Wait until it's the ticket's turn to read response.
+   * @param ticket - ticket returned by &l:HttpPipeline::enqueue ();.
+   * @return - `false` if pipeline has failed.
+   */
+  bool waitReadTurn(v_int64 ticket);
+
+  /**
+   * Same as &l:HttpPipeline::waitReadTurn (); but Async. Reports error if pipeline has failed.
+   * @param ticket - ticket returned by &l:HttpPipeline::enqueue ();.
+   * @return - &id:oatpp::async::CoroutineStarter;.
+   */
+  oatpp::async::CoroutineStarter waitReadTurnAsync(v_int64 ticket);
+
+  /**
+   * Read response of the current read turn. Throws on error.
+   * @param headRequest - `true` if response is for the HEAD request. (Such response has no body).
+   * @param bodyDecoder - body decoder to pass to the response.
+   * @return - &id:oatpp::web::protocol::http::incoming::Response;.
+   */
+  std::shared_ptr<Response> readResponse(bool headRequest, const std::shared_ptr<const BodyDecoder>& bodyDecoder);
+
+  /**
+   * Same as &l:HttpPipeline::readResponse (); but Async.
+   * @param headRequest - `true` if response is for the HEAD request. (Such response has no body).
+   * @param bodyDecoder - body decoder to pass to the response.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<Response>&>
+  readResponseAsync(bool headRequest, const std::shared_ptr<const BodyDecoder>& bodyDecoder);
+
+  /**
+   * Response of the current read turn is read.
+   * @param closeConnection - `true` if server is going to close the connection after this response.
+   */
+  void onRead(bool closeConnection);
+
+  /**
+   * Fail the pipeline. All requests in flight and all subsequent requests fail. Connection is invalidated.
+   */
+  void fail();
+
+  /**
+   * Check if pipeline has failed.
+   * @return - `true` if pipeline has failed.
+   */
+  bool isFailed();
+
+  /**
+   * Get number of requests enqueued but not yet answered.
+   * @return - number of requests in flight.
+   */
+  v_int64 getInFlightCount();
+
+};
+
+}}}
+
+#endif // oatpp_web_client_HttpPipeline_hpp
@@ -25,7 +25,6 @@
 #include "HttpRequestExecutor.hpp"
 
 #include "oatpp/web/protocol/http/incoming/ResponseHeadersReader.hpp"
-#include "oatpp/web/protocol/http/outgoing/Request.hpp"
 
 #include "oatpp/network/tcp/Connection.hpp"
 
@@ -86,9 +85,9 @@ data::stream::Context& HttpRequestExecutor::ConnectionProxy::getOutputStreamCont
 }
 
 void HttpRequestExecutor::ConnectionProxy::invalidate() {
-  if(m_valid) {
+  /* may be called concurrently - ex.: by the winner of a hedged request */
+  if(m_valid.exchange(false)) {
     m_connectionHandle.invalidator->invalidate(m_connectionHandle.object);
-    m_valid = false;
   }
 }
 
@@ -112,6 +111,24 @@ void HttpRequestExecutor::HttpConnectionHandle::invalidate() {
   m_connectionProxy->invalidate();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// HttpRequestExecutor::PipelinedConnectionHandle
+
+HttpRequestExecutor::PipelinedConnectionHandle::PipelinedConnectionHandle(const std::shared_ptr<ConnectionProxy>& connectionProxy,
+                                                                          v_int64 maxInFlight,
+                                                                          v_int64 maxBodySize)
+  : HttpConnectionHandle(connectionProxy)
+  , m_pipeline(std::make_shared<HttpPipeline>(connectionProxy, [connectionProxy]{ connectionProxy->invalidate(); }, maxInFlight, maxBodySize))
+{}
+
+std::shared_ptr<HttpPipeline> HttpRequestExecutor::PipelinedConnectionHandle::getPipeline() {
+  return m_pipeline;
+}
+
+void HttpRequestExecutor::PipelinedConnectionHandle::invalidate() {
+  m_pipeline->fail();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // HttpRequestExecutor
 
@@ -168,6 +185,47 @@ HttpRequestExecutor::getConnectionAsync() {
   
 }
 
+std::shared_ptr<HttpRequestExecutor::ConnectionHandle> HttpRequestExecutor::getPipelinedConnection(v_int64 maxInFlight, v_int64 maxBodySize) {
+  auto connection = m_connectionProvider->get();
+  if(!connection){
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_CANT_CONNECT,
+                                "[oatpp::web::client::HttpRequestExecutor::getPipelinedConnection()]: ConnectionProvider failed to provide Connection");
+  }
+  auto connectionProxy = std::make_shared<ConnectionProxy>(connection);
+  return std::make_shared<PipelinedConnectionHandle>(connectionProxy, maxInFlight, maxBodySize);
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>&>
+HttpRequestExecutor::getPipelinedConnectionAsync(v_int64 maxInFlight, v_int64 maxBodySize) {
+
+  class GetConnectionCoroutine : public oatpp::async::CoroutineWithResult<GetConnectionCoroutine, const std::shared_ptr<ConnectionHandle>&> {
+  private:
+    std::shared_ptr<ClientConnectionProvider> m_connectionProvider;
+    v_int64 m_maxInFlight;
+    v_int64 m_maxBodySize;
+  public:
+
+    GetConnectionCoroutine(const std::shared_ptr<ClientConnectionProvider>& connectionProvider, v_int64 maxInFlight, v_int64 maxBodySize)
+      : m_connectionProvider(connectionProvider)
+      , m_maxInFlight(maxInFlight)
+      , m_maxBodySize(maxBodySize)
+    {}
+
+    Action act() override {
+      return m_connectionProvider->getAsync().callbackTo(&GetConnectionCoroutine::onConnectionReady);
+    }
+
+    Action onConnectionReady(const provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+      auto connectionProxy = std::make_shared<ConnectionProxy>(connection);
+      return _return(std::make_shared<PipelinedConnectionHandle>(connectionProxy, m_maxInFlight, m_maxBodySize));
+    }
+
+  };
+
+  return GetConnectionCoroutine::startForResult(m_connectionProvider, maxInFlight, maxBodySize);
+
+}
+
 void HttpRequestExecutor::invalidateConnection(const std::shared_ptr<ConnectionHandle>& connectionHandle) {
 
   if(connectionHandle) {
@@ -177,6 +235,24 @@ void HttpRequestExecutor::invalidateConnection(const std::shared_ptr<ConnectionH
 
 }
   
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Request>
+HttpRequestExecutor::createRequest(const String& method,
+                                   const String& path,
+                                   const Headers& headers,
+                                   const std::shared_ptr<Body>& body)
+{
+  auto request = oatpp::web::protocol::http::outgoing::Request::createShared(method, path, headers, body);
+  oatpp::data::stream::BufferOutputStream hostValue;
+  hostValue << m_connectionProvider->getProperty("host").toString();
+  auto port = m_connectionProvider->getProperty("port");
+  if(port) {
+    hostValue << ":" << port.toString();
+  }
+  request->putHeaderIfNotExists_Unsafe(oatpp::web::protocol::http::Header::HOST, hostValue.toString());
+  request->putHeaderIfNotExists_Unsafe(oatpp::web::protocol::http::Header::CONNECTION, oatpp::web::protocol::http::Header::Value::CONNECTION_KEEP_ALIVE);
+  return request;
+}
+
 std::shared_ptr<HttpRequestExecutor::Response>
 HttpRequestExecutor::executeOnce(const String& method,
                                  const String& path,
@@ -195,18 +271,15 @@ HttpRequestExecutor::executeOnce(const String& method,
                                 "[oatpp::web::client::HttpRequestExecutor::executeOnce()]: Connection is null");
   }
 
+  auto pipelinedCH = std::dynamic_pointer_cast<PipelinedConnectionHandle>(httpCH);
+  if(pipelinedCH) {
+    return executePipelined(method, path, headers, body, pipelinedCH);
+  }
+
   connection->setInputStreamIOMode(data::stream::IOMode::BLOCKING);
   connection->setOutputStreamIOMode(data::stream::IOMode::BLOCKING);
   
-  auto request = oatpp::web::protocol::http::outgoing::Request::createShared(method, path, headers, body);
-  oatpp::data::stream::BufferOutputStream hostValue;
-  hostValue << m_connectionProvider->getProperty("host").toString();
-  auto port = m_connectionProvider->getProperty("port");
-  if(port) {
-    hostValue << ":" << port.toString();
-  }
-  request->putHeaderIfNotExists_Unsafe(oatpp::web::protocol::http::Header::HOST, hostValue.toString());
-  request->putHeaderIfNotExists_Unsafe(oatpp::web::protocol::http::Header::CONNECTION, oatpp::web::protocol::http::Header::Value::CONNECTION_KEEP_ALIVE);
+  auto request = createRequest(method, path, headers, body);
 
   oatpp::data::share::MemoryLabel buffer(std::make_shared<std::string>(oatpp::data::buffer::IOBuffer::BUFFER_SIZE, 0));
 
@@ -306,15 +379,7 @@ HttpRequestExecutor::executeOnceAsync(const String& method,
       m_connection->setInputStreamIOMode(data::stream::IOMode::ASYNCHRONOUS);
       m_connection->setOutputStreamIOMode(data::stream::IOMode::ASYNCHRONOUS);
 
-      auto request = OutgoingRequest::createShared(m_method, m_path, m_headers, m_body);
-      oatpp::data::stream::BufferOutputStream hostValue;
-      hostValue << m_this->m_connectionProvider->getProperty("host").toString();
-      auto port = m_this->m_connectionProvider->getProperty("port");
-      if(port) {
-        hostValue << ":" << port.toString();
-      }
-      request->putHeaderIfNotExists_Unsafe(Header::HOST, hostValue.toString());
-      request->putHeaderIfNotExists_Unsafe(Header::CONNECTION, Header::Value::CONNECTION_KEEP_ALIVE);
+      auto request = m_this->createRequest(m_method, m_path, m_headers, m_body);
       m_upstream = oatpp::data::stream::OutputStreamBufferedProxy::createShared(m_connection, m_buffer);
       return OutgoingRequest::sendAsync(request, m_upstream).next(m_upstream->flushAsync()).next(yieldTo(&ExecutorCoroutine::readResponse));
 
@@ -356,8 +421,173 @@ HttpRequestExecutor::executeOnceAsync(const String& method,
   };
 
   auto httpCH = std::static_pointer_cast<HttpConnectionHandle>(connectionHandle);
+
+  auto pipelinedCH = std::dynamic_pointer_cast<PipelinedConnectionHandle>(httpCH);
+  if(pipelinedCH) {
+    return executePipelinedAsync(method, path, headers, body, pipelinedCH);
+  }
+
   return ExecutorCoroutine::startForResult(this, method, path, headers, body, m_bodyDecoder, httpCH);
   
 }
+
+std::shared_ptr<HttpRequestExecutor::Response>
+HttpRequestExecutor::executePipelined(const String& method,
+                                      const String& path,
+                                      const Headers& headers,
+                                      const std::shared_ptr<Body>& body,
+                                      const std::shared_ptr<PipelinedConnectionHandle>& connectionHandle)
+{
+
+  auto pipeline = connectionHandle->getPipeline();
+  auto connection = pipeline->getConnection();
+
+  if(!pipeline->setIOMode(data::stream::IOMode::BLOCKING)) {
+    pipeline->fail();
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_PIPELINE_FAILED,
+                                "[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Pipelined connection is already used asynchronously.");
+  }
+
+  auto request = createRequest(method, path, headers, body);
+  auto ticket = pipeline->enqueue();
+
+  if(!pipeline->waitWriteTurn(ticket)) {
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_PIPELINE_FAILED,
+                                "[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Pipeline failed.");
+  }
+
+  try {
+    oatpp::data::stream::OutputStreamBufferedProxy upStream(connection, pipeline->getWriteBuffer());
+    request->send(&upStream);
+    if(upStream.flush() < 0) {
+      throw std::runtime_error("[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Failed to write request.");
+    }
+  } catch (...) {
+    pipeline->fail();
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_PIPELINE_FAILED,
+                                "[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Failed to write request.");
+  }
+
+  pipeline->onWritten();
+
+  if(!pipeline->waitReadTurn(ticket)) {
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_PIPELINE_FAILED,
+                                "[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Pipeline failed.");
+  }
+
+  std::shared_ptr<Response> response;
+
+  try {
+    response = pipeline->readResponse(method == "HEAD", m_bodyDecoder);
+  } catch (...) {
+    pipeline->fail();
+    throw RequestExecutionError(RequestExecutionError::ERROR_CODE_CANT_READ_RESPONSE,
+                                "[oatpp::web::client::HttpRequestExecutor::executePipelined()]: Failed to read response.");
+  }
+
+  auto connectionHeader = response->getHeaders().getAsMemoryLabel<oatpp::data::share::StringKeyLabelCI>(Header::CONNECTION);
+  pipeline->onRead(connectionHeader == "close");
+
+  return response;
+
+}
+
+oatpp::async::CoroutineStarterForResult<const std::shared_ptr<HttpRequestExecutor::Response>&>
+HttpRequestExecutor::executePipelinedAsync(const String& method,
+                                           const String& path,
+                                           const Headers& headers,
+                                           const std::shared_ptr<Body>& body,
+                                           const std::shared_ptr<PipelinedConnectionHandle>& connectionHandle)
+{
+
+  class PipelinedCoroutine : public oatpp::async::CoroutineWithResult<PipelinedCoroutine, const std::shared_ptr<HttpRequestExecutor::Response>&> {
+  private:
+    typedef oatpp::web::protocol::http::outgoing::Request OutgoingRequest;
+  private:
+    HttpRequestExecutor* m_this;
+    String m_method;
+    String m_path;
+    Headers m_headers;
+    std::shared_ptr<Body> m_body;
+    std::shared_ptr<HttpPipeline> m_pipeline;
+    std::shared_ptr<OutgoingRequest> m_request;
+    std::shared_ptr<oatpp::data::stream::OutputStreamBufferedProxy> m_upstream;
+    v_int64 m_ticket;
+  public:
+
+    PipelinedCoroutine(HttpRequestExecutor* _this,
+                       const String& method,
+                       const String& path,
+                       const Headers& headers,
+                       const std::shared_ptr<Body>& body,
+                       const std::shared_ptr<HttpPipeline>& pipeline)
+      : m_this(_this)
+      , m_method(method)
+      , m_path(path)
+      , m_headers(headers)
+      , m_body(body)
+      , m_pipeline(pipeline)
+      , m_ticket(-1)
+    {}
+
+    ~PipelinedCoroutine() override {
+      /* destroyed while holding a ticket - later tickets would wait for it forever */
+      if(m_ticket >= 0) {
+        m_pipeline->fail();
+      }
+    }
+
+    Action act() override {
+
+      if(!m_pipeline->setIOMode(data::stream::IOMode::ASYNCHRONOUS)) {
+        m_pipeline->fail();
+        return error<oatpp::async::Error>("[oatpp::web::client::HttpRequestExecutor::executePipelinedAsync()]: "
+                                          "Error. Pipelined connection is already used synchronously.");
+      }
+
+      m_request = m_this->createRequest(m_method, m_path, m_headers, m_body);
+      m_ticket = m_pipeline->enqueue();
+
+      return m_pipeline->waitWriteTurnAsync(m_ticket).next(yieldTo(&PipelinedCoroutine::write));
+
+    }
+
+    Action write() {
+      m_upstream = oatpp::data::stream::OutputStreamBufferedProxy::createShared(m_pipeline->getConnection(), m_pipeline->getWriteBuffer());
+      return OutgoingRequest::sendAsync(m_request, m_upstream)
+        .next(m_upstream->flushAsync())
+        .next(yieldTo(&PipelinedCoroutine::onWritten));
+    }
+
+    Action onWritten() {
+      m_upstream.reset();
+      m_pipeline->onWritten();
+      return m_pipeline->waitReadTurnAsync(m_ticket).next(yieldTo(&PipelinedCoroutine::read));
+    }
+
+    Action read() {
+      return m_pipeline->readResponseAsync(m_method == "HEAD", m_this->m_bodyDecoder).callbackTo(&PipelinedCoroutine::onResponse);
+    }
+
+    Action onResponse(const std::shared_ptr<HttpRequestExecutor::Response>& response) {
+      auto connectionHeader = response->getHeaders().getAsMemoryLabel<oatpp::data::share::StringKeyLabelCI>(Header::CONNECTION);
+      m_pipeline->onRead(connectionHeader == "close");
+      m_ticket = -1;
+      return _return(response);
+    }
+
+    Action handleError(oatpp::async::Error* error) override {
+      if(m_ticket >= 0) {
+        m_pipeline->fail();
+        m_ticket = -1;
+      }
+      return error;
+    }
+
+  };
+
+  return PipelinedCoroutine::startForResult(this, method, path, headers, body, connectionHandle->getPipeline());
+
+}
   
 }}}
@@ -26,11 +26,15 @@
 #define oatpp_web_client_HttpRequestExecutor_hpp
 
 #include "./RequestExecutor.hpp"
+#include "./HttpPipeline.hpp"
 
+#include "oatpp/web/protocol/http/outgoing/Request.hpp"
 #include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
 #include "oatpp/network/ConnectionPool.hpp"
 #include "oatpp/network/ConnectionProvider.hpp"
 
+#include <atomic>
+
 namespace oatpp { namespace web { namespace client {
 
 /**
@@ -49,7 +53,7 @@ public:
   class ConnectionProxy : public data::stream::IOStream {
   private:
   provider::ResourceHandle<data::stream::IOStream> m_connectionHandle;
-    bool m_valid;
+    std::atomic<bool> m_valid;
     bool m_invalidateOnDestroy;
   public:
 
@@ -88,9 +92,52 @@ public:
 
     std::shared_ptr<ConnectionProxy> getConnection();
 
-    void invalidate();
+    virtual void invalidate();
 
   };
+
+  /**
+   * Pipelined connection handle. <br>
+   * Requests executed with this handle are pipelined over a single connection - multiple threads (or coroutines)
+   * may execute requests with the same handle concurrently. See &id:oatpp::web::client::HttpPipeline;. <br>
+   * Obtain it with &l:HttpRequestExecutor::getPipelinedConnection ();.
+   */
+  class PipelinedConnectionHandle : public HttpConnectionHandle {
+  private:
+    std::shared_ptr<HttpPipeline> m_pipeline;
+  public:
+
+    PipelinedConnectionHandle(const std::shared_ptr<ConnectionProxy>& connectionProxy, v_int64 maxInFlight, v_int64 maxBodySize);
+
+    std::shared_ptr<HttpPipeline> getPipeline();
+
+    /**
+     * Invalidate connection. All requests in flight fail.
+     */
+    void invalidate() override;
+
+  };
+
+private:
+
+  std::shared_ptr<oatpp::web::protocol::http::outgoing::Request> createRequest(const String& method,
+                                                                               const String& path,
+                                                                               const Headers& headers,
+                                                                               const std::shared_ptr<Body>& body);
+
+  std::shared_ptr<Response> executePipelined(const String& method,
+                                             const String& path,
+                                             const Headers& headers,
+                                             const std::shared_ptr<Body>& body,
+                                             const std::shared_ptr<PipelinedConnectionHandle>& connectionHandle);
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<Response>&>
+  executePipelinedAsync(const String& method,
+                        const String& path,
+                        const Headers& headers,
+                        const std::shared_ptr<Body>& body,
+                        const std::shared_ptr<PipelinedConnectionHandle>& connectionHandle);
+
 public:
 
   /**
@@ -128,6 +175,33 @@ public:
    */
   oatpp::async::CoroutineStarterForResult<const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>&> getConnectionAsync() override;
 
+  /**
+   * Get pipelined connection (HTTP/1.1 pipelining). <br>
+   * Requests executed concurrently with the returned handle are written back-to-back over the same connection
+   * and responses are matched in FIFO order. Response bodies are read to memory before the response is returned. <br>
+   * If any request in the pipeline fails, the connection is invalidated and all requests in flight fail with
+   * &id:oatpp::web::client::RequestExecutor::RequestExecutionError::ERROR_CODE_PIPELINE_FAILED;. <br>
+   * *Note: use the handle either in sync or in async mode. The first request fixes the mode - a request made in the other mode
+   * fails the pipeline. Retries made by &id:oatpp::web::client::RequestExecutor::execute;
+   * go over a new non-pipelined connection.*
+   * @param maxInFlight - max number of requests written to the connection but not yet answered.
+   * @param maxBodySize - max size of a response body. Larger response fails with
+   * &id:oatpp::web::client::RequestExecutor::RequestExecutionError::ERROR_CODE_CANT_READ_RESPONSE; and fails the pipeline.
+   * `<= 0` - no limit.
+   * @return - &l:HttpRequestExecutor::PipelinedConnectionHandle;.
+   */
+  std::shared_ptr<ConnectionHandle> getPipelinedConnection(v_int64 maxInFlight = 16,
+                                                           v_int64 maxBodySize = HttpPipeline::DEFAULT_MAX_BODY_SIZE);
+
+  /**
+   * Same as &l:HttpRequestExecutor::getPipelinedConnection (); but async.
+   * @param maxInFlight - max number of requests written to the connection but not yet answered.
+   * @param maxBodySize - max size of a response body. `<= 0` - no limit.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>&>
+  getPipelinedConnectionAsync(v_int64 maxInFlight = 16, v_int64 maxBodySize = HttpPipeline::DEFAULT_MAX_BODY_SIZE);
+
   /**
    * Invalidate connection.
    * @param connectionHandle
@@ -24,8 +24,13 @@
 
 #include "RequestExecutor.hpp"
 
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/CoroutineWaitList.hpp"
+
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace oatpp { namespace web { namespace client {
 
@@ -48,10 +53,346 @@ v_int32 RequestExecutor::RequestExecutionError::getReadErrorCode() const {
   return m_readErrorCode;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestExecutor::HedgeState
+
+/*
+ * State shared between the original attempt and the hedged attempt. <br>
+ * The first attempt to get a response becomes the winner and invalidates the connection of the other one.
+ */
+struct RequestExecutor::HedgeState : public oatpp::async::CoroutineWaitList::Listener {
+
+  enum class Winner : v_int32 {
+    NONE = 0,
+    PRIMARY = 1,
+    HEDGE = 2
+  };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  bool primaryDone = false;
+  bool hedgeStarted = false;
+  bool hedgeDone = false;
+  Winner winner = Winner::NONE;
+
+  std::shared_ptr<ConnectionHandle> primaryConnection;
+  std::shared_ptr<ConnectionHandle> hedgeConnection;
+  std::shared_ptr<Response> hedgeResponse;
+
+  /*
+   * Hedged attempt waits here for its delay. Woken early once the original attempt is done.
+   */
+  oatpp::async::CoroutineWaitList delayWaitList;
+
+  /*
+   * Original async attempt waits here for the result of the hedged attempt.
+   */
+  oatpp::async::CoroutineWaitList resultWaitList;
+
+  HedgeState() {
+    delayWaitList.setListener(this);
+    resultWaitList.setListener(this);
+  }
+
+  /*
+   * Re-check the condition once coroutine is on the list - so that the notification sent in between is not lost.
+   */
+  void onNewItem(oatpp::async::CoroutineWaitList& list) override {
+    bool wake;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(&list == &delayWaitList) {
+        wake = primaryDone;
+      } else {
+        wake = !(winner == Winner::NONE && hedgeStarted && !hedgeDone);
+      }
+    }
+    if(wake) {
+      list.notifyAll();
+    }
+  }
+
+  bool isPrimaryDone() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return primaryDone;
+  }
+
+  /*
+   * Called by the hedged attempt once the delay has passed.
+   * returns `false` if the hedge shouldn't be sent.
+   */
+  bool tryStartHedge(RetryBudget* budget) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(primaryDone || (budget && !budget->tryWithdraw())) {
+      return false;
+    }
+    hedgeStarted = true;
+    return true;
+  }
+
+  /*
+   * returns `false` if the original attempt has already won.
+   */
+  bool setHedgeConnection(const std::shared_ptr<ConnectionHandle>& connection) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(winner != Winner::NONE) {
+      return false;
+    }
+    hedgeConnection = connection;
+    return true;
+  }
+
+  /*
+   * returns connection to invalidate.
+   */
+  std::shared_ptr<ConnectionHandle> onHedgeResult(const std::shared_ptr<Response>& response,
+                                                  const std::shared_ptr<ConnectionHandle>& connection)
+  {
+    std::shared_ptr<ConnectionHandle> loser = connection;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      hedgeDone = true;
+      if(response && winner == Winner::NONE) {
+        winner = Winner::HEDGE;
+        hedgeResponse = response;
+        loser = primaryConnection;
+      }
+    }
+    condition.notify_all();
+    resultWaitList.notifyAll();
+    return loser;
+  }
+
+  /*
+   * returns connection to invalidate.
+   */
+  std::shared_ptr<ConnectionHandle> onPrimaryResult(bool success) {
+    std::shared_ptr<ConnectionHandle> loser;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      primaryDone = true;
+      if(success && winner == Winner::NONE) {
+        winner = Winner::PRIMARY;
+        loser = hedgeConnection;
+      }
+    }
+    delayWaitList.notifyAll();
+    return loser;
+  }
+
+  /*
+   * Is hedged attempt still in flight and can win.
+   */
+  bool isHedgePending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return winner == Winner::NONE && hedgeStarted && !hedgeDone;
+  }
+
+  Winner getWinner() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return winner;
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestExecutor::HedgeCoroutine
+
+/*
+ * Hedged attempt. Runs on the executor passed to setHedgingPolicy() for both sync and async requests. <br>
+ * Holds the RequestExecutor - it may outlive the original attempt (and the caller's reference to the executor).
+ */
+class RequestExecutor::HedgeCoroutine : public oatpp::async::Coroutine<HedgeCoroutine> {
+private:
+  std::shared_ptr<RequestExecutor> m_this;
+  std::shared_ptr<HedgeState> m_state;
+  String m_method;
+  String m_path;
+  Headers m_headers;
+  std::shared_ptr<Body> m_body;
+  std::chrono::system_clock::time_point m_hedgeTime;
+  std::shared_ptr<ConnectionHandle> m_connectionHandle;
+public:
+
+  HedgeCoroutine(const std::shared_ptr<RequestExecutor>& _this,
+                 const std::shared_ptr<HedgeState>& state,
+                 const String& method,
+                 const String& path,
+                 const Headers& headers,
+                 const std::shared_ptr<Body>& body,
+                 v_int64 delay)
+    : m_this(_this)
+    , m_state(state)
+    , m_method(method)
+    , m_path(path)
+    , m_headers(headers)
+    , m_body(body)
+    , m_hedgeTime(std::chrono::system_clock::now() + std::chrono::microseconds(delay))
+  {}
+
+  Action act() override {
+    /* the original attempt is done - hedge is not needed */
+    if(m_state->isPrimaryDone()) {
+      return finish();
+    }
+    if(std::chrono::system_clock::now() >= m_hedgeTime) {
+      return yieldTo(&HedgeCoroutine::start);
+    }
+    return Action::createWaitListAction(&m_state->delayWaitList, m_hedgeTime);
+  }
+
+  Action start() {
+    if(!m_state->tryStartHedge(m_this->m_retryBudget.get())) {
+      return finish();
+    }
+    m_this->m_hedgingPolicy->onHedge();
+    return m_this->getConnectionAsync().callbackTo(&HedgeCoroutine::onConnection);
+  }
+
+  Action onConnection(const std::shared_ptr<ConnectionHandle>& connectionHandle) {
+    m_connectionHandle = connectionHandle;
+    if(!m_state->setHedgeConnection(connectionHandle)) {
+      return onResult(nullptr);
+    }
+    return m_this->executeOnceAsync(m_method, m_path, m_headers, m_body, m_connectionHandle).callbackTo(&HedgeCoroutine::onResult);
+  }
+
+  Action onResult(const std::shared_ptr<Response>& response) {
+    auto loser = m_state->onHedgeResult(response, m_connectionHandle);
+    if(loser) {
+      m_this->invalidateConnection(loser);
+    }
+    return finish();
+  }
+
+  Action handleError(Error* error) override {
+    (void) error;
+    return onResult(nullptr);
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestExecutor
+
 RequestExecutor::RequestExecutor(const std::shared_ptr<RetryPolicy>& retryPolicy)
   : m_retryPolicy(retryPolicy)
 {}
 
+void RequestExecutor::setRetryBudget(const std::shared_ptr<RetryBudget>& retryBudget) {
+  m_retryBudget = retryBudget;
+}
+
+std::shared_ptr<RetryBudget> RequestExecutor::getRetryBudget() const {
+  return m_retryBudget;
+}
+
+void RequestExecutor::setHedgingPolicy(const std::shared_ptr<HedgingPolicy>& hedgingPolicy,
+                                       const std::shared_ptr<oatpp::async::Executor>& asyncExecutor)
+{
+  if(hedgingPolicy) {
+    if(!asyncExecutor) {
+      throw std::runtime_error("[oatpp::web::client::RequestExecutor::setHedgingPolicy()]: "
+                               "Error. No async executor to run hedged attempts on.");
+    }
+    if(weak_from_this().expired()) {
+      throw std::runtime_error("[oatpp::web::client::RequestExecutor::setHedgingPolicy()]: "
+                               "Error. RequestExecutor must be owned by std::shared_ptr to hedge requests.");
+    }
+  }
+  m_hedgingPolicy = hedgingPolicy;
+  m_hedgingExecutor = asyncExecutor;
+}
+
+std::shared_ptr<HedgingPolicy> RequestExecutor::getHedgingPolicy() const {
+  return m_hedgingPolicy;
+}
+
+bool RequestExecutor::isHedgeable(const String& method, const std::shared_ptr<Body>& body) const {
+  return m_hedgingPolicy && m_hedgingPolicy->canHedge(method) && (!body || body->getKnownData() != nullptr);
+}
+
+bool RequestExecutor::withdrawRetryBudget() {
+  return !m_retryBudget || m_retryBudget->tryWithdraw();
+}
+
+std::shared_ptr<RequestExecutor::HedgeState> RequestExecutor::startHedge(const String& method,
+                                                                         const String& path,
+                                                                         const Headers& headers,
+                                                                         const std::shared_ptr<Body>& body,
+                                                                         const std::shared_ptr<ConnectionHandle>& connectionHandle)
+{
+
+  if(!m_hedgingExecutor || !isHedgeable(method, body)) {
+    return nullptr;
+  }
+
+  /* the hedged attempt may outlive the request - it must keep the executor alive */
+  auto self = weak_from_this().lock();
+  if(!self) {
+    return nullptr;
+  }
+
+  auto state = std::make_shared<HedgeState>();
+  state->primaryConnection = connectionHandle;
+
+  /* headers are copied by the coroutine - the hedged attempt must not share them with the original one */
+  m_hedgingExecutor->execute<HedgeCoroutine>(self, state, method, path, headers, body, m_hedgingPolicy->getDelayMicroseconds());
+
+  return state;
+
+}
+
+std::shared_ptr<RequestExecutor::Response> RequestExecutor::executeHedged(
+  const String& method,
+  const String& path,
+  const Headers& headers,
+  const std::shared_ptr<Body>& body,
+  std::shared_ptr<ConnectionHandle>& connectionHandle
+) {
+
+  v_int64 tick0 = oatpp::Environment::getMicroTickCount();
+
+  auto state = startHedge(method, path, headers, body, connectionHandle);
+  if(!state) {
+    return executeOnce(method, path, headers, body, connectionHandle);
+  }
+
+  std::shared_ptr<Response> response;
+  std::exception_ptr error;
+
+  try {
+    response = executeOnce(method, path, headers, body, connectionHandle);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  auto loser = state->onPrimaryResult(response != nullptr);
+  if(loser) {
+    invalidateConnection(loser);
+  }
+
+  if(!response) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while(state->winner == HedgeState::Winner::NONE && state->hedgeStarted && !state->hedgeDone) {
+      state->condition.wait(lock);
+    }
+  }
+
+  if(state->getWinner() == HedgeState::Winner::HEDGE) {
+    m_hedgingPolicy->onHedgeWin();
+    connectionHandle = state->hedgeConnection;
+    response = state->hedgeResponse;
+  } else if(!response) {
+    std::rethrow_exception(error);
+  }
+
+  m_hedgingPolicy->recordLatency(oatpp::Environment::getMicroTickCount() - tick0);
+  return response;
+
+}
+
 std::shared_ptr<RequestExecutor::Response> RequestExecutor::execute(
   const String& method,
   const String& path,
@@ -60,6 +401,12 @@ std::shared_ptr<RequestExecutor::Response> RequestExecutor::execute(
   const std::shared_ptr<ConnectionHandle>& connectionHandle
 ) {
 
+  if(m_retryBudget) {
+    m_retryBudget->onRequest();
+  }
+
+  bool hedge = m_hedgingExecutor && isHedgeable(method, body);
+
   if(!m_retryPolicy) {
 
     auto ch = connectionHandle;
@@ -67,6 +414,9 @@ std::shared_ptr<RequestExecutor::Response> RequestExecutor::execute(
       ch = getConnection();
     }
 
+    if(hedge) {
+      return executeHedged(method, path, headers, body, ch);
+    }
     return executeOnce(method, path, headers, body, ch);
 
   } else {
@@ -84,14 +434,17 @@ std::shared_ptr<RequestExecutor::Response> RequestExecutor::execute(
           ch = getConnection();
         }
 
-        auto response = executeOnce(method, path, headers, body, ch);
+        auto response = hedge ? executeHedged(method, path, headers, body, ch) : executeOnce(method, path, headers, body, ch);
 
-        if(!m_retryPolicy->retryOnResponse(response->getStatusCode(), context) || !m_retryPolicy->canRetry(context)) {
+        if(!m_retryPolicy->retryOnResponse(response->getStatusCode(), context) ||
+           !m_retryPolicy->canRetry(context) ||
+           !withdrawRetryBudget())
+        {
           return response;
         }
 
       } catch (...) {
-        if(!m_retryPolicy->canRetry(context)) {
+        if(!m_retryPolicy->canRetry(context) || !withdrawRetryBudget()) {
           break;
         }
       }
@@ -133,6 +486,11 @@ RequestExecutor::executeAsync(
     std::shared_ptr<Body> m_body;
     std::shared_ptr<ConnectionHandle> m_connectionHandle;
     RetryPolicy::Context m_context;
+  private:
+    std::shared_ptr<HedgeState> m_hedge;
+    v_int64 m_hedgeTick0;
+    std::exception_ptr m_primaryError;
+    std::string m_primaryErrorMessage;
   public:
 
     ExecutorCoroutine(RequestExecutor* _this,
@@ -147,11 +505,16 @@ RequestExecutor::executeAsync(
       , m_headers(headers)
       , m_body(body)
       , m_connectionHandle(connectionHandle)
+      , m_hedgeTick0(0)
     {}
 
     Action act() override {
       m_context.attempt ++;
 
+      if(m_context.attempt == 1 && m_this->m_retryBudget) {
+        m_this->m_retryBudget->onRequest();
+      }
+
       if(!m_connectionHandle) {
         return m_this->getConnectionAsync().callbackTo(&ExecutorCoroutine::onConnection);
       }
@@ -166,14 +529,37 @@ RequestExecutor::executeAsync(
     }
 
     Action execute() {
+
+      m_hedgeTick0 = oatpp::Environment::getMicroTickCount();
+      m_hedge = m_this->startHedge(m_method, m_path, m_headers, m_body, m_connectionHandle);
+
       return m_this->executeOnceAsync(m_method, m_path, m_headers, m_body, m_connectionHandle).callbackTo(&ExecutorCoroutine::onResponse);
     }
 
     Action onResponse(const std::shared_ptr<RequestExecutor::Response>& response) {
 
+      if(m_hedge) {
+        auto loser = m_hedge->onPrimaryResult(true);
+        if(loser) {
+          m_this->invalidateConnection(loser);
+        }
+        if(m_hedge->getWinner() == HedgeState::Winner::HEDGE) {
+          return yieldTo(&ExecutorCoroutine::onHedgeWin);
+        }
+        m_this->m_hedgingPolicy->recordLatency(oatpp::Environment::getMicroTickCount() - m_hedgeTick0);
+        m_hedge.reset();
+      }
+
+      return onResult(response);
+
+    }
+
+    Action onResult(const std::shared_ptr<RequestExecutor::Response>& response) {
+
       if( m_this->m_retryPolicy &&
           m_this->m_retryPolicy->retryOnResponse(response->getStatusCode(), m_context) &&
-          m_this->m_retryPolicy->canRetry(m_context)
+          m_this->m_retryPolicy->canRetry(m_context) &&
+          m_this->withdrawRetryBudget()
       ) {
         return yieldTo(&ExecutorCoroutine::retry);
       }
@@ -181,6 +567,35 @@ RequestExecutor::executeAsync(
       return _return(response);
     }
 
+    Action onHedgeWin() {
+      m_this->m_hedgingPolicy->onHedgeWin();
+      m_this->m_hedgingPolicy->recordLatency(oatpp::Environment::getMicroTickCount() - m_hedgeTick0);
+      m_connectionHandle = m_hedge->hedgeConnection;
+      auto response = m_hedge->hedgeResponse;
+      m_hedge.reset();
+      m_primaryError = nullptr;
+      return onResult(response);
+    }
+
+    Action waitHedge() {
+
+      if(m_hedge->isHedgePending()) {
+        return Action::createWaitListAction(&m_hedge->resultWaitList);
+      }
+
+      if(m_hedge->getWinner() == HedgeState::Winner::HEDGE) {
+        return yieldTo(&ExecutorCoroutine::onHedgeWin);
+      }
+
+      /* both attempts failed - report error of the original attempt */
+      m_hedge.reset();
+      if(m_primaryError) {
+        return error<oatpp::async::Error>(m_primaryError);
+      }
+      return error<oatpp::async::Error>(m_primaryErrorMessage);
+
+    }
+
     Action retry() {
 
       if(m_connectionHandle) {
@@ -194,7 +609,20 @@ RequestExecutor::executeAsync(
 
     Action handleError(Error* error) override {
 
-      if(m_this->m_retryPolicy && m_this->m_retryPolicy->canRetry(m_context)) {
+      if(m_hedge) {
+        auto loser = m_hedge->onPrimaryResult(false);
+        if(loser) {
+          m_this->invalidateConnection(loser);
+        }
+        if(m_hedge->isHedgePending() || m_hedge->getWinner() == HedgeState::Winner::HEDGE) {
+          m_primaryError = error->getExceptionPtr();
+          m_primaryErrorMessage = error->what();
+          return yieldTo(&ExecutorCoroutine::waitHedge);
+        }
+        m_hedge.reset();
+      }
+
+      if(m_this->m_retryPolicy && m_this->m_retryPolicy->canRetry(m_context) && m_this->withdrawRetryBudget()) {
         return yieldTo(&ExecutorCoroutine::retry);
       }
 
@@ -26,18 +26,25 @@
 #define oatpp_web_client_RequestExecutor_hpp
 
 #include "RetryPolicy.hpp"
+#include "HedgingPolicy.hpp"
 
 #include "oatpp/web/protocol/http/incoming/Response.hpp"
 #include "oatpp/web/protocol/http/outgoing/Body.hpp"
 #include "oatpp/web/protocol/http/Http.hpp"
 
+namespace oatpp { namespace async {
+
+class Executor;
+
+}}
+
 namespace oatpp { namespace web { namespace client {
 
 /**
  * Abstract RequestExecutor.
  * RequestExecutor is class responsible for making remote requests.
  */
-class RequestExecutor {
+class RequestExecutor : public std::enable_shared_from_this<RequestExecutor> {
 public:
   /**
    * Convenience typedef for &id:oatpp::String;.
@@ -109,6 +116,12 @@ public:
      * Error code for "no response" error.
      */
     constexpr static const v_int32 ERROR_CODE_NO_RESPONSE = 5;
+
+    /**
+     * Error code for "pipeline failed" error. <br>
+     * Request was in flight on a pipelined connection which failed or was invalidated.
+     */
+    constexpr static const v_int32 ERROR_CODE_PIPELINE_FAILED = 6;
   private:
     v_int32 m_errorCode;
     const char* m_message;
@@ -147,8 +160,27 @@ public:
     
   };
 
+private:
+  struct HedgeState;
+  class HedgeCoroutine;
 private:
   std::shared_ptr<RetryPolicy> m_retryPolicy;
+  std::shared_ptr<RetryBudget> m_retryBudget;
+  std::shared_ptr<HedgingPolicy> m_hedgingPolicy;
+  std::shared_ptr<oatpp::async::Executor> m_hedgingExecutor;
+private:
+  bool isHedgeable(const String& method, const std::shared_ptr<Body>& body) const;
+  bool withdrawRetryBudget();
+  std::shared_ptr<HedgeState> startHedge(const String& method,
+                                         const String& path,
+                                         const Headers& headers,
+                                         const std::shared_ptr<Body>& body,
+                                         const std::shared_ptr<ConnectionHandle>& connectionHandle);
+  std::shared_ptr<Response> executeHedged(const String& method,
+                                          const String& path,
+                                          const Headers& headers,
+                                          const std::shared_ptr<Body>& body,
+                                          std::shared_ptr<ConnectionHandle>& connectionHandle);
 public:
 
   /**
@@ -162,6 +194,41 @@ public:
    */
   virtual ~RequestExecutor() = default;
 
+  /**
+   * Set &id:oatpp::web::client::RetryBudget;. <br>
+   * When set, every retry (and every hedged attempt) has to withdraw a token from the budget.
+   * Budget may be shared between several executors.
+   * @param retryBudget - &id:oatpp::web::client::RetryBudget;. `nullptr` - unlimited.
+   */
+  void setRetryBudget(const std::shared_ptr<RetryBudget>& retryBudget);
+
+  /**
+   * Get &id:oatpp::web::client::RetryBudget;.
+   * @return - &id:oatpp::web::client::RetryBudget;.
+   */
+  std::shared_ptr<RetryBudget> getRetryBudget() const;
+
+  /**
+   * Set &id:oatpp::web::client::HedgingPolicy;. <br>
+   * Only requests with no body or with body of known data (see &id:oatpp::web::protocol::http::outgoing::Body::getKnownData;)
+   * are hedged, since the body has to be sent twice. <br>
+   * For both &l:RequestExecutor::execute (); and &l:RequestExecutor::executeAsync (); the hedged attempt is
+   * a coroutine started on the `asyncExecutor`. It is cancelled as soon as the original attempt is done. <br>
+   * *Note: hedged attempts hold a reference to the RequestExecutor - it must be owned by `std::shared_ptr`.* <br>
+   * Throws `std::runtime_error` if `hedgingPolicy` is set while `asyncExecutor` is `nullptr`,
+   * or while the RequestExecutor is not owned by `std::shared_ptr`.
+   * @param hedgingPolicy - &id:oatpp::web::client::HedgingPolicy;. `nullptr` - disable hedging.
+   * @param asyncExecutor - &id:oatpp::async::Executor; to run hedged attempts on. Required unless hedging is disabled.
+   */
+  void setHedgingPolicy(const std::shared_ptr<HedgingPolicy>& hedgingPolicy,
+                        const std::shared_ptr<oatpp::async::Executor>& asyncExecutor = nullptr);
+
+  /**
+   * Get &id:oatpp::web::client::HedgingPolicy;.
+   * @return - &id:oatpp::web::client::HedgingPolicy;.
+   */
+  std::shared_ptr<HedgingPolicy> getHedgingPolicy() const;
+
   /**
    * Obtain &l:RequestExecutor::ConnectionHandle; which then can be passed to &l:RequestExecutor::execute ();.
    * @return std::shared_ptr to &l:RequestExecutor::ConnectionHandle;.
@@ -212,7 +279,7 @@ public:
                    const std::shared_ptr<ConnectionHandle>& connectionHandle) = 0;
 
   /**
-   * Execute request taking into account retry policy.
+   * Execute request taking into account retry policy, retry budget and hedging policy.
    * @param method - method ex: ["GET", "POST", "PUT", etc.].
    * @param path - path to resource.
    * @param headers - headers map &l:RequestExecutor::Headers;.
@@ -24,6 +24,10 @@
 
 #include "RetryPolicy.hpp"
 
+#include "oatpp/Environment.hpp"
+
+#include <mutex>
+
 namespace oatpp { namespace web { namespace client {
 
 SimpleRetryPolicy::SimpleRetryPolicy(v_int64 maxAttempts,
@@ -48,4 +52,55 @@ v_int64 SimpleRetryPolicy::waitForMicroseconds(const Context& context) {
   return m_delay;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RetryBudget
+
+RetryBudget::RetryBudget(v_float64 depositPerRequest, v_float64 maxTokens, v_float64 tokensPerSecond)
+  : m_depositPerRequest(depositPerRequest)
+  , m_maxTokens(maxTokens)
+  , m_tokensPerSecond(tokensPerSecond)
+  , m_tokens(maxTokens)
+  , m_lastRefillMicro(oatpp::Environment::getMicroTickCount())
+{}
+
+std::shared_ptr<RetryBudget> RetryBudget::createShared(v_float64 depositPerRequest, v_float64 maxTokens, v_float64 tokensPerSecond) {
+  return std::make_shared<RetryBudget>(depositPerRequest, maxTokens, tokensPerSecond);
+}
+
+void RetryBudget::refill(v_int64 nowMicro) {
+  if(nowMicro > m_lastRefillMicro) {
+    m_tokens += static_cast<v_float64>(nowMicro - m_lastRefillMicro) * m_tokensPerSecond / 1000000.0;
+    if(m_tokens > m_maxTokens) {
+      m_tokens = m_maxTokens;
+    }
+    m_lastRefillMicro = nowMicro;
+  }
+}
+
+void RetryBudget::onRequest() {
+  std::lock_guard<concurrency::SpinLock> lock(m_lock);
+  m_tokens += m_depositPerRequest;
+  if(m_tokens > m_maxTokens) {
+    m_tokens = m_maxTokens;
+  }
+}
+
+bool RetryBudget::tryWithdraw() {
+  auto now = oatpp::Environment::getMicroTickCount();
+  std::lock_guard<concurrency::SpinLock> lock(m_lock);
+  refill(now);
+  if(m_tokens >= 1.0) {
+    m_tokens -= 1.0;
+    return true;
+  }
+  return false;
+}
+
+v_float64 RetryBudget::getTokens() {
+  auto now = oatpp::Environment::getMicroTickCount();
+  std::lock_guard<concurrency::SpinLock> lock(m_lock);
+  refill(now);
+  return m_tokens;
+}
+
 }}}
@@ -25,6 +25,7 @@
 #ifndef oatpp_web_client_RetryPolicy_hpp
 #define oatpp_web_client_RetryPolicy_hpp
 
+#include "oatpp/concurrency/SpinLock.hpp"
 #include "oatpp/Types.hpp"
 
 #include <unordered_set>
@@ -122,6 +123,64 @@ public:
 
 };
 
+/**
+ * Token-bucket retry budget. <br>
+ * Limits the total amount of retries (and hedged attempts) across all requests made by the
+ * &id:oatpp::web::client::RequestExecutor; so that a failing upstream doesn't turn into a retry storm. <br>
+ * Every request deposits a fraction of a token, the bucket is also refilled at a constant rate,
+ * and every retry has to withdraw one whole token.
+ */
+class RetryBudget {
+private:
+  v_float64 m_depositPerRequest;
+  v_float64 m_maxTokens;
+  v_float64 m_tokensPerSecond;
+private:
+  concurrency::SpinLock m_lock;
+  v_float64 m_tokens;
+  v_int64 m_lastRefillMicro;
+private:
+  void refill(v_int64 nowMicro);
+public:
+
+  /**
+   * Constructor.
+   * @param depositPerRequest - tokens deposited per request. `0.2` - allow one retry per five requests.
+   * @param maxTokens - bucket capacity. Bucket starts full.
+   * @param tokensPerSecond - constant refill rate, independent of request rate. Lets low-traffic clients retry.
+   */
+  RetryBudget(v_float64 depositPerRequest = 0.2, v_float64 maxTokens = 100, v_float64 tokensPerSecond = 10);
+
+  /**
+   * Create shared RetryBudget.
+   * @param depositPerRequest - tokens deposited per request.
+   * @param maxTokens - bucket capacity.
+   * @param tokensPerSecond - constant refill rate.
+   * @return - `std::shared_ptr` to RetryBudget.
+   */
+  static std::shared_ptr<RetryBudget> createShared(v_float64 depositPerRequest = 0.2,
+                                                   v_float64 maxTokens = 100,
+                                                   v_float64 tokensPerSecond = 10);
+
+  /**
+   * Deposit tokens for a new request.
+   */
+  void onRequest();
+
+  /**
+   * Try to withdraw one token for a retry.
+   * @return - `true` if retry is allowed. `false` - budget is exhausted.
+   */
+  bool tryWithdraw();
+
+  /**
+   * Get amount of tokens currently in the bucket.
+   * @return - tokens.
+   */
+  v_float64 getTokens();
+
+};
+
 }}}
 
 #endif // oatpp_web_client_RetryPolicy_hpp
@@ -59,11 +59,13 @@ void ContentMappers::putMapper(const std::shared_ptr<data::mapping::ObjectMapper
   }
   m_index[mapper->getInfo().mimeType][mapper->getInfo().mimeSubtype] = mapper;
   m_mappers[mapper->getInfo().httpContentType] = mapper;
+  m_acceptCache.invalidate();
 }
 
 void ContentMappers::setDefaultMapper(const oatpp::String& contentType) {
   std::unique_lock<std::shared_mutex> lock(m_mutex);
   m_defaultMapper = m_mappers.at(contentType);
+  m_acceptCache.invalidate();
 }
 
 void ContentMappers::setDefaultMapper(const std::shared_ptr<data::mapping::ObjectMapper>& mapper) {
@@ -73,6 +75,7 @@ void ContentMappers::setDefaultMapper(const std::shared_ptr<data::mapping::Objec
     m_index[m_defaultMapper->getInfo().mimeType][m_defaultMapper->getInfo().mimeSubtype] = m_defaultMapper;
     m_mappers[mapper->getInfo().httpContentType] = m_defaultMapper;
   }
+  m_acceptCache.invalidate();
 }
 
 std::shared_ptr<data::mapping::ObjectMapper> ContentMappers::getMapper(const oatpp::String& contentType) const {
@@ -181,34 +184,61 @@ std::shared_ptr<data::mapping::ObjectMapper> ContentMappers::selectMapperForCont
 
 std::shared_ptr<data::mapping::ObjectMapper> ContentMappers::selectMapper(const oatpp::String& acceptHeader) const {
 
-  std::shared_lock<std::shared_mutex> lock(m_mutex);
-
   if(!acceptHeader || acceptHeader->empty()) {
-    return m_defaultMapper;
+    return getDefaultMapper();
   }
 
-  protocol::http::HeaderValueData values;
-  protocol::http::Parser::parseHeaderValueData(values, acceptHeader, ',');
+  return m_acceptCache.get(acceptHeader->data(), static_cast<v_buff_size>(acceptHeader->size()), [this, &acceptHeader]{
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    protocol::http::HeaderValueData values;
+    protocol::http::Parser::parseHeaderValueData(values, acceptHeader, ',');
 
-  return selectMapper(values);
+    return selectMapper(values);
+
+  });
 
 }
 
 std::shared_ptr<data::mapping::ObjectMapper> ContentMappers::selectMapper(const std::vector<oatpp::String>& acceptableContentTypes) const {
 
-  std::shared_lock<std::shared_mutex> lock(m_mutex);
-
   if(acceptableContentTypes.empty()) {
-    return m_defaultMapper;
+    return getDefaultMapper();
   }
 
-  protocol::http::HeaderValueData values;
+  auto negotiate = [this, &acceptableContentTypes]{
+
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    protocol::http::HeaderValueData values;
+    for(auto& ct : acceptableContentTypes) {
+      if(ct == nullptr || ct->empty()) continue;
+      protocol::http::Parser::parseHeaderValueData(values, ct, ',');
+    }
+
+    return selectMapper(values);
+
+  };
+
+  if(acceptableContentTypes.size() == 1) {
+    const auto& ct = acceptableContentTypes[0];
+    if(ct) {
+      return m_acceptCache.get(ct->data(), static_cast<v_buff_size>(ct->size()), negotiate);
+    }
+    return negotiate();
+  }
+
+  /* '\n' can't appear in the header value - join values so that the key is unambiguous */
+  std::string key;
   for(auto& ct : acceptableContentTypes) {
-    if(ct == nullptr || ct->empty()) continue;
-    protocol::http::Parser::parseHeaderValueData(values, ct, ',');
+    if(ct) {
+      key.append(ct->data(), ct->size());
+    }
+    key.push_back('\n');
   }
 
-  return selectMapper(values);
+  return m_acceptCache.get(key.data(), static_cast<v_buff_size>(key.size()), negotiate);
 
 }
 
@@ -216,6 +246,7 @@ void ContentMappers::clear() {
   std::unique_lock<std::shared_mutex> lock(m_mutex);
   m_defaultMapper = nullptr;
   m_mappers.clear();
+  m_acceptCache.invalidate();
 }
 
 }
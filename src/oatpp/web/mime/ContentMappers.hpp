@@ -26,6 +26,7 @@
 #define oatpp_web_mime_ContentMappers_hpp
 
 #include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/utils/NegotiationCache.hpp"
 #include "oatpp/data/mapping/ObjectMapper.hpp"
 
 #include <shared_mutex>
@@ -56,6 +57,7 @@ private:
   std::unordered_map<data::share::StringKeyLabelCI, std::shared_ptr<data::mapping::ObjectMapper>> m_mappers;
   std::shared_ptr<data::mapping::ObjectMapper> m_defaultMapper;
   mutable std::shared_mutex m_mutex;
+  utils::NegotiationCache<data::mapping::ObjectMapper> m_acceptCache;
 public:
 
   ContentMappers() = default;
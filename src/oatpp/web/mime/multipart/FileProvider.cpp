@@ -25,11 +25,45 @@
 #include "FileProvider.hpp"
 
 #include "oatpp/data/resource/File.hpp"
+#include "oatpp/data/stream/FileStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
 
 namespace oatpp { namespace web { namespace mime { namespace multipart {
 
-FileProvider::FileProvider(const oatpp::String& filename)
+std::shared_ptr<data::stream::OutputStream> FileProvider::openFileOutputStream(const std::shared_ptr<Part>& part,
+                                                                             const std::shared_ptr<data::resource::Resource>& resource,
+                                                                             const FileWriteConfig& config)
+{
+
+  auto stream = resource->openOutputStream();
+
+  auto fileStream = std::dynamic_pointer_cast<data::stream::FileOutputStream>(stream);
+  if(!fileStream) {
+    return stream;
+  }
+
+  if(config.bufferSize > 0) {
+    fileStream->setWriteBuffer(config.bufferSize);
+  }
+
+  if(config.preallocate) {
+    auto contentLength = part->getHeader("Content-Length");
+    if(contentLength) {
+      bool success;
+      auto size = utils::Conversion::strToInt64(contentLength, success);
+      if(success && size > 0) {
+        fileStream->preallocate(size);
+      }
+    }
+  }
+
+  return stream;
+
+}
+
+FileProvider::FileProvider(const oatpp::String& filename, const FileWriteConfig& config)
   : m_filename(filename)
+  , m_config(config)
 {}
 
 std::shared_ptr<data::resource::Resource> FileProvider::getResource(const std::shared_ptr<Part>& part) {
@@ -45,17 +79,29 @@ async::CoroutineStarter FileProvider::getResourceAsync(const std::shared_ptr<Par
   return nullptr;
 }
 
+std::shared_ptr<data::stream::OutputStream> FileProvider::openOutputStream(const std::shared_ptr<Part>& part,
+                                                                         const std::shared_ptr<data::resource::Resource>& resource)
+{
+  return openFileOutputStream(part, resource, m_config);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Other functions
 
-std::shared_ptr<PartReader> createFilePartReader(const oatpp::String& filename, v_io_size maxDataSize) {
-  auto provider = std::make_shared<FileProvider>(filename);
+std::shared_ptr<PartReader> createFilePartReader(const oatpp::String& filename,
+                                                 v_io_size maxDataSize,
+                                                 const FileWriteConfig& config)
+{
+  auto provider = std::make_shared<FileProvider>(filename, config);
   auto reader = std::make_shared<StreamPartReader>(provider, maxDataSize);
   return reader;
 }
 
-std::shared_ptr<AsyncPartReader> createAsyncFilePartReader(const oatpp::String& filename, v_io_size maxDataSize) {
-  auto provider = std::make_shared<FileProvider>(filename);
+std::shared_ptr<AsyncPartReader> createAsyncFilePartReader(const oatpp::String& filename,
+                                                           v_io_size maxDataSize,
+                                                           const FileWriteConfig& config)
+{
+  auto provider = std::make_shared<FileProvider>(filename, config);
   auto reader = std::make_shared<AsyncStreamPartReader>(provider, maxDataSize);
   return reader;
 }
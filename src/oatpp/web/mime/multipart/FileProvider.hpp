@@ -30,18 +30,56 @@
 
 namespace oatpp { namespace web { namespace mime { namespace multipart {
 
+/**
+ * Disk write options of file part providers. <br>
+ * *Note: async part readers write to the file with blocking calls, on the processor thread - file I/O is not offloaded.
+ * With a large `bufferSize` the writes happen less often, but each write that flushes the buffer takes longer.*
+ */
+struct FileWriteConfig {
+
+  /**
+   * Size of the aligned staging buffer. Part data is accumulated in the buffer and written to disk in large batches. <br>
+   * `0` - use default `std::FILE` buffering.
+   */
+  v_buff_size bufferSize = 0;
+
+  /**
+   * Reserve disk space upfront when the part has the `Content-Length` header.
+   */
+  bool preallocate = false;
+
+};
+
 class FileProvider : public PartReaderResourceProvider {
+public:
+
+  /**
+   * Open file output stream for the resource and apply &l:FileWriteConfig;. <br>
+   * If the resource's stream is not a &id:oatpp::data::stream::FileOutputStream; the config is ignored.
+   * @param part
+   * @param resource
+   * @param config - &l:FileWriteConfig;.
+   * @return - `std::shared_ptr` to &id:oatpp::data::stream::OutputStream;.
+   */
+  static std::shared_ptr<data::stream::OutputStream> openFileOutputStream(const std::shared_ptr<Part>& part,
+                                                                        const std::shared_ptr<data::resource::Resource>& resource,
+                                                                        const FileWriteConfig& config);
+
 private:
   oatpp::String m_filename;
+  FileWriteConfig m_config;
 public:
 
-  FileProvider(const oatpp::String& filename);
+  FileProvider(const oatpp::String& filename, const FileWriteConfig& config = FileWriteConfig());
 
   std::shared_ptr<data::resource::Resource> getResource(const std::shared_ptr<Part>& part) override;
 
   async::CoroutineStarter getResourceAsync(const std::shared_ptr<Part>& part,
                                            std::shared_ptr<data::resource::Resource>& resource) override;
 
+  std::shared_ptr<data::stream::OutputStream> openOutputStream(const std::shared_ptr<Part>& part,
+                                                             const std::shared_ptr<data::resource::Resource>& resource) override;
+
 };
 
 /**
@@ -49,18 +87,24 @@ public:
  * Reader will save part to a specified file.
  * @param filename - name of the file.
  * @param maxDataSize - max size of the received data. put `-1` for no-limit.
+ * @param config - &l:FileWriteConfig;.
  * @return - `std::shared_ptr` to &id:oatpp::web::mime::multipart::PartReader;.
  */
-std::shared_ptr<PartReader> createFilePartReader(const oatpp::String& filename, v_io_size maxDataSize = -1);
+std::shared_ptr<PartReader> createFilePartReader(const oatpp::String& filename,
+                                                 v_io_size maxDataSize = -1,
+                                                 const FileWriteConfig& config = FileWriteConfig());
 
 /**
  * Create async file part reader. <br>
- * Reader will save part to a specified file.
+ * Reader will save part to a specified file. File writes block the processor thread - see &l:FileWriteConfig;.
  * @param filename - name of the file.
  * @param maxDataSize - max size of the received data. put `-1` for no-limit.
+ * @param config - &l:FileWriteConfig;.
  * @return - `std::shared_ptr` to &id:oatpp::web::mime::multipart::AsyncPartReader;.
  */
-std::shared_ptr<AsyncPartReader> createAsyncFilePartReader(const oatpp::String& filename, v_io_size maxDataSize = -1);
+std::shared_ptr<AsyncPartReader> createAsyncFilePartReader(const oatpp::String& filename,
+                                                           v_io_size maxDataSize = -1,
+                                                           const FileWriteConfig& config = FileWriteConfig());
 
 }}}}
 
@@ -27,6 +27,13 @@
 
 namespace oatpp { namespace web { namespace mime { namespace multipart {
 
+std::shared_ptr<data::stream::OutputStream> PartReaderResourceProvider::openOutputStream(const std::shared_ptr<Part>& part,
+                                                                                       const std::shared_ptr<data::resource::Resource>& resource)
+{
+  (void)part;
+  return resource->openOutputStream();
+}
+
 const char* const StreamPartReader::TAG_NAME = "[oatpp::web::mime::multipart::StreamPartReader::TAG]";
 
 StreamPartReader::StreamPartReader(const std::shared_ptr<PartReaderResourceProvider>& resourceProvider,
@@ -50,7 +57,7 @@ void StreamPartReader::onNewPart(const std::shared_ptr<Part>& part) {
 
   auto tagObject = std::make_shared<TagObject>();
   tagObject->resource = m_resourceProvider->getResource(part);
-  tagObject->outputStream = tagObject->resource->openOutputStream();
+  tagObject->outputStream = m_resourceProvider->openOutputStream(part, tagObject->resource);
   part->setTag(TAG_NAME, tagObject);
 
 }
@@ -134,7 +141,7 @@ async::CoroutineStarter AsyncStreamPartReader::onNewPartAsync(const std::shared_
     Action onResourceObtained() {
       auto tagObject = std::make_shared<TagObject>();
       tagObject->resource = m_obtainedResource;
-      tagObject->outputStream = m_obtainedResource->openOutputStream();
+      tagObject->outputStream = m_resourceProvider->openOutputStream(m_part, m_obtainedResource);
       m_part->setTag(TAG_NAME, tagObject);
       return finish();
     }
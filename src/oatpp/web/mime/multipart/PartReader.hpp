@@ -115,6 +115,17 @@ public:
   virtual async::CoroutineStarter getResourceAsync(const std::shared_ptr<Part>& part,
                                                    std::shared_ptr<data::resource::Resource>& resource) = 0;
 
+  /**
+   * Open output stream to write part data to. <br>
+   * Override this method in order to tune the stream before the first write (buffering, preallocation, etc.). <br>
+   * Default implementation returns `resource->openOutputStream()`.
+   * @param part
+   * @param resource - resource obtained via `getResource` or `getResourceAsync`.
+   * @return - `std::shared_ptr` to &id:oatpp::data::stream::OutputStream;.
+   */
+  virtual std::shared_ptr<data::stream::OutputStream> openOutputStream(const std::shared_ptr<Part>& part,
+                                                                     const std::shared_ptr<data::resource::Resource>& resource);
+
 };
 
 /**
@@ -28,9 +28,12 @@
 
 namespace oatpp { namespace web { namespace mime { namespace multipart {
 
-TemporaryFileProvider::TemporaryFileProvider(const oatpp::String& tmpDirectory, v_int32 randomWordSizeBytes)
+TemporaryFileProvider::TemporaryFileProvider(const oatpp::String& tmpDirectory,
+                                             v_int32 randomWordSizeBytes,
+                                             const FileWriteConfig& config)
   : m_tmpDirectory(tmpDirectory)
   , m_randomWordSizeBytes(randomWordSizeBytes)
+  , m_config(config)
 {}
 
 std::shared_ptr<data::resource::Resource> TemporaryFileProvider::getResource(const std::shared_ptr<Part>& part) {
@@ -46,23 +49,31 @@ async::CoroutineStarter TemporaryFileProvider::getResourceAsync(const std::share
   return nullptr;
 }
 
+std::shared_ptr<data::stream::OutputStream> TemporaryFileProvider::openOutputStream(const std::shared_ptr<Part>& part,
+                                                                                  const std::shared_ptr<data::resource::Resource>& resource)
+{
+  return FileProvider::openFileOutputStream(part, resource, m_config);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Other functions
 
 std::shared_ptr<PartReader> createTemporaryFilePartReader(const oatpp::String& tmpDirectory,
                                                           v_int32 randomWordSizeBytes,
-                                                          v_io_size maxDataSize)
+                                                          v_io_size maxDataSize,
+                                                          const FileWriteConfig& config)
 {
-  auto provider = std::make_shared<TemporaryFileProvider>(tmpDirectory, randomWordSizeBytes);
+  auto provider = std::make_shared<TemporaryFileProvider>(tmpDirectory, randomWordSizeBytes, config);
   auto reader = std::make_shared<StreamPartReader>(provider, maxDataSize);
   return reader;
 }
 
 std::shared_ptr<AsyncPartReader> createAsyncTemporaryFilePartReader(const oatpp::String& tmpDirectory,
                                                                     v_int32 randomWordSizeBytes,
-                                                                    v_io_size maxDataSize)
+                                                                    v_io_size maxDataSize,
+                                                                    const FileWriteConfig& config)
 {
-  auto provider = std::make_shared<TemporaryFileProvider>(tmpDirectory, randomWordSizeBytes);
+  auto provider = std::make_shared<TemporaryFileProvider>(tmpDirectory, randomWordSizeBytes, config);
   auto reader = std::make_shared<AsyncStreamPartReader>(provider, maxDataSize);
   return reader;
 }
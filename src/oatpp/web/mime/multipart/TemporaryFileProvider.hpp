@@ -25,6 +25,7 @@
 #ifndef oatpp_web_mime_multipart_TemporaryFileProvider_hpp
 #define oatpp_web_mime_multipart_TemporaryFileProvider_hpp
 
+#include "FileProvider.hpp"
 #include "PartReader.hpp"
 #include "Reader.hpp"
 
@@ -34,15 +35,21 @@ class TemporaryFileProvider : public PartReaderResourceProvider {
 private:
   oatpp::String m_tmpDirectory;
   v_int32 m_randomWordSizeBytes;
+  FileWriteConfig m_config;
 public:
 
-  TemporaryFileProvider(const oatpp::String& tmpDirectory, v_int32 randomWordSizeBytes = 8);
+  TemporaryFileProvider(const oatpp::String& tmpDirectory,
+                        v_int32 randomWordSizeBytes = 8,
+                        const FileWriteConfig& config = FileWriteConfig());
 
   std::shared_ptr<data::resource::Resource> getResource(const std::shared_ptr<Part>& part) override;
 
   async::CoroutineStarter getResourceAsync(const std::shared_ptr<Part>& part,
                                            std::shared_ptr<data::resource::Resource>& resource) override;
 
+  std::shared_ptr<data::stream::OutputStream> openOutputStream(const std::shared_ptr<Part>& part,
+                                                             const std::shared_ptr<data::resource::Resource>& resource) override;
+
 };
 
 /**
@@ -50,22 +57,27 @@ public:
  * @param tmpDirectory - directory for temporary files.
  * @param randomWordSizeBytes - number of random bytes to generate file name.
  * @param maxDataSize - max size of the received data. put `-1` for no-limit.
+ * @param config - &id:oatpp::web::mime::multipart::FileWriteConfig;.
  * @return - `std::shared_ptr` to &id:oatpp::web::mime::multipart::PartReader;.
  */
 std::shared_ptr<PartReader> createTemporaryFilePartReader(const oatpp::String& tmpDirectory,
                                                           v_int32 randomWordSizeBytes = 8,
-                                                          v_io_size maxDataSize = -1);
+                                                          v_io_size maxDataSize = -1,
+                                                          const FileWriteConfig& config = FileWriteConfig());
 
 /**
- * Create async part reader to a temporary file.
+ * Create async part reader to a temporary file. <br>
+ * The temporary file is written synchronously, on the processor thread (see &id:oatpp::web::mime::multipart::FileWriteConfig;).
  * @param tmpDirectory - directory for temporary files.
  * @param randomWordSizeBytes - number of random bytes to generate file name.
  * @param maxDataSize - max size of the received data. put `-1` for no-limit.
+ * @param config - &id:oatpp::web::mime::multipart::FileWriteConfig;.
  * @return - `std::shared_ptr` to &id:oatpp::web::mime::multipart::AsyncPartReader;.
  */
 std::shared_ptr<AsyncPartReader> createAsyncTemporaryFilePartReader(const oatpp::String& tmpDirectory,
                                                                     v_int32 randomWordSizeBytes = 8,
-                                                                    v_io_size maxDataSize = -1);
+                                                                    v_io_size maxDataSize = -1,
+                                                                    const FileWriteConfig& config = FileWriteConfig());
 
 }}}}
 
@@ -24,13 +24,41 @@
 
 #include "Chunked.hpp"
 
-#include "oatpp/utils/Conversion.hpp"
-
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // EncoderChunked
 
+v_buff_size EncoderChunked::writeChunkHeader(p_char8 buffer, v_io_size chunkSize, bool firstChunk) {
+
+  static const char* HEX = "0123456789ABCDEF";
+
+  v_buff_size size = 0;
+
+  if(!firstChunk) {
+    buffer[size ++] = '\r';
+    buffer[size ++] = '\n';
+  }
+
+  v_char8 digits[16];
+  v_buff_size digitsCount = 0;
+  auto value = static_cast<v_uint64>(chunkSize);
+  do {
+    digits[digitsCount ++] = static_cast<v_char8>(HEX[value & 0xF]);
+    value >>= 4;
+  } while(value > 0);
+
+  while(digitsCount > 0) {
+    buffer[size ++] = digits[-- digitsCount];
+  }
+
+  buffer[size ++] = '\r';
+  buffer[size ++] = '\n';
+
+  return size;
+
+}
+
 v_io_size EncoderChunked::suggestInputStreamReadSize() {
   return 32767;
 }
@@ -59,17 +87,8 @@ v_int32 EncoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
 
     if(m_writeChunkHeader) {
 
-      async::Action action;
-      data::stream::BufferOutputStream stream(16);
-      if(!m_firstChunk) {
-        stream.write("\r\n", 2, action);
-      }
-
-      stream << utils::Conversion::primitiveToStr(dataIn.bytesLeft, "%X");
-      stream.write("\r\n", 2, action);
-
-      m_chunkHeader = stream.toString();
-      dataOut.set(reinterpret_cast<p_char8>(m_chunkHeader->data()), static_cast<v_buff_size>(m_chunkHeader->size()));
+      auto size = writeChunkHeader(m_chunkHeader, dataIn.bytesLeft, m_firstChunk);
+      dataOut.set(m_chunkHeader, size);
 
       m_firstChunk = false;
       m_writeChunkHeader = false;
@@ -87,16 +106,10 @@ v_int32 EncoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
 
   if(m_writeChunkHeader){
 
-    async::Action action;
-    data::stream::BufferOutputStream stream(16);
-    if(!m_firstChunk) {
-      stream.write("\r\n", 2, action);
-    }
-
-    stream.write("0\r\n\r\n", 5, action);
-
-    m_chunkHeader = stream.toString();
-    dataOut.set(reinterpret_cast<p_char8>(m_chunkHeader->data()), static_cast<v_buff_size>(m_chunkHeader->size()));
+    auto size = writeChunkHeader(m_chunkHeader, 0, m_firstChunk);
+    m_chunkHeader[size ++] = '\r';
+    m_chunkHeader[size ++] = '\n';
+    dataOut.set(m_chunkHeader, size);
 
     m_firstChunk = false;
     m_writeChunkHeader = false;
@@ -115,70 +128,147 @@ v_int32 EncoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
 // DecoderChunked
 
 DecoderChunked::DecoderChunked()
-  : m_chunkHeaderBuffer(16)
+  : m_headerState(SIZE)
+  , m_chunkSize(0)
+  , m_chunkSizeDigits(0)
+  , m_headerLineSize(0)
   , m_currentChunkSize(-1)
-  , m_firstChunk(true)
   , m_finished(false)
   , m_lastFlush(0)
 {}
 
 v_io_size DecoderChunked::suggestInputStreamReadSize() {
-  if(m_currentChunkSize > 0) {
-    return m_currentChunkSize;
-  }
-  return 1;
-}
-
-v_int32 DecoderChunked::readHeader(data::buffer::InlineReadData& dataIn) {
 
-  async::Action action;
+  /* Never ask for more than what is guaranteed to belong to the chunked body - the rest of the stream is not ours */
 
-  while(dataIn.bytesLeft > 0 && m_currentChunkSize < 0) {
-
-    if (m_chunkHeaderBuffer.getCurrentPosition() < 12) {
-
-      m_chunkHeaderBuffer.write(dataIn.currBufferPtr, 1, action);
-      dataIn.inc(1);
+  if(m_currentChunkSize > 0) {
+    return m_currentChunkSize + 5; // chunk data + "\r\n" + shortest chunk-size line
+  }
 
-      auto pos = m_chunkHeaderBuffer.getCurrentPosition();
+  switch(m_headerState) {
+    case DATA_CR: return 5;
+    case DATA_LF: return 4;
+    case SIZE: return m_chunkSizeDigits == 0 ? 3 : 2;
+    case EXTENSION: return 2;
+    case SIZE_LF: return m_chunkSize == 0 ? 3 : 2;
+    case TRAILER_START: return 2;
+    case TRAILER: return 2;
+    case TRAILER_LF: return 3;
+    case FINAL_LF: return 1;
+    default:
+      return 1;
+  }
 
-      if(m_currentChunkSize == -1) {
+}
 
-        if (pos > 2 && m_chunkHeaderBuffer.getData()[pos - 2] == '\r' && m_chunkHeaderBuffer.getData()[pos - 1] == '\n') {
+v_int32 DecoderChunked::readHeader(data::buffer::InlineReadData& dataIn) {
 
-          if(m_firstChunk) {
-            m_currentChunkSize = strtol(reinterpret_cast<const char *>(m_chunkHeaderBuffer.getData()), nullptr, 16);
-          } else {
-            // skip "/r/n" before chunk size
-            m_currentChunkSize = strtol(reinterpret_cast<const char *>(m_chunkHeaderBuffer.getData() + 2), nullptr, 16);
-          }
+  auto data = reinterpret_cast<const v_char8*>(dataIn.currBufferPtr);
+  v_buff_size size = dataIn.bytesLeft;
+  v_buff_size i = 0;
+
+  while(i < size) {
+
+    v_char8 a = data[i ++];
+
+    switch(m_headerState) {
+
+      case DATA_CR:
+        if(a != '\r') return ERROR_CHUNK_HEADER_INVALID;
+        m_headerState = DATA_LF;
+        break;
+
+      case DATA_LF:
+        if(a != '\n') return ERROR_CHUNK_HEADER_INVALID;
+        m_headerState = SIZE;
+        break;
+
+      case SIZE: {
+        v_int32 digit;
+        if(a >= '0' && a <= '9') {
+          digit = a - '0';
+        } else if(a >= 'a' && a <= 'f') {
+          digit = a - 'a' + 10;
+        } else if(a >= 'A' && a <= 'F') {
+          digit = a - 'A' + 10;
+        } else if(m_chunkSizeDigits == 0) {
+          return ERROR_CHUNK_HEADER_INVALID;
+        } else if(a == '\r') {
+          m_headerState = SIZE_LF;
+          break;
+        } else if(a == ';' || a == ' ' || a == '\t') {
+          m_headerState = EXTENSION;
+          m_headerLineSize = 0;
+          break;
+        } else {
+          return ERROR_CHUNK_HEADER_INVALID;
+        }
+        if(m_chunkSizeDigits == 15) {
+          return ERROR_CHUNK_HEADER_TOO_LONG;
+        }
+        m_chunkSize = (m_chunkSize << 4) | digit;
+        m_chunkSizeDigits ++;
+        break;
+      }
 
-          if (m_currentChunkSize > 0) {
-            return Error::OK;
-          } else {
-            m_currentChunkSize = -2;
-          }
+      case EXTENSION:
+        if(a == '\r') {
+          m_headerState = SIZE_LF;
+        } else if(++ m_headerLineSize > MAX_HEADER_LINE_SIZE) {
+          return ERROR_CHUNK_HEADER_TOO_LONG;
+        }
+        break;
+
+      case SIZE_LF:
+        if(a != '\n') return ERROR_CHUNK_HEADER_INVALID;
+        if(m_chunkSize > 0) {
+          m_currentChunkSize = m_chunkSize;
+          m_chunkSize = 0;
+          m_chunkSizeDigits = 0;
+          m_headerState = DATA_CR;
+          dataIn.inc(i);
+          return Error::OK;
+        }
+        m_headerState = TRAILER_START;
+        break;
+
+      case TRAILER_START:
+        if(a == '\r') {
+          m_headerState = FINAL_LF;
+        } else {
+          m_headerState = TRAILER;
+          m_headerLineSize = 1;
+        }
+        break;
 
+      case TRAILER:
+        if(a == '\r') {
+          m_headerState = TRAILER_LF;
+        } else if(++ m_headerLineSize > MAX_HEADER_LINE_SIZE) {
+          return ERROR_CHUNK_HEADER_TOO_LONG;
         }
+        break;
 
-      } else if(m_currentChunkSize == -2) {
+      case TRAILER_LF:
+        if(a != '\n') return ERROR_CHUNK_HEADER_INVALID;
+        m_headerState = TRAILER_START;
+        break;
 
-        if (pos > 4 &&
-            m_chunkHeaderBuffer.getData()[pos - 4] == '\r' && m_chunkHeaderBuffer.getData()[pos - 3] == '\n' &&
-            m_chunkHeaderBuffer.getData()[pos - 2] == '\r' && m_chunkHeaderBuffer.getData()[pos - 1] == '\n') {
-          m_currentChunkSize = 0;
-          m_finished = true;
-          return Error::OK;
-        }
+      case FINAL_LF:
+        if(a != '\n') return ERROR_CHUNK_HEADER_INVALID;
+        m_currentChunkSize = 0;
+        m_finished = true;
+        dataIn.inc(i);
+        return Error::OK;
 
-      }
+      default:
+        return ERROR_CHUNK_HEADER_INVALID;
 
-    } else {
-      return ERROR_CHUNK_HEADER_TOO_LONG;
     }
 
   }
 
+  dataIn.inc(i);
   return Error::PROVIDE_DATA_IN;
 
 }
@@ -212,14 +302,11 @@ v_int32 DecoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
     if(m_currentChunkSize < 0) {
       return readHeader(dataIn);
     } else if(m_currentChunkSize == 0) {
-      m_chunkHeaderBuffer.setCurrentPosition(0);
       dataOut.set(nullptr, 0);
       m_finished = true;
       return Error::FINISHED;
     }
 
-    m_chunkHeaderBuffer.setCurrentPosition(0);
-
     m_lastFlush = dataIn.bytesLeft;
     if(m_lastFlush > m_currentChunkSize) {
       m_lastFlush = m_currentChunkSize;
@@ -230,7 +317,6 @@ v_int32 DecoderChunked::iterate(data::buffer::InlineReadData& dataIn, data::buff
 
   }
 
-  m_chunkHeaderBuffer.setCurrentPosition(0);
   dataOut.set(nullptr, 0);
   m_finished = true;
   return Error::FINISHED;
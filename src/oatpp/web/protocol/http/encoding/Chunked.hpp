@@ -35,7 +35,14 @@ namespace oatpp { namespace web { namespace protocol { namespace http { namespac
  */
 class EncoderChunked : public data::buffer::Processor {
 private:
-  oatpp::String m_chunkHeader;
+  /*
+   * "\r\n" + up to 16 hex digits + "\r\n"
+   */
+  static constexpr v_buff_size MAX_CHUNK_HEADER_SIZE = 20;
+private:
+  static v_buff_size writeChunkHeader(p_char8 buffer, v_io_size chunkSize, bool firstChunk);
+private:
+  v_char8 m_chunkHeader[MAX_CHUNK_HEADER_SIZE];
   bool m_writeChunkHeader = true;
   bool m_firstChunk = true;
   bool m_finished = false;
@@ -66,10 +73,36 @@ public:
 class DecoderChunked : public data::buffer::Processor {
 public:
   static constexpr v_int32 ERROR_CHUNK_HEADER_TOO_LONG = 100;
+  static constexpr v_int32 ERROR_CHUNK_HEADER_INVALID = 101;
+public:
+  /**
+   * Max size of chunk-extension or trailer line.
+   */
+  static constexpr v_io_size MAX_HEADER_LINE_SIZE = 1024;
+private:
+
+  /*
+   * Chunk header is parsed byte-by-byte by this state machine straight from the input data -
+   * so that header split between reads doesn't need to be buffered.
+   */
+  enum HeaderState : v_int32 {
+    DATA_CR,        // '\r' after chunk data
+    DATA_LF,        // '\n' after chunk data
+    SIZE,           // chunk-size hex digits
+    EXTENSION,      // chunk-extension - skipped
+    SIZE_LF,        // '\n' of the chunk-size line
+    TRAILER_START,  // start of the trailer line or final '\r'
+    TRAILER,        // trailer line - skipped
+    TRAILER_LF,     // '\n' of the trailer line
+    FINAL_LF        // final '\n'
+  };
+
 private:
-  data::stream::BufferOutputStream m_chunkHeaderBuffer;
+  HeaderState m_headerState;
+  v_io_size m_chunkSize;
+  v_int32 m_chunkSizeDigits;
+  v_io_size m_headerLineSize;
   v_io_size m_currentChunkSize;
-  bool m_firstChunk;
   bool m_finished;
   v_io_size m_lastFlush;
 private:
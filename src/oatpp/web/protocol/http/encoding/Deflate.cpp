@@ -0,0 +1,466 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "Deflate.hpp"
+
+#ifdef OATPP_ZLIB_ENABLED
+#include <zlib.h>
+#endif
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+#ifdef OATPP_ZLIB_ENABLED
+
+namespace {
+
+/*
+ * Per-thread pool of initialized z_streams.
+ * Deflate state is a few hundred KB - reset of the pooled stream is much cheaper than init/end per response.
+ */
+class ZStreamPool {
+public:
+  static constexpr size_t MAX_STREAMS = 8;
+public:
+  enum Mode : v_int32 {
+    DEFLATE = 0,
+    INFLATE = 1
+  };
+private:
+  struct Entry {
+    Mode mode;
+    v_int32 windowBits;
+    v_int32 level;
+    z_stream* stream;
+  };
+private:
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+  /* trivially destructible - remains valid while other thread_local objects are destroyed */
+  static thread_local bool DESTROYED;
+#endif
+private:
+  std::vector<Entry> m_entries;
+public:
+
+  ~ZStreamPool() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+    DESTROYED = true;
+#endif
+    for(auto& entry : m_entries) {
+      end(entry.mode, entry.stream);
+    }
+  }
+
+  static ZStreamPool* getThreadPool() {
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+    if(DESTROYED) {
+      return nullptr;
+    }
+    static thread_local ZStreamPool pool;
+    return &pool;
+#else
+    return nullptr;
+#endif
+  }
+
+  static z_stream* acquire(Mode mode, v_int32 windowBits, v_int32 level) {
+
+    auto pool = getThreadPool();
+    if(pool != nullptr) {
+      for(auto it = pool->m_entries.begin(); it != pool->m_entries.end(); it ++) {
+        if(it->mode == mode && it->windowBits == windowBits && it->level == level) {
+          auto stream = it->stream;
+          pool->m_entries.erase(it);
+          return stream;
+        }
+      }
+    }
+
+    auto stream = new z_stream();
+    int res;
+    if(mode == DEFLATE) {
+      res = deflateInit2(stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+    } else {
+      res = inflateInit2(stream, windowBits);
+    }
+
+    if(res != Z_OK) {
+      delete stream;
+      throw std::runtime_error("[oatpp::web::protocol::http::encoding::ZStreamPool::acquire()]: Error. Can't initialize z_stream.");
+    }
+
+    return stream;
+
+  }
+
+  static void release(Mode mode, v_int32 windowBits, v_int32 level, z_stream* stream) {
+
+    int res;
+    if(mode == DEFLATE) {
+      res = deflateReset(stream);
+    } else {
+      res = inflateReset(stream);
+    }
+
+    auto pool = getThreadPool();
+    if(res == Z_OK && pool != nullptr && pool->m_entries.size() < MAX_STREAMS) {
+      pool->m_entries.push_back({mode, windowBits, level, stream});
+      return;
+    }
+
+    end(mode, stream);
+
+  }
+
+  static void end(Mode mode, z_stream* stream) {
+    if(mode == DEFLATE) {
+      deflateEnd(stream);
+    } else {
+      inflateEnd(stream);
+    }
+    delete stream;
+  }
+
+};
+
+#ifndef OATPP_COMPAT_BUILD_NO_THREAD_LOCAL
+thread_local bool ZStreamPool::DESTROYED = false;
+#endif
+
+v_int32 getWindowBits(DeflateFormat format) {
+  if(format == DeflateFormat::GZIP) {
+    return MAX_WBITS + 16;
+  }
+  return MAX_WBITS;
+}
+
+uInt getAvailableSize(v_buff_size size) {
+  if(size > static_cast<v_buff_size>(std::numeric_limits<uInt>::max())) {
+    return std::numeric_limits<uInt>::max();
+  }
+  return static_cast<uInt>(size);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateEncoder
+
+DeflateEncoder::DeflateEncoder(DeflateFormat format, v_int32 level)
+  : m_format(format)
+  , m_level(level)
+  , m_stream(ZStreamPool::acquire(ZStreamPool::DEFLATE, getWindowBits(format), level))
+  , m_pendingOutput(false)
+  , m_finished(false)
+{}
+
+DeflateEncoder::~DeflateEncoder() {
+  ZStreamPool::release(ZStreamPool::DEFLATE, getWindowBits(m_format), m_level, m_stream);
+}
+
+v_io_size DeflateEncoder::suggestInputStreamReadSize() {
+  return BUFFER_SIZE;
+}
+
+v_int32 DeflateEncoder::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(m_finished) {
+    dataOut.set(nullptr, 0);
+    return Error::FINISHED;
+  }
+
+  int flush = Z_FINISH;
+  uInt inSize = 0;
+
+  if(dataIn.currBufferPtr != nullptr) {
+
+    if(dataIn.bytesLeft == 0 && !m_pendingOutput) {
+      return Error::PROVIDE_DATA_IN;
+    }
+
+    flush = Z_NO_FLUSH;
+    inSize = getAvailableSize(dataIn.bytesLeft);
+    m_stream->next_in = static_cast<Bytef*>(dataIn.currBufferPtr);
+
+  } else {
+    m_stream->next_in = nullptr;
+  }
+
+  m_stream->avail_in = inSize;
+  m_stream->next_out = m_buffer;
+  m_stream->avail_out = BUFFER_SIZE;
+
+  auto res = deflate(m_stream, flush);
+  if(res == Z_STREAM_ERROR) {
+    return ERROR_STREAM;
+  }
+
+  if(flush == Z_NO_FLUSH) {
+    dataIn.inc(static_cast<v_buff_size>(inSize - m_stream->avail_in));
+  }
+
+  m_pendingOutput = m_stream->avail_out == 0;
+  m_finished = res == Z_STREAM_END;
+
+  auto produced = BUFFER_SIZE - static_cast<v_buff_size>(m_stream->avail_out);
+  if(produced > 0) {
+    dataOut.set(m_buffer, produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(flush == Z_NO_FLUSH && dataIn.bytesLeft == 0) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  return Error::OK;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateDecoder
+
+DeflateDecoder::DeflateDecoder(DeflateFormat format)
+  : m_format(format)
+  , m_stream(ZStreamPool::acquire(ZStreamPool::INFLATE, getWindowBits(format), 0))
+  , m_pendingOutput(false)
+  , m_finished(false)
+{}
+
+DeflateDecoder::~DeflateDecoder() {
+  ZStreamPool::release(ZStreamPool::INFLATE, getWindowBits(m_format), 0, m_stream);
+}
+
+v_io_size DeflateDecoder::suggestInputStreamReadSize() {
+  return BUFFER_SIZE / 4;
+}
+
+v_int32 DeflateDecoder::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+
+  if(dataOut.bytesLeft > 0) {
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  uInt inSize = 0;
+
+  if(dataIn.currBufferPtr != nullptr) {
+
+    if(m_finished) {
+      /* ignore data after the end of compressed stream */
+      dataIn.setEof();
+      return Error::PROVIDE_DATA_IN;
+    }
+
+    if(dataIn.bytesLeft == 0 && !m_pendingOutput) {
+      return Error::PROVIDE_DATA_IN;
+    }
+
+    inSize = getAvailableSize(dataIn.bytesLeft);
+    m_stream->next_in = static_cast<Bytef*>(dataIn.currBufferPtr);
+
+  } else {
+
+    if(m_finished) {
+      dataOut.set(nullptr, 0);
+      return Error::FINISHED;
+    }
+
+    if(!m_pendingOutput) {
+      return ERROR_UNEXPECTED_END;
+    }
+
+    m_stream->next_in = nullptr;
+
+  }
+
+  m_stream->avail_in = inSize;
+  m_stream->next_out = m_buffer;
+  m_stream->avail_out = BUFFER_SIZE;
+
+  auto res = inflate(m_stream, Z_NO_FLUSH);
+
+  switch(res) {
+    case Z_OK:
+    case Z_BUF_ERROR:
+      break;
+    case Z_STREAM_END:
+      m_finished = true;
+      break;
+    case Z_NEED_DICT:
+    case Z_DATA_ERROR:
+      return ERROR_DATA;
+    default:
+      return ERROR_STREAM;
+  }
+
+  if(dataIn.currBufferPtr != nullptr) {
+    dataIn.inc(static_cast<v_buff_size>(inSize - m_stream->avail_in));
+  }
+
+  m_pendingOutput = m_stream->avail_out == 0;
+
+  auto produced = BUFFER_SIZE - static_cast<v_buff_size>(m_stream->avail_out);
+  if(produced > 0) {
+    dataOut.set(m_buffer, produced);
+    return Error::FLUSH_DATA_OUT;
+  }
+
+  if(dataIn.currBufferPtr != nullptr && dataIn.bytesLeft == 0 && !m_finished) {
+    return Error::PROVIDE_DATA_IN;
+  }
+
+  return Error::OK;
+
+}
+
+#else
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Built without zlib
+
+/* constructors always throw in this build - don't suggest noreturn for them (till the end of file) */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
+#endif
+
+DeflateEncoder::DeflateEncoder(DeflateFormat format, v_int32 level)
+  : m_format(format)
+  , m_level(level)
+  , m_stream(nullptr)
+  , m_pendingOutput(false)
+  , m_finished(false)
+{
+  throw std::runtime_error("[oatpp::web::protocol::http::encoding::DeflateEncoder::DeflateEncoder()]: Error. oatpp is built without zlib.");
+}
+
+DeflateEncoder::~DeflateEncoder() = default;
+
+v_io_size DeflateEncoder::suggestInputStreamReadSize() {
+  return BUFFER_SIZE;
+}
+
+v_int32 DeflateEncoder::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+  (void) dataIn;
+  (void) dataOut;
+  return ERROR_STREAM;
+}
+
+DeflateDecoder::DeflateDecoder(DeflateFormat format)
+  : m_format(format)
+  , m_stream(nullptr)
+  , m_pendingOutput(false)
+  , m_finished(false)
+{
+  throw std::runtime_error("[oatpp::web::protocol::http::encoding::DeflateDecoder::DeflateDecoder()]: Error. oatpp is built without zlib.");
+}
+
+DeflateDecoder::~DeflateDecoder() = default;
+
+v_io_size DeflateDecoder::suggestInputStreamReadSize() {
+  return BUFFER_SIZE;
+}
+
+v_int32 DeflateDecoder::iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) {
+  (void) dataIn;
+  (void) dataOut;
+  return ERROR_STREAM;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateEncoderProvider
+
+DeflateEncoderProvider::DeflateEncoderProvider(DeflateFormat format,
+                                               v_int32 level,
+                                               const std::shared_ptr<EncodedBufferCache>& cache)
+  : m_format(format)
+  , m_level(level)
+  , m_encodingName(format == DeflateFormat::GZIP ? "gzip" : "deflate")
+  , m_cache(cache)
+{
+#ifndef OATPP_ZLIB_ENABLED
+  throw std::runtime_error("[oatpp::web::protocol::http::encoding::DeflateEncoderProvider::DeflateEncoderProvider()]: Error. oatpp is built without zlib.");
+#endif
+  if(level < DeflateEncoder::DEFAULT_LEVEL || level > 9) {
+    throw std::runtime_error("[oatpp::web::protocol::http::encoding::DeflateEncoderProvider::DeflateEncoderProvider()]: Error. Invalid compression level.");
+  }
+}
+
+oatpp::String DeflateEncoderProvider::getEncodingName() {
+  return m_encodingName;
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateEncoderProvider::getProcessor() {
+  return std::make_shared<DeflateEncoder>(m_format, m_level);
+}
+
+EncodedBufferCache* DeflateEncoderProvider::getEncodedBufferCache() {
+  return m_cache.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeflateDecoderProvider
+
+DeflateDecoderProvider::DeflateDecoderProvider(DeflateFormat format)
+  : m_format(format)
+  , m_encodingName(format == DeflateFormat::GZIP ? "gzip" : "deflate")
+{
+#ifndef OATPP_ZLIB_ENABLED
+  throw std::runtime_error("[oatpp::web::protocol::http::encoding::DeflateDecoderProvider::DeflateDecoderProvider()]: Error. oatpp is built without zlib.");
+#endif
+}
+
+oatpp::String DeflateDecoderProvider::getEncodingName() {
+  return m_encodingName;
+}
+
+std::shared_ptr<data::buffer::Processor> DeflateDecoderProvider::getProcessor() {
+  return std::make_shared<DeflateDecoder>(m_format);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GzipEncoderProvider / GzipDecoderProvider
+
+GzipEncoderProvider::GzipEncoderProvider(v_int32 level, const std::shared_ptr<EncodedBufferCache>& cache)
+  : DeflateEncoderProvider(DeflateFormat::GZIP, level, cache)
+{}
+
+GzipDecoderProvider::GzipDecoderProvider()
+  : DeflateDecoderProvider(DeflateFormat::GZIP)
+{}
+
+#if defined(__GNUC__) && !defined(__clang__) && !defined(OATPP_ZLIB_ENABLED)
+#pragma GCC diagnostic pop
+#endif
+
+}}}}}
@@ -0,0 +1,264 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_Deflate_hpp
+#define oatpp_web_protocol_http_encoding_Deflate_hpp
+
+#include "EncodedBufferCache.hpp"
+
+struct z_stream_s;
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+/**
+ * Format of the compressed data.
+ */
+enum class DeflateFormat : v_int32 {
+
+  /**
+   * "gzip" - RFC 1952.
+   */
+  GZIP = 0,
+
+  /**
+   * "deflate" - zlib data format RFC 1950.
+   */
+  ZLIB = 1
+
+};
+
+/**
+ * Deflate-encoding buffer processor. &id:oatpp::data::buffer::Processor;. <br>
+ * z_streams are reused through the per-thread pool, so creating an encoder per response is cheap. <br>
+ * *Available only if oatpp is built with zlib (`OATPP_LINK_ZLIB`). Otherwise constructor throws.*
+ */
+class DeflateEncoder : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_STREAM = 100;
+public:
+  /**
+   * Default compression level (zlib `Z_DEFAULT_COMPRESSION`).
+   */
+  static constexpr v_int32 DEFAULT_LEVEL = -1;
+
+  /**
+   * Size of the output buffer.
+   */
+  static constexpr v_buff_size BUFFER_SIZE = 16 * 1024;
+private:
+  DeflateFormat m_format;
+  v_int32 m_level;
+  z_stream_s* m_stream;
+  bool m_pendingOutput;
+  bool m_finished;
+  v_char8 m_buffer[BUFFER_SIZE];
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   * @param level - compression level `0..9` or &l:DeflateEncoder::DEFAULT_LEVEL;.
+   */
+  DeflateEncoder(DeflateFormat format, v_int32 level = DEFAULT_LEVEL);
+
+  /**
+   * Destructor. Returns z_stream to the per-thread pool.
+   */
+  ~DeflateEncoder() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+};
+
+/**
+ * Deflate-decoding buffer processor. &id:oatpp::data::buffer::Processor;. <br>
+ * Data following the end of the compressed stream is ignored. <br>
+ * *Available only if oatpp is built with zlib (`OATPP_LINK_ZLIB`). Otherwise constructor throws.*
+ */
+class DeflateDecoder : public data::buffer::Processor {
+public:
+  static constexpr v_int32 ERROR_STREAM = 100;
+  static constexpr v_int32 ERROR_DATA = 101;
+  static constexpr v_int32 ERROR_UNEXPECTED_END = 102;
+public:
+  /**
+   * Size of the output buffer.
+   */
+  static constexpr v_buff_size BUFFER_SIZE = 16 * 1024;
+private:
+  DeflateFormat m_format;
+  z_stream_s* m_stream;
+  bool m_pendingOutput;
+  bool m_finished;
+  v_char8 m_buffer[BUFFER_SIZE];
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   */
+  DeflateDecoder(DeflateFormat format);
+
+  /**
+   * Destructor. Returns z_stream to the per-thread pool.
+   */
+  ~DeflateDecoder() override;
+
+  /**
+   * If the client is using the input stream to read data and add it to the processor,
+   * the client MAY ask the processor for a suggested read size.
+   * @return - suggested read size.
+   */
+  v_io_size suggestInputStreamReadSize() override;
+
+  /**
+   * Process data.
+   * @param dataIn - data provided by client to processor. Input data. &id:data::buffer::InlineReadData;.
+   * Set `dataIn` buffer pointer to `nullptr` to designate the end of input.
+   * @param dataOut - data provided to client by processor. Output data. &id:data::buffer::InlineReadData;.
+   * @return - &l:Processor::Error;.
+   */
+  v_int32 iterate(data::buffer::InlineReadData& dataIn, data::buffer::InlineReadData& dataOut) override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" and "deflate" encodings.
+ */
+class DeflateEncoderProvider : public EncoderProvider {
+private:
+  DeflateFormat m_format;
+  v_int32 m_level;
+  oatpp::String m_encodingName;
+  std::shared_ptr<EncodedBufferCache> m_cache;
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   * @param level - compression level `0..9` or &l:DeflateEncoder::DEFAULT_LEVEL;.
+   * @param cache - &id:oatpp::web::protocol::http::encoding::EncodedBufferCache;.
+   * Set to cache encoded immutable &id:oatpp::web::protocol::http::outgoing::BufferBody; responses.
+   */
+  DeflateEncoderProvider(DeflateFormat format = DeflateFormat::ZLIB,
+                         v_int32 level = DeflateEncoder::DEFAULT_LEVEL,
+                         const std::shared_ptr<EncodedBufferCache>& cache = nullptr);
+
+  /**
+   * Get encoding name.
+   * @return - "gzip" or "deflate".
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::web::protocol::http::encoding::DeflateEncoder;.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+  /**
+   * Get cache of encoded immutable buffers.
+   * @return - &id:oatpp::web::protocol::http::encoding::EncodedBufferCache;. `nullptr` if not set.
+   */
+  EncodedBufferCache* getEncodedBufferCache() override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" and "deflate" decoding.
+ */
+class DeflateDecoderProvider : public EncoderProvider {
+private:
+  DeflateFormat m_format;
+  oatpp::String m_encodingName;
+public:
+
+  /**
+   * Constructor.
+   * @param format - &l:DeflateFormat;.
+   */
+  DeflateDecoderProvider(DeflateFormat format = DeflateFormat::ZLIB);
+
+  /**
+   * Get encoding name.
+   * @return - "gzip" or "deflate".
+   */
+  oatpp::String getEncodingName() override;
+
+  /**
+   * Get &id:oatpp::web::protocol::http::encoding::DeflateDecoder;.
+   * @return - &id:oatpp::data::buffer::Processor;
+   */
+  std::shared_ptr<data::buffer::Processor> getProcessor() override;
+
+};
+
+/**
+ * EncoderProvider for "gzip" encoding.
+ */
+class GzipEncoderProvider : public DeflateEncoderProvider {
+public:
+
+  /**
+   * Constructor.
+   * @param level - compression level `0..9` or &l:DeflateEncoder::DEFAULT_LEVEL;.
+   * @param cache - &id:oatpp::web::protocol::http::encoding::EncodedBufferCache;.
+   * Set to cache encoded immutable &id:oatpp::web::protocol::http::outgoing::BufferBody; responses.
+   */
+  GzipEncoderProvider(v_int32 level = DeflateEncoder::DEFAULT_LEVEL,
+                      const std::shared_ptr<EncodedBufferCache>& cache = nullptr);
+
+};
+
+/**
+ * EncoderProvider for "gzip" decoding.
+ */
+class GzipDecoderProvider : public DeflateDecoderProvider {
+public:
+
+  /**
+   * Constructor.
+   */
+  GzipDecoderProvider();
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_encoding_Deflate_hpp
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "EncodedBufferCache.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/data/buffer/IOBuffer.hpp"
+
+namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
+
+bool EncodedBufferCache::Key::operator==(const Key& other) const {
+  return buffer == other.buffer && encoding == other.encoding;
+}
+
+std::size_t EncodedBufferCache::KeyHash::operator()(const Key& key) const {
+  return std::hash<const std::string*>{}(key.buffer) ^ std::hash<std::string>{}(*key.encoding);
+}
+
+EncodedBufferCache::EncodedBufferCache(v_buff_size maxSize, v_buff_size maxBufferSize)
+  : m_maxSize(maxSize)
+  , m_maxBufferSize(maxBufferSize)
+  , m_size(0)
+{}
+
+void EncodedBufferCache::removeEntry(std::list<Entry>::iterator it) {
+  m_size -= static_cast<v_buff_size>(it->encoded->size());
+  m_index.erase(it->key);
+  m_entries.erase(it);
+}
+
+oatpp::String EncodedBufferCache::encode(const oatpp::String& buffer, EncoderProvider* provider) {
+  data::stream::BufferInputStream inStream(buffer);
+  data::stream::BufferOutputStream outStream(static_cast<v_buff_size>(buffer->size() / 2) + 64);
+  data::buffer::IOBuffer ioBuffer;
+  auto processor = provider->getProcessor();
+  data::stream::transfer(&inStream, &outStream, 0, ioBuffer.getData(), ioBuffer.getSize(), processor);
+  return outStream.toString();
+}
+
+oatpp::String EncodedBufferCache::get(const outgoing::BufferBody& body, EncoderProvider* provider) {
+
+  /* buffers are keyed by address - only bodies that promise not to change may be cached */
+  if(!body.isImmutable()) {
+    return nullptr;
+  }
+
+  auto buffer = body.getBuffer();
+  if(!buffer || static_cast<v_buff_size>(buffer->size()) > m_maxBufferSize) {
+    return nullptr;
+  }
+
+  Key key{buffer.get(), provider->getEncodingName()};
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if(it != m_index.end()) {
+      auto entry = it->second;
+      /* size check catches the most obvious in-place modifications of the "immutable" buffer */
+      if(entry->source.lock() == buffer.getPtr() && entry->sourceSize == static_cast<v_buff_size>(buffer->size())) {
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return entry->encoded;
+      }
+      /* same address is reused by the other buffer or the buffer was modified */
+      removeEntry(entry);
+    }
+  }
+
+  auto encoded = encode(buffer, provider);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_index.find(key);
+  if(it != m_index.end()) {
+    /* encoded concurrently */
+    removeEntry(it->second);
+  }
+
+  m_entries.push_front({key, buffer.getPtr(), static_cast<v_buff_size>(buffer->size()), encoded});
+  m_index.insert({key, m_entries.begin()});
+  m_size += static_cast<v_buff_size>(encoded->size());
+
+  while(m_size > m_maxSize && !m_entries.empty()) {
+    removeEntry(std::prev(m_entries.end()));
+  }
+
+  return encoded;
+
+}
+
+v_buff_size EncodedBufferCache::getSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_size;
+}
+
+v_buff_size EncodedBufferCache::getEntriesCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_buff_size>(m_entries.size());
+}
+
+void EncodedBufferCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_index.clear();
+  m_entries.clear();
+  m_size = 0;
+}
+
+}}}}}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_protocol_http_encoding_EncodedBufferCache_hpp
+#define oatpp_web_protocol_http_encoding_EncodedBufferCache_hpp
+
+#include "EncoderProvider.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace web { namespace protocol { namespace http {
+
+namespace outgoing {
+  class BufferBody; // FWD
+}
+
+namespace encoding {
+
+/**
+ * Cache of encoded immutable buffers. <br>
+ * Buffers are identified by the instance of the underlying `std::string` of &id:oatpp::String;,
+ * so the same buffer is encoded only once per encoding for as long as it's alive. <br>
+ * Only bodies explicitly marked immutable (see &id:oatpp::web::protocol::http::outgoing::BufferBody::isImmutable;)
+ * are cached - other bodies are neither looked up nor inserted.
+ * Least recently used entries are evicted once the total size of encoded data exceeds the limit.
+ */
+class EncodedBufferCache {
+private:
+
+  struct Key {
+
+    const std::string* buffer;
+    oatpp::String encoding;
+
+    bool operator==(const Key& other) const;
+
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::weak_ptr<std::string> source;
+    v_buff_size sourceSize;
+    oatpp::String encoded;
+  };
+
+private:
+  v_buff_size m_maxSize;
+  v_buff_size m_maxBufferSize;
+  v_buff_size m_size;
+  std::list<Entry> m_entries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+  std::mutex m_mutex;
+private:
+  void removeEntry(std::list<Entry>::iterator it);
+public:
+
+  /**
+   * Constructor.
+   * @param maxSize - max total size of encoded data held by the cache.
+   * @param maxBufferSize - buffers bigger than this size are not cached.
+   */
+  EncodedBufferCache(v_buff_size maxSize = 16 * 1024 * 1024, v_buff_size maxBufferSize = 1024 * 1024);
+
+  /**
+   * Encode buffer with the processor of the provider.
+   * @param buffer - &id:oatpp::String;.
+   * @param provider - &id:oatpp::web::protocol::http::encoding::EncoderProvider;.
+   * @return - encoded data.
+   */
+  static oatpp::String encode(const oatpp::String& buffer, EncoderProvider* provider);
+
+  /**
+   * Get encoded body. Encode and cache it if it's not in the cache yet.
+   * @param body - &id:oatpp::web::protocol::http::outgoing::BufferBody;. Its buffer MUST NOT be modified once
+   * the body is marked immutable.
+   * @param provider - &id:oatpp::web::protocol::http::encoding::EncoderProvider;.
+   * @return - encoded data. `nullptr` if the body is not immutable or is too big to be cached.
+   */
+  oatpp::String get(const outgoing::BufferBody& body, EncoderProvider* provider);
+
+  /**
+   * Total size of encoded data held by the cache.
+   * @return
+   */
+  v_buff_size getSize();
+
+  /**
+   * Number of cached entries.
+   * @return
+   */
+  v_buff_size getEntriesCount();
+
+  /**
+   * Remove all entries.
+   */
+  void clear();
+
+};
+
+}}}}}
+
+#endif // oatpp_web_protocol_http_encoding_EncodedBufferCache_hpp
@@ -30,6 +30,8 @@
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
 
+class EncodedBufferCache;
+
 /**
  * TestProvider of encoding or decoding &id:oatpp::data::buffer::Processor;.
  */
@@ -53,6 +55,16 @@ public:
    */
   virtual std::shared_ptr<data::buffer::Processor> getProcessor() = 0;
 
+  /**
+   * Get cache of already encoded immutable buffers. <br>
+   * If provider returns cache, immutable &id:oatpp::web::protocol::http::outgoing::BufferBody; responses
+   * are encoded once and then served from the cache.
+   * @return - &id:oatpp::web::protocol::http::encoding::EncodedBufferCache;. `nullptr` if provider doesn't cache encoded data.
+   */
+  virtual EncodedBufferCache* getEncodedBufferCache() {
+    return nullptr;
+  }
+
 };
 
 }}}}}
@@ -24,10 +24,13 @@
 
 #include "ProviderCollection.hpp"
 
+#include "oatpp/web/protocol/http/Http.hpp"
+
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace encoding {
 
 void ProviderCollection::add(const std::shared_ptr<EncoderProvider>& provider) {
   m_providers[provider->getEncodingName()] = provider;
+  m_negotiationCache.invalidate();
 }
 
 std::shared_ptr<EncoderProvider> ProviderCollection::get(const data::share::StringKeyLabelCI& encoding) const {
@@ -51,4 +54,18 @@ std::shared_ptr<EncoderProvider> ProviderCollection::get(const std::unordered_se
 
 }
 
+std::shared_ptr<EncoderProvider> ProviderCollection::negotiate(const data::share::StringKeyLabel& acceptEncoding) const {
+
+  if(!acceptEncoding) {
+    return nullptr;
+  }
+
+  return m_negotiationCache.get(static_cast<const char*>(acceptEncoding.getData()), acceptEncoding.getSize(), [this, &acceptEncoding]{
+    http::HeaderValueData valueData;
+    http::Parser::parseHeaderValueData(valueData, acceptEncoding, ',');
+    return get(valueData.tokens);
+  });
+
+}
+
 }}}}}
@@ -27,6 +27,7 @@
 
 #include "EncoderProvider.hpp"
 #include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/utils/NegotiationCache.hpp"
 #include <unordered_map>
 #include <unordered_set>
 
@@ -38,6 +39,7 @@ namespace oatpp { namespace web { namespace protocol { namespace http { namespac
 class ProviderCollection {
 private:
   std::unordered_map<data::share::StringKeyLabelCI, std::shared_ptr<EncoderProvider>> m_providers;
+  oatpp::utils::NegotiationCache<EncoderProvider> m_negotiationCache;
 public:
 
   /**
@@ -60,6 +62,14 @@ public:
    */
   std::shared_ptr<EncoderProvider> get(const std::unordered_set<data::share::StringKeyLabelCI>& encodings) const;
 
+  /**
+   * Select available provider for the value of `Accept-Encoding` header. <br>
+   * Result is memoized per distinct header value until the collection changes.
+   * @param acceptEncoding - value of `Accept-Encoding` header.
+   * @return
+   */
+  std::shared_ptr<EncoderProvider> negotiate(const data::share::StringKeyLabel& acceptEncoding) const;
+
 };
 
 }}}}}
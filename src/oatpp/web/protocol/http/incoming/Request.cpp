@@ -37,6 +37,25 @@ Request::Request(const std::shared_ptr<oatpp::data::stream::IOStream>& connectio
   , m_bodyStream(bodyStream)
   , m_bodyDecoder(bodyDecoder)
   , m_queryParamsParsed(false)
+  , m_deadline(0)
+{}
+
+Request::Request(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
+                 const http::RequestStartingLine& startingLine,
+                 const http::Headers& headers,
+                 const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
+                 const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder,
+                 const std::shared_ptr<base::Arena>& arena)
+  : m_arena(arena)
+  , m_connection(connection)
+  , m_startingLine(startingLine)
+  , m_pathVariables(arena.get())
+  , m_headers(headers, arena.get())
+  , m_bodyStream(bodyStream)
+  , m_bodyDecoder(bodyDecoder)
+  , m_queryParamsParsed(false)
+  , m_queryParams(arena.get())
+  , m_deadline(0)
 {}
 
 std::shared_ptr<Request> Request::createShared(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
@@ -48,6 +67,16 @@ std::shared_ptr<Request> Request::createShared(const std::shared_ptr<oatpp::data
   return std::make_shared<Request>(connection, startingLine, headers, bodyStream, bodyDecoder);
 }
 
+std::shared_ptr<Request> Request::createShared(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
+                                               const http::RequestStartingLine& startingLine,
+                                               const http::Headers& headers,
+                                               const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
+                                               const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder,
+                                               const std::shared_ptr<base::Arena>& arena)
+{
+  return std::make_shared<Request>(connection, startingLine, headers, bodyStream, bodyDecoder, arena);
+}
+
 std::shared_ptr<oatpp::data::stream::IOStream> Request::getConnection() {
   return m_connection;
 }
@@ -147,6 +176,14 @@ const data::Bundle& Request::getBundle() const {
   return m_bundle;
 }
 
+void Request::setDeadline(v_int64 deadline) {
+  m_deadline = deadline;
+}
+
+v_int64 Request::getDeadline() const {
+  return m_deadline;
+}
+
 void Request::transferBody(const base::ObjectHandle<data::stream::WriteCallback>& writeCallback) const {
   m_bodyDecoder->decode(m_headers, m_bodyStream.get(), writeCallback.get(), m_connection.get());
 }
@@ -39,6 +39,12 @@ namespace oatpp { namespace web { namespace protocol { namespace http { namespac
 class Request : public oatpp::base::Countable {
 private:
 
+  /*
+   * Arena for headers, path variables and query parameters.
+   * Declared first - must outlive the containers allocated from it.
+   */
+  std::shared_ptr<base::Arena> m_arena;
+
   std::shared_ptr<oatpp::data::stream::IOStream> m_connection;
   http::RequestStartingLine m_startingLine;
   url::mapping::Pattern::MatchMap m_pathVariables;
@@ -56,6 +62,8 @@ private:
 
   data::Bundle m_bundle;
 
+  v_int64 m_deadline;
+
 public:
   
   Request(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
@@ -63,6 +71,13 @@ public:
           const http::Headers& headers,
           const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
           const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder);
+
+  Request(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
+          const http::RequestStartingLine& startingLine,
+          const http::Headers& headers,
+          const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
+          const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder,
+          const std::shared_ptr<base::Arena>& arena);
 public:
   
   static std::shared_ptr<Request> createShared(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
@@ -71,6 +86,24 @@ public:
                                                const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
                                                const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder);
 
+  /**
+   * Create request which allocates its headers, path variables and query parameters from the arena. <br>
+   * Request keeps the arena alive.
+   * @param connection
+   * @param startingLine
+   * @param headers
+   * @param bodyStream
+   * @param bodyDecoder
+   * @param arena - &id:oatpp::base::Arena;. May be `nullptr`.
+   * @return
+   */
+  static std::shared_ptr<Request> createShared(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
+                                               const http::RequestStartingLine& startingLine,
+                                               const http::Headers& headers,
+                                               const std::shared_ptr<oatpp::data::stream::InputStream>& bodyStream,
+                                               const std::shared_ptr<const http::incoming::BodyDecoder>& bodyDecoder,
+                                               const std::shared_ptr<base::Arena>& arena);
+
   /**
    * Get raw connection stream.
    * @return - &id:std::shared_ptr<oatpp::data::stream::IOStream> m_connection;.
@@ -239,6 +272,19 @@ public:
    */
   const data::Bundle& getBundle() const;
 
+  /**
+   * Set request deadline. <br>
+   * Async endpoints of this request fail with &id:oatpp::async::TimeoutError; once the deadline is reached.
+   * @param deadline - time point in microseconds (as &id:oatpp::Environment::getMicroTickCount;). `0` - no deadline.
+   */
+  void setDeadline(v_int64 deadline);
+
+  /**
+   * Get request deadline.
+   * @return - time point in microseconds (as &id:oatpp::Environment::getMicroTickCount;). `0` - no deadline.
+   */
+  v_int64 getDeadline() const;
+
   /**
    * Transfer body. <br>
    * Read body chunk by chunk and pass chunks to the `writeCallback`.
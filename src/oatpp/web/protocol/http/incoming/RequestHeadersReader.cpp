@@ -66,11 +66,12 @@ v_io_size RequestHeadersReader::readHeadersSectionIterative(ReadHeadersIteration
 }
   
 RequestHeadersReader::Result RequestHeadersReader::readHeaders(data::stream::InputStreamBufferedProxy* stream,
-                                                               http::HttpError::Info& error) {
+                                                               http::HttpError::Info& error,
+                                                               base::Arena* arena) {
 
   m_bufferStream->setCurrentPosition(0);
 
-  RequestHeadersReader::Result result;
+  RequestHeadersReader::Result result(arena);
   ReadHeadersIteration iteration;
   async::Action action;
 
@@ -108,7 +109,7 @@ RequestHeadersReader::Result RequestHeadersReader::readHeaders(data::stream::Inp
   
   
 oatpp::async::CoroutineStarterForResult<const RequestHeadersReader::Result&>
-RequestHeadersReader::readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream)
+RequestHeadersReader::readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream, base::Arena* arena)
 {
   
   class ReaderCoroutine : public oatpp::async::CoroutineWithResult<ReaderCoroutine, const Result&> {
@@ -120,9 +121,11 @@ RequestHeadersReader::readHeadersAsync(const std::shared_ptr<data::stream::Input
   public:
     
     ReaderCoroutine(RequestHeadersReader* _this,
-                    const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream)
+                    const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream,
+                    base::Arena* arena)
       : m_stream(stream)
       , m_this(_this)
+      , m_result(arena)
     {
       m_this->m_bufferStream->setCurrentPosition(0);
     }
@@ -172,7 +175,7 @@ RequestHeadersReader::readHeadersAsync(const std::shared_ptr<data::stream::Input
     
   };
   
-  return ReaderCoroutine::startForResult(this, stream);
+  return ReaderCoroutine::startForResult(this, stream, arena);
   
 }
 
@@ -49,6 +49,17 @@ public:
    * Result of headers reading and parsing.
    */
   struct Result {
+
+    Result() = default;
+
+    /**
+     * Constructor.
+     * @param arena - &id:oatpp::base::Arena; to allocate headers from. May be `nullptr`.
+     */
+    explicit Result(base::Arena* arena)
+      : headers(arena)
+    {}
+
     /**
      * &id:oatpp::web::protocol::http::RequestStartingLine;.
      */
@@ -95,16 +106,19 @@ public:
    * Read and parse http headers from stream.
    * @param stream - &id:oatpp::data::stream::InputStreamBufferedProxy;.
    * @param error - out parameter &id:oatpp::web::protocol::ProtocolError::Info;.
+   * @param arena - &id:oatpp::base::Arena; to allocate headers from. May be `nullptr`.
    * @return - &l:RequestHeadersReader::Result;.
    */
-  Result readHeaders(data::stream::InputStreamBufferedProxy* stream, http::HttpError::Info& error);
+  Result readHeaders(data::stream::InputStreamBufferedProxy* stream, http::HttpError::Info& error, base::Arena* arena = nullptr);
 
   /**
    * Read and parse http headers from stream in asynchronous manner.
    * @param stream - `std::shared_ptr` to &id:oatpp::data::stream::InputStreamBufferedProxy;.
+   * @param arena - &id:oatpp::base::Arena; to allocate headers from. May be `nullptr`.
    * @return - &id:oatpp::async::CoroutineStarterForResult;.
    */
-  oatpp::async::CoroutineStarterForResult<const RequestHeadersReader::Result&> readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream);
+  oatpp::async::CoroutineStarterForResult<const RequestHeadersReader::Result&>
+  readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream, base::Arena* arena = nullptr);
   
 };
   
@@ -66,6 +66,54 @@ v_io_size ResponseHeadersReader::readHeadersSectionIterative(ReadHeadersIteratio
 
 }
 
+v_io_size ResponseHeadersReader::readHeadersSectionIterative(ReadHeadersIteration& iteration,
+                                                             data::stream::InputStreamBufferedProxy* stream,
+                                                             data::stream::ConsistentOutputStream* bufferStream,
+                                                             async::Action& action)
+{
+
+  v_buff_size desiredToRead = m_buffer.getSize();
+  if(iteration.progress + desiredToRead > m_maxHeadersSize) {
+    desiredToRead = m_maxHeadersSize - iteration.progress;
+    if(desiredToRead <= 0) {
+      return -1;
+    }
+  }
+
+  auto bufferData = reinterpret_cast<p_char8>(const_cast<void*>(m_buffer.getData()));
+  auto res = stream->peek(bufferData, desiredToRead, action);
+  if(res > 0) {
+
+    for(v_buff_size i = 0; i < res; i ++) {
+      iteration.accumulator <<= 8;
+      iteration.accumulator |= bufferData[i];
+      if(iteration.accumulator == SECTION_END) {
+        bufferStream->writeSimple(bufferData, i + 1);
+        stream->commitReadOffset(i + 1);
+        iteration.progress += i + 1;
+        iteration.done = true;
+        return res;
+      }
+    }
+
+    bufferStream->writeSimple(bufferData, res);
+    stream->commitReadOffset(res);
+    iteration.progress += res;
+
+  }
+
+  return res;
+
+}
+
+void ResponseHeadersReader::parseHeaders(const oatpp::String& headersText, Result& result, http::Status& status) {
+  oatpp::utils::parser::Caret caret (headersText);
+  http::Parser::parseResponseStartingLine(result.startingLine, headersText.getPtr(), caret, status);
+  if(status.code == 0) {
+    http::Parser::parseHeaders(result.headers, headersText.getPtr(), caret, status);
+  }
+}
+
 ResponseHeadersReader::Result ResponseHeadersReader::readHeaders(const std::shared_ptr<oatpp::data::stream::IOStream>& connection,
                                                                  http::HttpError::Info& error) {
   
@@ -176,4 +224,99 @@ ResponseHeadersReader::readHeadersAsync(const std::shared_ptr<oatpp::data::strea
   
 }
   
+ResponseHeadersReader::Result ResponseHeadersReader::readHeaders(data::stream::InputStreamBufferedProxy* stream,
+                                                                 http::HttpError::Info& error)
+{
+
+  Result result;
+  result.bufferPosStart = 0;
+  result.bufferPosEnd = 0;
+
+  ReadHeadersIteration iteration;
+  async::Action action;
+
+  oatpp::data::stream::BufferOutputStream buffer;
+
+  while(!iteration.done) {
+
+    error.ioStatus = readHeadersSectionIterative(iteration, stream, &buffer, action);
+
+    if(!action.isNone()) {
+      throw std::runtime_error("[oatpp::web::protocol::http::incoming::ResponseHeadersReader::readHeaders]: Error. Async action is unexpected.");
+    }
+
+    if(error.ioStatus > 0) {
+      continue;
+    } else if(error.ioStatus == IOError::RETRY_READ || error.ioStatus == IOError::RETRY_WRITE) {
+      continue;
+    } else {
+      break;
+    }
+
+  }
+
+  if(error.ioStatus > 0) {
+    parseHeaders(buffer.toString(), result, error.status);
+  }
+
+  return result;
+
+}
+
+oatpp::async::CoroutineStarterForResult<const ResponseHeadersReader::Result&>
+ResponseHeadersReader::readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream)
+{
+
+  class ReaderCoroutine : public oatpp::async::CoroutineWithResult<ReaderCoroutine, const Result&> {
+  private:
+    ResponseHeadersReader* m_this;
+    std::shared_ptr<data::stream::InputStreamBufferedProxy> m_stream;
+    ReadHeadersIteration m_iteration;
+    ResponseHeadersReader::Result m_result;
+    oatpp::data::stream::BufferOutputStream m_bufferStream;
+  public:
+
+    ReaderCoroutine(ResponseHeadersReader* _this,
+                    const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream)
+      : m_this(_this)
+      , m_stream(stream)
+    {
+      m_result.bufferPosStart = 0;
+      m_result.bufferPosEnd = 0;
+    }
+
+    Action act() override {
+
+      async::Action action;
+      auto res = m_this->readHeadersSectionIterative(m_iteration, m_stream.get(), &m_bufferStream, action);
+
+      if(!action.isNone()) {
+        return action;
+      }
+
+      if(m_iteration.done) {
+        return yieldTo(&ReaderCoroutine::parseHeaders);
+      } else if (res > 0 || res == IOError::RETRY_READ || res == IOError::RETRY_WRITE) {
+        return repeat();
+      }
+
+      return error<Error>("[oatpp::web::protocol::http::incoming::ResponseHeadersReader::readHeadersAsync()]: Error. Error reading connection stream.");
+
+    }
+
+    Action parseHeaders() {
+      http::Status status;
+      ResponseHeadersReader::parseHeaders(m_bufferStream.toString(), m_result, status);
+      if(status.code == 0) {
+        return _return(m_result);
+      }
+      return error<Error>("[oatpp::web::protocol::http::incoming::ResponseHeadersReader::readHeadersAsync()]: Error. Can't parse response headers.");
+    }
+
+  };
+
+  return ReaderCoroutine::startForResult(this, stream);
+
+}
+
 }}}}}
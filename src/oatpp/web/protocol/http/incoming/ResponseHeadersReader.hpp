@@ -26,6 +26,7 @@
 #define oatpp_web_protocol_http_incoming_ResponseHeadersReader_hpp
 
 #include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/data/stream/StreamBufferedProxy.hpp"
 #include "oatpp/async/Coroutine.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace incoming {
@@ -83,6 +84,13 @@ private:
                                               Result& result,
                                               async::Action& action);
 
+  v_io_size readHeadersSectionIterative(ReadHeadersIteration& iteration,
+                                        data::stream::InputStreamBufferedProxy* stream,
+                                        data::stream::ConsistentOutputStream* bufferStream,
+                                        async::Action& action);
+
+  static void parseHeaders(const oatpp::String& headersText, Result& result, http::Status& status);
+
 private:
   oatpp::data::share::MemoryLabel m_buffer;
   v_buff_size m_maxHeadersSize;
@@ -112,6 +120,24 @@ public:
    * @return - &id:oatpp::async::CoroutineStarterForResult;.
    */
   oatpp::async::CoroutineStarterForResult<const Result&> readHeadersAsync(const std::shared_ptr<oatpp::data::stream::IOStream>& connection);
+
+  /**
+   * Read and parse http headers from buffered stream. <br>
+   * Unlike &l:ResponseHeadersReader::readHeaders (); this method consumes exactly the headers section from the stream
+   * leaving everything past it in the stream - so that multiple responses can be read from the same connection one by one.
+   * &l:ResponseHeadersReader::Result::bufferPosStart; and &l:ResponseHeadersReader::Result::bufferPosEnd; are set to `0`.
+   * @param stream - &id:oatpp::data::stream::InputStreamBufferedProxy;.
+   * @param error - out parameter &id:oatpp::web::protocol::ProtocolError::Info;.
+   * @return - &l:ResponseHeadersReader::Result;.
+   */
+  Result readHeaders(data::stream::InputStreamBufferedProxy* stream, http::HttpError::Info& error);
+
+  /**
+   * Same as &l:ResponseHeadersReader::readHeaders (); for buffered stream but Async.
+   * @param stream - &id:oatpp::data::stream::InputStreamBufferedProxy;.
+   * @return - &id:oatpp::async::CoroutineStarterForResult;.
+   */
+  oatpp::async::CoroutineStarterForResult<const Result&> readHeadersAsync(const std::shared_ptr<data::stream::InputStreamBufferedProxy>& stream);
   
 };
   
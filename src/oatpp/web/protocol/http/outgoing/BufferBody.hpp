@@ -39,18 +39,22 @@ private:
   oatpp::String m_buffer;
   oatpp::data::share::StringKeyLabel m_contentType;
   data::buffer::InlineReadData m_inlineData;
+  bool m_immutable;
 public:
-  BufferBody(const oatpp::String& buffer, const data::share::StringKeyLabel& contentType);
+  BufferBody(const oatpp::String& buffer, const data::share::StringKeyLabel& contentType, bool immutable = false);
 public:
 
   /**
    * Create shared BufferBody.
    * @param buffer - &id:oatpp::String;.
    * @param contentType - type of the content.
+   * @param immutable - `true` if the buffer is never modified. Encoded immutable buffers may be served from
+   * &id:oatpp::web::protocol::http::encoding::EncodedBufferCache; of the content encoder.
    * @return - `std::shared_ptr` to BufferBody.
    */
   static std::shared_ptr<BufferBody> createShared(const oatpp::String& buffer,
-                                                  const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel());
+                                                  const data::share::StringKeyLabel& contentType = data::share::StringKeyLabel(),
+                                                  bool immutable = false);
 
   /**
    * Read operation callback.
@@ -79,6 +83,18 @@ public:
    * @return - `v_buff_size`.
    */
   v_int64 getKnownSize() override;
+
+  /**
+   * Get buffer.
+   * @return - &id:oatpp::String;.
+   */
+  oatpp::String getBuffer() const;
+
+  /**
+   * Check if the buffer is declared immutable.
+   * @return
+   */
+  bool isImmutable() const;
   
 };
   
@@ -24,7 +24,10 @@
 
 #include "./Response.hpp"
 
+#include "./BufferBody.hpp"
+
 #include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/protocol/http/encoding/EncodedBufferCache.hpp"
 #include "oatpp/utils/Conversion.hpp"
 
 namespace oatpp { namespace web { namespace protocol { namespace http { namespace outgoing {
@@ -105,12 +108,25 @@ std::shared_ptr<const Response::ConnectionHandler::ParameterMap> Response::getCo
   return m_connectionUpgradeParameters;
 }
 
+oatpp::String Response::getCachedEncodedBody(http::encoding::EncoderProvider* contentEncoderProvider) {
+  auto cache = contentEncoderProvider->getEncodedBufferCache();
+  if(cache == nullptr) {
+    return nullptr;
+  }
+  auto bufferBody = std::dynamic_pointer_cast<BufferBody>(m_body);
+  if(!bufferBody) {
+    return nullptr;
+  }
+  return cache->get(*bufferBody, contentEncoderProvider);
+}
+
 void Response::send(data::stream::OutputStream* stream,
                     data::stream::BufferOutputStream* headersWriteBuffer,
                     http::encoding::EncoderProvider* contentEncoderProvider)
 {
 
   v_int64 bodySize = -1;
+  oatpp::String encodedBody;
 
   if(m_body){
 
@@ -127,8 +143,17 @@ void Response::send(data::stream::OutputStream* stream,
       }
 
     } else {
-      m_headers.put_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
+
+      encodedBody = getCachedEncodedBody(contentEncoderProvider);
+
+      if(encodedBody) {
+        bodySize = static_cast<v_int64>(encodedBody->size());
+        m_headers.put_LockFree(Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(bodySize));
+      } else {
+        m_headers.put_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
+      }
       m_headers.put_LockFree(Header::CONTENT_ENCODING, contentEncoderProvider->getEncodingName());
+
     }
 
   } else {
@@ -149,7 +174,17 @@ void Response::send(data::stream::OutputStream* stream,
 
   if(m_body) {
 
-    if(contentEncoderProvider == nullptr) {
+    if(encodedBody) {
+
+      if (bodySize + headersWriteBuffer->getCurrentPosition() < headersWriteBuffer->getCapacity()) {
+        headersWriteBuffer->writeSimple(encodedBody->data(), bodySize);
+        headersWriteBuffer->flushToStream(stream);
+      } else {
+        headersWriteBuffer->flushToStream(stream);
+        stream->writeExactSizeDataSimple(encodedBody->data(), bodySize);
+      }
+
+    } else if(contentEncoderProvider == nullptr) {
 
       if (bodySize >= 0) {
 
@@ -213,6 +248,7 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
     std::shared_ptr<data::stream::OutputStream> m_stream;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersWriteBuffer;
     std::shared_ptr<http::encoding::EncoderProvider> m_contentEncoderProvider;
+    oatpp::String m_encodedBody;
   public:
 
     SendAsyncCoroutine(const std::shared_ptr<Response>& _this,
@@ -244,8 +280,17 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
           }
 
         } else {
-          m_this->m_headers.putIfNotExists_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
+
+          m_encodedBody = m_this->getCachedEncodedBody(m_contentEncoderProvider.get());
+
+          if(m_encodedBody) {
+            bodySize = static_cast<v_buff_size>(m_encodedBody->size());
+            m_this->m_headers.putIfNotExists_LockFree(Header::CONTENT_LENGTH, utils::Conversion::int64ToStr(bodySize));
+          } else {
+            m_this->m_headers.putIfNotExists_LockFree(Header::TRANSFER_ENCODING, Header::Value::TRANSFER_ENCODING_CHUNKED);
+          }
           m_this->m_headers.putIfNotExists_LockFree(Header::CONTENT_ENCODING, m_contentEncoderProvider->getEncodingName());
+
         }
 
       } else {
@@ -266,7 +311,22 @@ oatpp::async::CoroutineStarter Response::sendAsync(const std::shared_ptr<Respons
 
       if(m_this->m_body) {
 
-        if(!m_contentEncoderProvider) {
+        if(m_encodedBody) {
+
+          if (bodySize + m_headersWriteBuffer->getCurrentPosition() < m_headersWriteBuffer->getCapacity()) {
+
+            m_headersWriteBuffer->writeSimple(m_encodedBody->data(), bodySize);
+            return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
+              .next(finish());
+
+          } else {
+
+            return oatpp::data::stream::BufferOutputStream::flushToStreamAsync(m_headersWriteBuffer, m_stream)
+              .next(m_stream->writeExactSizeDataAsync(m_encodedBody->data(), bodySize))
+              .next(finish());
+          }
+
+        } else if(!m_contentEncoderProvider) {
 
           if (bodySize >= 0) {
 
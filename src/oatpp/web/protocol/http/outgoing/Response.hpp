@@ -60,6 +60,8 @@ private:
   std::shared_ptr<ConnectionHandler> m_connectionUpgradeHandler;
   std::shared_ptr<const ConnectionHandler::ParameterMap> m_connectionUpgradeParameters;
   data::Bundle m_bundle;
+private:
+  oatpp::String getCachedEncodedBody(http::encoding::EncoderProvider* contentEncoderProvider);
 public:
   /**
    * Constructor.
@@ -83,12 +83,7 @@ CommunicationUtils::selectEncoder(const std::shared_ptr<http::incoming::Request>
     auto suggested = request->getHeaders().getAsMemoryLabel<oatpp::data::share::StringKeyLabel>(Header::ACCEPT_ENCODING);
 
     if(suggested) {
-
-      http::HeaderValueData valueData;
-      http::Parser::parseHeaderValueData(valueData, suggested, ',');
-
-      return providers->get(valueData.tokens);
-
+      return providers->negotiate(suggested);
     }
 
   }
@@ -24,22 +24,59 @@
 
 #include "./AsyncHttpConnectionHandler.hpp"
 
+#include <cstring>
+#include <limits>
+
 namespace oatpp { namespace web { namespace server {
 
+const char* const AsyncHttpConnectionHandler::SERVICE_UNAVAILABLE_RESPONSE =
+  "HTTP/1.1 503 Service Unavailable\r\n"
+  "Content-Length: 0\r\n"
+  "Connection: close\r\n"
+  "Retry-After: 1\r\n"
+  "\r\n";
+
 void AsyncHttpConnectionHandler::onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) {
 
+  auto key = reinterpret_cast<v_uint64>(connection.object.get());
+
   std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
-  m_connections.insert({reinterpret_cast<v_uint64>(connection.object.get()), connection});
+  m_connections.insert({key, connection});
 
   if(!m_continue.load()) {
     connection.invalidator->invalidate(connection.object);
   }
 
+  /* coroutine is created when the processor picks up the task - measure how long the connection waited for it */
+  auto it = m_acceptTimes.find(key);
+  if(it != m_acceptTimes.end()) {
+
+    auto now = oatpp::Environment::getMicroTickCount();
+    auto sojourn = now - it->second;
+    m_acceptTimes.erase(it);
+
+    if(sojourn < m_sojournIntervalMin) {
+      m_sojournIntervalMin = sojourn;
+    }
+
+    auto interval = m_admission.sojournInterval.count();
+    if(now - m_sojournIntervalStart >= interval) {
+      m_sojourn.store(m_sojournIntervalMin);
+      m_shedUntil.store(m_sojournIntervalMin > m_admission.targetSojourn.count() ? now + interval : 0);
+      m_sojournIntervalStart = now;
+      m_sojournIntervalMin = std::numeric_limits<v_int64>::max();
+    }
+
+  }
+
 }
 
 void AsyncHttpConnectionHandler::onTaskEnd(const provider::ResourceHandle<data::stream::IOStream>& connection) {
-  std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
-  m_connections.erase(reinterpret_cast<v_uint64>(connection.object.get()));
+  {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+    m_connections.erase(reinterpret_cast<v_uint64>(connection.object.get()));
+  }
+  -- m_connectionsInFlight;
 }
 
 void AsyncHttpConnectionHandler::invalidateAllConnections() {
@@ -60,6 +97,15 @@ AsyncHttpConnectionHandler::AsyncHttpConnectionHandler(const std::shared_ptr<Htt
   : m_executor(std::make_shared<oatpp::async::Executor>(threadCount))
   , m_components(components)
   , m_continue(true)
+  , m_connectionsInFlight(0)
+  , m_sojournIntervalStart(0)
+  , m_sojournIntervalMin(std::numeric_limits<v_int64>::max())
+  , m_sojourn(0)
+  , m_shedUntil(0)
+  , m_admitted(0)
+  , m_shedConnections(0)
+  , m_shedExecutorTasks(0)
+  , m_shedSojourn(0)
 {
   m_executor->detach();
 }
@@ -69,6 +115,15 @@ AsyncHttpConnectionHandler::AsyncHttpConnectionHandler(const std::shared_ptr<Htt
   : m_executor(executor)
   , m_components(components)
   , m_continue(true)
+  , m_connectionsInFlight(0)
+  , m_sojournIntervalStart(0)
+  , m_sojournIntervalMin(std::numeric_limits<v_int64>::max())
+  , m_sojourn(0)
+  , m_shedUntil(0)
+  , m_admitted(0)
+  , m_shedConnections(0)
+  , m_shedExecutorTasks(0)
+  , m_shedSojourn(0)
 {}
 
 std::shared_ptr<AsyncHttpConnectionHandler> AsyncHttpConnectionHandler::createShared(const std::shared_ptr<HttpRouter>& router, v_int32 threadCount){
@@ -102,6 +157,78 @@ void AsyncHttpConnectionHandler::addResponseInterceptor(const std::shared_ptr<in
   m_components->responseInterceptors.push_back(interceptor);
 }
 
+void AsyncHttpConnectionHandler::setAdmissionConfig(const AdmissionConfig& config) {
+  m_admission = config;
+}
+
+AsyncHttpConnectionHandler::AdmissionStats AsyncHttpConnectionHandler::getAdmissionStats() const {
+  AdmissionStats stats;
+  stats.admitted = m_admitted.load();
+  stats.shedConnections = m_shedConnections.load();
+  stats.shedExecutorTasks = m_shedExecutorTasks.load();
+  stats.shedSojourn = m_shedSojourn.load();
+  stats.sojourn = m_sojourn.load();
+  return stats;
+}
+
+bool AsyncHttpConnectionHandler::admit(const provider::ResourceHandle<IOStream>& connection) {
+
+  if(m_admission.maxExecutorTasks > 0 && m_executor->getTasksCount() >= m_admission.maxExecutorTasks) {
+    ++ m_shedExecutorTasks;
+    return false;
+  }
+
+  v_int64 now = 0;
+  if(m_admission.targetSojourn.count() > 0) {
+    now = oatpp::Environment::getMicroTickCount();
+    if(now < m_shedUntil.load()) {
+      ++ m_shedSojourn;
+      return false;
+    }
+  }
+
+  if(++ m_connectionsInFlight > m_admission.maxConnections && m_admission.maxConnections > 0) {
+    -- m_connectionsInFlight;
+    ++ m_shedConnections;
+    return false;
+  }
+
+  if(now > 0) {
+    std::lock_guard<oatpp::concurrency::SpinLock> lock(m_connectionsLock);
+    m_acceptTimes[reinterpret_cast<v_uint64>(connection.object.get())] = now;
+  }
+
+  ++ m_admitted;
+  return true;
+
+}
+
+void AsyncHttpConnectionHandler::shed(const provider::ResourceHandle<IOStream>& connection) {
+
+  if(m_admission.sendServiceUnavailable) {
+
+    /* never block the accepting thread */
+    connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+    connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+
+    /* consume what the client has already sent - closing a socket with unread data resets the connection */
+    v_char8 buffer[1024];
+    for(v_int32 i = 0; i < 16; i ++) {
+      async::Action action;
+      if(connection.object->read(buffer, 1024, action) <= 0) {
+        break;
+      }
+    }
+
+    async::Action action;
+    connection.object->write(SERVICE_UNAVAILABLE_RESPONSE, static_cast<v_buff_size>(std::strlen(SERVICE_UNAVAILABLE_RESPONSE)), action);
+
+  }
+
+  connection.invalidator->invalidate(connection.object);
+
+}
+
 void AsyncHttpConnectionHandler::handleConnection(const provider::ResourceHandle<IOStream>& connection,
                                                   const std::shared_ptr<const ParameterMap>& params)
 {
@@ -110,6 +237,11 @@ void AsyncHttpConnectionHandler::handleConnection(const provider::ResourceHandle
 
   if (m_continue.load()) {
 
+    if(!admit(connection)) {
+      shed(connection);
+      return;
+    }
+
     connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
     connection.object->setInputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
 
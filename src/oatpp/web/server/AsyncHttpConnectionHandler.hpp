@@ -38,6 +38,77 @@ namespace oatpp { namespace web { namespace server {
  * Asynchronous &id:oatpp::network::ConnectionHandler; for handling http communication.
  */
 class AsyncHttpConnectionHandler : public base::Countable, public network::ConnectionHandler, public HttpProcessor::TaskProcessingListener {
+public:
+
+  /**
+   * Admission control config. <br>
+   * When any of the limits is exceeded, new connections are shed - answered with `503 Service Unavailable` and closed -
+   * instead of being queued on the executor. Connections which are already being served are not affected. <br>
+   * Limits set to `0` are disabled. By default all limits are disabled.
+   */
+  struct AdmissionConfig {
+
+    /**
+     * Max number of connections being served by this handler.
+     */
+    v_int64 maxConnections = 0;
+
+    /**
+     * Max number of not finished tasks on the executor (&id:oatpp::async::Executor::getTasksCount ();).
+     */
+    v_int64 maxExecutorTasks = 0;
+
+    /**
+     * Target sojourn time - time from accepting the connection until the executor starts processing it. <br>
+     * CoDel style: if the minimum sojourn time over the `sojournInterval` exceeds the target,
+     * new connections are shed for the next `sojournInterval`.
+     */
+    std::chrono::duration<v_int64, std::micro> targetSojourn = std::chrono::microseconds(0);
+
+    /**
+     * Interval of sojourn time evaluation.
+     */
+    std::chrono::duration<v_int64, std::micro> sojournInterval = std::chrono::milliseconds(100);
+
+    /**
+     * Answer shed connections with `503 Service Unavailable`. If `false` - shed connections are just closed.
+     */
+    bool sendServiceUnavailable = true;
+
+  };
+
+  /**
+   * Admission control counters.
+   */
+  struct AdmissionStats {
+
+    /**
+     * Connections admitted.
+     */
+    v_int64 admitted;
+
+    /**
+     * Connections shed because of &l:AsyncHttpConnectionHandler::AdmissionConfig::maxConnections;.
+     */
+    v_int64 shedConnections;
+
+    /**
+     * Connections shed because of &l:AsyncHttpConnectionHandler::AdmissionConfig::maxExecutorTasks;.
+     */
+    v_int64 shedExecutorTasks;
+
+    /**
+     * Connections shed because of &l:AsyncHttpConnectionHandler::AdmissionConfig::targetSojourn;.
+     */
+    v_int64 shedSojourn;
+
+    /**
+     * Minimum sojourn time over the last evaluated interval (microseconds).
+     */
+    v_int64 sojourn;
+
+  };
+
 protected:
 
   void onTaskStart(const provider::ResourceHandle<data::stream::IOStream>& connection) override;
@@ -45,12 +116,29 @@ protected:
 
   void invalidateAllConnections();
 
+private:
+  static const char* const SERVICE_UNAVAILABLE_RESPONSE;
+private:
+  bool admit(const provider::ResourceHandle<IOStream>& connection);
+  void shed(const provider::ResourceHandle<IOStream>& connection);
 private:
   std::shared_ptr<oatpp::async::Executor> m_executor;
   std::shared_ptr<HttpProcessor::Components> m_components;
   std::atomic_bool m_continue;
   std::unordered_map<v_uint64, provider::ResourceHandle<data::stream::IOStream>> m_connections;
   oatpp::concurrency::SpinLock m_connectionsLock;
+private:
+  AdmissionConfig m_admission;
+  std::atomic<v_int64> m_connectionsInFlight;
+  std::unordered_map<v_uint64, v_int64> m_acceptTimes; // guarded by m_connectionsLock
+  v_int64 m_sojournIntervalStart; // guarded by m_connectionsLock
+  v_int64 m_sojournIntervalMin; // guarded by m_connectionsLock
+  std::atomic<v_int64> m_sojourn;
+  std::atomic<v_int64> m_shedUntil;
+  std::atomic<v_int64> m_admitted;
+  std::atomic<v_int64> m_shedConnections;
+  std::atomic<v_int64> m_shedExecutorTasks;
+  std::atomic<v_int64> m_shedSojourn;
 public:
 
   /**
@@ -139,6 +227,19 @@ public:
    */
   void addResponseInterceptor(const std::shared_ptr<interceptor::ResponseInterceptor>& interceptor);
 
+  /**
+   * Set admission control config. <br>
+   * Should be called before the server is started.
+   * @param config - &l:AsyncHttpConnectionHandler::AdmissionConfig;.
+   */
+  void setAdmissionConfig(const AdmissionConfig& config);
+
+  /**
+   * Get admission control counters.
+   * @return - &l:AsyncHttpConnectionHandler::AdmissionStats;.
+   */
+  AdmissionStats getAdmissionStats() const;
+
   
   void handleConnection(const provider::ResourceHandle<IOStream>& connection,
                         const std::shared_ptr<const ParameterMap>& params) override;
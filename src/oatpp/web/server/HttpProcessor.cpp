@@ -27,6 +27,9 @@
 #include "oatpp/web/server/HttpServerError.hpp"
 #include "oatpp/web/protocol/http/incoming/SimpleBodyDecoder.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <algorithm>
 
 namespace oatpp { namespace web { namespace server {
 
@@ -72,6 +75,54 @@ HttpProcessor::Components::Components(const std::shared_ptr<HttpRouter>& pRouter
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Other
 
+base::Arena* HttpProcessor::acquireArena(std::shared_ptr<base::Arena>& arena, const Config& config) {
+  if(!config.useRequestArena) {
+    return nullptr;
+  }
+  if(!arena) {
+    arena = std::make_shared<base::Arena>(config.requestArenaChunkSize);
+  }
+  return arena.get();
+}
+
+void HttpProcessor::releaseArena(std::shared_ptr<base::Arena>& arena) {
+  if(arena) {
+    if(arena.use_count() == 1) {
+      arena->reset();
+    } else {
+      /* request is still referenced - the last owner will free the arena */
+      arena.reset();
+    }
+  }
+}
+
+void HttpProcessor::applyDeadline(const Config& config, const std::shared_ptr<protocol::http::incoming::Request>& request) {
+
+  v_int64 deadline = 0;
+
+  if(config.requestDeadline.count() > 0) {
+    deadline = oatpp::Environment::getMicroTickCount() + std::min<v_int64>(config.requestDeadline.count(), MAX_DEADLINE);
+  }
+
+  if(config.deadlineHeader) {
+    auto value = request->getHeader(config.deadlineHeader);
+    if(value) {
+      bool success;
+      auto timeoutMs = utils::Conversion::strToInt64(value, success);
+      if(success && timeoutMs > 0) {
+        /* clamp before converting to microseconds - client controls the value */
+        auto headerDeadline = oatpp::Environment::getMicroTickCount() + std::min<v_int64>(timeoutMs, MAX_DEADLINE / 1000) * 1000;
+        if(deadline == 0 || headerDeadline < deadline) {
+          deadline = headerDeadline;
+        }
+      }
+    }
+  }
+
+  request->setDeadline(deadline);
+
+}
+
 HttpProcessor::ProcessingResources::ProcessingResources(const std::shared_ptr<Components>& pComponents,
                                                         const provider::ResourceHandle<oatpp::data::stream::IOStream>& pConnection)
   : components(pComponents)
@@ -129,7 +180,8 @@ HttpProcessor::processNextRequest(ProcessingResources& resources,
 HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResources& resources) {
 
   oatpp::web::protocol::http::HttpError::Info error;
-  auto headersReadResult = resources.headersReader.readHeaders(resources.inStream.get(), error);
+  auto arena = acquireArena(resources.arena, *resources.components->config);
+  auto headersReadResult = resources.headersReader.readHeaders(resources.inStream.get(), error, arena);
 
   if(error.ioStatus <= 0) {
     return ConnectionState::DEAD;
@@ -150,7 +202,9 @@ HttpProcessor::ConnectionState HttpProcessor::processNextRequest(ProcessingResou
                                                               headersReadResult.startingLine,
                                                               headersReadResult.headers,
                                                               resources.inStream,
-                                                              resources.components->bodyDecoder);
+                                                              resources.components->bodyDecoder,
+                                                              resources.arena);
+    applyDeadline(*resources.components->config, request);
 
     response = processNextRequest(resources, request, connectionState);
 
@@ -263,6 +317,7 @@ void HttpProcessor::Task::run(){
     do {
 
       connectionState = HttpProcessor::processNextRequest(resources);
+      releaseArena(resources.arena);
 
     } while (connectionState == ConnectionState::ALIVE);
 
@@ -301,7 +356,8 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::act() {
 
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::parseHeaders() {
   m_shouldInterceptResponse = true;
-  return m_headersReader.readHeadersAsync(m_inStream).callbackTo(&HttpProcessor::Coroutine::onHeadersParsed);
+  auto arena = acquireArena(m_arena, *m_components->config);
+  return m_headersReader.readHeadersAsync(m_inStream, arena).callbackTo(&HttpProcessor::Coroutine::onHeadersParsed);
 }
 
 oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHeadersReader::Result& headersReadResult) {
@@ -310,7 +366,9 @@ oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHead
                                                                      headersReadResult.startingLine,
                                                                      headersReadResult.headers,
                                                                      m_inStream,
-                                                                     m_components->bodyDecoder);
+                                                                     m_components->bodyDecoder,
+                                                                     m_arena);
+  applyDeadline(*m_components->config, m_currentRequest);
 
   for(auto& interceptor : m_components->requestInterceptors) {
     m_currentResponse = interceptor->intercept(m_currentRequest);
@@ -340,10 +398,13 @@ oatpp::async::Action HttpProcessor::Coroutine::onHeadersParsed(const RequestHead
 }
 
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestFormed() {
+  /* endpoint coroutine inherits the deadline */
+  setDeadline(m_currentRequest->getDeadline());
   return m_currentRoute.getEndpoint()->handleAsync(m_currentRequest).callbackTo(&HttpProcessor::Coroutine::onResponse);
 }
 
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onResponse(const std::shared_ptr<protocol::http::outgoing::Response>& response) {
+  setDeadline(0);
   m_currentResponse = response;
   return yieldTo(&HttpProcessor::Coroutine::onResponseFormed);
 }
@@ -395,6 +456,8 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestDone() {
 
   switch (m_connectionState) {
     case ConnectionState::ALIVE:
+      m_currentRequest.reset();
+      releaseArena(m_arena);
       return yieldTo(&HttpProcessor::Coroutine::parseHeaders);
 
     /* Delegate connection handling to another handler only after the response is sent to the client */
@@ -423,6 +486,9 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::onRequestDone() {
   
 HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::handleError(Error* error) {
 
+  /* the response (error response included) is sent without the deadline */
+  setDeadline(0);
+
   if(error) {
 
     if(error->is<oatpp::AsyncIOError>()) {
@@ -439,7 +505,9 @@ HttpProcessor::Coroutine::Action HttpProcessor::Coroutine::handleError(Error* er
 
 
     std::exception_ptr ePtr = error->getExceptionPtr();
-    if(!ePtr) {
+    if(error->is<async::TimeoutError>()) {
+      ePtr = std::make_exception_ptr(oatpp::web::protocol::http::HttpError(protocol::http::Status::CODE_504, "Request deadline exceeded"));
+    } else if(!ePtr) {
       ePtr = std::make_exception_ptr(*error);
     }
 
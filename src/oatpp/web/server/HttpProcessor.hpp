@@ -49,6 +49,12 @@ namespace oatpp { namespace web { namespace server {
  */
 class HttpProcessor {
 public:
+
+  /**
+   * Max time budget of a request - 24 hours in microseconds. Larger configured or requested budgets are clamped to it.
+   */
+  static constexpr v_int64 MAX_DEADLINE = 24LL * 60 * 60 * 1000 * 1000;
+
   typedef std::list<std::shared_ptr<web::server::interceptor::RequestInterceptor>> RequestInterceptors;
   typedef std::list<std::shared_ptr<web::server::interceptor::ResponseInterceptor>> ResponseInterceptors;
   typedef web::protocol::http::incoming::RequestHeadersReader RequestHeadersReader;
@@ -83,6 +89,35 @@ public:
      */
     v_buff_size headersReaderMaxSize = 4096;
 
+    /**
+     * Allocate request headers, path variables and query parameters from the per-connection
+     * &id:oatpp::base::Arena;. The arena is released in one shot once the response is sent. <br>
+     * If the request object is still referenced after the response is sent, its arena is left to the request
+     * and a new arena is created for the next request.
+     */
+    bool useRequestArena = false;
+
+    /**
+     * Size of the request arena chunk.
+     */
+    v_buff_size requestArenaChunkSize = base::Arena::DEFAULT_CHUNK_SIZE;
+
+    /**
+     * Time given to the async endpoint to produce the response, counted from the moment request headers are parsed. <br>
+     * Once the deadline is exceeded the endpoint coroutine (and all coroutines started by it) is aborted
+     * with &id:oatpp::async::TimeoutError; and the client gets `504 Gateway Timeout`. <br>
+     * Values above &l:HttpProcessor::MAX_DEADLINE; are clamped. `0` - no deadline.
+     */
+    std::chrono::duration<v_int64, std::micro> requestDeadline = std::chrono::microseconds(0);
+
+    /**
+     * Name of the request header carrying the client's time budget in milliseconds (ex.: `X-Request-Timeout: 250`). <br>
+     * If both &l:HttpProcessor::Config::requestDeadline; and the header are set, the earlier deadline wins.
+     * Values above &l:HttpProcessor::MAX_DEADLINE; are clamped. <br>
+     * `nullptr` - header is ignored.
+     */
+    oatpp::String deadlineHeader = nullptr;
+
   };
 
 public:
@@ -172,9 +207,14 @@ private:
     oatpp::data::stream::BufferOutputStream headersOutBuffer;
     RequestHeadersReader headersReader;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> inStream;
+    std::shared_ptr<base::Arena> arena;
 
   };
 
+  static base::Arena* acquireArena(std::shared_ptr<base::Arena>& arena, const Config& config);
+  static void releaseArena(std::shared_ptr<base::Arena>& arena);
+  static void applyDeadline(const Config& config, const std::shared_ptr<protocol::http::incoming::Request>& request);
+
   static
   std::shared_ptr<protocol::http::outgoing::Response>
   processNextRequest(ProcessingResources& resources,
@@ -258,6 +298,7 @@ public:
     RequestHeadersReader m_headersReader;
     std::shared_ptr<oatpp::data::stream::BufferOutputStream> m_headersOutBuffer;
     std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> m_inStream;
+    std::shared_ptr<base::Arena> m_arena;
     ConnectionState m_connectionState;
   private:
     oatpp::web::server::HttpRouter::BranchRouter::Route m_currentRoute;
@@ -240,6 +240,10 @@ protected:
 
       async::Action handleError(async::Error* error) override {
 
+        if(error->is<async::TimeoutError>()) {
+          return error; // request deadline exceeded - the response is formed by HttpProcessor
+        }
+
         std::exception_ptr ePtr = error->getExceptionPtr();
         if(!ePtr) {
           ePtr = std::make_exception_ptr(*error);
@@ -0,0 +1,260 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "RateLimiter.hpp"
+
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/base/Log.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace oatpp { namespace web { namespace server { namespace interceptor {
+
+RateLimiter::RateLimiter(const Config& config)
+  : m_config(config)
+  , m_noPeerAddressLogged(false)
+{
+
+  if(m_config.rate <= 0 || m_config.burst < 1 || m_config.shardsCount < 1 || m_config.shardCapacity < 1) {
+    throw std::runtime_error("[oatpp::web::server::interceptor::RateLimiter::RateLimiter()]: Error. Invalid config.");
+  }
+
+  m_emissionInterval = static_cast<v_int64>(std::ceil(1000000.0 / m_config.rate));
+  if(m_emissionInterval < 1) {
+    m_emissionInterval = 1;
+  }
+  m_tolerance = m_emissionInterval * (m_config.burst - 1);
+
+  m_shards.reset(new Shard[static_cast<size_t>(m_config.shardsCount)]);
+  for(v_int32 i = 0; i < m_config.shardsCount; i ++) {
+    m_shards[static_cast<size_t>(i)].slots.reset(new Slot[static_cast<size_t>(m_config.shardCapacity)]);
+  }
+
+}
+
+std::shared_ptr<RateLimiter> RateLimiter::createShared(const Config& config) {
+  return std::make_shared<RateLimiter>(config);
+}
+
+v_uint64 RateLimiter::hash(v_uint64 h, const char* data, v_buff_size size) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    h ^= static_cast<v_uint8>(data[i]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+v_uint64 RateLimiter::finalize(v_uint64 h) {
+  // FNV low bits are weak for the shard/slot selection. 0 marks an empty slot.
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return h == 0 ? 1 : h;
+}
+
+v_uint64 RateLimiter::getKey(const std::shared_ptr<IncomingRequest>& request) const {
+
+  v_uint64 h = 14695981039346656037ULL;
+
+  switch(m_config.keyType) {
+
+    case KeyType::REMOTE_ADDRESS: {
+      auto connection = request->getConnection();
+      if(connection) {
+        auto address = connection->getInputStreamContext().getProperties()
+          .get(network::tcp::server::ConnectionProvider::ExtendedConnection::PROPERTY_PEER_ADDRESS);
+        if(address) {
+          h = hash(h, address->data(), static_cast<v_buff_size>(address->size()));
+        } else {
+          /* don't put all clients to one bucket - limit each connection on its own */
+          if(!m_noPeerAddressLogged.exchange(true)) {
+            OATPP_LOGw("[oatpp::web::server::interceptor::RateLimiter::getKey()]",
+                       "Warning. Connection has no '{}' property - requests are limited per connection. "
+                       "Use tcp::server::ConnectionProvider with useExtendedConnections=true to limit per remote address.",
+                       network::tcp::server::ConnectionProvider::ExtendedConnection::PROPERTY_PEER_ADDRESS)
+          }
+          auto id = reinterpret_cast<std::uintptr_t>(connection.get());
+          h = hash(h, "connection:", 11);
+          h = hash(h, reinterpret_cast<const char*>(&id), sizeof(id));
+        }
+      }
+      break;
+    }
+
+    case KeyType::HEADER: {
+      auto value = request->getHeader(m_config.keyHeader);
+      if(value) {
+        h = hash(h, value->data(), static_cast<v_buff_size>(value->size()));
+      }
+      break;
+    }
+
+    case KeyType::PATH: {
+      const auto& line = request->getStartingLine();
+      h = hash(h, reinterpret_cast<const char*>(line.method.getData()), line.method.getSize());
+      h = hash(h, " ", 1);
+      auto path = reinterpret_cast<const char*>(line.path.getData());
+      v_buff_size size = 0;
+      while(size < line.path.getSize() && path[size] != '?') {
+        size ++;
+      }
+      h = hash(h, path, size);
+      break;
+    }
+
+    default:
+      break;
+
+  }
+
+  return finalize(h);
+
+}
+
+RateLimiter::Slot& RateLimiter::getSlot(Shard& shard, v_uint64 key, v_int64 now) {
+
+  auto capacity = static_cast<v_uint64>(m_config.shardCapacity);
+  auto start = (key >> 32) % capacity;
+  auto probe = static_cast<v_uint64>(MAX_PROBE) < capacity ? static_cast<v_uint64>(MAX_PROBE) : capacity;
+
+  Slot* idleSlot = nullptr;
+  v_uint64 idleKey = 0;
+
+  for(v_uint64 i = 0; i < probe; i ++) {
+
+    auto& slot = shard.slots[(start + i) % capacity];
+    auto slotKey = slot.key.load(std::memory_order_acquire);
+
+    if(slotKey == key) {
+      return slot;
+    }
+
+    if(slotKey == 0) {
+      if(slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel) || slotKey == key) {
+        return slot;
+      }
+      continue;
+    }
+
+    if(idleSlot == nullptr && slot.tat.load(std::memory_order_relaxed) <= now - m_config.idleTimeout.count()) {
+      idleSlot = &slot;
+      idleKey = slotKey;
+    }
+
+  }
+
+  // A bucket idle for long enough is full - it can be taken over by the new key as is.
+  if(idleSlot != nullptr) {
+    if(idleSlot->key.compare_exchange_strong(idleKey, key, std::memory_order_acq_rel)) {
+      shard.evicted.fetch_add(1, std::memory_order_relaxed);
+      return *idleSlot;
+    }
+    if(idleKey == key) {
+      return *idleSlot;
+    }
+  }
+
+  return shard.overflow;
+
+}
+
+bool RateLimiter::acquire(v_uint64 key, v_int64& retryAfter) {
+
+  auto& shard = m_shards[key % static_cast<v_uint64>(m_config.shardsCount)];
+  auto now = oatpp::Environment::getMicroTickCount();
+  auto& slot = getSlot(shard, key, now);
+
+  auto tat = slot.tat.load(std::memory_order_relaxed);
+  while(true) {
+    auto base = tat > now ? tat : now;
+    if(base - now > m_tolerance) {
+      retryAfter = base - now - m_tolerance;
+      shard.rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if(slot.tat.compare_exchange_weak(tat, base + m_emissionInterval, std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  retryAfter = 0;
+  shard.allowed.fetch_add(1, std::memory_order_relaxed);
+  return true;
+
+}
+
+bool RateLimiter::tryAcquire(const oatpp::String& key, v_int64& retryAfter) {
+  v_uint64 h = 14695981039346656037ULL;
+  if(key) {
+    h = hash(h, key->data(), static_cast<v_buff_size>(key->size()));
+  }
+  return acquire(finalize(h), retryAfter);
+}
+
+std::shared_ptr<RequestInterceptor::OutgoingResponse> RateLimiter::intercept(const std::shared_ptr<IncomingRequest>& request) {
+
+  v_int64 retryAfter;
+  if(acquire(getKey(request), retryAfter)) {
+    return nullptr;
+  }
+
+  auto response = protocol::http::outgoing::ResponseFactory::createResponse(protocol::http::Status::CODE_429, "Too Many Requests");
+  response->putHeader("Retry-After", utils::Conversion::int64ToStr((retryAfter + 999999) / 1000000));
+  return response;
+
+}
+
+v_int64 RateLimiter::getAllowedCount() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < m_config.shardsCount; i ++) {
+    result += m_shards[static_cast<size_t>(i)].allowed.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+v_int64 RateLimiter::getRejectedCount() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < m_config.shardsCount; i ++) {
+    result += m_shards[static_cast<size_t>(i)].rejected.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+v_int64 RateLimiter::getEvictedCount() const {
+  v_int64 result = 0;
+  for(v_int32 i = 0; i < m_config.shardsCount; i ++) {
+    result += m_shards[static_cast<size_t>(i)].evicted.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+v_int64 RateLimiter::getCapacity() const {
+  return static_cast<v_int64>(m_config.shardsCount) * m_config.shardCapacity;
+}
+
+}}}}
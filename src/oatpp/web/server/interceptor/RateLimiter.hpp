@@ -0,0 +1,207 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_web_server_interceptor_RateLimiter_hpp
+#define oatpp_web_server_interceptor_RateLimiter_hpp
+
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace oatpp { namespace web { namespace server { namespace interceptor {
+
+/**
+ * Token-bucket rate limiter. <br>
+ * Rejects requests with `429 Too Many Requests` before they are routed.
+ * Works the same for &id:oatpp::web::server::HttpConnectionHandler; and &id:oatpp::web::server::AsyncHttpConnectionHandler;. <br>
+ * Each bucket is stored as a single "theoretical arrival time" (GCRA) and is updated with a single CAS - no locks are taken. <br>
+ * Buckets live in a fixed-size table split into shards, so memory is bounded.
+ * Buckets idle for longer than `idleTimeout` are reclaimed by new keys.
+ * When there is no free slot for a key, the key shares the overflow bucket of its shard.
+ */
+class RateLimiter : public RequestInterceptor {
+public:
+
+  /**
+   * What requests are grouped by.
+   */
+  enum class KeyType : v_int32 {
+
+    /**
+     * Remote address - `peer_address` property of the connection. <br>
+     * The property is set by &id:oatpp::network::tcp::server::ConnectionProvider; only when it's created with
+     * `useExtendedConnections = true`. Connections without this property are limited per connection
+     * (a warning is logged once) - enable extended connections for per-client limits.
+     */
+    REMOTE_ADDRESS = 0,
+
+    /**
+     * Value of the header (ex.: API key). Requests without the header share one bucket.
+     */
+    HEADER = 1,
+
+    /**
+     * Request method and path (without query). <br>
+     * *Note: interceptors run before routing - requests to the same route with different path variables
+     * get different buckets.*
+     */
+    PATH = 2
+
+  };
+
+  /**
+   * Rate limiter config.
+   */
+  struct Config {
+
+    /**
+     * What requests are grouped by.
+     */
+    KeyType keyType = KeyType::REMOTE_ADDRESS;
+
+    /**
+     * Header name used with &l:RateLimiter::KeyType::HEADER;.
+     */
+    oatpp::String keyHeader = "X-API-Key";
+
+    /**
+     * Tokens added per second (sustained requests per second).
+     */
+    v_float64 rate = 10;
+
+    /**
+     * Bucket size (max requests in a burst).
+     */
+    v_int64 burst = 20;
+
+    /**
+     * Buckets which haven't been used for this time can be reclaimed by other keys.
+     */
+    std::chrono::duration<v_int64, std::micro> idleTimeout = std::chrono::seconds(60);
+
+    /**
+     * Number of shards.
+     */
+    v_int32 shardsCount = 16;
+
+    /**
+     * Number of buckets in a shard.
+     */
+    v_int32 shardCapacity = 1024;
+
+  };
+
+private:
+
+  struct Slot {
+    std::atomic<v_uint64> key{0};
+    std::atomic<v_int64> tat{0};
+  };
+
+  struct alignas(64) Shard {
+    std::unique_ptr<Slot[]> slots;
+    Slot overflow;
+    std::atomic<v_int64> allowed{0};
+    std::atomic<v_int64> rejected{0};
+    std::atomic<v_int64> evicted{0};
+  };
+
+private:
+  static constexpr v_int32 MAX_PROBE = 8;
+private:
+  static v_uint64 hash(v_uint64 h, const char* data, v_buff_size size);
+  static v_uint64 finalize(v_uint64 h);
+private:
+  Slot& getSlot(Shard& shard, v_uint64 key, v_int64 now);
+  v_uint64 getKey(const std::shared_ptr<IncomingRequest>& request) const;
+  bool acquire(v_uint64 key, v_int64& retryAfter);
+private:
+  Config m_config;
+  mutable std::atomic<bool> m_noPeerAddressLogged;
+  v_int64 m_emissionInterval;
+  v_int64 m_tolerance;
+  std::unique_ptr<Shard[]> m_shards;
+public:
+
+  /**
+   * Constructor.
+   * @param config - &l:RateLimiter::Config;.
+   */
+  RateLimiter(const Config& config);
+
+  /**
+   * Create shared RateLimiter.
+   * @param config - &l:RateLimiter::Config;.
+   * @return - `std::shared_ptr` to RateLimiter.
+   */
+  static std::shared_ptr<RateLimiter> createShared(const Config& config);
+
+  /**
+   * Take one token from the bucket of the key. <br>
+   * Use it to apply the same limits outside of the request interception.
+   * @param key - bucket key. Keys are compared by hash.
+   * @param retryAfter - out parameter. When rejected - time until the next token is available (microseconds).
+   * @return - `true` if allowed.
+   */
+  bool tryAcquire(const oatpp::String& key, v_int64& retryAfter);
+
+  /**
+   * Return `429 Too Many Requests` if the bucket of the request is empty. Otherwise return `nullptr`.
+   * @param request - &id:oatpp::web::protocol::http::incoming::Request;.
+   * @return - &id:oatpp::web::protocol::http::outgoing::Response; or `nullptr`.
+   */
+  std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+
+  /**
+   * Get number of allowed requests.
+   * @return
+   */
+  v_int64 getAllowedCount() const;
+
+  /**
+   * Get number of rejected requests.
+   * @return
+   */
+  v_int64 getRejectedCount() const;
+
+  /**
+   * Get number of idle buckets reclaimed by other keys.
+   * @return
+   */
+  v_int64 getEvictedCount() const;
+
+  /**
+   * Get max number of buckets.
+   * @return
+   */
+  v_int64 getCapacity() const;
+
+};
+
+}}}}
+
+#endif // oatpp_web_server_interceptor_RateLimiter_hpp
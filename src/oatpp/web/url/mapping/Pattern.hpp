@@ -27,6 +27,7 @@
 
 #include "oatpp/data/share/MemoryLabel.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/base/Arena.hpp"
 
 #include <list>
 #include <unordered_map>
@@ -41,13 +42,22 @@ public:
   class MatchMap {
     friend Pattern;
   public:
-    typedef std::unordered_map<StringKeyLabel, StringKeyLabel> Variables;
+    typedef std::unordered_map<StringKeyLabel, StringKeyLabel, std::hash<StringKeyLabel>, std::equal_to<StringKeyLabel>,
+                               base::ArenaAllocator<std::pair<const StringKeyLabel, StringKeyLabel>>> Variables;
   private:
     Variables m_variables;
     StringKeyLabel m_tail;
   public:
     
     MatchMap() {}
+
+    /**
+     * Constructor.
+     * @param arena - &id:oatpp::base::Arena; to allocate variables from. `nullptr` - allocate on heap.
+     */
+    explicit MatchMap(base::Arena* arena)
+      : m_variables(Variables::allocator_type(arena))
+    {}
     
     MatchMap(const Variables& vars, const StringKeyLabel& urlTail)
       : m_variables(vars)
@@ -1,16 +1,24 @@
 
 #include "oatpp/web/ClientRetryTest.hpp"
+#include "oatpp/web/client/HedgingTest.hpp"
+#include "oatpp/web/client/HttpPipelineTest.hpp"
 #include "oatpp/web/FullTest.hpp"
 #include "oatpp/web/FullAsyncTest.hpp"
 #include "oatpp/web/FullAsyncClientTest.hpp"
 #include "oatpp/web/PipelineTest.hpp"
 #include "oatpp/web/PipelineAsyncTest.hpp"
 #include "oatpp/web/protocol/http/encoding/ChunkedTest.hpp"
+#include "oatpp/web/protocol/http/encoding/DeflateTest.hpp"
+#include "oatpp/web/protocol/http/encoding/ProviderCollectionTest.hpp"
 #include "oatpp/web/server/api/ApiControllerTest.hpp"
 #include "oatpp/web/server/handler/AuthorizationHandlerTest.hpp"
+#include "oatpp/web/server/interceptor/RateLimiterTest.hpp"
 #include "oatpp/web/server/HttpRouterTest.hpp"
+#include "oatpp/web/server/AdmissionControlTest.hpp"
+#include "oatpp/web/server/RequestDeadlineTest.hpp"
 #include "oatpp/web/server/ServerStopTest.hpp"
 #include "oatpp/web/mime/multipart/StatefulParserTest.hpp"
+#include "oatpp/web/mime/multipart/FileProviderTest.hpp"
 #include "oatpp/web/mime/ContentMappersTest.hpp"
 
 #include "oatpp/network/virtual_/PipeTest.hpp"
@@ -18,6 +26,8 @@
 #include "oatpp/network/UrlTest.hpp"
 #include "oatpp/network/ConnectionPoolTest.hpp"
 #include "oatpp/network/monitor/ConnectionMonitorTest.hpp"
+#include "oatpp/network/resolver/ResolverTest.hpp"
+#include "oatpp/network/unix_/ConnectionProviderTest.hpp"
 
 #include "oatpp/json/DeserializerTest.hpp"
 #include "oatpp/json/DTOMapperPerfTest.hpp"
@@ -32,10 +42,15 @@
 #include "oatpp/encoding/UrlTest.hpp"
 
 #include "oatpp/utils/parser/CaretTest.hpp"
+#include "oatpp/utils/CRC32Test.hpp"
+#include "oatpp/utils/ConversionTest.hpp"
 #include "oatpp/provider/PoolTest.hpp"
 #include "oatpp/provider/PoolTemplateTest.hpp"
 #include "oatpp/async/ConditionVariableTest.hpp"
+#include "oatpp/async/DeadlineTest.hpp"
+#include "oatpp/async/ExecutorTest.hpp"
 #include "oatpp/async/LockTest.hpp"
+#include "oatpp/async/ProcessorTest.hpp"
 
 #include "oatpp/data/type/UnorderedMapTest.hpp"
 #include "oatpp/data/type/PairListTest.hpp"
@@ -64,8 +79,11 @@
 #include "oatpp/data/share/LazyStringMapTest.hpp"
 #include "oatpp/data/share/StringTemplateTest.hpp"
 #include "oatpp/data/share/MemoryLabelTest.hpp"
+#include "oatpp/data/share/StringInternTableTest.hpp"
 #include "oatpp/data/buffer/ProcessorTest.hpp"
 
+#include "oatpp/base/ArenaTest.hpp"
+#include "oatpp/base/CountableTest.hpp"
 #include "oatpp/base/CommandLineArgumentsTest.hpp"
 #include "oatpp/base/LogTest.hpp"
 
@@ -107,12 +125,15 @@ void runTests() {
   }
 
   OATPP_RUN_TEST(oatpp::test::LoggerTest);
+  OATPP_RUN_TEST(oatpp::base::ArenaTest);
+  OATPP_RUN_TEST(oatpp::base::CountableTest);
   OATPP_RUN_TEST(oatpp::base::CommandLineArgumentsTest);
   OATPP_RUN_TEST(oatpp::base::LogTest);
 
   OATPP_RUN_TEST(oatpp::data::share::MemoryLabelTest);
   OATPP_RUN_TEST(oatpp::data::share::LazyStringMapTest);
   OATPP_RUN_TEST(oatpp::data::share::StringTemplateTest);
+  OATPP_RUN_TEST(oatpp::data::share::StringInternTableTest);
 
   OATPP_RUN_TEST(oatpp::data::buffer::ProcessorTest);
   OATPP_RUN_TEST(oatpp::data::stream::BufferStreamTest);
@@ -144,9 +165,14 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::data::resource::InMemoryDataTest);
 
   OATPP_RUN_TEST(oatpp::async::ConditionVariableTest);
+  OATPP_RUN_TEST(oatpp::async::DeadlineTest);
+  OATPP_RUN_TEST(oatpp::async::ExecutorTest);
   OATPP_RUN_TEST(oatpp::async::LockTest);
+  OATPP_RUN_TEST(oatpp::async::ProcessorTest);
 
   OATPP_RUN_TEST(oatpp::utils::parser::CaretTest);
+  OATPP_RUN_TEST(oatpp::utils::CRC32Test);
+  OATPP_RUN_TEST(oatpp::utils::ConversionTest);
 
   OATPP_RUN_TEST(oatpp::provider::PoolTest);
   OATPP_RUN_TEST(oatpp::provider::PoolTemplateTest);
@@ -169,17 +195,33 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::test::network::UrlTest);
   OATPP_RUN_TEST(oatpp::test::network::ConnectionPoolTest);
   OATPP_RUN_TEST(oatpp::test::network::monitor::ConnectionMonitorTest);
+  OATPP_RUN_TEST(oatpp::test::network::resolver::ResolverTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::PipeTest);
   OATPP_RUN_TEST(oatpp::test::network::virtual_::InterfaceTest);
 
   OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::ChunkedTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::DeflateTest);
+  OATPP_RUN_TEST(oatpp::test::web::protocol::http::encoding::ProviderCollectionTest);
+  OATPP_RUN_TEST(oatpp::test::web::client::HedgingTest);
+  OATPP_RUN_TEST(oatpp::test::web::client::HttpPipelineTest);
 
   OATPP_RUN_TEST(oatpp::test::web::mime::multipart::StatefulParserTest);
+  OATPP_RUN_TEST(oatpp::test::web::mime::multipart::FileProviderTest);
   OATPP_RUN_TEST(oatpp::web::mime::ContentMappersTest);
 
   OATPP_RUN_TEST(oatpp::test::web::server::HttpRouterTest);
   OATPP_RUN_TEST(oatpp::test::web::server::api::ApiControllerTest);
   OATPP_RUN_TEST(oatpp::test::web::server::handler::AuthorizationHandlerTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::interceptor::RateLimiterTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::AdmissionControlTest);
+  OATPP_RUN_TEST(oatpp::test::web::server::RequestDeadlineTest);
+
+  {
+
+    oatpp::test::network::unix_::ConnectionProviderTest test(2000);
+    test.run();
+
+  }
 
   {
 
@@ -219,6 +261,9 @@ void runTests() {
     oatpp::test::web::FullTest test_port(8000, 5);
     test_port.run();
 
+    oatpp::test::web::FullTest test_arena(0, 100, true);
+    test_arena.run();
+
   }
 
   {
@@ -229,6 +274,9 @@ void runTests() {
     oatpp::test::web::FullAsyncTest test_port(8000, 5);
     test_port.run();
 
+    oatpp::test::web::FullAsyncTest test_arena(0, 100, true);
+    test_arena.run();
+
   }
 
   {
@@ -0,0 +1,232 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DeadlineTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/Lock.hpp"
+
+#if !defined(WIN32) && !defined(_WIN32)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <functional>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+struct Result {
+  std::atomic<bool> finished {false};
+  std::atomic<bool> timedOut {false};
+  std::atomic<v_int64> elapsed {0};
+};
+
+/* sets the deadline and starts the child - the child inherits the deadline */
+class RootCoroutine : public oatpp::async::Coroutine<RootCoroutine> {
+private:
+  Result* m_result;
+  std::chrono::duration<v_int64, std::micro> m_timeout;
+  std::function<CoroutineStarter()> m_starter;
+  v_int64 m_startTime;
+public:
+
+  RootCoroutine(Result* result,
+                const std::chrono::duration<v_int64, std::micro>& timeout,
+                const std::function<CoroutineStarter()>& starter)
+    : m_result(result)
+    , m_timeout(timeout)
+    , m_starter(starter)
+    , m_startTime(0)
+  {}
+
+  Action act() override {
+    m_startTime = oatpp::Environment::getMicroTickCount();
+    setDeadline(m_startTime + m_timeout.count());
+    return m_starter().next(yieldTo(&RootCoroutine::onDone));
+  }
+
+  Action onDone() {
+    m_result->elapsed = oatpp::Environment::getMicroTickCount() - m_startTime;
+    m_result->finished = true;
+    return finish();
+  }
+
+  Action handleError(Error* error) override {
+    m_result->elapsed = oatpp::Environment::getMicroTickCount() - m_startTime;
+    if(error->is<TimeoutError>()) {
+      m_result->timedOut = true;
+      return finish();
+    }
+    return error;
+  }
+
+};
+
+class SleepCoroutine : public oatpp::async::Coroutine<SleepCoroutine> {
+private:
+  std::chrono::duration<v_int64, std::micro> m_duration;
+public:
+
+  SleepCoroutine(const std::chrono::duration<v_int64, std::micro>& duration)
+    : m_duration(duration)
+  {}
+
+  Action act() override {
+    return waitFor(m_duration).next(finish());
+  }
+
+};
+
+class SpinCoroutine : public oatpp::async::Coroutine<SpinCoroutine> {
+public:
+
+  Action act() override {
+    return repeat();
+  }
+
+};
+
+class LockCoroutine : public oatpp::async::Coroutine<LockCoroutine> {
+private:
+  oatpp::async::LockGuard m_lockGuard;
+public:
+
+  LockCoroutine(oatpp::async::Lock* lock)
+    : m_lockGuard(lock)
+  {}
+
+  Action act() override {
+    return m_lockGuard.lockAsync().next(finish());
+  }
+
+};
+
+class ReadWaitCoroutine : public oatpp::async::Coroutine<ReadWaitCoroutine> {
+private:
+  v_io_handle m_handle;
+public:
+
+  ReadWaitCoroutine(v_io_handle handle)
+    : m_handle(handle)
+  {}
+
+  Action act() override {
+    return ioWait(m_handle, Action::IOEventType::IO_EVENT_READ);
+  }
+
+};
+
+void runWithDeadline(oatpp::async::Executor& executor,
+                     Result& result,
+                     const std::chrono::duration<v_int64, std::micro>& timeout,
+                     const std::function<CoroutineStarter()>& starter)
+{
+  executor.execute<RootCoroutine>(&result, timeout, starter);
+  executor.waitTasksFinished(std::chrono::seconds(30));
+}
+
+void checkTimedOut(const char* testName, const Result& result) {
+  OATPP_LOGd(testName, "timedOut={}, elapsed={}us", result.timedOut.load(), result.elapsed.load())
+  OATPP_ASSERT(result.timedOut)
+  OATPP_ASSERT(!result.finished)
+  OATPP_ASSERT(result.elapsed >= 90 * 1000)
+  OATPP_ASSERT(result.elapsed < 5 * 1000 * 1000)
+}
+
+void runIOTests(v_int32 ioWorkerType) {
+
+  oatpp::async::Executor executor(1, 1, 1, ioWorkerType);
+
+  {
+    Result result;
+    runWithDeadline(executor, result, std::chrono::milliseconds(100), [] {
+      return SleepCoroutine::start(std::chrono::seconds(10));
+    });
+    checkTimedOut("timer", result);
+  }
+
+  {
+    Result result;
+    runWithDeadline(executor, result, std::chrono::seconds(5), [] {
+      return SleepCoroutine::start(std::chrono::milliseconds(10));
+    });
+    OATPP_ASSERT(result.finished)
+    OATPP_ASSERT(!result.timedOut)
+  }
+
+  {
+    Result result;
+    runWithDeadline(executor, result, std::chrono::milliseconds(100), [] {
+      return SpinCoroutine::start();
+    });
+    checkTimedOut("repeat", result);
+  }
+
+  {
+    oatpp::async::Lock lock;
+    lock.lock();
+    Result result;
+    runWithDeadline(executor, result, std::chrono::milliseconds(100), [&lock] {
+      return LockCoroutine::start(&lock);
+    });
+    lock.unlock();
+    checkTimedOut("wait-list", result);
+  }
+
+#if !defined(WIN32) && !defined(_WIN32)
+  {
+    int fds[2];
+    OATPP_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0)
+    Result result;
+    runWithDeadline(executor, result, std::chrono::milliseconds(100), [&fds] {
+      return ReadWaitCoroutine::start(fds[0]);
+    });
+    ::close(fds[0]);
+    ::close(fds[1]);
+    checkTimedOut("io", result);
+  }
+#endif
+
+  executor.waitTasksFinished();
+  executor.stop();
+  executor.join();
+
+}
+
+}
+
+void DeadlineTest::onRun() {
+
+  OATPP_LOGd(TAG, "IO_WORKER_TYPE_EVENT")
+  runIOTests(oatpp::async::Executor::IO_WORKER_TYPE_EVENT);
+
+  OATPP_LOGd(TAG, "IO_WORKER_TYPE_NAIVE")
+  runIOTests(oatpp::async::Executor::IO_WORKER_TYPE_NAIVE);
+
+}
+
+}}
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ExecutorTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/concurrency/Utils.hpp"
+
+namespace oatpp { namespace async {
+
+namespace {
+
+class CounterCoroutine : public oatpp::async::Coroutine<CounterCoroutine> {
+private:
+  std::atomic<v_int32>* m_counter;
+public:
+
+  CounterCoroutine(std::atomic<v_int32>* counter)
+    : m_counter(counter)
+  {}
+
+  Action act() override {
+    ++ (*m_counter);
+    return finish();
+  }
+
+};
+
+}
+
+void ExecutorTest::onRun() {
+
+  std::vector<std::vector<v_int32>> nodes = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+
+  {
+    OATPP_LOGd(TAG, "Placement NONE")
+    Executor::Placement placement;
+    OATPP_ASSERT(Executor::chooseProcessorCpus(placement, nodes, 4).empty())
+  }
+
+  {
+    OATPP_LOGd(TAG, "Placement COMPACT")
+    Executor::Placement placement;
+    placement.policy = Executor::Placement::COMPACT;
+    auto cpus = Executor::chooseProcessorCpus(placement, nodes, 6);
+    OATPP_ASSERT((cpus == std::vector<v_int32>{0, 1, 2, 3, 4, 5}))
+  }
+
+  {
+    OATPP_LOGd(TAG, "Placement SCATTER")
+    Executor::Placement placement;
+    placement.policy = Executor::Placement::SCATTER;
+    auto cpus = Executor::chooseProcessorCpus(placement, nodes, 4);
+    OATPP_ASSERT((cpus == std::vector<v_int32>{0, 4, 1, 5}))
+  }
+
+  {
+    OATPP_LOGd(TAG, "Placement CPU_LIST")
+    Executor::Placement placement;
+    placement.policy = Executor::Placement::CPU_LIST;
+    placement.cpus = {3, 7};
+    auto cpus = Executor::chooseProcessorCpus(placement, nodes, 3);
+    OATPP_ASSERT((cpus == std::vector<v_int32>{3, 7, 3}))
+
+    placement.cpus = {};
+    bool thrown = false;
+    try {
+      Executor::chooseProcessorCpus(placement, nodes, 3);
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Worker CPUs")
+    std::vector<v_int32> processorCpus = {0, 4, 1, 5};
+
+    OATPP_ASSERT(Executor::chooseWorkerCpus(2, {}).empty())
+
+    /* fewer workers than processors - each worker gets CPUs of all processors it serves */
+    auto cpus = Executor::chooseWorkerCpus(2, processorCpus);
+    OATPP_ASSERT((cpus == std::vector<std::vector<v_int32>>{{0, 1}, {4, 5}}))
+
+    cpus = Executor::chooseWorkerCpus(1, processorCpus);
+    OATPP_ASSERT((cpus == std::vector<std::vector<v_int32>>{{0, 1, 4, 5}}))
+
+    cpus = Executor::chooseWorkerCpus(8, processorCpus);
+    OATPP_ASSERT((cpus == std::vector<std::vector<v_int32>>{{0}, {4}, {1}, {5}, {0}, {4}, {1}, {5}}))
+
+    /* workers are linked to every processor */
+    cpus = Executor::chooseWorkerCpus(3, processorCpus);
+    OATPP_ASSERT((cpus == std::vector<std::vector<v_int32>>{{0, 1, 4, 5}, {0, 1, 4, 5}, {0, 1, 4, 5}}))
+  }
+
+  {
+    OATPP_LOGd(TAG, "NUMA topology")
+    auto topology = oatpp::concurrency::Utils::getNumaNodesCpus();
+    OATPP_ASSERT(!topology.empty())
+    for(auto& node : topology) {
+      OATPP_ASSERT(!node.empty())
+    }
+  }
+
+  {
+    OATPP_LOGd(TAG, "Run pinned executor")
+    Executor::Placement placement;
+    placement.policy = Executor::Placement::COMPACT;
+    Executor executor(2, 1, 1, Executor::VALUE_SUGGESTED, placement);
+
+    std::atomic<v_int32> counter(0);
+    for(v_int32 i = 0; i < 100; i ++) {
+      executor.execute<CounterCoroutine>(&counter);
+    }
+
+    executor.waitTasksFinished();
+    executor.stop();
+    executor.join();
+
+    OATPP_ASSERT(counter == 100)
+  }
+
+}
+
+}}
@@ -0,0 +1,134 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ProcessorTest.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/async/CoroutineWaitList.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace async {
+
+namespace {
+
+/*
+ * Sleeps on a wait list until the timeout `times` times in a row.
+ * Records the total time slept and the shortest single sleep.
+ */
+class SleepCoroutine : public Coroutine<SleepCoroutine> {
+private:
+  CoroutineWaitList m_waitList;
+  std::chrono::milliseconds m_timeout;
+  v_int32 m_times;
+  v_int64 m_sleepStart;
+  std::atomic<v_int64>* m_total;
+  std::atomic<v_int64>* m_shortest;
+public:
+
+  SleepCoroutine(const std::chrono::milliseconds& timeout, v_int32 times, std::atomic<v_int64>* total, std::atomic<v_int64>* shortest)
+    : m_timeout(timeout)
+    , m_times(times)
+    , m_sleepStart(0)
+    , m_total(total)
+    , m_shortest(shortest)
+  {}
+
+  Action act() override {
+    *m_total = oatpp::Environment::getMicroTickCount();
+    return yieldTo(&SleepCoroutine::sleep);
+  }
+
+  Action sleep() {
+
+    auto now = oatpp::Environment::getMicroTickCount();
+
+    if(m_sleepStart > 0) {
+      auto slept = now - m_sleepStart;
+      if(*m_shortest == 0 || slept < *m_shortest) {
+        *m_shortest = slept;
+      }
+      if(-- m_times == 0) {
+        *m_total = now - *m_total;
+        return finish();
+      }
+    }
+
+    m_sleepStart = now;
+    return Action::createWaitListAction(&m_waitList, std::chrono::system_clock::now() + m_timeout);
+
+  }
+
+};
+
+}
+
+void ProcessorTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Wait-list timeouts are not rounded up to the sleep-checker period...")
+
+    std::atomic<v_int64> total(0);
+    std::atomic<v_int64> shortest(0);
+
+    auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    executor->execute<SleepCoroutine>(std::chrono::milliseconds(10), 20, &total, &shortest);
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+
+    OATPP_LOGd(TAG, "20 x 10ms: total={}(micro), shortest={}(micro)", total.load(), shortest.load())
+    OATPP_ASSERT(shortest >= 10 * 1000)
+    OATPP_ASSERT(total < 1000 * 1000)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Earlier timeout wakes the sleep-checker waiting for a later one...")
+
+    std::atomic<v_int64> longTotal(0);
+    std::atomic<v_int64> longShortest(0);
+    std::atomic<v_int64> shortTotal(0);
+    std::atomic<v_int64> shortShortest(0);
+
+    auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    executor->execute<SleepCoroutine>(std::chrono::milliseconds(2000), 1, &longTotal, &longShortest);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    executor->execute<SleepCoroutine>(std::chrono::milliseconds(20), 1, &shortTotal, &shortShortest);
+    executor->waitTasksFinished();
+    executor->stop();
+    executor->join();
+
+    OATPP_LOGd(TAG, "short={}(micro), long={}(micro)", shortTotal.load(), longTotal.load())
+    OATPP_ASSERT(shortShortest >= 20 * 1000)
+    OATPP_ASSERT(shortShortest < 1000 * 1000)
+    OATPP_ASSERT(longShortest >= 2000 * 1000)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,156 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ArenaTest.hpp"
+
+#include "oatpp/base/Arena.hpp"
+#include "oatpp/web/protocol/http/Http.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace base {
+
+namespace {
+
+typedef oatpp::web::protocol::http::Headers Headers;
+
+void fillHeaders(Headers& headers, v_int32 count) {
+  for(v_int32 i = 0; i < count; i ++) {
+    headers.put_LockFree("X-Header-" + oatpp::utils::Conversion::int32ToStr(i), "value");
+  }
+}
+
+}
+
+void ArenaTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Alignment...")
+
+    Arena arena(256);
+
+    auto a = arena.allocate(1, 1);
+    auto b = arena.allocate(8, 8);
+    auto c = arena.allocate(3, 1);
+    auto d = arena.allocate(16, 16);
+
+    OATPP_ASSERT(a != nullptr && b != nullptr && c != nullptr && d != nullptr)
+    OATPP_ASSERT(reinterpret_cast<v_buff_usize>(b) % 8 == 0)
+    OATPP_ASSERT(reinterpret_cast<v_buff_usize>(d) % 16 == 0)
+    OATPP_ASSERT(arena.getAllocationsCount() == 4)
+    OATPP_ASSERT(arena.getHeapAllocationsCount() == 1)
+
+    /* larger than the chunk */
+    auto e = arena.allocate(1024);
+    OATPP_ASSERT(e != nullptr)
+    OATPP_ASSERT(arena.getHeapAllocationsCount() == 2)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Reset coalesces chunks...")
+
+    Arena arena(256);
+
+    for(v_int32 i = 0; i < 100; i ++) {
+      arena.allocate(32);
+    }
+
+    auto heapAllocations = arena.getHeapAllocationsCount();
+    OATPP_ASSERT(heapAllocations > 1)
+
+    arena.reset();
+    OATPP_ASSERT(arena.getHeapAllocationsCount() == heapAllocations + 1)
+
+    /* steady state - no more heap allocations */
+    for(v_int32 cycle = 0; cycle < 10; cycle ++) {
+      for(v_int32 i = 0; i < 100; i ++) {
+        arena.allocate(32);
+      }
+      arena.reset();
+    }
+    OATPP_ASSERT(arena.getHeapAllocationsCount() == heapAllocations + 1)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Containers...")
+
+    Arena arena;
+
+    std::vector<v_int64, ArenaAllocator<v_int64>> vector{ArenaAllocator<v_int64>(&arena)};
+    for(v_int64 i = 0; i < 100; i ++) {
+      vector.push_back(i);
+    }
+    OATPP_ASSERT(vector.size() == 100)
+    OATPP_ASSERT(vector[99] == 99)
+    OATPP_ASSERT(arena.getAllocationsCount() > 0)
+
+    /* copy of the container is allocated on the heap */
+    auto copy = vector;
+    OATPP_ASSERT(copy.get_allocator().getArena() == nullptr)
+    OATPP_ASSERT(copy == vector)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Headers...")
+
+    Arena arena;
+
+    Headers heapHeaders;
+    fillHeaders(heapHeaders, 20);
+
+    auto allocationsBefore = arena.getAllocationsCount();
+
+    Headers headers(heapHeaders, &arena);
+    OATPP_ASSERT(headers.getSize() == 20)
+    OATPP_ASSERT(headers.get("X-Header-7") == "value")
+    OATPP_ASSERT(headers.get("x-header-19") == "value")
+
+    /* one node per header + buckets */
+    OATPP_ASSERT(arena.getAllocationsCount() - allocationsBefore > 20)
+    OATPP_ASSERT(arena.getHeapAllocationsCount() == 1)
+
+    /* move keeps the arena */
+    Headers moved(std::move(headers));
+    OATPP_ASSERT(moved.getSize() == 20)
+    OATPP_ASSERT(moved.getAll_Unsafe().get_allocator().getArena() == &arena)
+
+    /* copy goes to the heap */
+    Headers copy(moved);
+    OATPP_ASSERT(copy.getSize() == 20)
+    OATPP_ASSERT(copy.getAll_Unsafe().get_allocator().getArena() == nullptr)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}
@@ -0,0 +1,98 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CountableTest.hpp"
+
+#include "oatpp/base/Countable.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace base {
+
+namespace {
+
+class TestObject : public Countable {
+};
+
+}
+
+void CountableTest::onRun() {
+
+#ifndef OATPP_DISABLE_ENV_OBJECT_COUNTERS
+
+  {
+    OATPP_LOGi(TAG, "Case1 - same thread ...")
+    auto count = Environment::getObjectsCount();
+    auto created = Environment::getObjectsCreated();
+    {
+      TestObject a;
+      TestObject b(a);
+      OATPP_ASSERT(Environment::getObjectsCount() - count == 2)
+      OATPP_ASSERT(Environment::getObjectsCreated() - created == 2)
+    }
+    OATPP_ASSERT(Environment::getObjectsCount() == count)
+    OATPP_ASSERT(Environment::getObjectsCreated() - created == 2)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case2 - created and destroyed by different threads ...")
+
+    const v_int32 threadsCount = 8;
+    const v_int32 objectsPerThread = 10000;
+
+    auto count = Environment::getObjectsCount();
+    auto created = Environment::getObjectsCreated();
+
+    std::vector<std::vector<std::unique_ptr<TestObject>>> objects(threadsCount);
+    std::vector<std::thread> threads;
+    for(v_int32 i = 0; i < threadsCount; i ++) {
+      auto& list = objects[static_cast<size_t>(i)];
+      threads.emplace_back([&list, objectsPerThread]{
+        for(v_int32 j = 0; j < objectsPerThread; j ++) {
+          list.push_back(std::make_unique<TestObject>());
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    OATPP_ASSERT(Environment::getObjectsCount() - count == threadsCount * objectsPerThread)
+    OATPP_ASSERT(Environment::getObjectsCreated() - created == threadsCount * objectsPerThread)
+
+    objects.clear();
+
+    OATPP_ASSERT(Environment::getObjectsCount() == count)
+    OATPP_ASSERT(Environment::getObjectsCreated() - created == threadsCount * objectsPerThread)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+#endif
+
+}
+
+}}
@@ -0,0 +1,201 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "StringInternTableTest.hpp"
+
+#include "oatpp/data/share/StringInternTable.hpp"
+#include "oatpp/data/mapping/ObjectToTreeMapper.hpp"
+#include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace data { namespace share {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class InternDto : public oatpp::DTO {
+
+  DTO_INIT(InternDto, DTO)
+
+  DTO_FIELD(String, internedFieldName, "interned-field-name");
+
+};
+
+class HolderDto : public oatpp::DTO {
+
+  DTO_INIT(HolderDto, DTO)
+
+  DTO_FIELD(Object<InternDto>, dto);
+  DTO_FIELD(Fields<String>, fields);
+  DTO_FIELD(Tree, tree);
+  DTO_FIELD(Any, any);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void StringInternTableTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Case1 ...")
+    StringInternTable table;
+    auto s1 = table.intern("hello");
+    auto s2 = table.intern(std::string("hello"));
+    auto s3 = table.intern("hello world", 5);
+    OATPP_ASSERT(s1 == "hello")
+    OATPP_ASSERT(s1.get() == s2.get())
+    OATPP_ASSERT(s1.get() == s3.get())
+    OATPP_ASSERT(table.getSize() == 1)
+
+    auto empty = table.intern("");
+    OATPP_ASSERT(empty && empty->empty())
+    OATPP_ASSERT(table.getSize() == 2)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case2 ...")
+    StringInternTable table;
+    OATPP_ASSERT(table.find("hello", 5) == nullptr)
+    OATPP_ASSERT(table.getSize() == 0)
+    auto s = table.intern("hello");
+    OATPP_ASSERT(table.find("hello", 5).get() == s.get())
+    OATPP_ASSERT(table.find("hell", 4) == nullptr)
+    OATPP_ASSERT(table.isInterned(s))
+    OATPP_ASSERT(!table.isInterned(oatpp::String("hello")))
+    OATPP_ASSERT(!table.isInterned(nullptr))
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case3 - concurrent intern ...")
+    StringInternTable table;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<oatpp::String>> results(8);
+    for(size_t t = 0; t < results.size(); t ++) {
+      threads.emplace_back([&table, &results, t]{
+        for(v_int32 i = 0; i < 1000; i ++) {
+          results[t].push_back(table.intern("key-" + std::to_string(i)));
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+    OATPP_ASSERT(table.getSize() == 1000)
+    for(size_t t = 1; t < results.size(); t ++) {
+      for(size_t i = 0; i < results[t].size(); i ++) {
+        OATPP_ASSERT(results[t][i].get() == results[0][i].get())
+      }
+    }
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case4 - DTO property names ...")
+    auto& global = StringInternTable::getGlobal();
+    oatpp::Object<InternDto>::getPropertiesMap();
+    OATPP_ASSERT(global.find("interned-field-name", 19) != nullptr)
+    OATPP_ASSERT(global.find("internedFieldName", 17) != nullptr)
+
+    mapping::ObjectToTreeMapper treeMapper;
+    mapping::ObjectToTreeMapper::Config config;
+    mapping::Tree tree;
+    mapping::ObjectToTreeMapper::State state;
+    state.tree = &tree;
+    state.config = &config;
+
+    auto dto = InternDto::createShared();
+    dto->internedFieldName = "value";
+    treeMapper.map(state, dto);
+    OATPP_ASSERT(state.errorStack.empty())
+    /* the tree is returned to the user - keys must not be the interned instances */
+    OATPP_ASSERT(tree.getMap()[0].first == "interned-field-name")
+    OATPP_ASSERT(!global.isInterned(tree.getMap()[0].first))
+
+    /* the tree which is only serialized may share the interned names */
+    mapping::Tree internedTree;
+    state.tree = &internedTree;
+    state.internKeys = true;
+    treeMapper.map(state, dto);
+    OATPP_ASSERT(state.errorStack.empty())
+    OATPP_ASSERT(internedTree.getMap()[0].first == "interned-field-name")
+    OATPP_ASSERT(global.isInterned(internedTree.getMap()[0].first))
+
+    json::ObjectMapper mapper;
+    OATPP_ASSERT(mapper.writeToString(dto) == R"({"interned-field-name":"value"})")
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Case5 - JSON object keys ...")
+    auto& global = StringInternTable::getGlobal();
+    oatpp::Object<InternDto>::getPropertiesMap();
+    json::ObjectMapper mapper;
+
+    auto parsed = mapper.readFromString<oatpp::Tree>(R"({"interned-field-name":"v","not-interned-field":"v"})");
+    OATPP_ASSERT(parsed->getMap()[0].first == "interned-field-name")
+    OATPP_ASSERT(!global.isInterned(parsed->getMap()[0].first))
+    OATPP_ASSERT(parsed->getMap()[1].first == "not-interned-field")
+    OATPP_ASSERT(global.find("not-interned-field", 18) == nullptr)
+
+    auto escaped = mapper.readFromString<oatpp::Tree>(R"({"interned\u002dfield-name":"v"})");
+    OATPP_ASSERT(escaped->getMap()[0].first == "interned-field-name")
+    OATPP_ASSERT(!global.isInterned(escaped->getMap()[0].first))
+
+    /* keys that are only looked up may be interned - keys that reach the user must be copies */
+    auto holder = mapper.readFromString<oatpp::Object<HolderDto>>(R"({
+      "dto": {"interned-field-name": "a"},
+      "fields": {"interned-field-name": "b"},
+      "tree": {"interned-field-name": {"interned-field-name": "c"}},
+      "any": {"interned-field-name": "d"}
+    })");
+    OATPP_ASSERT(holder->dto->internedFieldName == "a")
+
+    OATPP_ASSERT(holder->fields->size() == 1)
+    OATPP_ASSERT(holder->fields->front().first == "interned-field-name")
+    OATPP_ASSERT(!global.isInterned(holder->fields->front().first))
+
+    auto treeKey = holder->tree->getMap()[0].first;
+    auto nestedKey = holder->tree->getMap()[0].second.get().getMap()[0].first;
+    OATPP_ASSERT(treeKey == "interned-field-name" && !global.isInterned(treeKey))
+    OATPP_ASSERT(nestedKey == "interned-field-name" && !global.isInterned(nestedKey))
+    OATPP_ASSERT(holder->tree["interned-field-name"]["interned-field-name"].getString() == "c")
+
+    auto anyFields = holder->any.retrieve<oatpp::Fields<oatpp::Any>>();
+    OATPP_ASSERT(anyFields->front().first == "interned-field-name")
+    OATPP_ASSERT(!global.isInterned(anyFields->front().first))
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}
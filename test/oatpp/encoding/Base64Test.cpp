@@ -25,9 +25,61 @@
 #include "Base64Test.hpp"
 
 #include "oatpp/encoding/Base64.hpp"
+#include "oatpp/utils/Random.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 namespace oatpp { namespace test { namespace encoding {
+
+namespace {
+
+oatpp::String referenceEncode(const oatpp::String& data, const char* alphabet) {
+  std::string result;
+  auto bytes = reinterpret_cast<const v_char8*>(data->data());
+  auto size = data->size();
+  for(size_t i = 0; i < size; i += 3) {
+    v_uint32 block = static_cast<v_uint32>(bytes[i]) << 16;
+    if(i + 1 < size) block |= static_cast<v_uint32>(bytes[i + 1]) << 8;
+    if(i + 2 < size) block |= static_cast<v_uint32>(bytes[i + 2]);
+    result.push_back(alphabet[(block >> 18) & 63]);
+    result.push_back(alphabet[(block >> 12) & 63]);
+    result.push_back(i + 1 < size ? alphabet[(block >> 6) & 63] : alphabet[64]);
+    result.push_back(i + 2 < size ? alphabet[block & 63] : alphabet[64]);
+  }
+  return result;
+}
+
+void testAlphabet(const char* alphabet, const char* auxiliaryChars) {
+
+  for(v_buff_size size = 0; size < 200; size ++) {
+
+    oatpp::String data(size);
+    oatpp::utils::Random::randomBytes(reinterpret_cast<p_char8>(data->data()), size);
+
+    auto encoded = oatpp::encoding::Base64::encode(data, alphabet);
+    OATPP_ASSERT(encoded == referenceEncode(data, alphabet))
+
+    auto decoded = oatpp::encoding::Base64::decode(encoded, auxiliaryChars);
+    OATPP_ASSERT(decoded == data)
+
+    if(encoded->size() > 0) {
+      std::string corrupted = *encoded;
+      corrupted[static_cast<size_t>(size) % corrupted.size()] = '*';
+      bool thrown = false;
+      try {
+        oatpp::encoding::Base64::decode(corrupted, auxiliaryChars);
+      } catch (const oatpp::encoding::Base64::DecodingError&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+    }
+
+  }
+
+}
+
+}
   
 void Base64Test::onRun() {
 
@@ -49,6 +101,41 @@ void Base64Test::onRun() {
     OATPP_ASSERT(message == decoded)
   }
 
+  {
+    testAlphabet(oatpp::encoding::Base64::ALPHABET_BASE64, oatpp::encoding::Base64::ALPHABET_BASE64_AUXILIARY_CHARS);
+    testAlphabet(oatpp::encoding::Base64::ALPHABET_BASE64_URL, oatpp::encoding::Base64::ALPHABET_BASE64_URL_AUXILIARY_CHARS);
+    testAlphabet(oatpp::encoding::Base64::ALPHABET_BASE64_URL_SAFE, oatpp::encoding::Base64::ALPHABET_BASE64_URL_SAFE_AUXILIARY_CHARS);
+  }
+
+  {
+    oatpp::String encoded = oatpp::encoding::Base64::encode(message);
+    oatpp::String decoded = oatpp::encoding::Base64::decode(encoded + "IGZyYW1ld29yaw==IGZyYW1ld29yaw==");
+    OATPP_ASSERT(message == decoded)
+  }
+
+  {
+    v_buff_size size = 1024 * 1024;
+    v_int32 numIterations = 100;
+
+    oatpp::String data(size);
+    oatpp::utils::Random::randomBytes(reinterpret_cast<p_char8>(data->data()), size);
+    oatpp::String encoded = oatpp::encoding::Base64::encode(data);
+
+    {
+      oatpp::test::PerformanceChecker checker("Base64 encode 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        oatpp::encoding::Base64::encode(data);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Base64 decode 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        oatpp::encoding::Base64::decode(encoded);
+      }
+    }
+  }
+
 }
   
 }}}
@@ -25,17 +25,84 @@
 #include "HexTest.hpp"
 
 #include "oatpp/encoding/Hex.hpp"
+#include "oatpp/utils/Random.hpp"
+
+#include "oatpp-test/Checker.hpp"
 
 namespace oatpp { namespace encoding {
 
 void HexTest::onRun() {
-  oatpp::String original = "Light and powerful C++ web framework for highly scalable and resource-efficient web application. It's zero-dependency and easy-portable.";
-  auto encoded = Hex::encode(original);
-  auto decoded = Hex::decode(encoded);
-  OATPP_LOGd(TAG, "original='{}'", original)
-  OATPP_LOGd(TAG, "encoded ='{}'", encoded)
-  OATPP_LOGd(TAG, "decoded ='{}'", decoded)
-  OATPP_ASSERT(original == decoded)
+
+  {
+    oatpp::String original = "Light and powerful C++ web framework for highly scalable and resource-efficient web application. It's zero-dependency and easy-portable.";
+    auto encoded = Hex::encode(original);
+    auto decoded = Hex::decode(encoded);
+    OATPP_LOGd(TAG, "original='{}'", original)
+    OATPP_LOGd(TAG, "encoded ='{}'", encoded)
+    OATPP_LOGd(TAG, "decoded ='{}'", decoded)
+    OATPP_ASSERT(original == decoded)
+  }
+
+  {
+    for(v_buff_size size = 0; size < 600; size ++) {
+
+      oatpp::String data(size);
+      oatpp::utils::Random::randomBytes(reinterpret_cast<p_char8>(data->data()), size);
+
+      auto encoded = Hex::encode(data, Hex::ALPHABET_LOWER);
+      for(v_buff_size i = 0; i < size; i ++) {
+        v_char8 c = static_cast<v_char8>(data->data()[i]);
+        OATPP_ASSERT(encoded->data()[i * 2] == Hex::ALPHABET_LOWER[c >> 4])
+        OATPP_ASSERT(encoded->data()[i * 2 + 1] == Hex::ALPHABET_LOWER[c & 0x0F])
+      }
+
+      OATPP_ASSERT(Hex::decode(encoded) == data)
+      OATPP_ASSERT(Hex::decode(Hex::encode(data, Hex::ALPHABET_UPPER)) == data)
+
+      if(size > 0) {
+        std::string corrupted = *encoded;
+        corrupted[static_cast<size_t>(size * 7) % corrupted.size()] = ':';
+        bool thrown = false;
+        try {
+          Hex::decode(corrupted);
+        } catch (const Hex::DecodingError&) {
+          thrown = true;
+        }
+        OATPP_ASSERT(thrown)
+      }
+
+    }
+  }
+
+  {
+    oatpp::String data = "0123456789abcdef0123456789ABCDEF:0123456789abcdef0123456789ABCDEF";
+    auto decoded = Hex::decode(data, true);
+    OATPP_ASSERT(Hex::encode(decoded) == "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF")
+  }
+
+  {
+    v_buff_size size = 1024 * 1024;
+    v_int32 numIterations = 100;
+
+    oatpp::String data(size);
+    oatpp::utils::Random::randomBytes(reinterpret_cast<p_char8>(data->data()), size);
+    oatpp::String encoded = Hex::encode(data);
+
+    {
+      oatpp::test::PerformanceChecker checker("Hex encode 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        Hex::encode(data);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Hex decode 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        Hex::decode(encoded);
+      }
+    }
+  }
+
 }
 
 }}
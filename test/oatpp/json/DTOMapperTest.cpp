@@ -399,6 +399,21 @@ void DTOMapperTest::onRun(){
 
   }
 
+  {
+
+    oatpp::json::ObjectMapper floatMapper;
+    auto values = oatpp::Vector<oatpp::Float64>({0.1 + 0.2, 0.64});
+    OATPP_ASSERT(floatMapper.writeToString(values) == "[0.3,0.64]")
+
+    floatMapper.serializerConfig().json.floatStringFormat = nullptr;
+    OATPP_ASSERT(floatMapper.writeToString(values) == "[0.30000000000000004,0.64]")
+    OATPP_ASSERT(floatMapper.writeToString(oatpp::Vector<oatpp::Float32>({0.32f})) == "[0.32]")
+
+    auto parsed = floatMapper.readFromString<oatpp::Vector<oatpp::Float64>>(floatMapper.writeToString(values));
+    OATPP_ASSERT(parsed[0] == 0.1 + 0.2)
+
+  }
+
 }
   
 #include OATPP_CODEGEN_END(DTO)
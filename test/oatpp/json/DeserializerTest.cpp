@@ -27,6 +27,8 @@
 #include <cmath>
 
 #include "oatpp/json/ObjectMapper.hpp"
+#include "oatpp/json/Utils.hpp"
+#include "oatpp/utils/Random.hpp"
 #include "oatpp/base/Log.hpp"
 #include "oatpp/macro/codegen.hpp"
 
@@ -40,6 +42,34 @@ typedef oatpp::utils::parser::Caret ParsingCaret;
 typedef oatpp::json::Serializer Serializer;
 typedef oatpp::json::Deserializer Deserializer;
 
+/*
+ * Byte-by-byte escaping of ASCII strings. Used as a reference for the json::Utils::escapeString().
+ */
+std::string referenceEscape(const std::string& str, bool solidus) {
+  std::string result;
+  for(char c : str) {
+    switch(c) {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\b': result += "\\b"; break;
+      case '\f': result += "\\f"; break;
+      case '\n': result += "\\n"; break;
+      case '\r': result += "\\r"; break;
+      case '\t': result += "\\t"; break;
+      case '/': result += solidus ? "\\/" : "/"; break;
+      default:
+        if(static_cast<v_char8>(c) < 32) {
+          char buff[8];
+          snprintf(buff, 8, "\\u%04X", static_cast<unsigned>(c));
+          result += buff;
+        } else {
+          result += c;
+        }
+    }
+  }
+  return result;
+}
+
 class EmptyDto : public oatpp::DTO {
 
   DTO_INIT(EmptyDto, DTO)
@@ -323,6 +353,48 @@ void DeserializerTest::onRun(){
     OATPP_ASSERT(dto->any.retrieve<Int64>() == -1234567890)
   }
 
+  OATPP_LOGd(TAG, "Escape/Unescape strings")
+  {
+    const char special[] = {'"', '\\', '/', '\n', '\t', '\x01', '\x1F'};
+    for(v_buff_size size = 0; size < 150; size ++) {
+      for(v_int32 k = 0; k < 8; k ++) {
+
+        std::string str(static_cast<size_t>(size), 'a');
+        for(v_buff_size i = 0; i < size; i ++) {
+          v_char8 r;
+          utils::Random::randomBytes(&r, 1);
+          str[static_cast<size_t>(i)] = r % 16 == 0 ? special[r % 7] : static_cast<char>('a' + r % 26);
+        }
+
+        for(v_uint32 flags : {0U, Utils::FLAG_ESCAPE_SOLIDUS}) {
+          auto escaped = Utils::escapeString(str.data(), size, flags);
+          OATPP_ASSERT(escaped == referenceEscape(str, flags == Utils::FLAG_ESCAPE_SOLIDUS))
+
+          v_int64 errorCode;
+          v_buff_size errorPosition;
+          auto unescaped = Utils::unescapeString(escaped->data(), static_cast<v_buff_size>(escaped->size()), errorCode, errorPosition);
+          OATPP_ASSERT(errorCode == 0)
+          OATPP_ASSERT(unescaped == str)
+
+          auto json = mapper.writeToString(oatpp::String(str));
+          OATPP_ASSERT(mapper.readFromString<oatpp::String>(json) == str)
+        }
+
+      }
+    }
+
+    std::string utf8 = std::string(40, 'x') + "\xD0\x9F\xD1\x80\xD0\xB8/" + std::string(40, 'y') + "\xF0\x9F\x98\x80";
+    auto escaped = Utils::escapeString(utf8.data(), static_cast<v_buff_size>(utf8.size()), Utils::FLAG_ESCAPE_ALL);
+    OATPP_ASSERT(escaped == std::string(40, 'x') + "\\u041F\\u0440\\u0438\\/" + std::string(40, 'y') + "\\uD83D\\uDE00")
+    escaped = Utils::escapeString(utf8.data(), static_cast<v_buff_size>(utf8.size()), 0);
+    OATPP_ASSERT(escaped == utf8)
+
+    // truncated utf-8 sequence at the end
+    auto truncated = std::string(40, 'x') + "\xF0\x9F";
+    escaped = Utils::escapeString(truncated.data(), static_cast<v_buff_size>(truncated.size()), 0);
+    OATPP_ASSERT(escaped == std::string(40, 'x') + "????")
+  }
+
 }
   
 }}
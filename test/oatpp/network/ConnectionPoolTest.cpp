@@ -25,6 +25,7 @@
 #include "ConnectionPoolTest.hpp"
 
 #include "oatpp/network/ConnectionPool.hpp"
+#include "oatpp/network/virtual_/Socket.hpp"
 #include "oatpp/async/Executor.hpp"
 #include "oatpp/base/Log.hpp"
 
@@ -214,6 +215,23 @@ void ConnectionPoolTest::onRun() {
   /* wait pool cleanup task exit */
   std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
+  {
+    OATPP_LOGd(TAG, "connection validator")
+
+    oatpp::network::ConnectionValidator validator;
+
+    auto pipeIn = oatpp::network::virtual_::Pipe::createShared();
+    auto pipeOut = oatpp::network::virtual_::Pipe::createShared();
+    auto socket = oatpp::network::virtual_::Socket::createShared(pipeIn, pipeOut);
+    socket->setInputStreamIOMode(oatpp::data::stream::IOMode::BLOCKING);
+
+    OATPP_ASSERT(validator.validate(socket))
+    OATPP_ASSERT(socket->getInputStreamIOMode() == oatpp::data::stream::IOMode::BLOCKING)
+
+    pipeIn->close();
+    OATPP_ASSERT(!validator.validate(socket))
+  }
+
 }
 
 }}}
@@ -37,6 +37,8 @@
 #include "oatpp/network/tcp/client/ConnectionProvider.hpp"
 #include "oatpp/network/tcp/server/ConnectionProvider.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 #include <thread>
 
 namespace oatpp { namespace test { namespace network { namespace monitor {
@@ -90,6 +92,171 @@ public:
 
 };
 
+class StubStream : public oatpp::data::stream::IOStream, public oatpp::base::Countable {
+private:
+  oatpp::data::stream::DefaultInitializedContext m_context {oatpp::data::stream::StreamType::STREAM_INFINITE};
+public:
+
+  v_io_size write(const void *buff, v_buff_size count, async::Action& actions) override {
+    return count;
+  }
+
+  v_io_size read(void *buff, v_buff_size count, async::Action& action) override {
+    return count;
+  }
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {}
+
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getOutputStreamContext() override {
+    return m_context;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {}
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return oatpp::data::stream::IOMode::BLOCKING;
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return m_context;
+  }
+
+};
+
+class StubStreamProvider : public oatpp::network::ClientConnectionProvider {
+private:
+
+  class Invalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+  private:
+    StubStreamProvider* m_provider;
+  public:
+
+    Invalidator(StubStreamProvider* provider)
+      : m_provider(provider)
+    {}
+
+    void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override {
+      (void)connection;
+      ++ m_provider->invalidated;
+    }
+
+  };
+
+private:
+  std::shared_ptr<Invalidator> m_invalidator = std::make_shared<Invalidator>(this);
+public:
+
+  std::atomic<v_int64> invalidated {0};
+
+  oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> get() override {
+    return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(std::make_shared<StubStream>(), m_invalidator);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override {
+    throw std::runtime_error("It's a stub!");
+  }
+
+  void stop() override {
+    // DO NOTHING
+  }
+
+};
+
+struct CallsCount {
+  v_int64 reads = 0;
+  v_int64 writes = 0;
+};
+
+class CallsCollector : public oatpp::network::monitor::StatCollector {
+public:
+
+  oatpp::String metricName() override {
+    return "calls";
+  }
+
+  void* createMetricData() override {
+    return new CallsCount();
+  }
+
+  void deleteMetricData(void* metricData) override {
+    delete static_cast<CallsCount*>(metricData);
+  }
+
+  void onRead(void* metricData, v_io_size readResult, v_int64 timestamp) override {
+    static_cast<CallsCount*>(metricData)->reads ++;
+  }
+
+  void onWrite(void* metricData, v_io_size writeResult, v_int64 timestamp) override {
+    static_cast<CallsCount*>(metricData)->writes ++;
+  }
+
+};
+
+class IdleCollector : public oatpp::network::monitor::StatCollector {
+public:
+
+  oatpp::String metricName() override {
+    return "idle";
+  }
+
+  void* createMetricData() override {
+    return nullptr;
+  }
+
+  void deleteMetricData(void* metricData) override {
+    (void) metricData;
+  }
+
+  void onRead(void* metricData, v_io_size readResult, v_int64 timestamp) override {
+    (void) metricData; (void) readResult; (void) timestamp;
+  }
+
+  void onWrite(void* metricData, v_io_size writeResult, v_int64 timestamp) override {
+    (void) metricData; (void) writeResult; (void) timestamp;
+  }
+
+};
+
+class CallsChecker : public oatpp::network::monitor::MetricsChecker {
+private:
+  v_int64 m_index = -1;
+public:
+
+  std::atomic<v_int64> totalRead {0};
+  std::atomic<v_int64> totalWrite {0};
+  std::atomic<v_int64> reads {0};
+  std::atomic<v_int64> writes {0};
+
+  std::vector<oatpp::String> getMetricsList() override {
+    return {"calls"};
+  }
+
+  std::shared_ptr<oatpp::network::monitor::StatCollector> createStatCollector(const oatpp::String& metricName) override {
+    return std::make_shared<CallsCollector>();
+  }
+
+  void onMetricsRegistered(oatpp::network::monitor::ConnectionMonitor& monitor) override {
+    m_index = monitor.getMetricIndex("calls");
+  }
+
+  bool check(const oatpp::network::monitor::ConnectionStats& stats, v_int64 currMicroTime) override {
+    totalRead = stats.totalRead;
+    totalWrite = stats.totalWrite;
+    auto index = static_cast<size_t>(m_index);
+    if(m_index >= 0 && index < stats.metricsData.size() && stats.metricsData[index] != nullptr) {
+      auto calls = static_cast<CallsCount*>(stats.metricsData[index]);
+      reads = calls->reads;
+      writes = calls->writes;
+    }
+    return stats.totalRead < 1000;
+  }
+
+};
+
 std::shared_ptr<oatpp::network::Server> runServer(const std::shared_ptr<oatpp::network::monitor::ConnectionMonitor>& monitor) {
 
   auto router = oatpp::web::server::HttpRouter::createShared();
@@ -211,10 +378,96 @@ void runAsyncClient() {
 
 }
 
+void runStatsTest(bool registerCollectorFirst, bool measurePerformance) {
+
+  auto provider = std::make_shared<StubStreamProvider>();
+  auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(provider);
+
+  if(registerCollectorFirst) {
+    /* some other collector takes index 0 */
+    monitor->addMetricsChecker(std::make_shared<oatpp::network::monitor::ConnectionMaxAgeChecker>(std::chrono::seconds(10)));
+    monitor->addStatCollector(std::make_shared<IdleCollector>());
+    /* checker doesn't create its own collector for "calls" - it has to use the registered one */
+    monitor->addStatCollector(std::make_shared<CallsCollector>());
+    OATPP_ASSERT(monitor->getMetricIndex("calls") == 1)
+  }
+
+  auto checker = std::make_shared<CallsChecker>();
+  monitor->addMetricsChecker(checker);
+  OATPP_ASSERT(monitor->getMetricIndex("calls") >= 0)
+  OATPP_ASSERT(monitor->getMetricIndex("unknown") == -1)
+
+  auto connection = monitor->get();
+  OATPP_ASSERT(connection)
+
+  v_char8 buffer[100];
+  oatpp::async::Action action;
+  for(v_int32 i = 0; i < 10; i ++) {
+    connection.object->read(buffer, 100, action);
+  }
+  connection.object->write(buffer, 50, action);
+  connection.object->write(buffer, 50, action);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+
+  OATPP_ASSERT(checker->totalRead == 1000)
+  OATPP_ASSERT(checker->totalWrite == 100)
+  OATPP_ASSERT(checker->reads == 10)
+  OATPP_ASSERT(checker->writes == 2)
+  OATPP_ASSERT(provider->invalidated > 0)
+
+  if(measurePerformance) {
+    oatpp::test::PerformanceChecker perf("ConnectionMonitor proxy read/write x 1M");
+    for(v_int32 i = 0; i < 1000000; i ++) {
+      connection.object->read(buffer, 1, action);
+      connection.object->write(buffer, 1, action);
+    }
+  }
+
+  connection = nullptr;
+  monitor->stop();
+
+}
+
 }
 
 void ConnectionMonitorTest::onRun() {
 
+  {
+    OATPP_LOGd(TAG, "run stats test")
+    runStatsTest(false, true);
+  }
+
+  {
+    OATPP_LOGd(TAG, "run stats test - collector registered before checker")
+    runStatsTest(true, false);
+  }
+
+  {
+    OATPP_LOGd(TAG, "run deadlines test")
+
+    auto provider = std::make_shared<StubStreamProvider>();
+    auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(provider);
+    monitor->addMetricsChecker(
+      std::make_shared<oatpp::network::monitor::ConnectionMaxAgeChecker>(std::chrono::milliseconds(200))
+    );
+
+    std::vector<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> connections;
+    for(v_int32 i = 0; i < 100; i ++) {
+      connections.push_back(monitor->get());
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    OATPP_ASSERT(provider->invalidated == 0)
+
+    // deadline is way sooner than the default 1-second monitor tick
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    OATPP_ASSERT(provider->invalidated >= 100)
+
+    connections.clear();
+    monitor->stop();
+  }
+
   auto connectionProvider = oatpp::network::tcp::server::ConnectionProvider::createShared(
     {"localhost", 8000});
   auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(connectionProvider);
@@ -0,0 +1,437 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResolverTest.hpp"
+
+#include "oatpp/network/resolver/CachingResolver.hpp"
+#include "oatpp/network/resolver/SystemResolver.hpp"
+
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+#if !defined(WIN32) && !defined(_WIN32)
+  #include <arpa/inet.h>
+  #include <fcntl.h>
+  #include <netinet/in.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+#endif
+
+namespace oatpp { namespace test { namespace network { namespace resolver {
+
+namespace {
+
+typedef oatpp::network::Address Address;
+typedef oatpp::network::resolver::Resolver Resolver;
+typedef oatpp::network::resolver::CachingResolver CachingResolver;
+typedef oatpp::network::resolver::SystemResolver SystemResolver;
+
+/*
+ * Resolver with a fixed hosts table. Counts lookups.
+ */
+class StubResolver : public Resolver {
+public:
+
+  std::unordered_map<std::string, Endpoints> hosts;
+  std::atomic<v_int32> lookupsCount;
+
+  StubResolver()
+    : lookupsCount(0)
+  {}
+
+  Endpoints resolve(const Address& address) override {
+    ++ lookupsCount;
+    auto it = hosts.find(*address.host);
+    if(it == hosts.end()) {
+      throw std::runtime_error("[StubResolver::resolve()]: Unknown host.");
+    }
+    return it->second;
+  }
+
+  oatpp::async::CoroutineStarterForResult<const Endpoints&> resolveAsync(const Address& address) override {
+
+    class ResolveCoroutine : public oatpp::async::CoroutineWithResult<ResolveCoroutine, const Endpoints&> {
+    private:
+      StubResolver* m_this;
+      Address m_address;
+      Endpoints m_endpoints;
+    public:
+
+      ResolveCoroutine(StubResolver* _this, const Address& address)
+        : m_this(_this)
+        , m_address(address)
+      {}
+
+      Action act() override {
+        try {
+          m_endpoints = m_this->resolve(m_address);
+        } catch (...) {
+          return error<oatpp::async::Error>(std::current_exception());
+        }
+        return _return(m_endpoints);
+      }
+
+    };
+
+    return ResolveCoroutine::startForResult(this, address);
+
+  }
+
+  void addHost(const oatpp::String& host, const std::vector<Address>& addresses) {
+    Endpoints endpoints;
+    for(auto& address : addresses) {
+      Endpoints numeric;
+      OATPP_ASSERT(resolveNumeric(address, numeric))
+      endpoints.insert(endpoints.end(), numeric.begin(), numeric.end());
+    }
+    hosts[*host] = endpoints;
+  }
+
+};
+
+class ResolveCoroutine : public oatpp::async::Coroutine<ResolveCoroutine> {
+private:
+  std::shared_ptr<Resolver> m_resolver;
+  Address m_address;
+  std::atomic<v_int32>* m_resolved;
+  std::atomic<v_int32>* m_failed;
+public:
+
+  ResolveCoroutine(const std::shared_ptr<Resolver>& resolver,
+                   const Address& address,
+                   std::atomic<v_int32>* resolved,
+                   std::atomic<v_int32>* failed)
+    : m_resolver(resolver)
+    , m_address(address)
+    , m_resolved(resolved)
+    , m_failed(failed)
+  {}
+
+  Action act() override {
+    return m_resolver->resolveAsync(m_address).callbackTo(&ResolveCoroutine::onResolved);
+  }
+
+  Action onResolved(const Resolver::Endpoints& endpoints) {
+    OATPP_ASSERT(endpoints.size() > 0)
+    ++ (*m_resolved);
+    return finish();
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    (void) error;
+    ++ (*m_failed);
+    return finish();
+  }
+
+};
+
+#if !defined(WIN32) && !defined(_WIN32)
+
+/*
+ * Listening socket with a full accept queue - connection attempts to it never complete.
+ */
+class Blackhole {
+private:
+  int m_listener;
+  std::vector<int> m_fillers;
+public:
+
+  Blackhole(v_uint16 port) {
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(sockaddr_in));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    m_listener = socket(AF_INET, SOCK_STREAM, 0);
+    int yes = 1;
+    setsockopt(m_listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(int));
+    OATPP_ASSERT(bind(m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(sockaddr_in)) == 0)
+    OATPP_ASSERT(listen(m_listener, 0) == 0)
+
+    for(v_int32 i = 0; i < 4; i ++) {
+      int filler = socket(AF_INET, SOCK_STREAM, 0);
+      fcntl(filler, F_SETFL, O_NONBLOCK);
+      connect(filler, reinterpret_cast<sockaddr*>(&address), sizeof(sockaddr_in));
+      m_fillers.push_back(filler);
+    }
+
+  }
+
+  ~Blackhole() {
+    for(auto filler : m_fillers) {
+      close(filler);
+    }
+    close(m_listener);
+  }
+
+};
+
+#endif
+
+class ConnectCoroutine : public oatpp::async::Coroutine<ConnectCoroutine> {
+private:
+  std::shared_ptr<oatpp::network::ClientConnectionProvider> m_provider;
+  std::atomic<v_int32>* m_connected;
+public:
+
+  ConnectCoroutine(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& provider, std::atomic<v_int32>* connected)
+    : m_provider(provider)
+    , m_connected(connected)
+  {}
+
+  Action act() override {
+    return m_provider->getAsync().callbackTo(&ConnectCoroutine::onConnected);
+  }
+
+  Action onConnected(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+    OATPP_ASSERT(connection.object)
+    ++ (*m_connected);
+    connection.invalidator->invalidate(connection.object);
+    return finish();
+  }
+
+};
+
+}
+
+void ResolverTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Numeric hosts...")
+
+    Resolver::Endpoints endpoints;
+    OATPP_ASSERT(Resolver::resolveNumeric({"127.0.0.1", 8000}, endpoints))
+    OATPP_ASSERT(endpoints.size() == 1)
+    OATPP_ASSERT(Resolver::resolveNumeric({"::1", 8000}, endpoints))
+    OATPP_ASSERT(endpoints.size() == 1)
+    OATPP_ASSERT(!Resolver::resolveNumeric({"localhost", 8000}, endpoints))
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Interleave...")
+
+    Resolver::Endpoints endpoints = {{6, {1}}, {6, {2}}, {6, {3}}, {4, {4}}};
+    auto result = Resolver::interleave(endpoints);
+
+    OATPP_ASSERT(result.size() == 4)
+    OATPP_ASSERT(result[0].data[0] == 1)
+    OATPP_ASSERT(result[1].data[0] == 4)
+    OATPP_ASSERT(result[2].data[0] == 2)
+    OATPP_ASSERT(result[3].data[0] == 3)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "System resolver (/etc/hosts)...")
+
+    auto resolver = SystemResolver::createShared();
+    OATPP_ASSERT(resolver->resolve({"localhost", 8000}).size() > 0)
+
+    std::atomic<v_int32> resolved(0);
+    std::atomic<v_int32> failed(0);
+
+    {
+      oatpp::async::Executor executor(1, 1, 1);
+      for(v_int32 i = 0; i < 10; i ++) {
+        executor.execute<ResolveCoroutine>(resolver, Address("localhost", 8000), &resolved, &failed);
+      }
+      executor.execute<ResolveCoroutine>(resolver, Address("127.0.0.1", 8000), &resolved, &failed);
+      executor.execute<ResolveCoroutine>(resolver, Address("host.invalid", 8000), &resolved, &failed);
+      executor.waitTasksFinished();
+      executor.stop();
+      executor.join();
+    }
+
+    OATPP_ASSERT(resolved == 11)
+    OATPP_ASSERT(failed == 1)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Caching resolver...")
+
+    auto stub = std::make_shared<StubResolver>();
+    stub->addHost("test.host", {{"127.0.0.1", 8000}});
+
+    auto resolver = CachingResolver::createShared(stub, std::chrono::milliseconds(300), std::chrono::milliseconds(300));
+
+    OATPP_ASSERT(resolver->resolve({"test.host", 8000}).size() == 1)
+    OATPP_ASSERT(resolver->resolve({"test.host", 8000}).size() == 1)
+    OATPP_ASSERT(stub->lookupsCount == 1)
+    OATPP_ASSERT(resolver->getHitsCount() == 1)
+    OATPP_ASSERT(resolver->getMissesCount() == 1)
+
+    /* different port - different entry */
+    resolver->resolve({"test.host", 8001});
+    OATPP_ASSERT(stub->lookupsCount == 2)
+
+    /* numeric hosts don't go to the resolver */
+    resolver->resolve({"127.0.0.1", 8000});
+    OATPP_ASSERT(stub->lookupsCount == 2)
+
+    /* negative caching */
+    for(v_int32 i = 0; i < 3; i ++) {
+      bool thrown = false;
+      try {
+        resolver->resolve({"unknown.host", 8000});
+      } catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+    }
+    OATPP_ASSERT(stub->lookupsCount == 3)
+
+    std::atomic<v_int32> resolved(0);
+    std::atomic<v_int32> failed(0);
+
+    {
+      oatpp::async::Executor executor(1, 1, 1);
+      executor.execute<ResolveCoroutine>(resolver, Address("test.host", 8000), &resolved, &failed);
+      executor.execute<ResolveCoroutine>(resolver, Address("unknown.host", 8000), &resolved, &failed);
+      executor.waitTasksFinished();
+      executor.stop();
+      executor.join();
+    }
+
+    OATPP_ASSERT(resolved == 1)
+    OATPP_ASSERT(failed == 1)
+    OATPP_ASSERT(stub->lookupsCount == 3)
+
+    /* TTL expired */
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    resolver->resolve({"test.host", 8000});
+    OATPP_ASSERT(stub->lookupsCount == 4)
+
+    resolver->clear();
+    resolver->resolve({"test.host", 8000});
+    OATPP_ASSERT(stub->lookupsCount == 5)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Default resolver...")
+
+    auto provider1 = oatpp::network::tcp::client::ConnectionProvider::createShared({"localhost", 8000});
+    auto provider2 = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", 8001});
+
+    /* one cache and one set of resolver threads for all providers */
+    OATPP_ASSERT(provider1->getResolver())
+    OATPP_ASSERT(provider1->getResolver() == provider2->getResolver())
+    OATPP_ASSERT(provider1->getResolver() == Resolver::getDefault())
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Connection race...")
+
+    auto server = oatpp::network::tcp::server::ConnectionProvider::createShared({"127.0.0.1", 8000, Address::IP_4});
+
+    /* first address refuses connection, second one accepts */
+    auto stub = std::make_shared<StubResolver>();
+    stub->addHost("test.host", {{"127.0.0.1", 8001}, {"127.0.0.1", 8000}});
+
+    auto provider = oatpp::network::tcp::client::ConnectionProvider::createShared({"test.host", 8000}, stub);
+    OATPP_ASSERT(provider->getResolver() == stub)
+
+    {
+      auto connection = provider->get();
+      OATPP_ASSERT(connection.object)
+      connection.invalidator->invalidate(connection.object);
+    }
+
+    std::atomic<v_int32> connected(0);
+
+    {
+      oatpp::async::Executor executor(1, 1, 1);
+      executor.execute<ConnectCoroutine>(provider, &connected);
+      executor.waitTasksFinished();
+      executor.stop();
+      executor.join();
+    }
+
+    OATPP_ASSERT(connected == 1)
+
+#if !defined(WIN32) && !defined(_WIN32)
+    {
+      /* first attempts hang - the next ones start after the attempt delay and race them */
+      Blackhole blackhole(8002);
+      stub->addHost("race.host", {{"127.0.0.1", 8002}, {"127.0.0.1", 8002}, {"127.0.0.1", 8000}});
+
+      auto raceProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"race.host", 8000}, stub);
+      raceProvider->setConnectionAttemptDelay(std::chrono::milliseconds(50));
+
+      auto ticks = oatpp::Environment::getMicroTickCount();
+      {
+        auto connection = raceProvider->get();
+        OATPP_ASSERT(connection.object)
+        connection.invalidator->invalidate(connection.object);
+      }
+      OATPP_ASSERT(oatpp::Environment::getMicroTickCount() - ticks < 500 * 1000)
+
+      ticks = oatpp::Environment::getMicroTickCount();
+      {
+        oatpp::async::Executor executor(1, 1, 1);
+        executor.execute<ConnectCoroutine>(raceProvider, &connected);
+        executor.waitTasksFinished();
+        executor.stop();
+        executor.join();
+      }
+      OATPP_ASSERT(connected == 2)
+      OATPP_LOGi(TAG, "Async race time: {}(micro)", oatpp::Environment::getMicroTickCount() - ticks)
+    }
+#endif
+
+    /* nothing accepts */
+    stub->addHost("test.host", {{"127.0.0.1", 8001}});
+    bool thrown = false;
+    try {
+      provider->get();
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+
+    server->stop();
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}
@@ -0,0 +1,322 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ConnectionProviderTest.hpp"
+
+#include "oatpp/network/unix_/client/ConnectionProvider.hpp"
+#include "oatpp/network/unix_/server/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/network/monitor/ConnectionMonitor.hpp"
+#include "oatpp/network/ConnectionPool.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <thread>
+
+namespace oatpp { namespace test { namespace network { namespace unix_ {
+
+namespace {
+
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+
+const char* const HELLO = "Hello World!!!";
+
+class HelloHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared(HELLO));
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<OutgoingResponse>&>
+  handleAsync(const std::shared_ptr<IncomingRequest>& request) override {
+
+    class HelloCoroutine : public oatpp::async::CoroutineWithResult<HelloCoroutine, const std::shared_ptr<OutgoingResponse>&> {
+    public:
+
+      Action act() override {
+        return _return(OutgoingResponse::createShared(Status::CODE_200, oatpp::web::protocol::http::outgoing::BufferBody::createShared(HELLO)));
+      }
+
+    };
+
+    (void) request;
+    return HelloCoroutine::startForResult();
+
+  }
+
+};
+
+class TestServer {
+private:
+  std::shared_ptr<oatpp::network::ServerConnectionProvider> m_connectionProvider;
+  std::shared_ptr<oatpp::async::Executor> m_executor;
+  std::shared_ptr<oatpp::network::ConnectionHandler> m_connectionHandler;
+  std::shared_ptr<oatpp::network::Server> m_server;
+  std::thread m_thread;
+public:
+
+  TestServer(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& connectionProvider, bool async)
+    : m_connectionProvider(connectionProvider)
+  {
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    router->route("GET", "/", std::make_shared<HelloHandler>());
+
+    if(async) {
+      m_executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+      m_connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, m_executor);
+    } else {
+      m_connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    }
+
+    m_server = oatpp::network::Server::createShared(m_connectionProvider, m_connectionHandler);
+    m_thread = std::thread([this]{
+      m_server->run();
+    });
+
+  }
+
+  ~TestServer() {
+    m_server->stop();
+    m_connectionProvider->stop();
+    m_thread.join();
+    m_connectionHandler->stop();
+    if(m_executor) {
+      m_executor->waitTasksFinished();
+      m_executor->stop();
+      m_executor->join();
+    }
+  }
+
+};
+
+class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
+private:
+  std::shared_ptr<HttpRequestExecutor> m_executor;
+  std::atomic<v_int32>* m_counter;
+public:
+
+  ClientCoroutine(const std::shared_ptr<HttpRequestExecutor>& executor, std::atomic<v_int32>* counter)
+    : m_executor(executor)
+    , m_counter(counter)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync("GET", "/", {}, nullptr, nullptr).callbackTo(&ClientCoroutine::onResponse);
+  }
+
+  Action onResponse(const std::shared_ptr<HttpRequestExecutor::Response>& response) {
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    return response->readBodyToStringAsync().callbackTo(&ClientCoroutine::onBody);
+  }
+
+  Action onBody(const oatpp::String& body) {
+    OATPP_ASSERT(body == HELLO)
+    ++ (*m_counter);
+    return finish();
+  }
+
+};
+
+void runSyncClient(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider, v_int32 requestsCount) {
+
+  auto pool = oatpp::network::ClientConnectionPool::createShared(connectionProvider, 4, std::chrono::seconds(5));
+  auto executor = HttpRequestExecutor::createShared(pool);
+
+  for(v_int32 i = 0; i < requestsCount; i ++) {
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    OATPP_ASSERT(response->readBodyToString() == HELLO)
+  }
+
+  pool->stop();
+
+}
+
+void runAsyncClient(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider, v_int32 requestsCount) {
+
+  auto executor = HttpRequestExecutor::createShared(connectionProvider);
+  std::atomic<v_int32> counter(0);
+
+  oatpp::async::Executor asyncExecutor(1, 1, 1);
+  for(v_int32 i = 0; i < requestsCount; i ++) {
+    asyncExecutor.execute<ClientCoroutine>(executor, &counter);
+  }
+  asyncExecutor.waitTasksFinished();
+  asyncExecutor.stop();
+  asyncExecutor.join();
+
+  OATPP_ASSERT(counter == requestsCount)
+
+}
+
+v_int64 runBenchmark(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider, v_int32 iterations) {
+
+  auto executor = HttpRequestExecutor::createShared(connectionProvider);
+  auto connection = executor->getConnection();
+
+  auto startTime = oatpp::Environment::getMicroTickCount();
+
+  for(v_int32 i = 0; i < iterations; i ++) {
+    auto response = executor->execute("GET", "/", {}, nullptr, connection);
+    OATPP_ASSERT(response->readBodyToString() == HELLO)
+  }
+
+  auto elapsed = oatpp::Environment::getMicroTickCount() - startTime;
+  executor->invalidateConnection(connection);
+  return elapsed;
+
+}
+
+}
+
+void ConnectionProviderTest::onRun() {
+
+  const char* const SOCKET_PATH = "/tmp/oatpp-test-unix-socket.sock";
+
+  {
+    OATPP_LOGi(TAG, "Sync server, sync client...")
+    TestServer server(oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH), false);
+    runSyncClient(oatpp::network::unix_::client::ConnectionProvider::createShared(SOCKET_PATH), 100);
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Async server, async client...")
+    TestServer server(oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH), true);
+    runAsyncClient(oatpp::network::unix_::client::ConnectionProvider::createShared(SOCKET_PATH), 100);
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Connection monitor...")
+    auto monitor = std::make_shared<oatpp::network::monitor::ConnectionMonitor>(
+      oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH)
+    );
+    {
+      TestServer server(monitor, false);
+      runSyncClient(oatpp::network::unix_::client::ConnectionProvider::createShared(SOCKET_PATH), 10);
+    }
+    monitor->stop();
+    OATPP_LOGi(TAG, "OK")
+  }
+
+#if defined(__linux__)
+  {
+    OATPP_LOGi(TAG, "Abstract namespace...")
+    TestServer server(oatpp::network::unix_::server::ConnectionProvider::createShared("@oatpp-test-unix-socket"), false);
+    runSyncClient(oatpp::network::unix_::client::ConnectionProvider::createShared("@oatpp-test-unix-socket"), 10);
+    OATPP_LOGi(TAG, "OK")
+  }
+#endif
+
+  {
+    OATPP_LOGi(TAG, "Existing files...")
+
+    /* not a socket - never removed */
+    const char* const FILE_PATH = "/tmp/oatpp-test-unix-socket-regular-file";
+    {
+      std::ofstream file(FILE_PATH);
+      file << "data";
+    }
+    bool thrown = false;
+    try {
+      oatpp::network::unix_::server::ConnectionProvider::createShared(FILE_PATH);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+    OATPP_ASSERT(std::ifstream(FILE_PATH).good())
+    std::remove(FILE_PATH);
+
+    /* socket replaced by another server - stop() of the first one doesn't remove it */
+    auto first = oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH);
+    auto second = oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH);
+    first->stop();
+
+    auto client = oatpp::network::unix_::client::ConnectionProvider::createShared(SOCKET_PATH);
+    auto connection = client->get();
+    OATPP_ASSERT(connection.object)
+    connection.invalidator->invalidate(connection.object);
+
+    second->stop();
+    thrown = false;
+    try {
+      client->get();
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Connect to missing socket...")
+    auto provider = oatpp::network::unix_::client::ConnectionProvider::createShared("/tmp/oatpp-test-unix-socket-missing.sock");
+    bool thrown = false;
+    try {
+      provider->get();
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Benchmark. {} sequential requests over keep-alive connection...", m_benchmarkIterations)
+
+    v_int64 unixTime;
+    v_int64 tcpTime;
+
+    {
+      TestServer server(oatpp::network::unix_::server::ConnectionProvider::createShared(SOCKET_PATH), false);
+      unixTime = runBenchmark(oatpp::network::unix_::client::ConnectionProvider::createShared(SOCKET_PATH), m_benchmarkIterations);
+    }
+
+    {
+      TestServer server(oatpp::network::tcp::server::ConnectionProvider::createShared({"127.0.0.1", 8000, oatpp::network::Address::IP_4}), false);
+      tcpTime = runBenchmark(oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", 8000, oatpp::network::Address::IP_4}), m_benchmarkIterations);
+    }
+
+    OATPP_LOGi(TAG, "unix_: {}(micro) total, {}(micro) per request", unixTime, unixTime / m_benchmarkIterations)
+    OATPP_LOGi(TAG, "tcp loopback: {}(micro) total, {}(micro) per request", tcpTime, tcpTime / m_benchmarkIterations)
+  }
+
+}
+
+}}}}
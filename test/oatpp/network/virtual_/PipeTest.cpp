@@ -57,7 +57,8 @@ namespace {
     
     void run() {
       while (m_transferedBytes < CHUNK_SIZE * m_chunksToTransfer) {
-        auto res = m_pipe->getWriter()->writeSimple(&DATA_CHUNK[m_position], CHUNK_SIZE - m_position);
+        oatpp::async::Action action;
+        auto res = m_pipe->getWriter()->write(&DATA_CHUNK[m_position], CHUNK_SIZE - m_position, action);
         if(res > 0) {
           m_transferedBytes += res;
           m_position += res;
@@ -89,7 +90,8 @@ namespace {
     void run() {
       v_char8 readBuffer[256];
       while (m_buffer->getCurrentPosition() < CHUNK_SIZE * m_chunksToTransfer) {
-        auto res = m_pipe->getReader()->readSimple(readBuffer, 256);
+        oatpp::async::Action action;
+        auto res = m_pipe->getReader()->read(readBuffer, 256, action);
         if(res > 0) {
           m_buffer->writeSimple(readBuffer, res);
         }
@@ -104,6 +106,9 @@ namespace {
     OATPP_LOGv("transfer", "writer-nb: {}, reader-nb: {}", writeNonBlock, readerNonBlock)
     
     auto buffer = std::make_shared<oatpp::data::stream::BufferOutputStream>();
+
+    pipe->getWriter()->setOutputStreamIOMode(writeNonBlock ? oatpp::data::stream::IOMode::ASYNCHRONOUS : oatpp::data::stream::IOMode::BLOCKING);
+    pipe->getReader()->setInputStreamIOMode(readerNonBlock ? oatpp::data::stream::IOMode::ASYNCHRONOUS : oatpp::data::stream::IOMode::BLOCKING);
     
     {
       
@@ -130,6 +135,61 @@ namespace {
     OATPP_ASSERT(str1 == str2)
     
   }
+
+  void runThroughput(v_int64 bytesToTransfer, v_buff_size chunkSize) {
+
+    auto pipe = Pipe::createShared();
+
+    std::unique_ptr<v_char8[]> writeBuffer(new v_char8[static_cast<size_t>(chunkSize)]);
+    for(v_buff_size i = 0; i < chunkSize; i ++) {
+      writeBuffer[static_cast<size_t>(i)] = static_cast<v_char8>(i);
+    }
+
+    v_int64 writeChecksum = 0;
+    v_int64 readChecksum = 0;
+    v_int64 received = 0;
+    v_int64 elapsed;
+
+    {
+
+      oatpp::test::PerformanceChecker timer("throughput");
+
+      std::thread writerThread([&pipe, &writeBuffer, &writeChecksum, bytesToTransfer, chunkSize] {
+        v_int64 sent = 0;
+        while(sent < bytesToTransfer) {
+          auto size = std::min<v_int64>(chunkSize, bytesToTransfer - sent);
+          writeBuffer[0] = static_cast<v_char8>(sent / chunkSize);
+          auto res = pipe->getWriter()->writeExactSizeDataSimple(writeBuffer.get(), size);
+          OATPP_ASSERT(res == size)
+          writeChecksum += writeBuffer[0];
+          sent += res;
+        }
+      });
+
+      std::thread readerThread([&pipe, &readChecksum, &received, bytesToTransfer, chunkSize] {
+        std::unique_ptr<v_char8[]> readBuffer(new v_char8[static_cast<size_t>(chunkSize)]);
+        while(received < bytesToTransfer) {
+          auto size = std::min<v_int64>(chunkSize, bytesToTransfer - received);
+          auto res = pipe->getReader()->readExactSizeDataSimple(readBuffer.get(), size);
+          OATPP_ASSERT(res == size)
+          readChecksum += readBuffer[0];
+          received += res;
+        }
+      });
+
+      writerThread.join();
+      readerThread.join();
+
+      elapsed = timer.getElapsedTicks();
+
+    }
+
+    OATPP_LOGd("throughput", "chunk={}, {} MB/s", chunkSize, elapsed > 0 ? bytesToTransfer / elapsed : 0)
+
+    OATPP_ASSERT(received == bytesToTransfer)
+    OATPP_ASSERT(readChecksum == writeChecksum)
+
+  }
   
 }
   
@@ -144,6 +204,10 @@ void PipeTest::onRun() {
   runTransfer(pipe, chunkCount, false, true);
   runTransfer(pipe, chunkCount, true, true);
 
+  runThroughput(4 * 1024 * 1024, 64);
+  runThroughput(4 * 1024 * 1024, 1024);
+  runThroughput(4 * 1024 * 1024, 16 * 1024);
+
 }
   
 }}}}
@@ -27,6 +27,8 @@
 #include "oatpp/provider/Pool.hpp"
 #include "oatpp/async/Executor.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 #include <thread>
 
 namespace oatpp { namespace provider {
@@ -130,6 +132,24 @@ struct AcquisitionProxy : public oatpp::provider::AcquisitionProxy<Resource, Acq
 
 typedef oatpp::provider::Pool<oatpp::provider::Provider<Resource>, Resource, AcquisitionProxy> TestPool;
 
+class TestValidator : public oatpp::provider::Validator<Resource> {
+public:
+
+  std::atomic<v_int64> validated{0};
+  std::atomic<bool> accept{true};
+  std::atomic<bool> validating{false};
+  std::chrono::milliseconds delay{0};
+
+  bool validate(const std::shared_ptr<Resource>& resource) override {
+    (void) resource;
+    validating = true;
+    std::this_thread::sleep_for(delay);
+    ++ validated;
+    return accept;
+  }
+
+};
+
 
 class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
 private:
@@ -228,6 +248,138 @@ void PoolTest::onRun() {
   /* wait pool cleanup task exit */
   std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
+  {
+    OATPP_LOGd(TAG, "Run contended")
+
+    auto contendedProvider = std::make_shared<TestProvider>();
+    auto contendedPool = TestPool::createShared(contendedProvider, 4, std::chrono::seconds(10));
+    std::atomic<v_int64> inUse{0};
+
+    {
+      oatpp::test::PerformanceChecker checker("TestPool get/release 8 threads x 100K");
+      std::list<std::thread> workers;
+      for(v_int32 t = 0; t < 8; t ++) {
+        workers.push_back(std::thread([contendedPool, &inUse] {
+          for(v_int32 i = 0; i < 100000; i ++) {
+            auto resource = contendedPool->get();
+            OATPP_ASSERT(resource.object)
+            OATPP_ASSERT(++ inUse <= 4)
+            -- inUse;
+          }
+        }));
+      }
+      for(std::thread& worker : workers) {
+        worker.join();
+      }
+    }
+
+    OATPP_LOGd(TAG, "counter={}, created={}", contendedPool->getCounter(), contendedProvider->getIdCounter())
+    OATPP_ASSERT(contendedPool->getCounter() <= 4)
+    OATPP_ASSERT(contendedProvider->getIdCounter() <= 4)
+
+    OATPP_LOGd(TAG, "Run timeout")
+
+    auto timeoutPool = TestPool::createShared(contendedProvider, 1, std::chrono::seconds(10), std::chrono::milliseconds(100));
+    auto resource = timeoutPool->get();
+    OATPP_ASSERT(resource.object)
+    OATPP_ASSERT(timeoutPool->get().object == nullptr)
+    resource = nullptr;
+    OATPP_ASSERT(timeoutPool->get().object)
+
+    timeoutPool->stop();
+    contendedPool->stop();
+
+    /* wait pool cleanup task exit */
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
+  {
+    OATPP_LOGd(TAG, "Run min-idle")
+
+    auto idleProvider = std::make_shared<TestProvider>();
+    auto idlePool = TestPool::createShared(idleProvider, 5, std::chrono::milliseconds(300));
+
+    OATPP_ASSERT(idlePool->prewarm(3) == 3)
+    OATPP_ASSERT(idlePool->getIdleCount() == 3)
+    OATPP_ASSERT(idleProvider->getIdCounter() == 3)
+
+    /* resources are taken from the bench - no new resources created */
+    {
+      auto r1 = idlePool->get();
+      auto r2 = idlePool->get();
+      OATPP_ASSERT(idleProvider->getIdCounter() == 3)
+      OATPP_ASSERT(idlePool->getIdleCount() == 1)
+    }
+    OATPP_ASSERT(idlePool->getIdleCount() == 3)
+
+    /* prewarm never goes over maxResources */
+    OATPP_ASSERT(idlePool->prewarm(10) == 2)
+    OATPP_ASSERT(idlePool->getCounter() == 5)
+
+    idlePool->setMinIdle(2);
+
+    /* all resources expire by TTL, maintenance task keeps minIdle */
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    for(v_int32 i = 0; i < 100 && (idlePool->getIdleCount() != 2 || idlePool->getCounter() != 2); i ++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    OATPP_LOGd(TAG, "idle={}, counter={}, created={}", idlePool->getIdleCount(), idlePool->getCounter(), idleProvider->getIdCounter())
+    OATPP_ASSERT(idlePool->getIdleCount() == 2)
+    OATPP_ASSERT(idlePool->getCounter() == 2)
+    OATPP_ASSERT(idleProvider->getIdCounter() > 5)
+
+    /* invalid resources are replaced in background */
+    auto validator = std::make_shared<TestValidator>();
+    validator->accept = false;
+    idlePool->setValidator(validator, std::chrono::milliseconds(50));
+    auto created = idleProvider->getIdCounter();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    idlePool->setValidator(nullptr);
+
+    OATPP_LOGd(TAG, "validated={}, idle={}, created={}", validator->validated.load(), idlePool->getIdleCount(), idleProvider->getIdCounter())
+    OATPP_ASSERT(validator->validated > 0)
+    OATPP_ASSERT(idleProvider->getIdCounter() > created)
+    OATPP_ASSERT(idlePool->getCounter() <= 5)
+
+    idlePool->stop();
+
+    /* wait pool cleanup task exit */
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
+  {
+    OATPP_LOGd(TAG, "get() while the only idle resource is validated")
+
+    auto validatingProvider = std::make_shared<TestProvider>();
+    auto validatingPool = TestPool::createShared(validatingProvider, 1, std::chrono::seconds(10), std::chrono::seconds(5));
+    OATPP_ASSERT(validatingPool->prewarm(1) == 1)
+
+    auto validator = std::make_shared<TestValidator>();
+    validator->delay = std::chrono::milliseconds(300);
+    validatingPool->setValidator(validator, std::chrono::milliseconds(10));
+
+    while(!validator->validating) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    /* resource is off the bench - get() has to wait and be woken up when the valid resource is back */
+    auto startTime = oatpp::Environment::getMicroTickCount();
+    auto resource = validatingPool->get();
+    auto elapsed = oatpp::Environment::getMicroTickCount() - startTime;
+    validatingPool->setValidator(nullptr);
+
+    OATPP_LOGd(TAG, "waited {}(micro)", elapsed)
+    OATPP_ASSERT(resource)
+    OATPP_ASSERT(elapsed < 2 * 1000 * 1000)
+    OATPP_ASSERT(validatingProvider->getIdCounter() == 1)
+
+    resource = nullptr;
+    validatingPool->stop();
+
+    /* wait pool cleanup task exit */
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
 }
 
 }}
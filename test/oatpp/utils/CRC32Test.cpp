@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>,
+ * Matthias Haselmaier <mhaselmaier@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CRC32Test.hpp"
+
+#include "oatpp/utils/CRC32.hpp"
+#include "oatpp/utils/Random.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace utils {
+
+namespace {
+
+v_uint32 referenceCRC32(const void* buffer, v_buff_size size) {
+  auto data = reinterpret_cast<const v_char8*>(buffer);
+  v_uint32 crc = 0xFFFFFFFF;
+  for(v_buff_size i = 0; i < size; i ++) {
+    crc = CRC32::TABLE_04C11DB7[(crc & 0xFF) ^ data[i]] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFF;
+}
+
+}
+
+void CRC32Test::onRun() {
+
+  {
+    const char* text = "123456789";
+    OATPP_ASSERT(CRC32::calc(text, 9) == 0xCBF43926)
+  }
+
+  {
+    oatpp::String data(4096);
+    Random::randomBytes(reinterpret_cast<p_char8>(data->data()), static_cast<v_buff_size>(data->size()));
+
+    for(v_buff_size size = 0; size < 600; size ++) {
+      for(v_buff_size offset = 0; offset < 4; offset ++) {
+        OATPP_ASSERT(CRC32::calc(data->data() + offset, size) == referenceCRC32(data->data() + offset, size))
+      }
+    }
+
+    auto expected = referenceCRC32(data->data(), static_cast<v_buff_size>(data->size()));
+    OATPP_ASSERT(CRC32::calc(data->data(), static_cast<v_buff_size>(data->size())) == expected)
+
+    v_uint32 crc = 0xFFFFFFFF;
+    for(v_buff_size i = 0; i < static_cast<v_buff_size>(data->size()); i += 100) {
+      auto size = std::min<v_buff_size>(100, static_cast<v_buff_size>(data->size()) - i);
+      crc = CRC32::update(crc, data->data() + i, size);
+    }
+    OATPP_ASSERT((crc ^ 0xFFFFFFFF) == expected)
+
+    v_uint32 value = 0;
+    for(v_buff_size i = 0; i < static_cast<v_buff_size>(data->size()); i += 77) {
+      auto size = std::min<v_buff_size>(77, static_cast<v_buff_size>(data->size()) - i);
+      value = CRC32::calc(data->data() + i, size, value);
+    }
+    OATPP_ASSERT(value == expected)
+  }
+
+  {
+    oatpp::String data(100000);
+    Random::randomBytes(reinterpret_cast<p_char8>(data->data()), static_cast<v_buff_size>(data->size()));
+
+    oatpp::data::stream::BufferInputStream input(data);
+    oatpp::data::stream::BufferOutputStream output;
+    CRC32::Processor processor;
+    v_char8 buffer[1000];
+
+    auto transferred = oatpp::data::stream::transfer(&input, &output, 0, buffer, 1000, &processor);
+    OATPP_ASSERT(transferred == static_cast<v_io_size>(data->size()))
+    OATPP_ASSERT(output.toString() == data)
+    OATPP_ASSERT(processor.getValue() == referenceCRC32(data->data(), static_cast<v_buff_size>(data->size())))
+  }
+
+  {
+    v_buff_size size = 1024 * 1024;
+    v_int32 numIterations = 100;
+
+    oatpp::String data(size);
+    Random::randomBytes(reinterpret_cast<p_char8>(data->data()), size);
+
+    v_uint32 expected = 0;
+    v_uint32 result = 0;
+
+    {
+      oatpp::test::PerformanceChecker checker("CRC32 byte-by-byte 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        data->data()[0] = static_cast<char>(i);
+        expected += referenceCRC32(data->data(), size);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("CRC32 calc 100MB");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        data->data()[0] = static_cast<char>(i);
+        result += CRC32::calc(data->data(), size);
+      }
+    }
+
+    OATPP_ASSERT(result == expected)
+  }
+
+}
+
+}}
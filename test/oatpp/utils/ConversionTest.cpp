@@ -0,0 +1,179 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>,
+ * Matthias Haselmaier <mhaselmaier@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ConversionTest.hpp"
+
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/utils/Random.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <limits>
+#include <cstring>
+
+namespace oatpp { namespace utils {
+
+namespace {
+
+template<typename T>
+bool checkFloatRoundTrip(T value) {
+  v_char8 buff[100];
+  auto size = Conversion::float64ToCharSequence(static_cast<v_float64>(value), buff, 100, nullptr);
+  bool success;
+  auto parsed = Conversion::strToFloat64(oatpp::String(reinterpret_cast<const char*>(buff), size), success);
+  return success && parsed == static_cast<v_float64>(value);
+}
+
+}
+
+void ConversionTest::onRun() {
+
+  {
+    OATPP_ASSERT(Conversion::int32ToStr(0) == "0")
+    OATPP_ASSERT(Conversion::int32ToStr(7) == "7")
+    OATPP_ASSERT(Conversion::int32ToStr(-42) == "-42")
+    OATPP_ASSERT(Conversion::int32ToStr(std::numeric_limits<v_int32>::max()) == "2147483647")
+    OATPP_ASSERT(Conversion::int32ToStr(std::numeric_limits<v_int32>::min()) == "-2147483648")
+    OATPP_ASSERT(Conversion::uint32ToStr(std::numeric_limits<v_uint32>::max()) == "4294967295")
+    OATPP_ASSERT(Conversion::int64ToStr(std::numeric_limits<v_int64>::max()) == "9223372036854775807")
+    OATPP_ASSERT(Conversion::int64ToStr(std::numeric_limits<v_int64>::min()) == "-9223372036854775808")
+    OATPP_ASSERT(Conversion::uint64ToStr(std::numeric_limits<v_uint64>::max()) == "18446744073709551615")
+    OATPP_ASSERT(Conversion::uint64ToStdStr(1000000) == "1000000")
+  }
+
+  {
+    v_char8 buff[4];
+    std::memset(buff, 'x', 4);
+    auto size = Conversion::int32ToCharSequence(-12345, buff, 4);
+    OATPP_ASSERT(size == 6)
+    OATPP_ASSERT(std::memcmp(buff, "-12", 4) == 0)
+  }
+
+  {
+    for(v_int64 i = -100000; i < 100000; i += 7) {
+      char expected[32];
+      snprintf(expected, 32, "%lld", static_cast<long long int>(i));
+      OATPP_ASSERT(Conversion::int64ToStdStr(i) == expected)
+    }
+  }
+
+  {
+    v_int64 value;
+    OATPP_ASSERT(Conversion::charSequenceToInt64("12345", 5, value) == 5 && value == 12345)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("-12345,", 7, value) == 6 && value == -12345)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("+7", 2, value) == 2 && value == 7)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("123", 2, value) == 2 && value == 12)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("-", 1, value) == 0)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("abc", 3, value) == 0)
+    OATPP_ASSERT(Conversion::charSequenceToInt64("9223372036854775807", 19, value) == 19 && value == std::numeric_limits<v_int64>::max())
+    OATPP_ASSERT(Conversion::charSequenceToInt64("-9223372036854775808", 20, value) == 20 && value == std::numeric_limits<v_int64>::min())
+    OATPP_ASSERT(Conversion::charSequenceToInt64("99999999999999999999", 20, value) == 20 && value == std::numeric_limits<v_int64>::max())
+    OATPP_ASSERT(Conversion::charSequenceToInt64("-99999999999999999999", 21, value) == 21 && value == std::numeric_limits<v_int64>::min())
+
+    bool success;
+    OATPP_ASSERT(Conversion::strToInt64("-98765", success) == -98765 && success)
+    OATPP_ASSERT(Conversion::strToInt64(" 12", success) == 12 && success)
+    Conversion::strToInt64("12a", success);
+    OATPP_ASSERT(!success)
+  }
+
+  {
+    OATPP_ASSERT(Conversion::float64ToStr(0.1, nullptr) == "0.1")
+    OATPP_ASSERT(Conversion::float64ToStr(101.5, nullptr) == "101.5")
+    OATPP_ASSERT(Conversion::float64ToStr(-2.0, nullptr) == "-2")
+    OATPP_ASSERT(Conversion::float32ToStr(0.32f, nullptr) == "0.32")
+    OATPP_ASSERT(Conversion::float64ToStr(0.64, "%.2f") == "0.64")
+    OATPP_ASSERT(Conversion::float64ToStr(101.5) == "101.5")
+    OATPP_ASSERT(Conversion::float64ToStr(0.1 + 0.2) == "0.3") // default format is "%.16g"
+    OATPP_ASSERT(Conversion::float64ToStr(0.1 + 0.2, nullptr) == "0.30000000000000004")
+
+    OATPP_ASSERT(checkFloatRoundTrip(0.1 + 0.2))
+    OATPP_ASSERT(checkFloatRoundTrip(std::numeric_limits<v_float64>::max()))
+    OATPP_ASSERT(checkFloatRoundTrip(std::numeric_limits<v_float64>::min()))
+    OATPP_ASSERT(checkFloatRoundTrip(std::numeric_limits<v_float64>::denorm_min()))
+    OATPP_ASSERT(checkFloatRoundTrip(-1.0 / 3.0))
+    OATPP_ASSERT(checkFloatRoundTrip(1e21))
+
+    for(v_int32 i = 0; i < 10000; i ++) {
+      v_uint64 bits;
+      Random::randomBytes(reinterpret_cast<p_char8>(&bits), sizeof(bits));
+      v_float64 value;
+      std::memcpy(&value, &bits, sizeof(value));
+      if(value == value && value - value == 0) { // finite only
+        OATPP_ASSERT(checkFloatRoundTrip(value))
+      }
+    }
+
+    bool success;
+    OATPP_ASSERT(Conversion::strToFloat64("1.5e3", success) == 1500.0 && success)
+    OATPP_ASSERT(Conversion::strToFloat64("+1.5", success) == 1.5 && success)
+    Conversion::strToFloat64("1.5x", success);
+    OATPP_ASSERT(!success)
+
+    v_float64 value;
+    OATPP_ASSERT(Conversion::charSequenceToFloat64("3.25]", 5, value) == 4 && value == 3.25)
+  }
+
+  {
+    v_int32 numIterations = 1000000;
+    v_char8 buff[100];
+    v_buff_size total = 0;
+
+    {
+      oatpp::test::PerformanceChecker checker("snprintf int64 x 1M");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        total += snprintf(reinterpret_cast<char*>(buff), 100, "%lld", static_cast<long long int>(i) * 7919);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Conversion::int64ToCharSequence x 1M");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        total -= Conversion::int64ToCharSequence(static_cast<v_int64>(i) * 7919, buff, 100);
+      }
+    }
+
+    OATPP_ASSERT(total == 0)
+
+    {
+      oatpp::test::PerformanceChecker checker("snprintf %.17g float64 x 1M");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        total += snprintf(reinterpret_cast<char*>(buff), 100, "%.17g", static_cast<v_float64>(i) / 7.0);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Conversion::float64ToCharSequence (shortest) x 1M");
+      for(v_int32 i = 0; i < numIterations; i ++) {
+        total += Conversion::float64ToCharSequence(static_cast<v_float64>(i) / 7.0, buff, 100, nullptr);
+      }
+    }
+
+    OATPP_ASSERT(total > 0)
+  }
+
+}
+
+}}
@@ -58,10 +58,12 @@ typedef oatpp::web::protocol::http::outgoing::MultipartBody MultipartBody;
 class TestComponent {
 private:
   v_uint16 m_port;
+  bool m_useRequestArena;
 public:
 
-  TestComponent(v_uint16 port)
+  TestComponent(v_uint16 port, bool useRequestArena)
     : m_port(port)
+    , m_useRequestArena(useRequestArena)
   {}
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([] {
@@ -91,10 +93,13 @@ public:
     return oatpp::web::server::HttpRouter::createShared();
   }());
 
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([this] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
     OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executr);
-    return oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executr);
+    auto config = std::make_shared<oatpp::web::server::HttpProcessor::Config>();
+    config->useRequestArena = m_useRequestArena;
+    auto components = std::make_shared<oatpp::web::server::HttpProcessor::Components>(router, config);
+    return oatpp::web::server::AsyncHttpConnectionHandler::createShared(components, executr);
   }());
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper)([] {
@@ -140,7 +145,7 @@ std::shared_ptr<PartList> createMultipart(const std::unordered_map<oatpp::String
   
 void FullAsyncTest::onRun() {
 
-  TestComponent component(m_port);
+  TestComponent component(m_port, m_useRequestArena);
 
   oatpp::test::web::ClientServerTestRunner runner;
 
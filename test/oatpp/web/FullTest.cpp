@@ -61,10 +61,12 @@ typedef oatpp::web::protocol::http::outgoing::MultipartBody MultipartBody;
 class TestComponent {
 private:
   v_uint16 m_port;
+  bool m_useRequestArena;
 public:
 
-  TestComponent(v_uint16 port)
+  TestComponent(v_uint16 port, bool useRequestArena)
     : m_port(port)
+    , m_useRequestArena(useRequestArena)
   {}
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
@@ -90,9 +92,11 @@ public:
     return oatpp::web::server::HttpRouter::createShared();
   }());
 
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([this] {
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
-    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+    auto config = std::make_shared<oatpp::web::server::HttpProcessor::Config>();
+    config->useRequestArena = m_useRequestArena;
+    return std::make_shared<oatpp::web::server::HttpConnectionHandler>(router, config);
   }());
 
   OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper)([] {
@@ -138,7 +142,7 @@ std::shared_ptr<PartList> createMultipart(const std::unordered_map<oatpp::String
   
 void FullTest::onRun() {
 
-  TestComponent component(m_port);
+  TestComponent component(m_port, m_useRequestArena);
 
   oatpp::test::web::ClientServerTestRunner runner;
 
@@ -0,0 +1,479 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HedgingTest.hpp"
+
+#include "oatpp/web/client/RequestExecutor.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <thread>
+#include <mutex>
+
+namespace oatpp { namespace test { namespace web { namespace client {
+
+namespace {
+
+typedef oatpp::web::client::RequestExecutor RequestExecutor;
+typedef oatpp::web::client::HedgingPolicy HedgingPolicy;
+typedef oatpp::web::client::RetryBudget RetryBudget;
+typedef oatpp::web::protocol::http::incoming::Response Response;
+
+/*
+ * Executor which doesn't go to the network.
+ * Latency and status of every attempt is scripted by the connection index.
+ */
+class MockExecutor : public RequestExecutor {
+public:
+
+  class MockConnection : public ConnectionHandle {
+  public:
+
+    v_int64 index;
+    std::atomic<bool> invalidated;
+
+    MockConnection(v_int64 pIndex)
+      : index(pIndex)
+      , invalidated(false)
+    {}
+
+  };
+
+public:
+
+  std::vector<v_int64> latenciesMs;
+  v_int32 statusCode = 200;
+
+  std::atomic<v_int64> connectionsCount;
+  std::atomic<v_int64> invalidationsCount;
+
+private:
+
+  v_int64 getLatency(v_int64 index) {
+    if(index < static_cast<v_int64>(latenciesMs.size())) {
+      return latenciesMs[static_cast<size_t>(index)];
+    }
+    return 0;
+  }
+
+  std::shared_ptr<Response> createResponse(v_int64 index) {
+    return Response::createShared(statusCode, oatpp::utils::Conversion::int64ToStr(index), {}, nullptr, nullptr);
+  }
+
+public:
+
+  MockExecutor(const std::shared_ptr<oatpp::web::client::RetryPolicy>& retryPolicy = nullptr)
+    : RequestExecutor(retryPolicy)
+    , connectionsCount(0)
+    , invalidationsCount(0)
+  {}
+
+  std::shared_ptr<ConnectionHandle> getConnection() override {
+    return std::make_shared<MockConnection>(connectionsCount ++);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<ConnectionHandle>&> getConnectionAsync() override {
+
+    class GetConnectionCoroutine : public oatpp::async::CoroutineWithResult<GetConnectionCoroutine, const std::shared_ptr<ConnectionHandle>&> {
+    private:
+      MockExecutor* m_this;
+    public:
+
+      GetConnectionCoroutine(MockExecutor* _this)
+        : m_this(_this)
+      {}
+
+      Action act() override {
+        return _return(m_this->getConnection());
+      }
+
+    };
+
+    return GetConnectionCoroutine::startForResult(this);
+
+  }
+
+  void invalidateConnection(const std::shared_ptr<ConnectionHandle>& connectionHandle) override {
+    auto connection = std::static_pointer_cast<MockConnection>(connectionHandle);
+    if(!connection->invalidated.exchange(true)) {
+      invalidationsCount ++;
+    }
+  }
+
+  std::shared_ptr<Response> executeOnce(const String& method,
+                                        const String& path,
+                                        const Headers& headers,
+                                        const std::shared_ptr<Body>& body,
+                                        const std::shared_ptr<ConnectionHandle>& connectionHandle) override
+  {
+    (void) method; (void) path; (void) headers; (void) body;
+    auto connection = std::static_pointer_cast<MockConnection>(connectionHandle);
+    auto deadline = oatpp::Environment::getMicroTickCount() + getLatency(connection->index) * 1000;
+    while(oatpp::Environment::getMicroTickCount() < deadline) {
+      if(connection->invalidated) {
+        throw RequestExecutionError(RequestExecutionError::ERROR_CODE_CANT_READ_RESPONSE, "[MockExecutor::executeOnce()]: Connection invalidated.");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return createResponse(connection->index);
+  }
+
+  oatpp::async::CoroutineStarterForResult<const std::shared_ptr<Response>&>
+  executeOnceAsync(const String& method,
+                   const String& path,
+                   const Headers& headers,
+                   const std::shared_ptr<Body>& body,
+                   const std::shared_ptr<ConnectionHandle>& connectionHandle) override
+  {
+
+    (void) method; (void) path; (void) headers; (void) body;
+
+    class ExecuteCoroutine : public oatpp::async::CoroutineWithResult<ExecuteCoroutine, const std::shared_ptr<Response>&> {
+    private:
+      MockExecutor* m_this;
+      std::shared_ptr<MockConnection> m_connection;
+      v_int64 m_deadline;
+    public:
+
+      ExecuteCoroutine(MockExecutor* _this, const std::shared_ptr<MockConnection>& connection)
+        : m_this(_this)
+        , m_connection(connection)
+        , m_deadline(oatpp::Environment::getMicroTickCount() + _this->getLatency(connection->index) * 1000)
+      {}
+
+      Action act() override {
+        if(m_connection->invalidated) {
+          return error<oatpp::async::Error>("[MockExecutor::executeOnceAsync()]: Connection invalidated.");
+        }
+        if(oatpp::Environment::getMicroTickCount() < m_deadline) {
+          return waitRepeat(std::chrono::milliseconds(1));
+        }
+        return _return(m_this->createResponse(m_connection->index));
+      }
+
+    };
+
+    return ExecuteCoroutine::startForResult(this, std::static_pointer_cast<MockConnection>(connectionHandle));
+
+  }
+
+};
+
+class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
+private:
+  std::shared_ptr<MockExecutor> m_executor;
+  std::shared_ptr<Response>* m_result;
+public:
+
+  ClientCoroutine(const std::shared_ptr<MockExecutor>& executor, std::shared_ptr<Response>* result)
+    : m_executor(executor)
+    , m_result(result)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync("GET", "/", {}, nullptr, nullptr).callbackTo(&ClientCoroutine::onResponse);
+  }
+
+  Action onResponse(const std::shared_ptr<Response>& response) {
+    *m_result = response;
+    return finish();
+  }
+
+};
+
+}
+
+void HedgingTest::onRun() {
+
+  {
+    OATPP_LOGd(TAG, "RetryBudget")
+
+    RetryBudget budget(0.5, 2, 0);
+    OATPP_ASSERT(budget.tryWithdraw())
+    OATPP_ASSERT(budget.tryWithdraw())
+    OATPP_ASSERT(!budget.tryWithdraw())
+
+    budget.onRequest();
+    OATPP_ASSERT(!budget.tryWithdraw())
+    budget.onRequest();
+    OATPP_ASSERT(budget.tryWithdraw())
+    OATPP_ASSERT(!budget.tryWithdraw())
+
+    for(v_int32 i = 0; i < 100; i ++) {
+      budget.onRequest();
+    }
+    OATPP_ASSERT(budget.getTokens() == 2)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Adaptive delay")
+
+    HedgingPolicy policy(0.95, std::chrono::milliseconds(5), std::chrono::milliseconds(80));
+    OATPP_ASSERT(policy.getDelayMicroseconds() == 80 * 1000)
+
+    for(v_int64 i = 1; i <= 100; i ++) {
+      policy.recordLatency(i * 1000);
+    }
+    OATPP_ASSERT(policy.getDelayMicroseconds() == 80 * 1000) // clamped by maxDelay
+
+    for(v_int64 i = 0; i < HedgingPolicy::LATENCY_WINDOW; i ++) {
+      policy.recordLatency(i < 120 ? 1000 : 50000);
+    }
+    OATPP_ASSERT(policy.getDelayMicroseconds() == 50000)
+
+    for(v_int64 i = 0; i < HedgingPolicy::LATENCY_WINDOW; i ++) {
+      policy.recordLatency(100);
+    }
+    OATPP_ASSERT(policy.getDelayMicroseconds() == 5000) // clamped by minDelay
+
+    OATPP_ASSERT(policy.canHedge("GET"))
+    OATPP_ASSERT(policy.canHedge("PUT"))
+    OATPP_ASSERT(!policy.canHedge("POST"))
+    OATPP_ASSERT(!policy.canHedge("PATCH"))
+  }
+
+  /* hedged attempts of sync requests run on the async executor too */
+  auto hedgingExecutor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+
+  {
+    OATPP_LOGd(TAG, "Slow primary - hedge wins")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {2000, 10};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(20));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+
+    auto tick0 = oatpp::Environment::getMicroTickCount();
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+    auto elapsed = oatpp::Environment::getMicroTickCount() - tick0;
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "1")
+    OATPP_ASSERT(elapsed < 1000 * 1000)
+    OATPP_ASSERT(policy->getHedgesCount() == 1)
+    OATPP_ASSERT(policy->getHedgeWinsCount() == 1)
+    OATPP_ASSERT(executor->connectionsCount == 2)
+    OATPP_ASSERT(executor->invalidationsCount == 1) // loser invalidated
+  }
+
+  {
+    OATPP_LOGd(TAG, "Fast primary - no hedge")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {5, 5};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(500));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "0")
+    OATPP_ASSERT(policy->getHedgesCount() == 0)
+    OATPP_ASSERT(executor->connectionsCount == 1)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Hedged attempt is slower - primary wins")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {100, 2000};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(10));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+
+    auto tick0 = oatpp::Environment::getMicroTickCount();
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+    auto elapsed = oatpp::Environment::getMicroTickCount() - tick0;
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "0")
+    OATPP_ASSERT(elapsed < 1000 * 1000) // hedge was cancelled
+    OATPP_ASSERT(policy->getHedgesCount() == 1)
+    OATPP_ASSERT(policy->getHedgeWinsCount() == 0)
+    OATPP_ASSERT(executor->invalidationsCount == 1)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Hedging can't work - policy is rejected")
+
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(5));
+
+    /* no executor for hedged attempts */
+    auto executor = std::make_shared<MockExecutor>();
+    bool thrown = false;
+    try {
+      executor->setHedgingPolicy(policy);
+    } catch (const std::runtime_error& e) {
+      (void) e;
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+    OATPP_ASSERT(executor->getHedgingPolicy() == nullptr)
+
+    /* executor is not owned by std::shared_ptr */
+    MockExecutor unownedExecutor;
+    thrown = false;
+    try {
+      unownedExecutor.setHedgingPolicy(policy, hedgingExecutor);
+    } catch (const std::runtime_error& e) {
+      (void) e;
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+    OATPP_ASSERT(unownedExecutor.getHedgingPolicy() == nullptr)
+
+    /* disabling hedging needs no executor */
+    executor->setHedgingPolicy(nullptr);
+  }
+
+  {
+    OATPP_LOGd(TAG, "Pending hedge is cancelled and doesn't outlive the executor")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {5, 5};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(2000));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+    OATPP_ASSERT(response)
+
+    std::weak_ptr<MockExecutor> weakExecutor = executor;
+    executor.reset();
+
+    /* the hedge is woken by the original attempt - not after the 2s delay */
+    auto tick0 = oatpp::Environment::getMicroTickCount();
+    hedgingExecutor->waitTasksFinished();
+    auto elapsed = oatpp::Environment::getMicroTickCount() - tick0;
+
+    OATPP_ASSERT(elapsed < 1000 * 1000)
+    OATPP_ASSERT(weakExecutor.expired())
+    OATPP_ASSERT(policy->getHedgesCount() == 0)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Non-idempotent request is not hedged")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {50, 5};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(5));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+
+    auto response = executor->execute("POST", "/", {}, nullptr, nullptr);
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "0")
+    OATPP_ASSERT(policy->getHedgesCount() == 0)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Hedging is limited by retry budget")
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {50, 5};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(5));
+    executor->setHedgingPolicy(policy, hedgingExecutor);
+    executor->setRetryBudget(RetryBudget::createShared(0, 0, 0));
+
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "0")
+    OATPP_ASSERT(policy->getHedgesCount() == 0)
+  }
+
+  {
+    OATPP_LOGd(TAG, "Retries are limited by retry budget")
+
+    auto executor = std::make_shared<MockExecutor>(
+      std::make_shared<oatpp::web::client::SimpleRetryPolicy>(-1, std::chrono::microseconds(0))
+    );
+    executor->statusCode = 503;
+    executor->setRetryBudget(RetryBudget::createShared(0, 3, 0));
+
+    auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusCode() == 503)
+    OATPP_ASSERT(executor->connectionsCount == 4) // 1 + 3 retries
+  }
+
+  hedgingExecutor->waitTasksFinished();
+  hedgingExecutor->stop();
+  hedgingExecutor->join();
+
+  {
+    OATPP_LOGd(TAG, "Async. Slow primary - hedge wins")
+
+    auto asyncExecutor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {2000, 10};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(20));
+    executor->setHedgingPolicy(policy, asyncExecutor);
+
+    std::shared_ptr<Response> response;
+    auto tick0 = oatpp::Environment::getMicroTickCount();
+    asyncExecutor->execute<ClientCoroutine>(executor, &response);
+    asyncExecutor->waitTasksFinished();
+    auto elapsed = oatpp::Environment::getMicroTickCount() - tick0;
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "1")
+    OATPP_ASSERT(elapsed < 1000 * 1000)
+    OATPP_ASSERT(policy->getHedgesCount() == 1)
+    OATPP_ASSERT(policy->getHedgeWinsCount() == 1)
+    OATPP_ASSERT(executor->invalidationsCount == 1)
+
+    executor->setHedgingPolicy(nullptr);
+    asyncExecutor->stop();
+    asyncExecutor->join();
+  }
+
+  {
+    OATPP_LOGd(TAG, "Async. Fast primary - no hedge")
+
+    auto asyncExecutor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+
+    auto executor = std::make_shared<MockExecutor>();
+    executor->latenciesMs = {5, 5};
+    auto policy = HedgingPolicy::createShared(std::chrono::milliseconds(200));
+    executor->setHedgingPolicy(policy, asyncExecutor);
+
+    std::shared_ptr<Response> response;
+    asyncExecutor->execute<ClientCoroutine>(executor, &response);
+    asyncExecutor->waitTasksFinished();
+
+    OATPP_ASSERT(response)
+    OATPP_ASSERT(response->getStatusDescription() == "0")
+    OATPP_ASSERT(policy->getHedgesCount() == 0)
+    OATPP_ASSERT(executor->connectionsCount == 1)
+
+    executor->setHedgingPolicy(nullptr);
+    asyncExecutor->stop();
+    asyncExecutor->join();
+  }
+
+}
+
+}}}}
@@ -0,0 +1,377 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "HttpPipelineTest.hpp"
+
+#include "oatpp/web/app/Controller.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+#include "oatpp/macro/component.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace client {
+
+namespace {
+
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+typedef oatpp::web::client::RequestExecutor RequestExecutor;
+typedef oatpp::web::protocol::http::outgoing::BufferBody BufferBody;
+
+class TestComponent {
+public:
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface)([] {
+    return oatpp::network::virtual_::Interface::obtainShared("virtualhost");
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, serverConnectionProvider)([] {
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, _interface);
+    return std::static_pointer_cast<oatpp::network::ServerConnectionProvider>(
+      oatpp::network::virtual_::server::ConnectionProvider::createShared(_interface)
+    );
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, httpRouter)([] {
+    return oatpp::web::server::HttpRouter::createShared();
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+    OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper)([] {
+    return std::make_shared<oatpp::json::ObjectMapper>();
+  }());
+
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider)([] {
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, _interface);
+    return std::static_pointer_cast<oatpp::network::ClientConnectionProvider>(
+      oatpp::network::virtual_::client::ConnectionProvider::createShared(_interface)
+    );
+  }());
+
+};
+
+class ClientCoroutine : public oatpp::async::Coroutine<ClientCoroutine> {
+private:
+  std::shared_ptr<HttpRequestExecutor> m_executor;
+  std::shared_ptr<RequestExecutor::ConnectionHandle> m_connection;
+  oatpp::String m_text;
+  std::atomic<v_int32>* m_counter;
+public:
+
+  ClientCoroutine(const std::shared_ptr<HttpRequestExecutor>& executor,
+                  const std::shared_ptr<RequestExecutor::ConnectionHandle>& connection,
+                  const oatpp::String& text,
+                  std::atomic<v_int32>* counter)
+    : m_executor(executor)
+    , m_connection(connection)
+    , m_text(text)
+    , m_counter(counter)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync("POST", "echo", {}, BufferBody::createShared(m_text), m_connection)
+      .callbackTo(&ClientCoroutine::onResponse);
+  }
+
+  Action onResponse(const std::shared_ptr<RequestExecutor::Response>& response) {
+    OATPP_ASSERT(response->getStatusCode() == 200)
+    return response->readBodyToStringAsync().callbackTo(&ClientCoroutine::onBody);
+  }
+
+  Action onBody(const oatpp::String& body) {
+    OATPP_ASSERT(body == m_text)
+    (*m_counter) ++;
+    return finish();
+  }
+
+};
+
+class ErrorCoroutine : public oatpp::async::Coroutine<ErrorCoroutine> {
+private:
+  std::shared_ptr<HttpRequestExecutor> m_executor;
+  std::shared_ptr<RequestExecutor::ConnectionHandle> m_connection;
+  v_int64 m_timeout;
+  std::atomic<v_int32>* m_errors;
+public:
+
+  ErrorCoroutine(const std::shared_ptr<HttpRequestExecutor>& executor,
+                 const std::shared_ptr<RequestExecutor::ConnectionHandle>& connection,
+                 v_int64 timeout,
+                 std::atomic<v_int32>* errors)
+    : m_executor(executor)
+    , m_connection(connection)
+    , m_timeout(timeout)
+    , m_errors(errors)
+  {}
+
+  Action act() override {
+    if(m_timeout > 0) {
+      setDeadline(oatpp::Environment::getMicroTickCount() + m_timeout);
+    }
+    return m_executor->executeAsync("GET", "/", {}, nullptr, m_connection)
+      .callbackTo(&ErrorCoroutine::onResponse);
+  }
+
+  Action onResponse(const std::shared_ptr<RequestExecutor::Response>& response) {
+    (void) response;
+    return finish();
+  }
+
+  Action handleError(Error* error) override {
+    (void) error;
+    (*m_errors) ++;
+    return finish();
+  }
+
+};
+
+}
+
+void HttpPipelineTest::onRun() {
+
+  TestComponent component;
+
+  oatpp::test::web::ClientServerTestRunner runner;
+
+  runner.addController(app::Controller::createShared());
+
+  runner.run([this] {
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider);
+    auto executor = HttpRequestExecutor::createShared(clientConnectionProvider);
+
+    {
+      OATPP_LOGi(TAG, "Sync pipeline...")
+
+      auto connection = executor->getPipelinedConnection(4);
+
+      std::vector<std::thread> threads;
+      for(v_int32 i = 0; i < 16; i ++) {
+        threads.emplace_back([executor, connection, i]{
+          auto text = "request-" + oatpp::utils::Conversion::int32ToStr(i);
+          if(i % 2 == 0) {
+            auto response = executor->execute("POST", "echo", {}, BufferBody::createShared(text), connection);
+            OATPP_ASSERT(response->getStatusCode() == 200)
+            OATPP_ASSERT(response->readBodyToString() == text)
+          } else {
+            // chunked response body
+            auto response = executor->execute("GET", "chunked/" + text + "/3", {}, nullptr, connection);
+            OATPP_ASSERT(response->getStatusCode() == 200)
+            OATPP_ASSERT(response->readBodyToString() == text + text + text)
+          }
+        });
+      }
+
+      for(auto& thread : threads) {
+        thread.join();
+      }
+
+      auto response = executor->execute("GET", "/", {}, nullptr, connection);
+      OATPP_ASSERT(response->readBodyToString() == "Hello World!!!")
+
+      OATPP_LOGi(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGi(TAG, "Async pipeline...")
+
+      auto connection = executor->getPipelinedConnection(8);
+
+      std::atomic<v_int32> counter(0);
+
+      oatpp::async::Executor asyncExecutor(1, 1, 1);
+      for(v_int32 i = 0; i < 32; i ++) {
+        asyncExecutor.execute<ClientCoroutine>(executor, connection, "async-" + oatpp::utils::Conversion::int32ToStr(i), &counter);
+      }
+
+      asyncExecutor.waitTasksFinished();
+      asyncExecutor.stop();
+      asyncExecutor.join();
+
+      OATPP_ASSERT(counter == 32)
+      OATPP_LOGi(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGi(TAG, "Failed pipeline...")
+
+      auto connection = executor->getPipelinedConnection(4);
+      auto response = executor->execute("GET", "/", {}, nullptr, connection);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+
+      executor->invalidateConnection(connection);
+
+      bool thrown = false;
+      try {
+        executor->execute("GET", "/", {}, nullptr, connection);
+      } catch (const RequestExecutor::RequestExecutionError& error) {
+        OATPP_ASSERT(error.getErrorCode() == RequestExecutor::RequestExecutionError::ERROR_CODE_PIPELINE_FAILED)
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+
+      OATPP_LOGi(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGi(TAG, "Body is too large...")
+
+      for(v_int32 i = 0; i < 2; i ++) {
+
+        auto connection = executor->getPipelinedConnection(4, 16);
+
+        auto response = executor->execute("POST", "echo", {}, BufferBody::createShared("0123456789"), connection);
+        OATPP_ASSERT(response->readBodyToString() == "0123456789")
+
+        bool thrown = false;
+        try {
+          if(i == 0) {
+            executor->execute("POST", "echo", {}, BufferBody::createShared("0123456789-0123456789"), connection);
+          } else {
+            // chunked response body
+            executor->execute("GET", "chunked/0123456789/2", {}, nullptr, connection);
+          }
+        } catch (const RequestExecutor::RequestExecutionError& error) {
+          OATPP_ASSERT(error.getErrorCode() == RequestExecutor::RequestExecutionError::ERROR_CODE_CANT_READ_RESPONSE)
+          thrown = true;
+        }
+        OATPP_ASSERT(thrown)
+
+        thrown = false;
+        try {
+          executor->execute("GET", "/", {}, nullptr, connection);
+        } catch (const RequestExecutor::RequestExecutionError& error) {
+          OATPP_ASSERT(error.getErrorCode() == RequestExecutor::RequestExecutionError::ERROR_CODE_PIPELINE_FAILED)
+          thrown = true;
+        }
+        OATPP_ASSERT(thrown)
+
+      }
+
+      OATPP_LOGi(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGi(TAG, "Mixed sync/async use...")
+
+      oatpp::async::Executor asyncExecutor(1, 1, 1);
+
+      /* used synchronously first - async request is rejected and fails the pipeline */
+      auto connection = executor->getPipelinedConnection(4);
+      auto response = executor->execute("GET", "/", {}, nullptr, connection);
+      OATPP_ASSERT(response->readBodyToString() == "Hello World!!!")
+
+      std::atomic<v_int32> errors(0);
+      asyncExecutor.execute<ErrorCoroutine>(executor, connection, 0, &errors);
+      asyncExecutor.waitTasksFinished();
+      OATPP_ASSERT(errors == 1)
+
+      bool thrown = false;
+      try {
+        executor->execute("GET", "/", {}, nullptr, connection);
+      } catch (const RequestExecutor::RequestExecutionError& error) {
+        OATPP_ASSERT(error.getErrorCode() == RequestExecutor::RequestExecutionError::ERROR_CODE_PIPELINE_FAILED)
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+
+      /* used asynchronously first - sync request is rejected and fails the pipeline */
+      auto asyncConnection = executor->getPipelinedConnection(4);
+      std::atomic<v_int32> counter(0);
+      asyncExecutor.execute<ClientCoroutine>(executor, asyncConnection, "async-first", &counter);
+      asyncExecutor.waitTasksFinished();
+      OATPP_ASSERT(counter == 1)
+
+      thrown = false;
+      try {
+        executor->execute("GET", "/", {}, nullptr, asyncConnection);
+      } catch (const RequestExecutor::RequestExecutionError& error) {
+        OATPP_ASSERT(error.getErrorCode() == RequestExecutor::RequestExecutionError::ERROR_CODE_PIPELINE_FAILED)
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown)
+
+      errors = 0;
+      asyncExecutor.execute<ErrorCoroutine>(executor, asyncConnection, 0, &errors);
+      asyncExecutor.waitTasksFinished();
+      OATPP_ASSERT(errors == 1)
+
+      asyncExecutor.stop();
+      asyncExecutor.join();
+
+      OATPP_LOGi(TAG, "OK")
+    }
+
+    {
+      OATPP_LOGi(TAG, "Request timed out before its write turn...")
+
+      auto connection = executor->getPipelinedConnection(4);
+      auto pipeline = std::static_pointer_cast<HttpRequestExecutor::PipelinedConnectionHandle>(connection)->getPipeline();
+
+      /* hold the write turn, so that the request times out waiting for it */
+      OATPP_ASSERT(pipeline->setIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS))
+      auto ticket = pipeline->enqueue();
+
+      oatpp::async::Executor asyncExecutor(1, 1, 1);
+      std::atomic<v_int32> errors(0);
+      asyncExecutor.execute<ErrorCoroutine>(executor, connection, 50 * 1000, &errors);
+      asyncExecutor.waitTasksFinished();
+      asyncExecutor.stop();
+      asyncExecutor.join();
+
+      OATPP_ASSERT(errors == 1)
+
+      /* the ticket of the timed-out request is not left for the later ones to wait for - the pipeline fails */
+      OATPP_ASSERT(pipeline->isFailed())
+      OATPP_ASSERT(!pipeline->waitWriteTurn(ticket))
+
+      OATPP_LOGi(TAG, "OK")
+    }
+
+  }, std::chrono::minutes(10));
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+}
+
+}}}}
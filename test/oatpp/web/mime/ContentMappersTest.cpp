@@ -187,6 +187,43 @@ void ContentMappersTest::onRun() {
     OATPP_ASSERT(m->getInfo().httpContentType == "application/json")
   }
 
+  {
+    OATPP_LOGd(TAG, "case 12 - memoized selection is invalidated by putMapper")
+    ContentMappers mappers;
+    mappers.putMapper(std::make_shared<FakeMapper>("text", "html"));
+
+    OATPP_ASSERT(mappers.selectMapper("application/json") == nullptr)
+    OATPP_ASSERT(mappers.selectMapper("application/json") == nullptr)
+    OATPP_ASSERT(mappers.selectMapper(std::vector<oatpp::String>{"text/plain", "application/json"}) == nullptr)
+
+    auto json = std::make_shared<FakeMapper>("application", "json");
+    mappers.putMapper(json);
+
+    OATPP_ASSERT(mappers.selectMapper("application/json") == json)
+    OATPP_ASSERT(mappers.selectMapper("application/json") == json)
+    OATPP_ASSERT(mappers.selectMapper(std::vector<oatpp::String>{"text/plain", "application/json"}) == json)
+    OATPP_ASSERT(mappers.selectMapper(std::vector<oatpp::String>{"text/plain,application/json"}) == json)
+    OATPP_ASSERT(mappers.selectMapper(std::vector<oatpp::String>{"text/html", "text/plain"})->getInfo().httpContentType == "text/html")
+
+    mappers.clear();
+    OATPP_ASSERT(mappers.selectMapper("") == nullptr)
+  }
+
+  {
+    OATPP_LOGd(TAG, "case 13 - memoized selection - distinct instances")
+    ContentMappers mappers1;
+    ContentMappers mappers2;
+    auto json = std::make_shared<FakeMapper>("application", "json");
+    auto xml = std::make_shared<FakeMapper>("application", "xml");
+    mappers1.putMapper(json);
+    mappers2.putMapper(xml);
+
+    for(v_int32 i = 0; i < 3; i ++) {
+      OATPP_ASSERT(mappers1.selectMapper("application/*") == json)
+      OATPP_ASSERT(mappers2.selectMapper("application/*") == xml)
+    }
+  }
+
 }
 
 }
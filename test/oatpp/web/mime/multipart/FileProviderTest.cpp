@@ -0,0 +1,211 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>,
+ * Matthias Haselmaier <mhaselmaier@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "FileProviderTest.hpp"
+
+#include "oatpp/web/mime/multipart/TemporaryFileProvider.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/data/stream/FileStream.hpp"
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include <cstdio>
+
+namespace oatpp { namespace test { namespace web { namespace mime { namespace multipart {
+
+namespace {
+
+  typedef oatpp::web::mime::multipart::Part Part;
+  typedef oatpp::web::mime::multipart::AsyncPartReader AsyncPartReader;
+
+  class WritePartCoroutine : public oatpp::async::Coroutine<WritePartCoroutine> {
+  private:
+    std::shared_ptr<AsyncPartReader> m_reader;
+    std::shared_ptr<Part> m_part;
+    oatpp::String m_data;
+    v_buff_size m_chunkSize;
+    v_buff_size m_position;
+  public:
+
+    WritePartCoroutine(const std::shared_ptr<AsyncPartReader>& reader,
+                       const std::shared_ptr<Part>& part,
+                       const oatpp::String& data,
+                       v_buff_size chunkSize)
+      : m_reader(reader)
+      , m_part(part)
+      , m_data(data)
+      , m_chunkSize(chunkSize)
+      , m_position(0)
+    {}
+
+    Action act() override {
+      return m_reader->onNewPartAsync(m_part).next(yieldTo(&WritePartCoroutine::writeChunk));
+    }
+
+    Action writeChunk() {
+      auto dataSize = static_cast<v_buff_size>(m_data->size());
+      if(m_position < dataSize) {
+        auto size = std::min<v_buff_size>(m_chunkSize, dataSize - m_position);
+        auto data = m_data->data() + m_position;
+        m_position += size;
+        return m_reader->onPartDataAsync(m_part, data, size).next(yieldTo(&WritePartCoroutine::writeChunk));
+      }
+      return m_reader->onPartDataAsync(m_part, nullptr, 0).next(finish());
+    }
+
+  };
+
+  oatpp::String writePart(const oatpp::web::mime::multipart::FileWriteConfig& config,
+                          const oatpp::String& data,
+                          v_buff_size chunkSize,
+                          const oatpp::String& contentLength,
+                          bool async = false)
+  {
+
+    Part::Headers headers;
+    if(contentLength) {
+      headers.put("Content-Length", contentLength);
+    }
+    auto part = std::make_shared<Part>(headers);
+
+    if(async) {
+
+      auto reader = oatpp::web::mime::multipart::createAsyncTemporaryFilePartReader(nullptr, 8, -1, config);
+
+      oatpp::async::Executor executor(1, 1, 1);
+      executor.execute<WritePartCoroutine>(reader, part, data, chunkSize);
+      executor.waitTasksFinished();
+      executor.stop();
+      executor.join();
+
+    } else {
+
+      auto reader = oatpp::web::mime::multipart::createTemporaryFilePartReader(nullptr, 8, -1, config);
+
+      reader->onNewPart(part);
+      for(v_buff_size i = 0; i < static_cast<v_buff_size>(data->size()); i += chunkSize) {
+        auto size = std::min<v_buff_size>(chunkSize, static_cast<v_buff_size>(data->size()) - i);
+        reader->onPartData(part, data->data() + i, size);
+      }
+      reader->onPartData(part, nullptr, 0);
+
+    }
+
+    auto payload = part->getPayload();
+    OATPP_ASSERT(payload)
+
+    v_char8 buffer[256];
+    oatpp::data::stream::BufferOutputStream stream;
+    oatpp::data::stream::transfer(payload->openInputStream(), &stream, 0, buffer, 256);
+
+    return stream.toString();
+
+  }
+
+}
+
+void FileProviderTest::onRun() {
+
+  oatpp::data::stream::BufferOutputStream stream;
+  for(v_int32 i = 0; i < 10000; i ++) {
+    stream << "line-" << i << "\n";
+  }
+  oatpp::String data = stream.toString();
+
+  {
+    OATPP_LOGi(TAG, "FileOutputStream write buffer and preallocation...")
+
+    oatpp::data::stream::FileOutputStream fileStream(std::tmpfile(), true);
+
+    OATPP_ASSERT(!fileStream.setWriteBuffer(0))
+    OATPP_ASSERT(fileStream.setWriteBuffer(64 * 1024))
+    OATPP_ASSERT(!fileStream.setWriteBuffer(64 * 1024)) // buffer is already set
+
+#if defined(__linux__)
+    OATPP_ASSERT(fileStream.preallocate(static_cast<v_int64>(data->size())))
+#else
+    OATPP_ASSERT(!fileStream.preallocate(static_cast<v_int64>(data->size())))
+#endif
+    OATPP_ASSERT(!fileStream.preallocate(0))
+
+    OATPP_ASSERT(fileStream.writeSimple(data->data(), static_cast<v_buff_size>(data->size())) == static_cast<v_io_size>(data->size()))
+
+    /* preallocation doesn't change the visible size of the file */
+    std::fflush(fileStream.getFile());
+    std::fseek(fileStream.getFile(), 0, SEEK_END);
+    OATPP_ASSERT(std::ftell(fileStream.getFile()) == static_cast<long>(data->size()))
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Default config...")
+    auto result = writePart({}, data, 7, nullptr);
+    OATPP_ASSERT(result == data)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Staging buffer...")
+    oatpp::web::mime::multipart::FileWriteConfig config;
+    config.bufferSize = 64 * 1024;
+    auto result = writePart(config, data, 7, nullptr);
+    OATPP_ASSERT(result == data)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Staging buffer + preallocation...")
+    oatpp::web::mime::multipart::FileWriteConfig config;
+    config.bufferSize = 64 * 1024;
+    config.preallocate = true;
+    auto result = writePart(config, data, 1000, oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(data->size())));
+    OATPP_ASSERT(result == data)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Preallocation with wrong Content-Length hint...")
+    oatpp::web::mime::multipart::FileWriteConfig config;
+    config.preallocate = true;
+    auto result = writePart(config, data, 1000, oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(data->size()) * 2));
+    OATPP_ASSERT(result == data)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Async reader, staging buffer + preallocation...")
+    oatpp::web::mime::multipart::FileWriteConfig config;
+    config.bufferSize = 64 * 1024;
+    config.preallocate = true;
+    auto result = writePart(config, data, 1000, oatpp::utils::Conversion::int64ToStr(static_cast<v_int64>(data->size())), true);
+    OATPP_ASSERT(result == data)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}}
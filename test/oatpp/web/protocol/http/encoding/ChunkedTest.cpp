@@ -27,6 +27,8 @@
 #include "oatpp/web/protocol/http/encoding/Chunked.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
 
 void ChunkedTest::onRun() {
@@ -119,6 +121,99 @@ void ChunkedTest::onRun() {
     OATPP_ASSERT(result == data)
   }
 
+  { // Hex chunk size
+    oatpp::String body(0x1AB);
+    oatpp::data::stream::BufferInputStream inStream(body);
+    oatpp::data::stream::BufferOutputStream outStream;
+
+    oatpp::web::protocol::http::encoding::EncoderChunked encoder;
+
+    v_char8 buffer[1024];
+    oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer, 1024, &encoder);
+    auto result = outStream.toString();
+
+    OATPP_ASSERT(result->substr(0, 5) == "1AB\r\n")
+    OATPP_ASSERT(result->substr(result->size() - 7) == "\r\n0\r\n\r\n")
+  }
+
+  { // Chunk extensions, trailers and stream data after the body
+    oatpp::String encodedBody = "5;name=value\r\nHello\r\na\r\n World!!!!\r\n0\r\nTrailer: value\r\n\r\nNEXT";
+    oatpp::data::stream::BufferInputStream inStream(encodedBody);
+    oatpp::data::stream::BufferOutputStream outStream;
+
+    oatpp::web::protocol::http::encoding::DecoderChunked decoder;
+
+    v_char8 buffer[1024];
+    auto count = oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer, 1024, &decoder);
+    decoded = outStream.toString();
+    OATPP_LOGd(TAG, "decoded='{}'", decoded)
+    OATPP_ASSERT(decoded == "Hello World!!!!")
+    OATPP_ASSERT(count == static_cast<v_io_size>(encodedBody->size() - 4))
+  }
+
+  { // Invalid chunk headers
+    const char* invalid[] = {"X\r\n", "5\n", "1\r\naXX", "FFFFFFFFFFFFFFFF\r\n"};
+    v_int32 expected[] = {
+      oatpp::web::protocol::http::encoding::DecoderChunked::ERROR_CHUNK_HEADER_INVALID,
+      oatpp::web::protocol::http::encoding::DecoderChunked::ERROR_CHUNK_HEADER_INVALID,
+      oatpp::web::protocol::http::encoding::DecoderChunked::ERROR_CHUNK_HEADER_INVALID,
+      oatpp::web::protocol::http::encoding::DecoderChunked::ERROR_CHUNK_HEADER_TOO_LONG
+    };
+
+    for(v_int32 i = 0; i < 4; i ++) {
+
+      oatpp::String header = invalid[i];
+      oatpp::web::protocol::http::encoding::DecoderChunked decoder;
+
+      oatpp::data::buffer::InlineReadData dataIn(header->data(), static_cast<v_buff_size>(header->size()));
+      oatpp::data::buffer::InlineReadData dataOut;
+
+      v_int32 res;
+      do {
+        res = decoder.iterate(dataIn, dataOut);
+        if(res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT) {
+          dataOut.inc(dataOut.bytesLeft);
+        }
+      } while(res == oatpp::data::buffer::Processor::Error::OK ||
+              res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT);
+
+      OATPP_ASSERT(res == expected[i])
+
+    }
+  }
+
+  { // Throughput
+    const v_buff_size bodySize = 16 * 1024 * 1024;
+    const v_buff_size chunkSize = 256;
+
+    std::string bodyData(static_cast<size_t>(bodySize), '\0');
+    for(size_t i = 0; i < bodyData.size(); i ++) {
+      bodyData[i] = static_cast<char>('a' + i % 26);
+    }
+    oatpp::String body(std::move(bodyData));
+
+    v_char8 buffer[chunkSize];
+    oatpp::String encodedBody;
+
+    {
+      oatpp::test::PerformanceChecker checker("Chunked encode 16MB in 256 bytes chunks");
+      oatpp::data::stream::BufferInputStream inStream(body);
+      oatpp::data::stream::BufferOutputStream outStream(bodySize + bodySize / 16);
+      oatpp::web::protocol::http::encoding::EncoderChunked encoder;
+      oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer, chunkSize, &encoder);
+      encodedBody = outStream.toString();
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Chunked decode 16MB in 256 bytes chunks");
+      oatpp::data::stream::BufferInputStream inStream(encodedBody);
+      oatpp::data::stream::BufferOutputStream outStream(bodySize);
+      oatpp::web::protocol::http::encoding::DecoderChunked decoder;
+      auto count = oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer, chunkSize, &decoder);
+      OATPP_ASSERT(count == static_cast<v_io_size>(encodedBody->size()))
+      OATPP_ASSERT(outStream.toString() == body)
+    }
+  }
 
 }
 
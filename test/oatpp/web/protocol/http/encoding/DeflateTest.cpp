@@ -0,0 +1,327 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "DeflateTest.hpp"
+
+#include "oatpp/web/protocol/http/encoding/Deflate.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
+
+namespace {
+
+typedef oatpp::web::protocol::http::encoding::DeflateFormat DeflateFormat;
+typedef oatpp::web::protocol::http::encoding::DeflateEncoder DeflateEncoder;
+typedef oatpp::web::protocol::http::encoding::DeflateDecoder DeflateDecoder;
+
+oatpp::String process(const oatpp::String& data, oatpp::data::buffer::Processor* processor, v_buff_size bufferSize) {
+  oatpp::data::stream::BufferInputStream inStream(data);
+  oatpp::data::stream::BufferOutputStream outStream;
+  std::unique_ptr<v_char8[]> buffer(new v_char8[static_cast<size_t>(bufferSize)]);
+  oatpp::data::stream::transfer(&inStream, &outStream, 0, buffer.get(), bufferSize, processor);
+  return outStream.toString();
+}
+
+v_int32 iterateAll(const oatpp::String& data, oatpp::data::buffer::Processor* processor) {
+
+  oatpp::data::buffer::InlineReadData dataIn(data->data(), static_cast<v_buff_size>(data->size()));
+  oatpp::data::buffer::InlineReadData dataOut;
+
+  v_int32 res;
+  do {
+    res = processor->iterate(dataIn, dataOut);
+    if(res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT) {
+      dataOut.inc(dataOut.bytesLeft);
+    } else if(res == oatpp::data::buffer::Processor::Error::PROVIDE_DATA_IN) {
+      dataIn.set(nullptr, 0);
+      res = oatpp::data::buffer::Processor::Error::OK;
+    }
+  } while(res == oatpp::data::buffer::Processor::Error::OK ||
+          res == oatpp::data::buffer::Processor::Error::FLUSH_DATA_OUT);
+
+  return res;
+
+}
+
+oatpp::String generateData(v_buff_size size, bool compressible) {
+  std::string data(static_cast<size_t>(size), '\0');
+  v_uint32 seed = 12345;
+  for(size_t i = 0; i < data.size(); i ++) {
+    if(compressible) {
+      data[i] = static_cast<char>('a' + (i / 7) % 26);
+    } else {
+      seed = seed * 1103515245 + 12345;
+      data[i] = static_cast<char>(seed >> 16);
+    }
+  }
+  return oatpp::String(std::move(data));
+}
+
+}
+
+void DeflateTest::onRun() {
+
+#ifdef OATPP_ZLIB_ENABLED
+
+  oatpp::String compressible = generateData(100 * 1024, true);
+  oatpp::String random = generateData(100 * 1024, false);
+
+  { // Round trip
+    DeflateFormat formats[] = {DeflateFormat::GZIP, DeflateFormat::ZLIB};
+    v_int32 levels[] = {DeflateEncoder::DEFAULT_LEVEL, 0, 1, 9};
+    oatpp::String samples[] = {"", "Hello World!!!", compressible, random};
+    v_buff_size bufferSizes[] = {5, 4096};
+
+    for(auto format : formats) {
+      for(auto level : levels) {
+        for(auto& sample : samples) {
+          for(auto bufferSize : bufferSizes) {
+
+            DeflateEncoder encoder(format, level);
+            auto encoded = process(sample, &encoder, bufferSize);
+
+            OATPP_ASSERT(encoded->size() > 2)
+            if(format == DeflateFormat::GZIP) {
+              OATPP_ASSERT(static_cast<v_uint8>(encoded->at(0)) == 0x1F && static_cast<v_uint8>(encoded->at(1)) == 0x8B)
+            } else {
+              OATPP_ASSERT(static_cast<v_uint8>(encoded->at(0)) == 0x78)
+            }
+
+            DeflateDecoder decoder(format);
+            auto decoded = process(encoded, &decoder, bufferSize);
+            OATPP_ASSERT(decoded == sample)
+
+          }
+        }
+      }
+    }
+
+    DeflateEncoder encoder(DeflateFormat::GZIP);
+    auto encoded = process(compressible, &encoder, 4096);
+    OATPP_LOGd(TAG, "compressed {} -> {} bytes", compressible->size(), encoded->size())
+    OATPP_ASSERT(encoded->size() < compressible->size() / 10)
+  }
+
+  { // With chunked transfer-encoding
+    auto contentEncoder = std::make_shared<DeflateEncoder>(DeflateFormat::GZIP);
+    auto chunkedEncoder = std::make_shared<oatpp::web::protocol::http::encoding::EncoderChunked>();
+    oatpp::data::buffer::ProcessingPipeline encodingPipeline({contentEncoder, chunkedEncoder});
+    auto encoded = process(compressible, &encodingPipeline, 1024);
+
+    OATPP_ASSERT(encoded->substr(encoded->size() - 7) == "\r\n0\r\n\r\n")
+
+    auto chunkedDecoder = std::make_shared<oatpp::web::protocol::http::encoding::DecoderChunked>();
+    auto contentDecoder = std::make_shared<DeflateDecoder>(DeflateFormat::GZIP);
+    oatpp::data::buffer::ProcessingPipeline decodingPipeline({chunkedDecoder, contentDecoder});
+    auto decoded = process(encoded, &decodingPipeline, 1024);
+
+    OATPP_ASSERT(decoded == compressible)
+  }
+
+  { // Providers
+    oatpp::web::protocol::http::encoding::GzipEncoderProvider gzipEncoder(5);
+    oatpp::web::protocol::http::encoding::GzipDecoderProvider gzipDecoder;
+    oatpp::web::protocol::http::encoding::DeflateEncoderProvider deflateEncoder;
+    oatpp::web::protocol::http::encoding::DeflateDecoderProvider deflateDecoder;
+
+    OATPP_ASSERT(gzipEncoder.getEncodingName() == "gzip")
+    OATPP_ASSERT(gzipDecoder.getEncodingName() == "gzip")
+    OATPP_ASSERT(deflateEncoder.getEncodingName() == "deflate")
+    OATPP_ASSERT(deflateDecoder.getEncodingName() == "deflate")
+    OATPP_ASSERT(gzipEncoder.getEncodedBufferCache() == nullptr)
+
+    auto encoded = process(compressible, gzipEncoder.getProcessor().get(), 4096);
+    auto decoded = process(encoded, gzipDecoder.getProcessor().get(), 4096);
+    OATPP_ASSERT(decoded == compressible)
+
+    bool thrown = false;
+    try {
+      oatpp::web::protocol::http::encoding::GzipEncoderProvider invalid(10);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown)
+  }
+
+  { // Invalid, truncated and trailing data
+    DeflateEncoder encoder(DeflateFormat::GZIP);
+    auto encoded = process(compressible, &encoder, 4096);
+
+    {
+      DeflateDecoder decoder(DeflateFormat::GZIP);
+      oatpp::String truncated = encoded->substr(0, encoded->size() / 2);
+      OATPP_ASSERT(iterateAll(truncated, &decoder) == DeflateDecoder::ERROR_UNEXPECTED_END)
+    }
+
+    {
+      DeflateDecoder decoder(DeflateFormat::GZIP);
+      OATPP_ASSERT(iterateAll("this is not gzip", &decoder) == DeflateDecoder::ERROR_DATA)
+    }
+
+    {
+      DeflateDecoder decoder(DeflateFormat::GZIP);
+      oatpp::String withTrailer = *encoded + "TRAILING DATA";
+      OATPP_ASSERT(process(withTrailer, &decoder, 4096) == compressible)
+    }
+  }
+
+  { // EncodedBufferCache
+    using oatpp::web::protocol::http::outgoing::BufferBody;
+    oatpp::web::protocol::http::encoding::EncodedBufferCache cache(200 * 1024, 64 * 1024);
+    oatpp::web::protocol::http::encoding::GzipEncoderProvider gzip;
+    oatpp::web::protocol::http::encoding::DeflateEncoderProvider deflate;
+
+    oatpp::String small = generateData(32 * 1024, true);
+    BufferBody smallBody(small, "text/plain", true);
+
+    auto encoded1 = cache.get(smallBody, &gzip);
+    auto encoded2 = cache.get(smallBody, &gzip);
+    auto encoded3 = cache.get(smallBody, &deflate);
+
+    OATPP_ASSERT(encoded1 && encoded2 && encoded3)
+    OATPP_ASSERT(encoded1.get() == encoded2.get())
+    OATPP_ASSERT(encoded1.get() != encoded3.get())
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+    OATPP_ASSERT(cache.getSize() == static_cast<v_buff_size>(encoded1->size() + encoded3->size()))
+
+    DeflateDecoder decoder(DeflateFormat::GZIP);
+    OATPP_ASSERT(process(encoded1, &decoder, 4096) == small)
+
+    /* too big to be cached */
+    OATPP_ASSERT(cache.get(BufferBody(compressible, "text/plain", true), &gzip) == nullptr)
+
+    /* not immutable - neither looked up nor inserted */
+    OATPP_ASSERT(cache.get(BufferBody(small, "text/plain"), &gzip) == nullptr)
+    OATPP_ASSERT(cache.getEntriesCount() == 2)
+
+    /* equal content, different buffer */
+    oatpp::String copy = *small;
+    BufferBody copyBody(copy, "text/plain", true);
+    auto encoded4 = cache.get(copyBody, &gzip);
+    OATPP_ASSERT(encoded4 == encoded1)
+    OATPP_ASSERT(encoded4.get() != encoded1.get())
+    OATPP_ASSERT(cache.getEntriesCount() == 3)
+
+    /* "immutable" buffer changed its size - encoded again */
+    copy->append("tail");
+    auto encoded5 = cache.get(copyBody, &gzip);
+    OATPP_ASSERT(encoded5.get() != encoded4.get())
+    DeflateDecoder decoder5(DeflateFormat::GZIP);
+    OATPP_ASSERT(process(encoded5, &decoder5, 4096) == copy)
+    OATPP_ASSERT(cache.getEntriesCount() == 3)
+
+    /* eviction of the least recently used */
+    oatpp::web::protocol::http::encoding::EncodedBufferCache tinyCache(static_cast<v_buff_size>(encoded1->size() + 1), 64 * 1024);
+    tinyCache.get(smallBody, &gzip);
+    tinyCache.get(BufferBody(oatpp::String(*small), "text/plain", true), &gzip);
+    OATPP_ASSERT(tinyCache.getEntriesCount() == 1)
+
+    cache.clear();
+    OATPP_ASSERT(cache.getEntriesCount() == 0)
+    OATPP_ASSERT(cache.getSize() == 0)
+  }
+
+  { // Response with cached encoded body
+    auto cache = std::make_shared<oatpp::web::protocol::http::encoding::EncodedBufferCache>();
+    oatpp::web::protocol::http::encoding::GzipEncoderProvider gzip(DeflateEncoder::DEFAULT_LEVEL, cache);
+
+    for(v_int32 i = 0; i < 2; i ++) {
+
+      auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(compressible, "text/plain", true);
+      auto response = oatpp::web::protocol::http::outgoing::Response::createShared(oatpp::web::protocol::http::Status::CODE_200, body);
+
+      oatpp::data::stream::BufferOutputStream stream;
+      oatpp::data::stream::BufferOutputStream headersBuffer;
+      response->send(&stream, &headersBuffer, &gzip);
+
+      auto result = stream.toString();
+      auto headersEnd = result->find("\r\n\r\n");
+      OATPP_ASSERT(headersEnd != std::string::npos)
+
+      oatpp::String headers = result->substr(0, headersEnd);
+      oatpp::String content = result->substr(headersEnd + 4);
+
+      OATPP_ASSERT(headers->find("Content-Encoding: gzip") != std::string::npos)
+      OATPP_ASSERT(headers->find("Content-Length: " + std::to_string(content->size())) != std::string::npos)
+      OATPP_ASSERT(headers->find("Transfer-Encoding") == std::string::npos)
+
+      DeflateDecoder decoder(DeflateFormat::GZIP);
+      OATPP_ASSERT(process(content, &decoder, 4096) == compressible)
+
+    }
+
+    OATPP_ASSERT(cache->getEntriesCount() == 1)
+
+    { // Not immutable - not cached
+      auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(random, "text/plain");
+      auto response = oatpp::web::protocol::http::outgoing::Response::createShared(oatpp::web::protocol::http::Status::CODE_200, body);
+
+      oatpp::data::stream::BufferOutputStream stream;
+      oatpp::data::stream::BufferOutputStream headersBuffer;
+      response->send(&stream, &headersBuffer, &gzip);
+
+      auto result = stream.toString();
+      OATPP_ASSERT(result->find("Transfer-Encoding: chunked") != std::string::npos)
+      OATPP_ASSERT(cache->getEntriesCount() == 1)
+    }
+  }
+
+  { // Performance
+    oatpp::String json = generateData(8 * 1024, true);
+    const v_int32 iterations = 1000;
+
+    {
+      oatpp::web::protocol::http::encoding::GzipEncoderProvider gzip;
+      oatpp::test::PerformanceChecker checker("Gzip 8KB x 1000 - per-thread z_stream pool");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        auto encoded = oatpp::web::protocol::http::encoding::EncodedBufferCache::encode(json, &gzip);
+        OATPP_ASSERT(encoded->size() > 0)
+      }
+    }
+
+    {
+      oatpp::web::protocol::http::encoding::EncodedBufferCache cache;
+      oatpp::web::protocol::http::encoding::GzipEncoderProvider gzip;
+      oatpp::web::protocol::http::outgoing::BufferBody body(json, "application/json", true);
+      oatpp::test::PerformanceChecker checker("Gzip 8KB x 1000 - EncodedBufferCache");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        auto encoded = cache.get(body, &gzip);
+        OATPP_ASSERT(encoded->size() > 0)
+      }
+    }
+  }
+
+#else
+  OATPP_LOGi(TAG, "oatpp is built without zlib. Skipping.")
+#endif
+
+}
+
+}}}}}}
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ProviderCollectionTest.hpp"
+
+#include "oatpp/web/protocol/http/encoding/ProviderCollection.hpp"
+#include "oatpp/web/protocol/http/encoding/Chunked.hpp"
+#include "oatpp/web/protocol/http/Http.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace protocol { namespace http { namespace encoding {
+
+namespace {
+
+class FakeProvider : public oatpp::web::protocol::http::encoding::EncoderProvider {
+private:
+  oatpp::String m_name;
+public:
+
+  FakeProvider(const oatpp::String& name)
+    : m_name(name)
+  {}
+
+  oatpp::String getEncodingName() override {
+    return m_name;
+  }
+
+  std::shared_ptr<data::buffer::Processor> getProcessor() override {
+    return std::make_shared<oatpp::web::protocol::http::encoding::EncoderChunked>();
+  }
+
+};
+
+}
+
+void ProviderCollectionTest::onRun() {
+
+  typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
+
+  { // Negotiation is invalidated by add
+    oatpp::web::protocol::http::encoding::ProviderCollection providers;
+    auto gzip = std::make_shared<FakeProvider>("gzip");
+    auto br = std::make_shared<FakeProvider>("br");
+
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip, deflate, br")) == nullptr)
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip, deflate, br")) == nullptr)
+    OATPP_ASSERT(providers.negotiate(nullptr) == nullptr)
+
+    providers.add(gzip);
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip, deflate, br")) == gzip)
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip, deflate, br")) == gzip)
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("identity")) == nullptr)
+
+    providers.add(br);
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("br")) == br)
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("deflate, gzip")) == gzip)
+
+    oatpp::web::protocol::http::encoding::ProviderCollection other;
+    OATPP_ASSERT(other.negotiate(StringKeyLabel("br")) == nullptr)
+    OATPP_ASSERT(providers.negotiate(StringKeyLabel("br")) == br)
+  }
+
+  { // Memoized result doesn't keep the provider alive
+    auto gzip = std::make_shared<FakeProvider>("gzip");
+    std::weak_ptr<FakeProvider> weakGzip = gzip;
+    {
+      oatpp::web::protocol::http::encoding::ProviderCollection providers;
+      providers.add(gzip);
+      OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip")) == gzip)
+      OATPP_ASSERT(providers.negotiate(StringKeyLabel("gzip")) == gzip)
+    }
+    gzip.reset();
+    OATPP_ASSERT(weakGzip.expired())
+  }
+
+  { // Performance
+    oatpp::web::protocol::http::encoding::ProviderCollection providers;
+    providers.add(std::make_shared<FakeProvider>("gzip"));
+    providers.add(std::make_shared<FakeProvider>("deflate"));
+
+    oatpp::String header = "gzip, deflate, br, zstd";
+    StringKeyLabel label(header);
+    const v_int32 iterations = 100000;
+
+    {
+      oatpp::test::PerformanceChecker checker("Accept-Encoding negotiation x 100000 - parse");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        oatpp::web::protocol::http::HeaderValueData valueData;
+        oatpp::web::protocol::http::Parser::parseHeaderValueData(valueData, label, ',');
+        OATPP_ASSERT(providers.get(valueData.tokens) != nullptr)
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Accept-Encoding negotiation x 100000 - memoized");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        OATPP_ASSERT(providers.negotiate(label) != nullptr)
+      }
+    }
+  }
+
+}
+
+}}}}}}
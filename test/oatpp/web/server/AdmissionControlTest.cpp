@@ -0,0 +1,246 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AdmissionControlTest.hpp"
+
+#include "oatpp/web/app/ControllerAsync.hpp"
+
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::server::AsyncHttpConnectionHandler AsyncHttpConnectionHandler;
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+
+struct Client {
+  std::shared_ptr<oatpp::network::ClientConnectionProvider> connectionProvider;
+  std::shared_ptr<HttpRequestExecutor> executor;
+};
+
+class Blocker : public oatpp::async::Coroutine<Blocker> {
+private:
+  std::chrono::milliseconds m_time;
+public:
+
+  Blocker(const std::chrono::milliseconds& time)
+    : m_time(time)
+  {}
+
+  Action act() override {
+    /* occupy the processor thread - simulates CPU-heavy handlers */
+    std::this_thread::sleep_for(m_time);
+    return finish();
+  }
+
+};
+
+void runServer(const oatpp::String& interfaceName,
+               const AsyncHttpConnectionHandler::AdmissionConfig& config,
+               const std::function<void(const Client&,
+                                        const std::shared_ptr<AsyncHttpConnectionHandler>&,
+                                        const std::shared_ptr<oatpp::async::Executor>&)>& clientCode)
+{
+
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  auto handler = AsyncHttpConnectionHandler::createShared(router, executor);
+  handler->setAdmissionConfig(config);
+
+  /* each case gets its own interface - connections of the previous case can't reach this server */
+  oatpp::test::web::ClientServerTestRunner::runOnVirtualInterface(
+    interfaceName, router, handler, app::ControllerAsync::createShared(std::make_shared<oatpp::json::ObjectMapper>()),
+    [&handler, &executor, &clientCode](const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider) {
+      Client client;
+      client.connectionProvider = connectionProvider;
+      client.executor = HttpRequestExecutor::createShared(connectionProvider);
+      clientCode(client, handler, executor);
+    }
+  );
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+/* connect and read whatever the server sends before closing the connection */
+oatpp::String readRaw(const Client& client) {
+  auto connection = client.connectionProvider->get();
+  std::string result;
+  v_char8 buffer[256];
+  while(true) {
+    async::Action action;
+    auto res = connection.object->read(buffer, 256, action);
+    if(res <= 0) {
+      break;
+    }
+    result.append(reinterpret_cast<const char*>(buffer), static_cast<size_t>(res));
+  }
+  return result;
+}
+
+void assertOk(const Client& client, const std::shared_ptr<HttpRequestExecutor::ConnectionHandle>& connection) {
+  auto response = client.executor->execute("GET", "/", {}, nullptr, connection);
+  OATPP_ASSERT(response->getStatusCode() == 200)
+  OATPP_ASSERT(response->readBodyToString() == "Hello World Async!!!")
+}
+
+/* connection coroutine may still be running after the connection is closed - wait for it too */
+void waitConnectionsClosed(const std::shared_ptr<AsyncHttpConnectionHandler>& handler,
+                           const std::shared_ptr<oatpp::async::Executor>& executor)
+{
+  while(handler->getConnectionsCount() > 0 || executor->getTasksCount() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+}
+
+void AdmissionControlTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Max connections...")
+
+    AsyncHttpConnectionHandler::AdmissionConfig config;
+    config.maxConnections = 2;
+
+    runServer("AdmissionControlTest.maxConnections", config, [this](const Client& client,
+                                                                    const std::shared_ptr<AsyncHttpConnectionHandler>& handler,
+                                                                    const std::shared_ptr<oatpp::async::Executor>& executor)
+    {
+      waitConnectionsClosed(handler, executor);
+
+      {
+        auto connection1 = client.executor->getConnection();
+        auto connection2 = client.executor->getConnection();
+        assertOk(client, connection1);
+        assertOk(client, connection2);
+
+        auto response = readRaw(client);
+        OATPP_LOGd(TAG, "shed response: '{}'", response->substr(0, 32))
+        OATPP_ASSERT(response->find("HTTP/1.1 503 Service Unavailable\r\n") == 0)
+
+        assertOk(client, connection1);
+      }
+
+      waitConnectionsClosed(handler, executor);
+      assertOk(client, nullptr);
+
+      auto stats = handler->getAdmissionStats();
+      OATPP_ASSERT(stats.admitted == 3)
+      OATPP_ASSERT(stats.shedConnections == 1)
+      OATPP_ASSERT(stats.shedExecutorTasks == 0)
+      OATPP_ASSERT(stats.shedSojourn == 0)
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Max executor tasks...")
+
+    AsyncHttpConnectionHandler::AdmissionConfig config;
+    config.maxExecutorTasks = 1;
+
+    runServer("AdmissionControlTest.maxExecutorTasks", config, [](const Client& client,
+                                                                  const std::shared_ptr<AsyncHttpConnectionHandler>& handler,
+                                                                  const std::shared_ptr<oatpp::async::Executor>& executor)
+    {
+      waitConnectionsClosed(handler, executor);
+
+      {
+        auto connection = client.executor->getConnection();
+        assertOk(client, connection);
+        OATPP_ASSERT(executor->getTasksCount() == 1)
+
+        auto response = readRaw(client);
+        OATPP_ASSERT(response->find("HTTP/1.1 503 Service Unavailable\r\n") == 0)
+      }
+
+      waitConnectionsClosed(handler, executor);
+      assertOk(client, nullptr);
+
+      auto stats = handler->getAdmissionStats();
+      OATPP_ASSERT(stats.admitted == 2)
+      OATPP_ASSERT(stats.shedExecutorTasks == 1)
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Sojourn time...")
+
+    AsyncHttpConnectionHandler::AdmissionConfig config;
+    config.targetSojourn = std::chrono::milliseconds(50);
+    config.sojournInterval = std::chrono::seconds(1);
+    config.sendServiceUnavailable = false;
+
+    runServer("AdmissionControlTest.sojourn", config, [this](const Client& client,
+                                                             const std::shared_ptr<AsyncHttpConnectionHandler>& handler,
+                                                             const std::shared_ptr<oatpp::async::Executor>& executor)
+    {
+      waitConnectionsClosed(handler, executor);
+
+      executor->execute<Blocker>(std::chrono::milliseconds(500));
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+      {
+        /* this connection waits for the blocked processor */
+        auto connection = client.executor->getConnection();
+        assertOk(client, connection);
+      }
+
+      /* overloaded - the connection is closed without response */
+      OATPP_ASSERT(readRaw(client)->empty())
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+      assertOk(client, nullptr);
+
+      auto stats = handler->getAdmissionStats();
+      OATPP_LOGd(TAG, "sojourn={}(micro)", stats.sojourn)
+      OATPP_ASSERT(stats.admitted == 2)
+      OATPP_ASSERT(stats.shedSojourn == 1)
+      OATPP_ASSERT(stats.sojourn < 50000)
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}
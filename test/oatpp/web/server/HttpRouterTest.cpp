@@ -27,6 +27,8 @@
 #include "oatpp/web/server/HttpRouter.hpp"
 #include "oatpp/Types.hpp"
 
+#include "oatpp-test/Checker.hpp"
+
 namespace oatpp { namespace test { namespace web { namespace server {
 
 namespace {
@@ -186,6 +188,18 @@ void HttpRouterTest::onRun() {
     OATPP_ASSERT(r.getMatchMap().getTail() == "?q1=1&q2=2")
   }
 
+  {
+    OATPP_LOGi(TAG, "Routing performance")
+    v_int32 numIterations = 100000;
+    v_int64 matched = 0;
+    oatpp::test::PerformanceChecker checker("Router");
+    for(v_int32 i = 0; i < numIterations; i ++) {
+      auto r = router.getRoute("GET", "ints/all/10?q1=1");
+      matched += r.getEndpoint();
+    }
+    OATPP_ASSERT(matched == -numIterations)
+  }
+
 }
 
 }}}}
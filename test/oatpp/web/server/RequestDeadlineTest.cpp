@@ -0,0 +1,190 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "RequestDeadlineTest.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/async/Executor.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace test { namespace web { namespace server {
+
+namespace {
+
+typedef oatpp::web::server::HttpProcessor HttpProcessor;
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+
+class Controller : public oatpp::web::server::api::ApiController {
+public:
+  Controller(const std::shared_ptr<ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper)
+  {}
+public:
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+  ENDPOINT_ASYNC("GET", "slow", Slow) {
+
+    ENDPOINT_ASYNC_INIT(Slow)
+
+    Action act() override {
+      return waitFor(std::chrono::seconds(10)).next(yieldTo(&Slow::onReady));
+    }
+
+    Action onReady() {
+      return _return(controller->createResponse(Status::CODE_200, "slow"));
+    }
+
+  };
+
+  ENDPOINT_ASYNC("GET", "fast", Fast) {
+
+    ENDPOINT_ASYNC_INIT(Fast)
+
+    Action act() override {
+      return _return(controller->createResponse(Status::CODE_200, request->getDeadline() > 0 ? "deadline" : "none"));
+    }
+
+  };
+
+#include OATPP_CODEGEN_END(ApiController)
+
+};
+
+void runServer(const std::shared_ptr<HttpProcessor::Config>& config,
+               const std::function<void(const std::shared_ptr<HttpRequestExecutor>&)>& clientCode)
+{
+
+  auto executor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  auto handler = std::make_shared<oatpp::web::server::AsyncHttpConnectionHandler>(router, config, executor);
+
+  oatpp::test::web::ClientServerTestRunner::runOnVirtualInterface(
+    "RequestDeadlineTest", router, handler, std::make_shared<Controller>(std::make_shared<oatpp::json::ObjectMapper>()),
+    [&clientCode](const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider) {
+      clientCode(HttpRequestExecutor::createShared(connectionProvider));
+    }
+  );
+
+  executor->waitTasksFinished();
+  executor->stop();
+  executor->join();
+
+}
+
+void assertTimedOut(const std::shared_ptr<HttpRequestExecutor>& requestExecutor, const HttpRequestExecutor::Headers& headers) {
+  auto startTime = oatpp::Environment::getMicroTickCount();
+  auto response = requestExecutor->execute("GET", "/slow", headers, nullptr, nullptr);
+  auto elapsed = oatpp::Environment::getMicroTickCount() - startTime;
+  OATPP_LOGd("RequestDeadlineTest", "status={}, elapsed={}(micro)", response->getStatusCode(), elapsed)
+  OATPP_ASSERT(response->getStatusCode() == 504)
+  OATPP_ASSERT(elapsed < 5 * 1000 * 1000)
+}
+
+oatpp::String getFast(const std::shared_ptr<HttpRequestExecutor>& requestExecutor, const HttpRequestExecutor::Headers& headers) {
+  auto response = requestExecutor->execute("GET", "/fast", headers, nullptr, nullptr);
+  OATPP_ASSERT(response->getStatusCode() == 200)
+  return response->readBodyToString();
+}
+
+}
+
+void RequestDeadlineTest::onRun() {
+
+  HttpRequestExecutor::Headers timeoutHeader;
+  timeoutHeader.put("X-Request-Timeout", "100");
+
+  {
+    OATPP_LOGi(TAG, "Config deadline...")
+
+    auto config = std::make_shared<HttpProcessor::Config>();
+    config->requestDeadline = std::chrono::milliseconds(100);
+
+    runServer(config, [](const std::shared_ptr<HttpRequestExecutor>& requestExecutor) {
+      assertTimedOut(requestExecutor, {});
+      OATPP_ASSERT(getFast(requestExecutor, {}) == "deadline")
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Header deadline...")
+
+    auto config = std::make_shared<HttpProcessor::Config>();
+    config->deadlineHeader = "X-Request-Timeout";
+
+    runServer(config, [&timeoutHeader](const std::shared_ptr<HttpRequestExecutor>& requestExecutor) {
+      assertTimedOut(requestExecutor, timeoutHeader);
+      OATPP_ASSERT(getFast(requestExecutor, timeoutHeader) == "deadline")
+      OATPP_ASSERT(getFast(requestExecutor, {}) == "none")
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Huge deadlines are clamped...")
+
+    auto config = std::make_shared<HttpProcessor::Config>();
+    config->requestDeadline = std::chrono::duration<v_int64, std::micro>::max();
+    config->deadlineHeader = "X-Request-Timeout";
+
+    runServer(config, [](const std::shared_ptr<HttpRequestExecutor>& requestExecutor) {
+      HttpRequestExecutor::Headers hugeHeader;
+      hugeHeader.put("X-Request-Timeout", "9223372036854775807");
+      OATPP_ASSERT(getFast(requestExecutor, hugeHeader) == "deadline")
+      OATPP_ASSERT(getFast(requestExecutor, {}) == "deadline")
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Earlier deadline wins...")
+
+    auto config = std::make_shared<HttpProcessor::Config>();
+    config->requestDeadline = std::chrono::minutes(1);
+    config->deadlineHeader = "X-Request-Timeout";
+
+    runServer(config, [&timeoutHeader](const std::shared_ptr<HttpRequestExecutor>& requestExecutor) {
+      assertTimedOut(requestExecutor, timeoutHeader);
+    });
+
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}
@@ -0,0 +1,311 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "RateLimiterTest.hpp"
+
+#include "oatpp/web/app/Controller.hpp"
+#include "oatpp/web/app/ControllerAsync.hpp"
+
+#include "oatpp/web/server/interceptor/RateLimiter.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include "oatpp/json/ObjectMapper.hpp"
+
+#include "oatpp/async/Executor.hpp"
+#include "oatpp/utils/Conversion.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace web { namespace server { namespace interceptor {
+
+namespace {
+
+typedef oatpp::web::server::interceptor::RateLimiter RateLimiter;
+typedef oatpp::web::client::HttpRequestExecutor HttpRequestExecutor;
+typedef oatpp::web::protocol::http::Headers Headers;
+
+}
+
+void RateLimiterTest::onRun() {
+
+  {
+    OATPP_LOGi(TAG, "Burst...")
+
+    RateLimiter::Config config;
+    config.rate = 1;
+    config.burst = 5;
+    RateLimiter limiter(config);
+
+    v_int64 retryAfter;
+    for(v_int32 i = 0; i < 5; i ++) {
+      OATPP_ASSERT(limiter.tryAcquire("a", retryAfter))
+      OATPP_ASSERT(limiter.tryAcquire("b", retryAfter))
+    }
+    OATPP_ASSERT(!limiter.tryAcquire("a", retryAfter))
+    OATPP_ASSERT(retryAfter > 0 && retryAfter <= 1000000)
+
+    OATPP_ASSERT(limiter.getAllowedCount() == 10)
+    OATPP_ASSERT(limiter.getRejectedCount() == 1)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Refill...")
+
+    RateLimiter::Config config;
+    config.rate = 100;
+    config.burst = 1;
+    RateLimiter limiter(config);
+
+    v_int64 retryAfter;
+    OATPP_ASSERT(limiter.tryAcquire("a", retryAfter))
+    OATPP_ASSERT(!limiter.tryAcquire("a", retryAfter))
+    std::this_thread::sleep_for(std::chrono::microseconds(retryAfter + 1000));
+    OATPP_ASSERT(limiter.tryAcquire("a", retryAfter))
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Concurrent...")
+
+    RateLimiter::Config config;
+    config.rate = 0.001;
+    config.burst = 1000;
+    auto limiter = RateLimiter::createShared(config);
+
+    std::vector<std::thread> threads;
+    for(v_int32 i = 0; i < 8; i ++) {
+      threads.emplace_back([limiter]{
+        v_int64 retryAfter;
+        for(v_int32 j = 0; j < 500; j ++) {
+          limiter->tryAcquire("same-key", retryAfter);
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    OATPP_ASSERT(limiter->getAllowedCount() == 1000)
+    OATPP_ASSERT(limiter->getRejectedCount() == 3000)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Bounded table...")
+
+    RateLimiter::Config config;
+    config.rate = 1;
+    config.burst = 1;
+    config.shardsCount = 1;
+    config.shardCapacity = 8;
+    RateLimiter limiter(config);
+    OATPP_ASSERT(limiter.getCapacity() == 8)
+
+    v_int64 retryAfter;
+    for(v_int32 i = 0; i < 8; i ++) {
+      OATPP_ASSERT(limiter.tryAcquire("key-" + utils::Conversion::int32ToStr(i), retryAfter))
+    }
+
+    // table is full and nothing is idle - new keys share the overflow bucket
+    OATPP_ASSERT(limiter.tryAcquire("new-key-1", retryAfter))
+    OATPP_ASSERT(!limiter.tryAcquire("new-key-2", retryAfter))
+    OATPP_ASSERT(limiter.getEvictedCount() == 0)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "Idle eviction...")
+
+    RateLimiter::Config config;
+    config.rate = 1000;
+    config.burst = 1;
+    config.shardsCount = 1;
+    config.shardCapacity = 8;
+    config.idleTimeout = std::chrono::milliseconds(10);
+    RateLimiter limiter(config);
+
+    v_int64 retryAfter;
+    for(v_int32 i = 0; i < 8; i ++) {
+      OATPP_ASSERT(limiter.tryAcquire("key-" + utils::Conversion::int32ToStr(i), retryAfter))
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    OATPP_ASSERT(limiter.tryAcquire("new-key-1", retryAfter))
+    OATPP_ASSERT(limiter.tryAcquire("new-key-2", retryAfter))
+    OATPP_ASSERT(limiter.getEvictedCount() == 2)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  auto objectMapper = std::make_shared<oatpp::json::ObjectMapper>();
+
+  {
+    OATPP_LOGi(TAG, "HttpConnectionHandler - key by path...")
+
+    RateLimiter::Config config;
+    config.keyType = RateLimiter::KeyType::PATH;
+    config.rate = 0.01;
+    config.burst = 3;
+    auto limiter = RateLimiter::createShared(config);
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    auto handler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    handler->addRequestInterceptor(limiter);
+
+    oatpp::test::web::ClientServerTestRunner::runOnVirtualInterface(
+      "RateLimiterTest", router, handler, app::Controller::createShared(objectMapper),
+      [](const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider) {
+
+      auto executor = HttpRequestExecutor::createShared(connectionProvider);
+
+      for(v_int32 i = 0; i < 3; i ++) {
+        auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+        OATPP_ASSERT(response->getStatusCode() == 200)
+        OATPP_ASSERT(response->readBodyToString() == "Hello World!!!")
+      }
+
+      auto response = executor->execute("GET", "/", {}, nullptr, nullptr);
+      OATPP_ASSERT(response->getStatusCode() == 429)
+      OATPP_ASSERT(response->getHeader("Retry-After") != nullptr)
+      response->readBodyToString();
+
+      response = executor->execute("GET", "cors", {}, nullptr, nullptr);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      response->readBodyToString();
+
+    });
+
+    OATPP_ASSERT(limiter->getAllowedCount() == 4)
+    OATPP_ASSERT(limiter->getRejectedCount() == 1)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "HttpConnectionHandler - key by remote address without peer_address...")
+
+    RateLimiter::Config config;
+    config.keyType = RateLimiter::KeyType::REMOTE_ADDRESS;
+    config.rate = 0.01;
+    config.burst = 2;
+    auto limiter = RateLimiter::createShared(config);
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    auto handler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    handler->addRequestInterceptor(limiter);
+
+    oatpp::test::web::ClientServerTestRunner::runOnVirtualInterface(
+      "RateLimiterTest", router, handler, app::Controller::createShared(objectMapper),
+      [](const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider) {
+
+      auto executor = HttpRequestExecutor::createShared(connectionProvider);
+
+      /* virtual connections have no peer_address - each connection gets its own bucket */
+      auto connection1 = executor->getConnection();
+      auto connection2 = executor->getConnection();
+
+      for(v_int32 i = 0; i < 2; i ++) {
+        auto response = executor->execute("GET", "/", {}, nullptr, connection1);
+        OATPP_ASSERT(response->getStatusCode() == 200)
+        response->readBodyToString();
+      }
+
+      auto response = executor->execute("GET", "/", {}, nullptr, connection1);
+      OATPP_ASSERT(response->getStatusCode() == 429)
+      response->readBodyToString();
+
+      response = executor->execute("GET", "/", {}, nullptr, connection2);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      response->readBodyToString();
+
+      executor->invalidateConnection(connection1);
+      executor->invalidateConnection(connection2);
+
+    });
+
+    OATPP_ASSERT(limiter->getAllowedCount() == 3)
+    OATPP_ASSERT(limiter->getRejectedCount() == 1)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+  {
+    OATPP_LOGi(TAG, "AsyncHttpConnectionHandler - key by header...")
+
+    RateLimiter::Config config;
+    config.keyType = RateLimiter::KeyType::HEADER;
+    config.keyHeader = "X-API-Key";
+    config.rate = 0.01;
+    config.burst = 2;
+    auto limiter = RateLimiter::createShared(config);
+
+    auto router = oatpp::web::server::HttpRouter::createShared();
+    auto asyncExecutor = std::make_shared<oatpp::async::Executor>(1, 1, 1);
+    auto handler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, asyncExecutor);
+    handler->addRequestInterceptor(limiter);
+
+    oatpp::test::web::ClientServerTestRunner::runOnVirtualInterface(
+      "RateLimiterTest", router, handler, app::ControllerAsync::createShared(objectMapper),
+      [](const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider) {
+
+      auto executor = HttpRequestExecutor::createShared(connectionProvider);
+
+      Headers key1;
+      key1.put("X-API-Key", "key-1");
+      Headers key2;
+      key2.put("X-API-Key", "key-2");
+
+      for(v_int32 i = 0; i < 2; i ++) {
+        auto response = executor->execute("GET", "/", key1, nullptr, nullptr);
+        OATPP_ASSERT(response->getStatusCode() == 200)
+        response->readBodyToString();
+      }
+
+      auto response = executor->execute("GET", "/", key1, nullptr, nullptr);
+      OATPP_ASSERT(response->getStatusCode() == 429)
+      response->readBodyToString();
+
+      response = executor->execute("GET", "/", key2, nullptr, nullptr);
+      OATPP_ASSERT(response->getStatusCode() == 200)
+      response->readBodyToString();
+
+    });
+
+    asyncExecutor->waitTasksFinished();
+    asyncExecutor->stop();
+    asyncExecutor->join();
+
+    OATPP_ASSERT(limiter->getAllowedCount() == 3)
+    OATPP_ASSERT(limiter->getRejectedCount() == 1)
+    OATPP_LOGi(TAG, "OK")
+  }
+
+}
+
+}}}}}